@@ -0,0 +1,460 @@
+#include "Baseline.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+namespace Details
+{
+	struct JsonMember;
+
+	// Just enough JSON for the results files, numbers are doubles and objects keep their order
+	struct JsonValue
+	{
+		enum class Type
+		{
+			Null,
+			Bool,
+			Number,
+			String,
+			Array,
+			Object
+		};
+
+		Type type = Type::Null;
+		bool boolean = false;
+		double number = 0.0;
+		std::string string;
+		std::vector<JsonValue> elements;
+		std::vector<JsonMember> members;
+
+		// Member of an object, nullptr if there's none with the name
+		const JsonValue* Find(std::string_view name) const;
+	};
+
+	struct JsonMember
+	{
+		std::string name;
+		JsonValue value;
+	};
+
+	const JsonValue* JsonValue::Find(std::string_view name) const
+	{
+		for (const auto& member : members)
+		{
+			if (member.name == name)
+				return &member.value;
+		}
+		return nullptr;
+	}
+
+	class JsonParser
+	{
+	public:
+		inline JsonParser(std::string_view text) :m_text(text) {}
+
+		bool Parse(JsonValue& value)
+		{
+			if (!ParseValue(value, 0))
+				return false;
+			SkipWhitespace();
+			return m_pos == m_text.size();
+		}
+
+		inline size_t GetPosition() const { return m_pos; }
+	private:
+		// Results files nest three deep, this only stops malformed input from overflowing the stack
+		static constexpr uint32_t maxDepth = 64;
+
+		void SkipWhitespace()
+		{
+			while ((m_pos < m_text.size()) && ((m_text[m_pos] == ' ') || (m_text[m_pos] == '\t') || (m_text[m_pos] == '\n') || (m_text[m_pos] == '\r')))
+				m_pos++;
+		}
+
+		bool Consume(char c)
+		{
+			SkipWhitespace();
+			if ((m_pos >= m_text.size()) || (m_text[m_pos] != c))
+				return false;
+			m_pos++;
+			return true;
+		}
+
+		bool ConsumeLiteral(std::string_view literal)
+		{
+			if (m_text.substr(m_pos, literal.size()) != literal)
+				return false;
+			m_pos += literal.size();
+			return true;
+		}
+
+		bool ParseString(std::string& string)
+		{
+			if (!Consume('"'))
+				return false;
+
+			while (m_pos < m_text.size())
+			{
+				const char c = m_text[m_pos++];
+				if (c == '"')
+					return true;
+				if (c != '\\')
+				{
+					string += c;
+					continue;
+				}
+
+				if (m_pos >= m_text.size())
+					return false;
+				const char escaped = m_text[m_pos++];
+				switch (escaped)
+				{
+				case 'n': string += '\n'; break;
+				case 't': string += '\t'; break;
+				case 'r': string += '\r'; break;
+				case 'b': string += '\b'; break;
+				case 'f': string += '\f'; break;
+				case 'u':
+				{
+					// Only control characters are written escaped, anything outside ASCII is replaced
+					if (m_pos + 4 > m_text.size())
+						return false;
+					const unsigned long code = std::strtoul(std::string(m_text.substr(m_pos, 4)).c_str(), nullptr, 16);
+					string += code < 0x80 ? static_cast<char>(code) : '?';
+					m_pos += 4;
+					break;
+				}
+				default: string += escaped; break;
+				}
+			}
+			return false;
+		}
+
+		bool ParseValue(JsonValue& value, uint32_t depth)
+		{
+			if (depth > maxDepth)
+				return false;
+
+			SkipWhitespace();
+			if (m_pos >= m_text.size())
+				return false;
+
+			switch (m_text[m_pos])
+			{
+			case '{':
+			{
+				m_pos++;
+				value.type = JsonValue::Type::Object;
+				if (Consume('}'))
+					return true;
+				do
+				{
+					JsonMember member;
+					if (!ParseString(member.name) || !Consume(':') || !ParseValue(member.value, depth + 1))
+						return false;
+					value.members.push_back(std::move(member));
+				} while (Consume(','));
+				return Consume('}');
+			}
+			case '[':
+			{
+				m_pos++;
+				value.type = JsonValue::Type::Array;
+				if (Consume(']'))
+					return true;
+				do
+				{
+					value.elements.emplace_back();
+					if (!ParseValue(value.elements.back(), depth + 1))
+						return false;
+				} while (Consume(','));
+				return Consume(']');
+			}
+			case '"':
+				value.type = JsonValue::Type::String;
+				return ParseString(value.string);
+			case 't':
+				value.type = JsonValue::Type::Bool;
+				value.boolean = true;
+				return ConsumeLiteral("true");
+			case 'f':
+				value.type = JsonValue::Type::Bool;
+				return ConsumeLiteral("false");
+			case 'n':
+				return ConsumeLiteral("null");
+			default:
+			{
+				// strtod needs a terminated string, numbers are short
+				const size_t end = m_text.find_first_not_of("+-0123456789.eE", m_pos);
+				const std::string number{ m_text.substr(m_pos, end - m_pos) };
+				char* numberEnd = nullptr;
+				value.type = JsonValue::Type::Number;
+				value.number = std::strtod(number.c_str(), &numberEnd);
+				if (number.empty() || (numberEnd != number.c_str() + number.size()))
+					return false;
+				m_pos += number.size();
+				return true;
+			}
+			}
+		}
+
+		std::string_view m_text;
+		size_t m_pos = 0;
+	};
+
+	static double GetNumber(const JsonValue& object, std::string_view name)
+	{
+		const JsonValue* value = object.Find(name);
+		return (value && (value->type == JsonValue::Type::Number)) ? value->number : 0.0;
+	}
+
+	static std::vector<double> GetNumbers(const JsonValue& object, std::string_view name)
+	{
+		std::vector<double> numbers;
+		const JsonValue* value = object.Find(name);
+		if (!value || (value->type != JsonValue::Type::Array))
+			return numbers;
+
+		numbers.reserve(value->elements.size());
+		for (const auto& element : value->elements)
+		{
+			if (element.type == JsonValue::Type::Number)
+				numbers.push_back(element.number);
+		}
+		return numbers;
+	}
+
+	static double GetMedian(std::vector<double> values)
+	{
+		if (values.empty())
+			return 0.0;
+		std::sort(values.begin(), values.end());
+		const size_t count = values.size();
+		return (count % 2) ? values[count / 2] : (values[count / 2 - 1] + values[count / 2]) / 2.0;
+	}
+
+	static double GetMean(const std::vector<double>& values)
+	{
+		double sum = 0.0;
+		for (double value : values)
+			sum += value;
+		return values.empty() ? 0.0 : sum / values.size();
+	}
+
+	// Medians of consecutive blocks of samples, a partial block at the end is dropped unless it's the only one
+	static std::vector<double> GetBlockMedians(const std::vector<double>& samples, size_t blockSize)
+	{
+		if (blockSize <= 1)
+			return samples;
+
+		std::vector<double> medians;
+		for (size_t i = 0; i + blockSize <= samples.size(); i += blockSize)
+			medians.push_back(GetMedian(std::vector<double>(samples.begin() + i, samples.begin() + i + blockSize)));
+		if (medians.empty() && !samples.empty())
+			medians.push_back(GetMedian(samples));
+		return medians;
+	}
+
+	// Interquartile range relative to the median, how much a run's values vary on their own
+	static double GetRelativeSpread(std::vector<double> values)
+	{
+		if (values.size() < 2)
+			return 0.0;
+		std::sort(values.begin(), values.end());
+		const double median = GetMedian(values);
+		const double lower = values[(values.size() - 1) / 4];
+		const double upper = values[values.size() - 1 - (values.size() - 1) / 4];
+		return median > 0.0 ? (upper - lower) / median : 0.0;
+	}
+
+	// Compares two sets of times, times are regressions when they're both significantly and noticeably slower
+	// Consecutive frames depend on each other (caches, clocks, whatever else the machine is doing), tested one by one even
+	// a run against itself looks significant, so frames are tested as medians of blocks which are close to independent
+	static Comparison CompareTimes(const std::string& name, const char* metric, const std::vector<double>& baseline, const std::vector<double>& current, size_t blockSize, const RegressionConfig& config)
+	{
+		const std::vector<double> baselineBlocks = GetBlockMedians(baseline, blockSize);
+		const std::vector<double> currentBlocks = GetBlockMedians(current, blockSize);
+
+		Comparison comparison;
+		comparison.name = name;
+		comparison.metric = metric;
+		comparison.baseline = GetMedian(baselineBlocks);
+		comparison.current = GetMedian(currentBlocks);
+
+		const MannWhitneyResult slower = MannWhitneyU(baselineBlocks, currentBlocks);
+		const MannWhitneyResult faster = MannWhitneyU(currentBlocks, baselineBlocks);
+		const double change = comparison.baseline > 0.0 ? comparison.current / comparison.baseline - 1.0 : 0.0;
+		// A difference within the spread either run has on its own is noise, however significant the test finds it
+		const double minChange = std::max({ config.threshold, GetRelativeSpread(baselineBlocks), GetRelativeSpread(currentBlocks) });
+		comparison.pValue = std::min(slower.pValue, faster.pValue);
+		comparison.isRegression = (slower.pValue < config.alpha) && (change > minChange);
+		comparison.isImprovement = (faster.pValue < config.alpha) && (change < -minChange);
+		return comparison;
+	}
+}
+
+bool ReadBaseline(std::string_view path, std::vector<BenchmarkResult>& results, std::string& error)
+{
+	results.clear();
+
+	std::ifstream stream{ std::string(path) };
+	if (!stream)
+	{
+		error = "Couldn't open " + std::string(path);
+		return false;
+	}
+	std::stringstream text;
+	text << stream.rdbuf();
+	const std::string contents = text.str();
+
+	Details::JsonValue root;
+	Details::JsonParser parser{ contents };
+	if (!parser.Parse(root))
+	{
+		error = "Invalid JSON near offset " + std::to_string(parser.GetPosition());
+		return false;
+	}
+
+	const Details::JsonValue* benchmarks = root.Find("benchmarks");
+	if ((root.type != Details::JsonValue::Type::Object) || !benchmarks || (benchmarks->type != Details::JsonValue::Type::Array))
+	{
+		error = "Missing benchmarks array";
+		return false;
+	}
+
+	for (const auto& benchmark : benchmarks->elements)
+	{
+		const Details::JsonValue* name = benchmark.Find("name");
+		const Details::JsonValue* type = benchmark.Find("type");
+		if (!name || (name->type != Details::JsonValue::Type::String))
+		{
+			error = "Benchmark without a name";
+			return false;
+		}
+
+		BenchmarkResult result;
+		result.name = name->string;
+		result.isMacro = type && (type->string == "macro");
+		if (const Details::JsonValue* benchmarkError = benchmark.Find("error"))
+			result.error = benchmarkError->string;
+
+		result.numIterations = static_cast<uint64_t>(Details::GetNumber(benchmark, "iterations"));
+		result.median = Details::GetNumber(benchmark, "median");
+		result.mean = Details::GetNumber(benchmark, "mean");
+		result.min = Details::GetNumber(benchmark, "min");
+		result.max = Details::GetNumber(benchmark, "max");
+		result.p99 = Details::GetNumber(benchmark, "p99");
+		result.standardDeviation = Details::GetNumber(benchmark, "stddev");
+		result.bytesPerSecond = Details::GetNumber(benchmark, "bytesPerSecond");
+		result.allocationsPerOperation = Details::GetNumber(benchmark, "allocationsPerOperation");
+		result.samples = Details::GetNumbers(benchmark, "samples");
+		result.cpuFrameTimes = Details::GetNumbers(benchmark, "cpuSamples");
+		result.gpuFrameTimes = Details::GetNumbers(benchmark, "gpuSamples");
+		result.frameAllocations = Details::GetNumbers(benchmark, "allocationSamples");
+		results.push_back(std::move(result));
+	}
+
+	return true;
+}
+
+MannWhitneyResult MannWhitneyU(const std::vector<double>& baseline, const std::vector<double>& current)
+{
+	MannWhitneyResult result;
+	const size_t n1 = current.size();
+	const size_t n2 = baseline.size();
+	if (!n1 || !n2)
+		return result;
+
+	// Rank both samples together, tied values share the average of their ranks
+	std::vector<std::pair<double, bool>> values;
+	values.reserve(n1 + n2);
+	for (double value : current)
+		values.emplace_back(value, true);
+	for (double value : baseline)
+		values.emplace_back(value, false);
+	std::sort(values.begin(), values.end(), [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+	const double n = static_cast<double>(n1 + n2);
+	double currentRankSum = 0.0;
+	double tieCorrection = 0.0;
+	for (size_t i = 0; i < values.size();)
+	{
+		size_t j = i;
+		while ((j < values.size()) && (values[j].first == values[i].first))
+			j++;
+
+		const double rank = (i + 1 + j) / 2.0;
+		for (size_t k = i; k < j; k++)
+		{
+			if (values[k].second)
+				currentRankSum += rank;
+		}
+		const double numTied = static_cast<double>(j - i);
+		tieCorrection += numTied * numTied * numTied - numTied;
+		i = j;
+	}
+
+	result.u = currentRankSum - n1 * (n1 + 1) / 2.0;
+	const double mean = n1 * n2 / 2.0;
+	const double variance = n1 * n2 / 12.0 * ((n + 1.0) - tieCorrection / (n * (n - 1.0)));
+	// Every value is the same, there's nothing to tell the samples apart
+	if (variance <= 0.0)
+		return result;
+
+	// Continuity correction, U only takes whole or half values
+	result.z = (result.u - mean - 0.5) / std::sqrt(variance);
+	result.pValue = 0.5 * std::erfc(result.z / std::sqrt(2.0));
+	return result;
+}
+
+std::vector<Comparison> CompareResults(const std::vector<BenchmarkResult>& baseline, const std::vector<BenchmarkResult>& current, const RegressionConfig& config)
+{
+	std::vector<Comparison> comparisons;
+
+	for (const auto& result : current)
+	{
+		auto it = std::find_if(baseline.begin(), baseline.end(), [&](const BenchmarkResult& baselineResult) { return baselineResult.name == result.name; });
+		if ((it == baseline.end()) || !it->error.empty() || !result.error.empty())
+			continue;
+
+		// Micro benchmark samples already time many iterations each, only frames need grouping
+		const size_t blockSize = result.isMacro ? config.frameBlockSize : 1;
+		comparisons.push_back(Details::CompareTimes(result.name, "time", it->samples, result.samples, blockSize, config));
+		if (!it->cpuFrameTimes.empty() && !result.cpuFrameTimes.empty())
+			comparisons.push_back(Details::CompareTimes(result.name, "cpu", it->cpuFrameTimes, result.cpuFrameTimes, blockSize, config));
+		if (!it->gpuFrameTimes.empty() && !result.gpuFrameTimes.empty())
+			comparisons.push_back(Details::CompareTimes(result.name, "gpu", it->gpuFrameTimes, result.gpuFrameTimes, blockSize, config));
+
+		// Allocation counts hardly vary between runs, so any real increase is a regression
+		Comparison allocations;
+		allocations.name = result.name;
+		allocations.metric = "allocations";
+		allocations.baseline = it->frameAllocations.empty() ? it->allocationsPerOperation : Details::GetMean(it->frameAllocations);
+		allocations.current = result.frameAllocations.empty() ? result.allocationsPerOperation : Details::GetMean(result.frameAllocations);
+		allocations.isRegression = allocations.current > allocations.baseline * (1.0 + config.threshold) + config.allocationTolerance;
+		allocations.isImprovement = allocations.current < allocations.baseline * (1.0 - config.threshold) - config.allocationTolerance;
+		allocations.pValue = (allocations.isRegression || allocations.isImprovement) ? 0.0 : 1.0;
+		comparisons.push_back(std::move(allocations));
+	}
+
+	return comparisons;
+}
+
+uint32_t PrintComparisons(const std::vector<Comparison>& comparisons)
+{
+	uint32_t numRegressions = 0;
+	for (const auto& comparison : comparisons)
+	{
+		const double change = comparison.baseline > 0.0 ? 100.0 * (comparison.current / comparison.baseline - 1.0) : 0.0;
+		const char* verdict = comparison.isRegression ? "REGRESSION" : (comparison.isImprovement ? "improved" : "");
+		std::printf("%-40s %-12s %14.3f -> %14.3f %+8.1f%% p=%.4f %s\n", comparison.name.c_str(), comparison.metric.c_str(),
+			comparison.baseline, comparison.current, change, comparison.pValue, verdict);
+		numRegressions += comparison.isRegression;
+	}
+	std::fflush(stdout);
+	return numRegressions;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#ifndef BENCH_BASELINE_H
+#define BENCH_BASELINE_H
+
+#include "Benchmark.h"
+
+#include <string_view>
+
+// Reads results written by BenchmarkRunner::WriteJson, eg. a run of the last accepted version kept as the baseline
+// Returns false and sets error if the file can't be read or isn't in that format
+bool ReadBaseline(std::string_view path, std::vector<BenchmarkResult>& results, std::string& error);
+
+// Thresholds for when a difference from the baseline is a regression
+struct RegressionConfig
+{
+	// Significance level of the Mann-Whitney U test, lower needs more evidence before failing
+	double alpha = 0.01;
+	// Medians also have to differ by this fraction, and by more than the spread of either run's own samples
+	double threshold = 0.05;
+	// Frames are compared as medians of blocks this long, the test needs about 8 blocks in each run to ever fail
+	uint32_t frameBlockSize = 30;
+	// Allocations per operation or frame that may be added before it's a regression
+	double allocationTolerance = 0.5;
+};
+
+// Result of a one-sided Mann-Whitney U test, whether current tends to be larger than baseline
+struct MannWhitneyResult
+{
+	double u = 0.0;
+	double z = 0.0;
+	// Probability of a U at least this large if both samples came from the same distribution
+	double pValue = 1.0;
+};
+
+// Uses the normal approximation with a tie correction, which is accurate enough from about 8 samples each
+MannWhitneyResult MannWhitneyU(const std::vector<double>& baseline, const std::vector<double>& current);
+
+struct Comparison
+{
+	std::string name;
+	// "time", "cpu", "gpu" or "allocations"
+	std::string metric;
+	// Medians for times (of the block medians for frames), means for allocations
+	double baseline = 0.0;
+	double current = 0.0;
+	double pValue = 1.0;
+	bool isRegression = false;
+	bool isImprovement = false;
+};
+
+// Compares every benchmark that's in both result sets, benchmarks missing from either are skipped
+std::vector<Comparison> CompareResults(const std::vector<BenchmarkResult>& baseline, const std::vector<BenchmarkResult>& current, const RegressionConfig& config);
+// Prints the comparisons, returns the number of regressions
+uint32_t PrintComparisons(const std::vector<Comparison>& comparisons);
+
+#endif // BENCH_BASELINE_H
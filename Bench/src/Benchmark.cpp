@@ -0,0 +1,265 @@
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <iomanip>
+#include <numeric>
+
+namespace Details
+{
+	// Iterations grow at most this much between calibration runs, one short run shouldn't explode the count
+	constexpr double maxCalibrationGrowth = 10.0;
+
+	// Nearest-rank percentile of sorted samples, percentile is in [0, 1]
+	static double GetPercentile(const std::vector<double>& sortedSamples, double percentile)
+	{
+		if (sortedSamples.empty())
+			return 0.0;
+		const size_t rank = static_cast<size_t>(std::ceil(percentile * sortedSamples.size()));
+		return sortedSamples[std::min(std::max<size_t>(rank, 1), sortedSamples.size()) - 1];
+	}
+
+	static void Summarize(BenchmarkResult& result)
+	{
+		if (result.samples.empty())
+			return;
+
+		std::vector<double> sorted = result.samples;
+		std::sort(sorted.begin(), sorted.end());
+
+		const size_t count = sorted.size();
+		result.min = sorted.front();
+		result.max = sorted.back();
+		result.median = (count % 2) ? sorted[count / 2] : (sorted[count / 2 - 1] + sorted[count / 2]) / 2.0;
+		result.p99 = GetPercentile(sorted, 0.99);
+		result.mean = std::accumulate(sorted.begin(), sorted.end(), 0.0) / count;
+
+		double sumOfSquares = 0.0;
+		for (double sample : sorted)
+			sumOfSquares += (sample - result.mean) * (sample - result.mean);
+		result.standardDeviation = count > 1 ? std::sqrt(sumOfSquares / (count - 1)) : 0.0;
+	}
+
+	static void WriteJsonString(std::ostream& stream, std::string_view string)
+	{
+		stream << '"';
+		for (char c : string)
+		{
+			switch (c)
+			{
+			case '"': stream << "\\\""; break;
+			case '\\': stream << "\\\\"; break;
+			case '\n': stream << "\\n"; break;
+			case '\t': stream << "\\t"; break;
+			default:
+				if (static_cast<unsigned char>(c) < 0x20)
+					stream << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec << std::setfill(' ');
+				else
+					stream << c;
+				break;
+			}
+		}
+		stream << '"';
+	}
+
+	static void WriteJsonArray(std::ostream& stream, const std::vector<double>& values)
+	{
+		stream << '[';
+		for (size_t i = 0; i < values.size(); i++)
+			stream << (i ? "," : "") << values[i];
+		stream << ']';
+	}
+
+	static void PrintResult(const BenchmarkResult& result)
+	{
+		if (!result.error.empty())
+		{
+			std::printf("%-40s failed: %s\n", result.name.c_str(), result.error.c_str());
+			return;
+		}
+
+		// Frames are easier to read in milliseconds, operations in nanoseconds
+		const double scale = result.isMacro ? 1e-6 : 1.0;
+		const char* unit = result.isMacro ? "ms" : "ns";
+		std::printf("%-40s %12.3f %s median %12.3f %s p99 %10.1f%% dev", result.name.c_str(), result.median * scale, unit, result.p99 * scale, unit,
+			result.mean > 0.0 ? 100.0 * result.standardDeviation / result.mean : 0.0);
+		if (result.bytesPerSecond > 0.0)
+			std::printf(" %10.2f MB/s", result.bytesPerSecond / (1024.0 * 1024.0));
+		std::printf(" %8.2f allocs/%s\n", result.allocationsPerOperation, result.isMacro ? "frame" : "op");
+		std::fflush(stdout);
+	}
+}
+
+Blaze::WindowCreateInfo GetHeadlessWindowInfo()
+{
+	Blaze::WindowCreateInfo windowInfo;
+	windowInfo.wndTitle = "Blaze Bench";
+	windowInfo.x = 0;
+	windowInfo.y = 0;
+	windowInfo.width = 960;
+	windowInfo.height = 540;
+	windowInfo.windowAPI = Blaze::WindowAPI::Headless;
+	return windowInfo;
+}
+
+uint64_t GetTotalAllocations()
+{
+	const Blaze::AllocationStats stats = Blaze::AllocationTracker::GetStats();
+	uint64_t numAllocations = 0;
+	for (const auto& counts : stats.total)
+		numAllocations += counts.numAllocations;
+	return numAllocations;
+}
+
+void BenchmarkRunner::AddMicro(std::string name, MicroBenchmarkFunction function)
+{
+	m_microBenchmarks.push_back(MicroBenchmark{ std::move(name), function });
+}
+
+void BenchmarkRunner::AddMacro(std::string name, MacroBenchmarkFunction function)
+{
+	m_macroBenchmarks.push_back(MacroBenchmark{ std::move(name), function });
+}
+
+std::vector<BenchmarkResult> BenchmarkRunner::Run()
+{
+	std::vector<BenchmarkResult> results;
+
+	for (const auto& benchmark : m_microBenchmarks)
+	{
+		if (benchmark.name.find(m_config.filter) == std::string::npos)
+			continue;
+		results.push_back(RunMicro(benchmark));
+		Details::PrintResult(results.back());
+	}
+	for (const auto& benchmark : m_macroBenchmarks)
+	{
+		if (benchmark.name.find(m_config.filter) == std::string::npos)
+			continue;
+		results.push_back(RunMacro(benchmark));
+		Details::PrintResult(results.back());
+	}
+
+	return results;
+}
+
+BenchmarkResult BenchmarkRunner::RunMicro(const MicroBenchmark& benchmark)
+{
+	BenchmarkResult result;
+	result.name = benchmark.name;
+
+	// Runs the benchmark once, returns the nanoseconds it took
+	uint64_t bytesPerIteration = 0;
+	auto runOnce = [&](uint64_t numIterations) -> double
+	{
+		BenchmarkState state{ numIterations };
+		benchmark.function(state);
+		if (!state.GetEnd())
+			state.StopTiming();
+
+		if (!state.GetError().empty())
+			result.error = state.GetError();
+		bytesPerIteration = state.GetBytesPerIteration();
+		return static_cast<double>(state.GetEnd() - state.GetStart());
+	};
+
+	// Grow the iterations until a sample is long enough for the timer's resolution and scheduling noise not to matter
+	const double minSampleTime = m_config.minSampleTime * 1e9;
+	uint64_t numIterations = 1;
+	for (;;)
+	{
+		const double elapsed = runOnce(numIterations);
+		if (!result.error.empty())
+			return result;
+		if (elapsed >= minSampleTime)
+			break;
+
+		const double growth = elapsed > 0.0 ? std::min(1.2 * minSampleTime / elapsed, Details::maxCalibrationGrowth) : Details::maxCalibrationGrowth;
+		numIterations = std::max(numIterations + 1, static_cast<uint64_t>(numIterations * growth));
+	}
+	result.numIterations = numIterations;
+
+	const uint64_t allocationsStart = GetTotalAllocations();
+	for (uint32_t i = 0; i < m_config.numSamples; i++)
+	{
+		const double elapsed = runOnce(numIterations);
+		if (!result.error.empty())
+			return result;
+		result.samples.push_back(elapsed / numIterations);
+	}
+	const uint64_t numAllocations = GetTotalAllocations() - allocationsStart;
+
+	Details::Summarize(result);
+	if (bytesPerIteration && (result.median > 0.0))
+		result.bytesPerSecond = bytesPerIteration * 1e9 / result.median;
+	result.allocationsPerOperation = static_cast<double>(numAllocations) / (static_cast<double>(numIterations) * m_config.numSamples);
+
+	return result;
+}
+
+BenchmarkResult BenchmarkRunner::RunMacro(const MacroBenchmark& benchmark)
+{
+	BenchmarkResult result;
+	result.name = benchmark.name;
+	result.isMacro = true;
+
+	MacroBenchmarkResult frames = benchmark.function(m_config.macroConfig);
+	if (!frames.error.empty())
+	{
+		result.error = frames.error;
+		return result;
+	}
+
+	result.numIterations = frames.frameTimes.size();
+	result.samples = std::move(frames.frameTimes);
+	result.cpuFrameTimes = std::move(frames.cpuFrameTimes);
+	result.gpuFrameTimes = std::move(frames.gpuFrameTimes);
+	result.frameAllocations = std::move(frames.frameAllocations);
+	Details::Summarize(result);
+	if (!result.frameAllocations.empty())
+		result.allocationsPerOperation = std::accumulate(result.frameAllocations.begin(), result.frameAllocations.end(), 0.0) / result.frameAllocations.size();
+
+	return result;
+}
+
+void BenchmarkRunner::WriteJson(std::ostream& stream, const std::vector<BenchmarkResult>& results)
+{
+	stream << "{\n\"allocationTracking\":" << (Blaze::AllocationTracker::GetStats().isTracking ? "true" : "false") << ",\n\"benchmarks\":[";
+	stream << std::setprecision(9);
+
+	bool isFirst = true;
+	for (const auto& result : results)
+	{
+		stream << (isFirst ? "\n" : ",\n") << "{\"name\":";
+		Details::WriteJsonString(stream, result.name);
+		stream << ",\"type\":" << (result.isMacro ? "\"macro\"" : "\"micro\"") << ",\"unit\":\"ns\"";
+		isFirst = false;
+
+		if (!result.error.empty())
+		{
+			stream << ",\"error\":";
+			Details::WriteJsonString(stream, result.error);
+			stream << '}';
+			continue;
+		}
+
+		stream << ",\"iterations\":" << result.numIterations
+			<< ",\"median\":" << result.median << ",\"mean\":" << result.mean << ",\"min\":" << result.min << ",\"max\":" << result.max
+			<< ",\"p99\":" << result.p99 << ",\"stddev\":" << result.standardDeviation
+			<< ",\"bytesPerSecond\":" << result.bytesPerSecond << ",\"allocationsPerOperation\":" << result.allocationsPerOperation
+			<< ",\"samples\":";
+		Details::WriteJsonArray(stream, result.samples);
+		if (result.isMacro)
+		{
+			stream << ",\"cpuSamples\":";
+			Details::WriteJsonArray(stream, result.cpuFrameTimes);
+			stream << ",\"gpuSamples\":";
+			Details::WriteJsonArray(stream, result.gpuFrameTimes);
+			stream << ",\"allocationSamples\":";
+			Details::WriteJsonArray(stream, result.frameAllocations);
+		}
+		stream << '}';
+	}
+	stream << "\n]}\n";
+}
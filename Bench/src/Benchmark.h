@@ -0,0 +1,175 @@
+#pragma once
+
+#ifndef BENCH_BENCHMARK_H
+#define BENCH_BENCHMARK_H
+
+#include <Blaze/Blaze.h>
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif // _MSC_VER
+
+// Keeps the compiler from optimizing away a value a benchmark computes but never uses
+template<typename T>
+inline void DoNotOptimize(const T& value)
+{
+#if defined(_MSC_VER)
+	// MSVC has no inline assembly on x64, a volatile read and a compiler barrier do the same
+	const volatile char* bytes = reinterpret_cast<const volatile char*>(&value);
+	(void)*bytes;
+	_ReadWriteBarrier();
+#else // ^^^ MSVC / GCC, Clang vvv
+	asm volatile("" : : "g"(&value) : "memory");
+#endif // ^^^ GCC, Clang
+}
+
+// Makes the compiler assume all memory was read and written, so stores to buffers don't get dropped
+inline void ClobberMemory()
+{
+#if defined(_MSC_VER)
+	_ReadWriteBarrier();
+#else // ^^^ MSVC / GCC, Clang vvv
+	asm volatile("" : : : "memory");
+#endif // ^^^ GCC, Clang
+}
+
+// Passed to a micro benchmark, the benchmark runs its operation GetIterations() times
+// Setup before StartTiming and teardown after StopTiming aren't part of the sample
+class BenchmarkState
+{
+public:
+	inline BenchmarkState(uint64_t numIterations) :m_numIterations(numIterations), m_start(Blaze::Profiler::GetTimestamp()) {}
+
+	inline uint64_t GetIterations() const { return m_numIterations; }
+
+	inline void StartTiming() { m_start = Blaze::Profiler::GetTimestamp(); }
+	inline void StopTiming() { m_end = Blaze::Profiler::GetTimestamp(); }
+
+	// Bytes one iteration reads or writes, reported as throughput
+	inline void SetBytesPerIteration(uint64_t bytes) { m_bytesPerIteration = bytes; }
+	inline uint64_t GetBytesPerIteration() const { return m_bytesPerIteration; }
+
+	// Marks the benchmark as failed, eg. when a create call returns nullptr, it's reported without timings
+	inline void SetError(std::string error) { m_error = std::move(error); }
+	inline const std::string& GetError() const { return m_error; }
+
+	inline uint64_t GetStart() const { return m_start; }
+	inline uint64_t GetEnd() const { return m_end; }
+private:
+	uint64_t m_numIterations;
+	uint64_t m_start;
+	uint64_t m_end = 0;
+	uint64_t m_bytesPerIteration = 0;
+	std::string m_error;
+};
+
+using MicroBenchmarkFunction = void(*)(BenchmarkState& state);
+
+// A scenario runs a whole application for a number of frames and reports every frame
+struct MacroBenchmarkConfig
+{
+	uint32_t numFrames = 600;
+	// Frames run before measuring, so startup allocations and cold caches aren't measured
+	uint32_t numWarmupFrames = 60;
+	// Headless runs anywhere, a GPU API uses the platform's window and also measures GPU time
+	Blaze::RenderAPI renderAPI = Blaze::RenderAPI::Headless;
+	// Scenarios that replay input generate it from this, so every run gets the same events
+	uint32_t inputSeed = 0x2545F491;
+};
+
+struct MacroBenchmarkResult
+{
+	// Nanoseconds each measured frame took
+	std::vector<double> frameTimes;
+	// Nanoseconds of CPU work each measured frame did before presenting, see FrameTimeSeries::CPUFrame
+	std::vector<double> cpuFrameTimes;
+	// Nanoseconds of GPU work, only there when the render API has a GPU profiler, results arrive a few frames late
+	std::vector<double> gpuFrameTimes;
+	// Heap allocations each measured frame made
+	std::vector<double> frameAllocations;
+	std::string error;
+};
+
+using MacroBenchmarkFunction = MacroBenchmarkResult(*)(const MacroBenchmarkConfig& config);
+
+struct BenchmarkConfig
+{
+	// Only benchmarks with names containing the filter run, empty runs all of them
+	std::string filter;
+	// Micro benchmarks repeat their operation until a sample takes at least this many seconds
+	double minSampleTime = 0.01;
+	uint32_t numSamples = 15;
+	MacroBenchmarkConfig macroConfig;
+};
+
+// Summary of a benchmark's samples, in nanoseconds per operation for micro benchmarks and per frame for macro benchmarks
+struct BenchmarkResult
+{
+	std::string name;
+	bool isMacro = false;
+	uint64_t numIterations = 0;
+	double median = 0.0;
+	double mean = 0.0;
+	double min = 0.0;
+	double max = 0.0;
+	double p99 = 0.0;
+	double standardDeviation = 0.0;
+	double bytesPerSecond = 0.0;
+	// Only counted when allocations are tracked, see AllocationStats::isTracking
+	double allocationsPerOperation = 0.0;
+	std::vector<double> samples;
+	// Per frame values of macro benchmarks, see MacroBenchmarkResult
+	std::vector<double> cpuFrameTimes;
+	std::vector<double> gpuFrameTimes;
+	std::vector<double> frameAllocations;
+	std::string error;
+};
+
+// Runs the benchmarks it was given in the order they were added
+class BenchmarkRunner
+{
+public:
+	inline BenchmarkRunner(const BenchmarkConfig& config) :m_config(config) {}
+
+	void AddMicro(std::string name, MicroBenchmarkFunction function);
+	void AddMacro(std::string name, MacroBenchmarkFunction function);
+
+	// Runs every benchmark that matches the filter, progress goes to the console
+	std::vector<BenchmarkResult> Run();
+
+	// Writes the results as JSON, so they can be compared between runs or machines
+	static void WriteJson(std::ostream& stream, const std::vector<BenchmarkResult>& results);
+private:
+	struct MicroBenchmark
+	{
+		std::string name;
+		MicroBenchmarkFunction function;
+	};
+	struct MacroBenchmark
+	{
+		std::string name;
+		MacroBenchmarkFunction function;
+	};
+
+	BenchmarkResult RunMicro(const MicroBenchmark& benchmark);
+	BenchmarkResult RunMacro(const MacroBenchmark& benchmark);
+
+	BenchmarkConfig m_config;
+	std::vector<MicroBenchmark> m_microBenchmarks;
+	std::vector<MacroBenchmark> m_macroBenchmarks;
+};
+
+// Window that runs without a display, so benchmarks behave the same on every machine
+Blaze::WindowCreateInfo GetHeadlessWindowInfo();
+// Heap allocations of every tag since tracking started, 0 if allocations aren't tracked
+uint64_t GetTotalAllocations();
+
+void AddMicroBenchmarks(BenchmarkRunner& runner);
+void AddMacroBenchmarks(BenchmarkRunner& runner);
+
+#endif // BENCH_BENCHMARK_H
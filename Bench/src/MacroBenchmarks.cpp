@@ -0,0 +1,214 @@
+// Scenarios that run a whole GameApp for a number of frames, see ScenarioApp
+#include "Scenario.h"
+
+#include <cmath>
+
+namespace Details
+{
+	constexpr uint32_t numMeshes = 8;
+	constexpr uint32_t numMaterials = 4;
+	constexpr uint32_t numInstances = 2048;
+	constexpr uint32_t numParticles = 4096;
+	constexpr uint32_t maxProjectiles = 256;
+}
+
+// Nothing but the engine's own per-frame work
+class EmptyScenario
+	:public ScenarioApp
+{
+public:
+	using ScenarioApp::ScenarioApp;
+};
+
+// Instanced meshes with transforms that change every frame plus a particle stream rewritten through mapped memory
+class StreamingScenario
+	:public ScenarioApp
+{
+public:
+	using ScenarioApp::ScenarioApp;
+
+	virtual void OnCreate() override
+	{
+		ScenarioApp::OnCreate();
+		if (!m_deviceContext)
+			return;
+
+		Blaze::InstanceBatcherCreateInfo batcherInfo;
+		batcherInfo.deviceContext = m_deviceContext;
+		m_batcher = Blaze::InstanceBatcher::Create(batcherInfo);
+
+		// A cube per mesh, position and normal per vertex and a transform per instance
+		Blaze::VertexFormat format;
+		format.PushAttribute({ Blaze::Format::R32G32B32_Float });
+		format.PushAttribute({ Blaze::Format::R32G32B32_Float });
+		for (uint32_t row = 0; row < 4; row++)
+			format.PushInstanceAttribute({ Blaze::Format::R32G32B32A32_Float, 0, 1 });
+
+		std::array<float, 24 * 6> vertices{};
+		std::array<uint16_t, 36> indices{};
+		for (uint32_t face = 0; face < 6; face++)
+		{
+			for (uint32_t i = 0; i < 6; i++)
+				indices[face * 6 + i] = static_cast<uint16_t>(face * 4 + std::array<uint32_t, 6>{ 0, 1, 2, 2, 3, 0 }[i]);
+		}
+
+		Blaze::BufferCreateInfo vertexInfo;
+		vertexInfo.deviceContext = m_deviceContext;
+		vertexInfo.type = Blaze::BufferType::Vertex;
+		vertexInfo.usage = Blaze::BufferUsage::Static;
+		vertexInfo.data = vertices.data();
+		vertexInfo.size = sizeof(vertices);
+
+		Blaze::BufferCreateInfo indexInfo;
+		indexInfo.deviceContext = m_deviceContext;
+		indexInfo.type = Blaze::BufferType::Index;
+		indexInfo.usage = Blaze::BufferUsage::Static;
+		indexInfo.indexFormat = Blaze::Format::R16_UInt;
+		indexInfo.data = indices.data();
+		indexInfo.size = sizeof(indices);
+
+		for (auto& mesh : m_meshes)
+		{
+			mesh.format = format;
+			mesh.vertexBuffers[0] = Blaze::Buffer::Create(vertexInfo);
+			mesh.indexBuffer = Blaze::Buffer::Create(indexInfo);
+			mesh.count = static_cast<uint32_t>(indices.size());
+			mesh.instanceBinding = 1;
+		}
+
+		m_particleFormat.PushAttribute({ Blaze::Format::R32G32B32_Float });
+		Blaze::BufferCreateInfo particleInfo;
+		particleInfo.deviceContext = m_deviceContext;
+		particleInfo.type = Blaze::BufferType::Vertex;
+		particleInfo.usage = Blaze::BufferUsage::Stream;
+		std::vector<float> particles(Details::numParticles * 3, 0.0f);
+		particleInfo.data = particles.data();
+		particleInfo.size = particles.size() * sizeof(float);
+		m_particleBuffer = Blaze::Buffer::Create(particleInfo);
+
+		if (!m_batcher || !m_particleBuffer)
+			SetError("Scenario resource creation failed");
+	}
+
+	virtual void OnRender(double alpha) override
+	{
+		(void)alpha;
+		Blaze::Result res;
+		const float time = static_cast<float>(m_frameCount++) / 60.0f;
+
+		for (uint32_t i = 0; i < Details::numInstances; i++)
+		{
+			const float angle = time + static_cast<float>(i) * 0.01f;
+			const float c = std::cos(angle);
+			const float s = std::sin(angle);
+			const std::array<float, 16> transform{
+				c, 0.0f, -s, 0.0f,
+				0.0f, 1.0f, 0.0f, 0.0f,
+				s, 0.0f, c, 0.0f,
+				static_cast<float>(i % 64), 0.0f, static_cast<float>(i / 64), 1.0f
+			};
+			if ((res = m_batcher->Submit(m_meshes[i % Details::numMeshes], i % Details::numMaterials, transform.data())) != Blaze::Result::Success)
+			{
+				SetError("InstanceBatcher::Submit failed");
+				return;
+			}
+		}
+		if ((res = m_batcher->Flush()) != Blaze::Result::Success)
+		{
+			SetError("InstanceBatcher::Flush failed");
+			return;
+		}
+
+		void* ptr = nullptr;
+		if ((res = m_particleBuffer->MapMemory(Details::numParticles * 3 * sizeof(float), Blaze::BufferAccess::Write, ptr)) != Blaze::Result::Success)
+		{
+			SetError("Buffer::MapMemory failed");
+			return;
+		}
+		float* positions = static_cast<float*>(ptr);
+		for (uint32_t i = 0; i < Details::numParticles; i++)
+		{
+			positions[i * 3 + 0] = std::cos(time + i);
+			positions[i * 3 + 1] = time * static_cast<float>(i % 16);
+			positions[i * 3 + 2] = std::sin(time + i);
+		}
+		m_particleBuffer->UnmapMemory();
+
+		m_deviceContext->BindVertexBuffers(m_particleFormat, &m_particleBuffer, 1);
+		m_deviceContext->SetPrimitiveTopology(Blaze::PrimitiveTopology::PointList);
+		if ((res = m_deviceContext->Draw(Details::numParticles)) != Blaze::Result::Success)
+		{
+			SetError("DeviceContext::Draw failed");
+			return;
+		}
+		m_deviceContext->SetPrimitiveTopology(Blaze::PrimitiveTopology::TriangleList);
+
+		m_deviceContext->SwapBuffers();
+	}
+private:
+	Blaze::Ref<Blaze::InstanceBatcher> m_batcher;
+	std::array<Blaze::InstancedMesh, Details::numMeshes> m_meshes;
+	Blaze::VertexFormat m_particleFormat;
+	Blaze::Ref<Blaze::Buffer> m_particleBuffer;
+	uint32_t m_frameCount = 0;
+};
+
+// Replays the same generated keyboard and mouse input every run, the game moves a player and fires projectiles with it
+class InputReplayScenario
+	:public ScenarioApp
+{
+public:
+	InputReplayScenario(const MacroBenchmarkConfig& config)
+		:ScenarioApp(config), m_keyboard(GetWindow()), m_mouse(GetWindow())
+	{
+		const Blaze::WindowCreateInfo windowInfo = GetHeadlessWindowInfo();
+		SetInputScript(InputScript::Generate(config.inputSeed, config.numWarmupFrames + config.numFrames, windowInfo.width, windowInfo.height));
+		m_projectiles.reserve(Details::maxProjectiles);
+	}
+
+	virtual void OnRender(double alpha) override
+	{
+		(void)alpha;
+		constexpr float speed = 0.1f;
+
+		m_playerX += (m_keyboard.IsKeyPressed(Blaze::KeyCode::D) - m_keyboard.IsKeyPressed(Blaze::KeyCode::A)) * speed;
+		m_playerY += (m_keyboard.IsKeyPressed(Blaze::KeyCode::W) - m_keyboard.IsKeyPressed(Blaze::KeyCode::S)) * speed;
+
+		// Projectiles fly towards the cursor while the button is held, the oldest ones are replaced
+		if (m_mouse.IsButtonPressed(Blaze::MouseButton::Left) || m_keyboard.IsKeyPressed(Blaze::KeyCode::SpaceBar))
+		{
+			const Projectile projectile{ m_playerX, m_playerY, (m_mouse.GetX() - m_playerX) * 0.01f, (m_mouse.GetY() - m_playerY) * 0.01f };
+			if (m_projectiles.size() < Details::maxProjectiles)
+				m_projectiles.push_back(projectile);
+			else
+				m_projectiles[m_nextProjectile++ % Details::maxProjectiles] = projectile;
+		}
+		for (auto& projectile : m_projectiles)
+		{
+			projectile.x += projectile.velocityX;
+			projectile.y += projectile.velocityY;
+		}
+
+		m_deviceContext->SwapBuffers();
+	}
+private:
+	struct Projectile
+	{
+		float x, y;
+		float velocityX, velocityY;
+	};
+
+	Blaze::KeyboardInput m_keyboard;
+	Blaze::MouseInput m_mouse;
+	float m_playerX = 0.0f;
+	float m_playerY = 0.0f;
+	std::vector<Projectile> m_projectiles;
+	uint32_t m_nextProjectile = 0;
+};
+
+void AddMacroBenchmarks(BenchmarkRunner& runner)
+{
+	runner.AddMacro("Frame/Empty", RunScenario<EmptyScenario>);
+	runner.AddMacro("Frame/Streaming", RunScenario<StreamingScenario>);
+	runner.AddMacro("Frame/InputReplay", RunScenario<InputReplayScenario>);
+}
@@ -0,0 +1,134 @@
+// Runs the engine's micro benchmarks and frame scenarios on the headless backend and writes the results as JSON
+// With a baseline (the results of an earlier run) the results are compared to it, and regressions make the exit code 2
+// Usage: Bench [--filter text] [--out path] [--samples count] [--min-time seconds] [--frames count] [--warmup count] [--trace path]
+//              [--render-api headless|opengl] [--seed number] [--baseline path] [--alpha p] [--threshold fraction]
+//              [--frame-block count]
+#include "Benchmark.h"
+#include "Baseline.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string_view>
+
+// Allocations per operation and per frame are part of the results, so the executable's allocations are always tracked
+BLAZE_ALLOCATION_HOOKS
+
+int main(int argc, char** argv)
+{
+	BenchmarkConfig config;
+	std::string outputPath = "BlazeBench.json";
+	std::string tracePath;
+	std::string baselinePath;
+	RegressionConfig regressionConfig;
+
+	for (int i = 1; i < argc; i++)
+	{
+		const std::string_view arg = argv[i];
+		const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+		if (!value)
+		{
+			std::fprintf(stderr, "Missing value for %s\n", argv[i]);
+			return 1;
+		}
+
+		if (arg == "--filter")
+			config.filter = value;
+		else if (arg == "--out")
+			outputPath = value;
+		else if (arg == "--samples")
+			config.numSamples = static_cast<uint32_t>(std::max(1l, std::strtol(value, nullptr, 10)));
+		else if (arg == "--min-time")
+			config.minSampleTime = std::strtod(value, nullptr);
+		else if (arg == "--frames")
+			config.macroConfig.numFrames = static_cast<uint32_t>(std::max(1l, std::strtol(value, nullptr, 10)));
+		else if (arg == "--warmup")
+			config.macroConfig.numWarmupFrames = static_cast<uint32_t>(std::max(0l, std::strtol(value, nullptr, 10)));
+		else if (arg == "--trace")
+			tracePath = value;
+		else if (arg == "--render-api")
+		{
+			const std::string_view renderAPI = value;
+			if (renderAPI == "headless")
+				config.macroConfig.renderAPI = Blaze::RenderAPI::Headless;
+			else if (renderAPI == "opengl")
+				config.macroConfig.renderAPI = Blaze::RenderAPI::OpenGL;
+			else
+			{
+				std::fprintf(stderr, "Unknown render API %s\n", value);
+				return 1;
+			}
+		}
+		else if (arg == "--seed")
+			config.macroConfig.inputSeed = static_cast<uint32_t>(std::strtoul(value, nullptr, 0));
+		else if (arg == "--baseline")
+			baselinePath = value;
+		else if (arg == "--alpha")
+			regressionConfig.alpha = std::strtod(value, nullptr);
+		else if (arg == "--threshold")
+			regressionConfig.threshold = std::strtod(value, nullptr);
+		else if (arg == "--frame-block")
+			regressionConfig.frameBlockSize = static_cast<uint32_t>(std::max(1l, std::strtol(value, nullptr, 10)));
+		else
+		{
+			std::fprintf(stderr, "Unknown option %s\n", argv[i]);
+			return 1;
+		}
+		i++;
+	}
+
+	// Read the baseline first, a typo in its path shouldn't only show up after all the benchmarks ran
+	std::vector<BenchmarkResult> baseline;
+	if (!baselinePath.empty())
+	{
+		std::string error;
+		if (!ReadBaseline(baselinePath, baseline, error))
+		{
+			std::fprintf(stderr, "Couldn't read baseline %s: %s\n", baselinePath.c_str(), error.c_str());
+			return 1;
+		}
+	}
+
+	// Recording scopes costs time and memory the results shouldn't include, unless a trace was asked for
+	Blaze::Profiler::SetEnabled(!tracePath.empty());
+
+	BenchmarkRunner runner{ config };
+	AddMicroBenchmarks(runner);
+	AddMacroBenchmarks(runner);
+	const std::vector<BenchmarkResult> results = runner.Run();
+
+	if (!tracePath.empty())
+		Blaze::Profiler::WriteChromeTrace(tracePath);
+
+	if (!outputPath.empty())
+	{
+		std::ofstream stream{ outputPath };
+		if (!stream)
+		{
+			std::fprintf(stderr, "Couldn't write %s\n", outputPath.c_str());
+			return 1;
+		}
+		BenchmarkRunner::WriteJson(stream, results);
+		std::printf("Results written to %s\n", outputPath.c_str());
+	}
+
+	for (const auto& result : results)
+	{
+		if (!result.error.empty())
+			return 1;
+	}
+
+	if (!baselinePath.empty())
+	{
+		std::printf("\nCompared to %s\n", baselinePath.c_str());
+		const uint32_t numRegressions = PrintComparisons(CompareResults(baseline, results, regressionConfig));
+		if (numRegressions)
+		{
+			std::printf("%u regressions\n", numRegressions);
+			return 2;
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,372 @@
+// Benchmarks of single engine operations, everything runs on the headless backend so no GPU or display is needed
+#include "Benchmark.h"
+
+#include <cstring>
+
+namespace Details
+{
+	constexpr size_t smallBufferSize = 64 * 1024;
+	constexpr size_t largeBufferSize = 4 * 1024 * 1024;
+	constexpr uint32_t numKeys = 149;
+	// Other handlers on the window, so removing one has to search like it would in a game
+	constexpr uint32_t numOtherHandlers = 16;
+	// A mesh of 64Ki vertices, large enough that the kernels run from memory rather than L1
+	constexpr size_t numTransformVertices = 64 * 1024;
+
+	static Blaze::Ref<Blaze::DeviceContext> CreateDeviceContext(BenchmarkState& state, Blaze::Ref<Blaze::Window>& window)
+	{
+		window = Blaze::Window::Create(GetHeadlessWindowInfo());
+		if (!window)
+		{
+			state.SetError("Headless window creation failed");
+			return nullptr;
+		}
+
+		Blaze::DeviceContextCreateInfo contextInfo;
+		contextInfo.window = window;
+		contextInfo.renderingApi = Blaze::RenderAPI::Headless;
+		auto deviceContext = Blaze::DeviceContext::Create(contextInfo);
+		if (!deviceContext)
+			state.SetError("Headless device context creation failed");
+		return deviceContext;
+	}
+
+	static Blaze::Ref<Blaze::Buffer> CreateBuffer(BenchmarkState& state, const Blaze::Ref<Blaze::DeviceContext>& deviceContext, size_t size)
+	{
+		std::vector<uint8_t> data(size, 0);
+
+		Blaze::BufferCreateInfo bufferInfo;
+		bufferInfo.deviceContext = deviceContext;
+		bufferInfo.type = Blaze::BufferType::Vertex;
+		bufferInfo.usage = Blaze::BufferUsage::Stream;
+		bufferInfo.data = data.data();
+		bufferInfo.size = data.size();
+		auto buffer = Blaze::Buffer::Create(bufferInfo);
+		if (!buffer)
+			state.SetError("Buffer creation failed");
+		return buffer;
+	}
+
+	static void CountEvent(const Blaze::WindowEvent& event, void* data)
+	{
+		(void)event;
+		(*static_cast<uint64_t*>(data))++;
+	}
+
+	static void BufferWrite(BenchmarkState& state, size_t size)
+	{
+		Blaze::Ref<Blaze::Window> window;
+		auto deviceContext = CreateDeviceContext(state, window);
+		if (!deviceContext)
+			return;
+		auto buffer = CreateBuffer(state, deviceContext, size);
+		if (!buffer)
+			return;
+		std::vector<uint8_t> data(size, 0x5A);
+
+		state.SetBytesPerIteration(size);
+		state.StartTiming();
+		for (uint64_t i = 0; i < state.GetIterations(); i++)
+		{
+			data[i % size]++;
+			buffer->Write(data.data(), data.size());
+			ClobberMemory();
+		}
+		state.StopTiming();
+	}
+
+	static void BufferMapMemory(BenchmarkState& state, size_t size)
+	{
+		Blaze::Ref<Blaze::Window> window;
+		auto deviceContext = CreateDeviceContext(state, window);
+		if (!deviceContext)
+			return;
+		auto buffer = CreateBuffer(state, deviceContext, size);
+		if (!buffer)
+			return;
+
+		state.SetBytesPerIteration(size);
+		state.StartTiming();
+		for (uint64_t i = 0; i < state.GetIterations(); i++)
+		{
+			void* ptr = nullptr;
+			if (buffer->MapMemory(size, Blaze::BufferAccess::Write, ptr) != Blaze::Result::Success)
+			{
+				state.SetError("MapMemory failed");
+				return;
+			}
+			std::memset(ptr, static_cast<int>(i), size);
+			ClobberMemory();
+			buffer->UnmapMemory();
+		}
+		state.StopTiming();
+	}
+}
+
+static void CreateDestroyObjectID(BenchmarkState& state)
+{
+	for (uint64_t i = 0; i < state.GetIterations(); i++)
+	{
+		const uint32_t objectID = Blaze::Details::CreateObjectID(nullptr);
+		DoNotOptimize(objectID);
+		Blaze::Details::DestroyObjectID(objectID);
+	}
+}
+
+static void CreateDestroyBuffer(BenchmarkState& state)
+{
+	Blaze::Ref<Blaze::Window> window;
+	auto deviceContext = Details::CreateDeviceContext(state, window);
+	if (!deviceContext)
+		return;
+
+	Blaze::BufferCreateInfo bufferInfo;
+	bufferInfo.deviceContext = deviceContext;
+	bufferInfo.type = Blaze::BufferType::Vertex;
+
+	state.StartTiming();
+	for (uint64_t i = 0; i < state.GetIterations(); i++)
+	{
+		auto buffer = Blaze::Buffer::Create(bufferInfo);
+		DoNotOptimize(buffer);
+	}
+	state.StopTiming();
+}
+
+static void CastTo(BenchmarkState& state)
+{
+	Blaze::Ref<Blaze::Window> window;
+	auto deviceContext = Details::CreateDeviceContext(state, window);
+	if (!deviceContext)
+		return;
+	auto buffer = Details::CreateBuffer(state, deviceContext, 0);
+	if (!buffer)
+		return;
+
+	state.StartTiming();
+	for (uint64_t i = 0; i < state.GetIterations(); i++)
+	{
+		auto object = buffer->CastTo<Blaze::Object>();
+		DoNotOptimize(object);
+	}
+	state.StopTiming();
+}
+
+static void CastToInvalid(BenchmarkState& state)
+{
+	Blaze::Ref<Blaze::Window> window;
+	auto deviceContext = Details::CreateDeviceContext(state, window);
+	if (!deviceContext)
+		return;
+	auto buffer = Details::CreateBuffer(state, deviceContext, 0);
+	if (!buffer)
+		return;
+
+	state.StartTiming();
+	for (uint64_t i = 0; i < state.GetIterations(); i++)
+	{
+		auto object = buffer->CastTo(Blaze::Window::GetStaticClassID());
+		DoNotOptimize(object);
+	}
+	state.StopTiming();
+}
+
+static void PushRemoveEventHandler(BenchmarkState& state)
+{
+	auto window = Blaze::Window::Create(GetHeadlessWindowInfo());
+	if (!window)
+	{
+		state.SetError("Headless window creation failed");
+		return;
+	}
+
+	std::array<uint64_t, Details::numOtherHandlers> counts{};
+	for (auto& count : counts)
+		window->PushEventHandler(Blaze::WindowEvent::KeyDown, { Details::CountEvent, &count });
+
+	uint64_t count = 0;
+	state.StartTiming();
+	for (uint64_t i = 0; i < state.GetIterations(); i++)
+	{
+		window->PushEventHandler(Blaze::WindowEvent::KeyDown, { Details::CountEvent, &count });
+		window->RemoveEventHandler(Blaze::WindowEvent::KeyDown, { Details::CountEvent, &count });
+	}
+	state.StopTiming();
+}
+
+static void PostDispatchEvent(BenchmarkState& state)
+{
+	auto window = Blaze::Window::Create(GetHeadlessWindowInfo());
+	if (!window)
+	{
+		state.SetError("Headless window creation failed");
+		return;
+	}
+	Blaze::KeyboardInput keyboard{ window };
+	uint64_t count = 0;
+	window->PushEventHandler(Blaze::WindowEvent::KeyDown, { Details::CountEvent, &count });
+
+	Blaze::WindowEvent event;
+	event.window = window;
+	event.eventCode = Blaze::WindowEvent::KeyDown;
+
+	state.StartTiming();
+	for (uint64_t i = 0; i < state.GetIterations(); i++)
+	{
+		event.SetWindowEventInfo(Blaze::WindowKeyDownEventInfo{ static_cast<Blaze::KeyCode>(i % Details::numKeys + 1) });
+		window->PostEvent(event);
+		window->Update();
+	}
+	state.StopTiming();
+	DoNotOptimize(count);
+}
+
+static void IsKeyPressed(BenchmarkState& state)
+{
+	auto window = Blaze::Window::Create(GetHeadlessWindowInfo());
+	if (!window)
+	{
+		state.SetError("Headless window creation failed");
+		return;
+	}
+	Blaze::KeyboardInput keyboard{ window };
+
+	// Every other key is held, so the branch on the result can't be predicted from the key alone
+	Blaze::WindowEvent event;
+	event.window = window;
+	event.eventCode = Blaze::WindowEvent::KeyDown;
+	for (uint32_t key = 1; key <= Details::numKeys; key += 2)
+	{
+		event.SetWindowEventInfo(Blaze::WindowKeyDownEventInfo{ static_cast<Blaze::KeyCode>(key) });
+		window->PostEvent(event);
+	}
+	window->Update();
+
+	uint64_t numPressed = 0;
+	state.StartTiming();
+	for (uint64_t i = 0; i < state.GetIterations(); i++)
+		numPressed += keyboard.IsKeyPressed(static_cast<Blaze::KeyCode>(i % Details::numKeys + 1));
+	state.StopTiming();
+	DoNotOptimize(numPressed);
+}
+
+static void GetFormatInfo(BenchmarkState& state)
+{
+	constexpr uint32_t numFormats = static_cast<uint32_t>(Blaze::Format::R16G16B16A16_SNorm);
+
+	uint64_t totalSize = 0;
+	for (uint64_t i = 0; i < state.GetIterations(); i++)
+	{
+		const Blaze::Details::FormatInfo info = Blaze::Details::GetFormatInfo(static_cast<Blaze::Format>(i % numFormats + 1));
+		totalSize += info.sizeInBytes;
+	}
+	DoNotOptimize(totalSize);
+}
+
+static void BuildVertexFormat(BenchmarkState& state)
+{
+	for (uint64_t i = 0; i < state.GetIterations(); i++)
+	{
+		// Position, normal, texture coordinates and color per vertex, a transform per instance
+		Blaze::VertexFormat format;
+		format.PushAttribute({ Blaze::Format::R32G32B32_Float });
+		format.PushAttribute({ Blaze::Format::R32G32B32_Float });
+		format.PushAttribute({ Blaze::Format::R32G32_Float });
+		format.PushAttribute({ Blaze::Format::R8G8B8A8_UNorm });
+		for (uint32_t row = 0; row < 4; row++)
+			format.PushInstanceAttribute({ Blaze::Format::R32G32B32A32_Float, 0, 1 });
+		DoNotOptimize(format.GetHash());
+	}
+}
+
+static void TransformPointsSoA(BenchmarkState& state)
+{
+	std::vector<float> x(Details::numTransformVertices, 1.0f);
+	std::vector<float> y(Details::numTransformVertices, 2.0f);
+	std::vector<float> z(Details::numTransformVertices, 3.0f);
+	const Blaze::Mat4 transform = Blaze::ComposeTransform({ 1.0f, 2.0f, 3.0f }, Blaze::Quat::FromAxisAngle({ 0.0f, 1.0f, 0.0f }, 0.5f), Blaze::Vec3{ 1.0f });
+
+	state.SetBytesPerIteration(Details::numTransformVertices * sizeof(Blaze::Vec3));
+	for (uint64_t i = 0; i < state.GetIterations(); i++)
+	{
+		Blaze::TransformPointsSoA(transform, x.data(), y.data(), z.data(), x.data(), y.data(), z.data(), x.size());
+		ClobberMemory();
+	}
+}
+
+// Transforms the positions of interleaved position and normal vertices in mapped buffer memory
+static void TransformMappedVertices(BenchmarkState& state)
+{
+	Blaze::Ref<Blaze::Window> window;
+	auto deviceContext = Details::CreateDeviceContext(state, window);
+	if (!deviceContext)
+		return;
+
+	Blaze::VertexFormat format;
+	format.PushAttribute({ Blaze::VertexFormatOf<Blaze::Vec3>::format });
+	format.PushAttribute({ Blaze::VertexFormatOf<Blaze::Vec3>::format });
+	const size_t size = Details::numTransformVertices * format.GetStride();
+	auto buffer = Details::CreateBuffer(state, deviceContext, size);
+	if (!buffer)
+		return;
+	const Blaze::Mat4 transform = Blaze::ComposeTransform({ 1.0f, 2.0f, 3.0f }, Blaze::Quat::FromAxisAngle({ 0.0f, 1.0f, 0.0f }, 0.5f), Blaze::Vec3{ 1.0f });
+
+	state.SetBytesPerIteration(Details::numTransformVertices * sizeof(Blaze::Vec3));
+	state.StartTiming();
+	for (uint64_t i = 0; i < state.GetIterations(); i++)
+	{
+		void* ptr = nullptr;
+		if (buffer->MapMemory(size, Blaze::BufferAccess::ReadWrite, ptr) != Blaze::Result::Success)
+		{
+			state.SetError("MapMemory failed");
+			return;
+		}
+		if (Blaze::TransformVertexAttribute(transform, ptr, Details::numTransformVertices, format, 0) != Blaze::Result::Success)
+		{
+			state.SetError("TransformVertexAttribute failed");
+			return;
+		}
+		ClobberMemory();
+		buffer->UnmapMemory();
+	}
+	state.StopTiming();
+}
+
+static void BufferWriteSmall(BenchmarkState& state)
+{
+	Details::BufferWrite(state, Details::smallBufferSize);
+}
+
+static void BufferWriteLarge(BenchmarkState& state)
+{
+	Details::BufferWrite(state, Details::largeBufferSize);
+}
+
+static void BufferMapMemorySmall(BenchmarkState& state)
+{
+	Details::BufferMapMemory(state, Details::smallBufferSize);
+}
+
+static void BufferMapMemoryLarge(BenchmarkState& state)
+{
+	Details::BufferMapMemory(state, Details::largeBufferSize);
+}
+
+void AddMicroBenchmarks(BenchmarkRunner& runner)
+{
+	runner.AddMicro("Object/CreateDestroyObjectID", CreateDestroyObjectID);
+	runner.AddMicro("Object/CreateDestroyBuffer", CreateDestroyBuffer);
+	runner.AddMicro("Object/CastTo", CastTo);
+	runner.AddMicro("Object/CastToInvalid", CastToInvalid);
+	runner.AddMicro("Window/PushRemoveEventHandler", PushRemoveEventHandler);
+	runner.AddMicro("Window/PostDispatchEvent", PostDispatchEvent);
+	runner.AddMicro("Input/IsKeyPressed", IsKeyPressed);
+	runner.AddMicro("Format/GetFormatInfo", GetFormatInfo);
+	runner.AddMicro("Format/BuildVertexFormat", BuildVertexFormat);
+	runner.AddMicro("Math/TransformPointsSoA", TransformPointsSoA);
+	runner.AddMicro("Math/TransformMappedVertices", TransformMappedVertices);
+	runner.AddMicro("Buffer/Write64KiB", BufferWriteSmall);
+	runner.AddMicro("Buffer/Write4MiB", BufferWriteLarge);
+	runner.AddMicro("Buffer/MapMemory64KiB", BufferMapMemorySmall);
+	runner.AddMicro("Buffer/MapMemory4MiB", BufferMapMemoryLarge);
+}
@@ -0,0 +1,165 @@
+#include "Scenario.h"
+
+#include <algorithm>
+
+namespace Details
+{
+	constexpr uint32_t maxEventsPerFrame = 4;
+
+	// Same sequence on every machine and compiler, unlike the standard library's distributions
+	class Random
+	{
+	public:
+		inline Random(uint32_t seed) :m_state(seed ? seed : 1) {}
+
+		inline uint32_t Next()
+		{
+			m_state ^= m_state << 13;
+			m_state ^= m_state >> 17;
+			m_state ^= m_state << 5;
+			return m_state;
+		}
+		inline uint32_t Next(uint32_t max) { return max ? Next() % max : 0; }
+	private:
+		uint32_t m_state;
+	};
+
+	static Blaze::GameAppConfig GetScenarioConfig(const MacroBenchmarkConfig& config)
+	{
+		Blaze::GameAppConfig appConfig;
+		appConfig.windowInfo = GetHeadlessWindowInfo();
+		// GPU APIs need a window they can present to
+		if (config.renderAPI != Blaze::RenderAPI::Headless)
+			appConfig.windowInfo.windowAPI = Blaze::WindowAPI::Null;
+		// Frames run back to back, the limiter's sleeps would only add noise
+		appConfig.loopConfig.targetFrameRate = 0.0;
+		// Slow frames are what's being measured, they shouldn't write hitch dumps
+		appConfig.flightRecorderConfig.frameBudget = 0.0;
+		return appConfig;
+	}
+}
+
+InputScript InputScript::Generate(uint32_t seed, uint32_t numFrames, uint32_t width, uint32_t height)
+{
+	constexpr std::array<Blaze::KeyCode, 6> keys{ Blaze::KeyCode::W, Blaze::KeyCode::A, Blaze::KeyCode::S, Blaze::KeyCode::D, Blaze::KeyCode::SpaceBar, Blaze::KeyCode::LeftShift };
+	constexpr std::array<Blaze::MouseButton, 2> buttons{ Blaze::MouseButton::Left, Blaze::MouseButton::Right };
+
+	InputScript script;
+	Details::Random random{ seed };
+	for (uint32_t frameIndex = 0; frameIndex < numFrames; frameIndex++)
+	{
+		const uint32_t numEvents = random.Next(Details::maxEventsPerFrame + 1);
+		for (uint32_t i = 0; i < numEvents; i++)
+		{
+			ScriptedEvent scripted{ frameIndex, Blaze::WindowEvent{} };
+			Blaze::WindowEvent& event = scripted.event;
+
+			const uint32_t x = random.Next(width);
+			const uint32_t y = random.Next(height);
+			switch (random.Next(5))
+			{
+			case 0:
+				event.eventCode = Blaze::WindowEvent::KeyDown;
+				event.SetWindowEventInfo(Blaze::WindowKeyDownEventInfo{ keys[random.Next(static_cast<uint32_t>(keys.size()))] });
+				break;
+			case 1:
+				event.eventCode = Blaze::WindowEvent::KeyUp;
+				event.SetWindowEventInfo(Blaze::WindowKeyUpEventInfo{ keys[random.Next(static_cast<uint32_t>(keys.size()))] });
+				break;
+			case 2:
+				event.eventCode = Blaze::WindowEvent::MouseButtonDown;
+				event.SetWindowEventInfo(Blaze::WindowMouseButtonDownEventInfo{ x, y, buttons[random.Next(static_cast<uint32_t>(buttons.size()))] });
+				break;
+			case 3:
+				event.eventCode = Blaze::WindowEvent::MouseButtonUp;
+				event.SetWindowEventInfo(Blaze::WindowMouseButtonUpEventInfo{ x, y, buttons[random.Next(static_cast<uint32_t>(buttons.size()))] });
+				break;
+			default:
+				event.eventCode = Blaze::WindowEvent::MouseMove;
+				event.SetWindowEventInfo(Blaze::WindowMouseMoveEventInfo{ x, y });
+				break;
+			}
+			script.m_events.push_back(std::move(scripted));
+		}
+	}
+
+	return script;
+}
+
+void InputScript::Post(const Blaze::Ref<Blaze::Window>& window, uint32_t frameIndex) const
+{
+	auto it = std::lower_bound(m_events.begin(), m_events.end(), frameIndex, [](const ScriptedEvent& scripted, uint32_t frame) { return scripted.frameIndex < frame; });
+	for (; (it != m_events.end()) && (it->frameIndex == frameIndex); ++it)
+	{
+		Blaze::WindowEvent event = it->event;
+		event.window = window;
+		window->PostEvent(event);
+	}
+}
+
+ScenarioApp::ScenarioApp(const MacroBenchmarkConfig& config)
+	:Blaze::GameApp(Details::GetScenarioConfig(config)), m_config(config)
+{
+	m_result.frameTimes.reserve(config.numFrames);
+	m_result.cpuFrameTimes.reserve(config.numFrames);
+	m_result.gpuFrameTimes.reserve(config.numFrames);
+	m_result.frameAllocations.reserve(config.numFrames);
+}
+
+void ScenarioApp::OnCreate()
+{
+	if (!GetWindow())
+	{
+		SetError("Window creation failed");
+		return;
+	}
+
+	Blaze::DeviceContextCreateInfo contextInfo;
+	contextInfo.window = GetWindow();
+	contextInfo.renderingApi = m_config.renderAPI;
+	contextInfo.enableGPUProfiler = true;
+	m_deviceContext = Blaze::DeviceContext::Create(contextInfo);
+	if (!m_deviceContext)
+		SetError("Device context creation failed");
+}
+
+void ScenarioApp::OnDestroy()
+{
+}
+
+bool ScenarioApp::OnUpdate()
+{
+	if (!m_result.error.empty())
+		return false;
+
+	// Input arrives before the frame like it would from the system
+	m_inputScript.Post(GetWindow(), m_frameIndex);
+
+	const uint64_t allocationsStart = GetTotalAllocations();
+	const uint64_t start = Blaze::Profiler::GetTimestamp();
+	const bool isRunning = Blaze::GameApp::OnUpdate();
+	const uint64_t end = Blaze::Profiler::GetTimestamp();
+	const uint64_t numAllocations = GetTotalAllocations() - allocationsStart;
+
+	// Only new samples count, a frame that didn't present has no CPU frame and GPU times arrive in bursts, so a frame can have several
+	m_cpuSamples.clear();
+	m_gpuSamples.clear();
+	m_numCPUSamples = Blaze::FrameStatistics::GetNewSamples(Blaze::FrameTimeSeries::CPUFrame, m_numCPUSamples, m_cpuSamples);
+	m_numGPUSamples = Blaze::FrameStatistics::GetNewSamples(Blaze::FrameTimeSeries::GPUFrame, m_numGPUSamples, m_gpuSamples);
+	if (m_frameIndex >= m_config.numWarmupFrames)
+	{
+		m_result.frameTimes.push_back(static_cast<double>(end - start));
+		m_result.frameAllocations.push_back(static_cast<double>(numAllocations));
+		m_result.cpuFrameTimes.insert(m_result.cpuFrameTimes.end(), m_cpuSamples.begin(), m_cpuSamples.end());
+		m_result.gpuFrameTimes.insert(m_result.gpuFrameTimes.end(), m_gpuSamples.begin(), m_gpuSamples.end());
+	}
+	m_frameIndex++;
+
+	return isRunning && m_result.error.empty() && (m_frameIndex < m_config.numWarmupFrames + m_config.numFrames);
+}
+
+void ScenarioApp::OnRender(double alpha)
+{
+	(void)alpha;
+	m_deviceContext->SwapBuffers();
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#ifndef BENCH_SCENARIO_H
+#define BENCH_SCENARIO_H
+
+#include "Benchmark.h"
+
+// Keyboard and mouse events for every frame of a run, the same seed gives the same events on every machine
+class InputScript
+{
+public:
+	// Up to maxEventsPerFrame events per frame, cursor positions are inside width x height
+	static InputScript Generate(uint32_t seed, uint32_t numFrames, uint32_t width, uint32_t height);
+
+	// Posts the events of a frame to the window, they're dispatched by the frame's Window::Update
+	void Post(const Blaze::Ref<Blaze::Window>& window, uint32_t frameIndex) const;
+
+	inline size_t GetNumEvents() const { return m_events.size(); }
+private:
+	struct ScriptedEvent
+	{
+		uint32_t frameIndex;
+		Blaze::WindowEvent event;
+	};
+
+	// Sorted by frame
+	std::vector<ScriptedEvent> m_events;
+};
+
+// Runs a GameApp for a fixed number of frames and records each frame's time, CPU and GPU time and allocations
+// Scenarios override OnCreate and OnRender, work that has to be the same in every run belongs in OnRender
+// since the number of fixed ticks a frame runs depends on the machine
+class ScenarioApp
+	:public Blaze::GameApp
+{
+public:
+	ScenarioApp(const MacroBenchmarkConfig& config);
+
+	// Creates the device context, scenarios call this first
+	virtual void OnCreate() override;
+	virtual void OnDestroy() override;
+	virtual bool OnUpdate() override;
+	// Presents an empty frame
+	virtual void OnRender(double alpha) override;
+
+	// Replays the input script every frame from now on
+	inline void SetInputScript(InputScript inputScript) { m_inputScript = std::move(inputScript); }
+
+	// Stops the run, the scenario is reported as failed
+	inline void SetError(std::string error) { m_result.error = std::move(error); }
+	inline MacroBenchmarkResult TakeResult() { return std::move(m_result); }
+
+	inline const MacroBenchmarkConfig& GetConfig() const { return m_config; }
+protected:
+	Blaze::Ref<Blaze::DeviceContext> m_deviceContext;
+private:
+	MacroBenchmarkConfig m_config;
+	MacroBenchmarkResult m_result;
+	InputScript m_inputScript;
+	uint32_t m_frameIndex = 0;
+	uint64_t m_numCPUSamples = 0;
+	uint64_t m_numGPUSamples = 0;
+	// Reused every frame, so reading the samples doesn't allocate once they've grown
+	std::vector<uint64_t> m_cpuSamples;
+	std::vector<uint64_t> m_gpuSamples;
+};
+
+// Runs a ScenarioApp subclass to completion, the signature matches MacroBenchmarkFunction
+template<typename Scenario>
+inline MacroBenchmarkResult RunScenario(const MacroBenchmarkConfig& config)
+{
+	Scenario app{ config };
+	app.Run();
+	return app.TakeResult();
+}
+
+#endif // BENCH_SCENARIO_H
@@ -4,6 +4,16 @@
 #define BLAZE_APPLICATION_H
 
 #include <Blaze/Window.h>
+#include <Blaze/Jobs/JobSystem.h>
+#include <Blaze/GameLoop.h>
+#include <Blaze/Log.h>
+#include <Blaze/Memory/Arena.h>
+#include <Blaze/Memory/AllocationTracker.h>
+#include <Blaze/Profiling/Profiler.h>
+#include <Blaze/Profiling/FlightRecorder.h>
+#include <Blaze/Profiling/FrameStatistics.h>
+#include <Blaze/Profiling/ResourceCensus.h>
+#include <Blaze/Profiling/Telemetry.h>
 
 #include <string_view>
 
@@ -17,7 +27,17 @@ namespace Blaze
 
 		virtual void OnCreate() = 0;
 		virtual void OnDestroy() = 0;
+		// Called once per frame, returning false ends the application
 		virtual bool OnUpdate() = 0;
+
+		// Runs the application until OnUpdate returns false
+		inline int Run()
+		{
+			OnCreate();
+			while (OnUpdate());
+			OnDestroy();
+			return 0;
+		}
 	};
 
 	struct GameAppConfig
@@ -25,23 +45,103 @@ namespace Blaze
 		GameAppConfig() = default;
 
 		WindowCreateInfo windowInfo;
+		LogConfig logConfig;
+		JobSystemCreateInfo jobSystemInfo;
+		GameLoopConfig loopConfig;
+		// Transient memory every frame gets, see GameApp::GetFrameArena
+		size_t frameArenaSize = 4 * 1024 * 1024;
+		// Frames the frame arena keeps apart, up to maxFramesInFlight
+		uint32_t numFramesInFlight = 2;
+		// Chrome trace of the profiled scopes written when the app is destroyed, empty doesn't write one
+		std::string profileTracePath;
+		FlightRecorderConfig flightRecorderConfig;
+		FrameStatisticsConfig frameStatisticsConfig;
+		// Shared memory segment the engine's counters are published to for external monitors, empty doesn't publish
+		std::string telemetrySegment;
 	};
 
-	// GameApp base class, similair to the Application class, but creates things like a window
+	// GameApp base class, similair to the Application class, but creates things like a window and the job system
 	class GameApp
 		:public Application
 	{
 	public:
 		inline GameApp(const GameAppConfig& config)
+			:m_gameLoop(config.loopConfig), m_frameArena(config.frameArenaSize, config.numFramesInFlight), m_profileTracePath(config.profileTracePath)
 		{
+			Profiler::SetThreadName("Main");
+			Log::Configure(config.logConfig);
+			FlightRecorder::Configure(config.flightRecorderConfig);
+			FrameStatistics::Configure(config.frameStatisticsConfig);
+			if (!config.telemetrySegment.empty())
+				Telemetry::Open(config.telemetrySegment);
+			BLAZE_RESOURCE_SITE("GameApp");
 			m_window = Window::Create(config.windowInfo);
+			m_jobSystem = JobSystem::Create(config.jobSystemInfo);
+		}
+
+		inline virtual ~GameApp()
+		{
+			Telemetry::Close();
+			if (!m_profileTracePath.empty())
+				Profiler::WriteChromeTrace(m_profileTracePath);
+			Log::Shutdown();
+		}
+
+		// Runs a frame of the fixed timestep loop, override OnFixedUpdate and OnRender instead
+		inline virtual bool OnUpdate() override
+		{
+			const uint32_t numTicks = m_gameLoop.BeginFrame();
+			m_frameArena.BeginFrame();
+			FlightRecorder::NextFrame();
+			FrameStatistics::BeginCPUFrame();
+			AllocationTracker::NextFrame();
+			Telemetry::NextFrame();
+
+			const bool isAllocationFree = m_isAllocationFree;
+			if (isAllocationFree)
+				AllocationTracker::BeginAllocationFree();
+
+			m_window->Update();
+			for (uint32_t i = 0; i < numTicks; i++)
+			{
+				BLAZE_PROFILE_SCOPE("GameApp::FixedUpdate");
+				OnFixedUpdate(m_gameLoop.GetTickDelta());
+			}
+			{
+				BLAZE_PROFILE_SCOPE("GameApp::Render");
+				OnRender(m_gameLoop.GetInterpolationAlpha());
+			}
+
+			if (isAllocationFree)
+				AllocationTracker::EndAllocationFree();
+
+			m_gameLoop.EndFrame();
+			return m_window->IsRunning();
 		}
 
-		virtual ~GameApp() = default;
+		// Advances the simulation by deltaTime, which is the same every tick
+		inline virtual void OnFixedUpdate(double deltaTime) { (void)deltaTime; }
+		// Draws a frame, alpha is how far to interpolate from the previous tick's state to the last one's
+		inline virtual void OnRender(double alpha) { (void)alpha; }
 
 		inline Ref<Window> GetWindow() { return m_window; }
+		// Shared by every engine system, nothing should start threads of its own for CPU work
+		inline Ref<JobSystem> GetJobSystem() { return m_jobSystem; }
+		inline GameLoop& GetGameLoop() { return m_gameLoop; }
+		// Memory for anything that only lives for the frame, released numFramesInFlight frames later
+		inline FrameArena& GetFrameArena() { return m_frameArena; }
+
+		// Once the game reached its steady state, every heap allocation during a frame's updates and rendering is a violation
+		// Only allocations through the tracked operator new are seen, see BLAZE_ALLOCATION_HOOKS
+		inline void SetAllocationFree(bool isAllocationFree) { m_isAllocationFree = isAllocationFree; }
 	private:
+		GameLoop m_gameLoop;
+		FrameArena m_frameArena;
+		std::string m_profileTracePath;
+		bool m_isAllocationFree = false;
 		Ref<Window> m_window;
+		// Declared after the window so it's destroyed first, jobs may still use the window
+		Ref<JobSystem> m_jobSystem;
 	};
 
 }
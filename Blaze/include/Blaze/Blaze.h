@@ -6,9 +6,23 @@
 #include <Blaze/Core.h>
 #include <Blaze/Error.h>
 #include <Blaze/Application.h>
+#include <Blaze/GameLoop.h>
+#include <Blaze/Log.h>
+#include <Blaze/Mutex.h>
 #include <Blaze/Object.h>
 #include <Blaze/Window.h>
 
+#include <Blaze/Memory/Arena.h>
+#include <Blaze/Memory/ArenaAllocator.h>
+#include <Blaze/Memory/AllocationTracker.h>
+#include <Blaze/Profiling/Profiler.h>
+#include <Blaze/Profiling/FlightRecorder.h>
+#include <Blaze/Profiling/FrameStatistics.h>
+#include <Blaze/Profiling/HdrHistogram.h>
+#include <Blaze/Profiling/ResourceCensus.h>
+#include <Blaze/Profiling/Telemetry.h>
+#include <Blaze/Profiling/TelemetryLayout.h>
+
 #include <Blaze/InputBase.h>
 #include <Blaze/KeyboardInput.h>
 #include <Blaze/MouseInput.h>
@@ -16,5 +30,21 @@
 #include <Blaze/Renderer/DeviceContext.h>
 #include <Blaze/Renderer/Format.h>
 #include <Blaze/Renderer/Buffer.h>
+#include <Blaze/Renderer/InstanceBatcher.h>
+
+#include <Blaze/Math/Simd.h>
+#include <Blaze/Math/Vector.h>
+#include <Blaze/Math/Matrix.h>
+#include <Blaze/Math/Quaternion.h>
+#include <Blaze/Math/Bounds.h>
+#include <Blaze/Math/BatchTransform.h>
+
+#include <Blaze/Mesh/MeshOptimizer.h>
+#include <Blaze/Mesh/Meshlet.h>
+#include <Blaze/Mesh/MeshCodec.h>
+#include <Blaze/IO/Package.h>
+#include <Blaze/IO/AsyncIO.h>
+#include <Blaze/IO/FileSystem.h>
+#include <Blaze/Jobs/JobSystem.h>
 
 #endif // BLAZE_BLAZE_H
\ No newline at end of file
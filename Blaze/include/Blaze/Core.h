@@ -12,6 +12,7 @@
 
 #include <Blaze/Error.h>
 
+#if defined(_WIN32)
 #ifdef BLAZE_EXPORTS
 #define BLAZE_API __declspec(dllexport)
 #define BLAZE_STL_EXTERN
@@ -19,5 +20,23 @@
 #define BLAZE_API __declspec(dllimport)
 #define BLAZE_STL_EXTERN extern
 #endif
+#else // ^^^ Windows / Other platforms vvv
+#define BLAZE_API __attribute__((visibility("default")))
+#endif // ^^^ Other platforms
+
+// SIMD instruction sets the compiler is allowed to use
+#if defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)) || defined(__SSE2__)
+#define BLAZE_SIMD_SSE2
+#endif
+#if defined(__AVX__)
+#define BLAZE_SIMD_AVX
+#endif
+#if defined(__FMA__) || defined(__AVX2__)
+#define BLAZE_SIMD_FMA
+#endif
+// Only AArch64 NEON, 32-bit ARM lacks some of the instructions used (eg. division)
+#if defined(_M_ARM64) || (defined(__aarch64__) && defined(__ARM_NEON))
+#define BLAZE_SIMD_NEON
+#endif
 
 #endif // BLAZE_CORE_H
\ No newline at end of file
@@ -18,25 +18,31 @@ namespace Blaze
 		InvalidCast,
 		SystemError,
 		AllocationError,
-		Uninitialized
+		Uninitialized,
+		NotFound,
+		Cancelled
 	};
 
 	class Exception
 		:public std::exception
 	{
 	public:
+		// The message is kept by the exception, std::exception only takes one on MSVC
 		inline Exception(Result code, const char* message = nullptr)
-			:std::exception(("Blaze Exception (" + std::to_string(static_cast<int32_t>(m_code)) + "): " + (message ? message : "No message") + '\n').c_str()), m_code(code)
+			:m_what("Blaze Exception (" + std::to_string(static_cast<int32_t>(code)) + "): " + (message ? message : "No message") + '\n'), m_code(code)
 		{
 		}
 
 		inline Exception(const Exception& e)
-			:std::exception(e), m_code(e.m_code)
+			:std::exception(e), m_what(e.m_what), m_code(e.m_code)
 		{
 		}
 
+		inline virtual const char* what() const noexcept override { return m_what.c_str(); }
+
 		constexpr Result GetCode() { return m_code; }
 	private:
+		std::string m_what;
 		Result m_code;
 	};
 }
@@ -0,0 +1,113 @@
+#pragma once
+
+#ifndef BLAZE_GAMELOOP_H
+#define BLAZE_GAMELOOP_H
+
+#include <Blaze/Core.h>
+
+#include <chrono>
+
+namespace Blaze
+{
+	using Clock = std::chrono::steady_clock;
+
+	// Number of frames the frame statistics are computed over
+	constexpr uint32_t frameStatsWindowSize = 128;
+
+	struct GameLoopConfig
+	{
+		// Simulation ticks per second, every tick advances the simulation by the same amount of time
+		double tickRate = 60.0;
+		// Frames per second the loop is limited to, 0 doesn't limit it (eg. when vsync already does)
+		double targetFrameRate = 60.0;
+		// Ticks run in one frame at most, after a long hitch the rest is dropped instead of spiralling
+		uint32_t maxTicksPerFrame = 8;
+	};
+
+	// Times are in seconds and over the last frameStatsWindowSize frames
+	struct FrameStats
+	{
+		uint64_t numFrames = 0;
+		uint64_t numTicks = 0;
+		uint64_t numDroppedTicks = 0;
+		double lastFrameTime = 0.0;
+		double averageFrameTime = 0.0;
+		double minFrameTime = 0.0;
+		double maxFrameTime = 0.0;
+		// Standard deviation of the frame time, low means even frame pacing
+		double frameTimeDeviation = 0.0;
+		// Time spent on frames without waiting for the frame limiter
+		double averageWorkTime = 0.0;
+	};
+
+	// Waits out the rest of each frame, sleeping most of it and spinning the last part for sub-millisecond accuracy
+	class BLAZE_API FrameLimiter
+	{
+	public:
+		FrameLimiter(double targetFrameRate = 0.0);
+		~FrameLimiter();
+
+		FrameLimiter(const FrameLimiter&) = delete;
+		FrameLimiter& operator=(const FrameLimiter&) = delete;
+
+		// 0 doesn't limit the frame rate
+		void SetTargetFrameRate(double targetFrameRate);
+		inline double GetTargetFrameRate() const { return m_targetFrameRate; }
+
+		// Waits until the next frame is due, a frame that ran late restarts the schedule instead of rushing the next ones
+		void Wait();
+		// Sleeps while the deadline is further away than a sleep usually takes, then spins
+		void WaitUntil(Clock::time_point deadline);
+	private:
+		// Sleeps for about a millisecond and learns how long that really takes
+		void SleepOnce();
+
+		double m_targetFrameRate = 0.0;
+		Clock::duration m_framePeriod{ 0 };
+		Clock::time_point m_nextFrame;
+
+		// Running mean and variance of how long SleepOnce takes (Welford)
+		double m_sleepMean = 0.002;
+		double m_sleepM2 = 0.0;
+		uint32_t m_numSleeps = 1;
+
+		// High resolution waitable timer on Windows
+		void* m_timer = nullptr;
+	};
+
+	// Fixed timestep loop, the simulation runs at a fixed tick rate and rendering interpolates between ticks
+	class BLAZE_API GameLoop
+	{
+	public:
+		GameLoop(const GameLoopConfig& config = GameLoopConfig{});
+
+		// Starts a frame, returns how many ticks the simulation has to run this frame
+		uint32_t BeginFrame();
+		// Ends a frame and waits for the frame limiter
+		void EndFrame();
+
+		// Seconds of simulation per tick
+		inline double GetTickDelta() const { return std::chrono::duration<double>(m_tickPeriod).count(); }
+		// How far time got past the last tick in ticks [0, 1), render at lerp(previousTick, lastTick, alpha)
+		inline double GetInterpolationAlpha() const { return m_interpolationAlpha; }
+
+		inline FrameLimiter& GetFrameLimiter() { return m_frameLimiter; }
+		FrameStats GetStats() const;
+	private:
+		Clock::duration m_tickPeriod;
+		uint32_t m_maxTicksPerFrame;
+		FrameLimiter m_frameLimiter;
+
+		Clock::time_point m_frameStart;
+		Clock::duration m_accumulator{ 0 };
+		double m_interpolationAlpha = 0.0;
+
+		std::array<float, frameStatsWindowSize> m_frameTimes{};
+		std::array<float, frameStatsWindowSize> m_workTimes{};
+		uint64_t m_numFrames = 0;
+		uint64_t m_numTicks = 0;
+		uint64_t m_numDroppedTicks = 0;
+	};
+}
+
+#endif // BLAZE_GAMELOOP_H
@@ -0,0 +1,123 @@
+#pragma once
+
+#ifndef BLAZE_ASYNCIO_H
+#define BLAZE_ASYNCIO_H
+
+#include <Blaze/Core.h>
+#include <Blaze/Object.h>
+
+#include <functional>
+
+namespace Blaze
+{
+	// Reads of a higher priority are always started before reads of a lower priority
+	enum class IOPriority
+	{
+		Null = 0,
+		Invalid = Null,
+		Critical,	// Needed to finish the current frame or loading screen
+		Streaming,	// Needed soon, eg. the world around the player
+		Prefetch,	// Might be needed, read when nothing else is waiting
+		NumPriorities = Prefetch
+	};
+
+	enum class AsyncIOBackend
+	{
+		Null = 0,
+		Invalid = Null,
+		ThreadPool,	// Blocking reads on worker threads, works everywhere
+		IOUring		// Linux io_uring, many reads in flight from one thread with batched submission
+	};
+
+	using IOFileID = uint32_t;
+	using IORequestID = uint64_t;
+
+	struct IOReadResult
+	{
+		IORequestID requestID;
+		// Success, Cancelled, or the error of the read
+		Result result;
+		void* buffer;
+		// Less than the requested size if the read went past the end of the file
+		size_t bytesRead;
+	};
+
+	// Called on a worker thread when a read finishes, decoding can be done right in the callback
+	// Callbacks may queue more reads
+	using IOCompletionCallback = std::function<void(const IOReadResult& result)>;
+
+	struct IOReadRequest
+	{
+		IOFileID file = 0;
+		uint64_t offset = 0;
+		size_t size = 0;
+		// Must stay alive until the callback is called
+		void* buffer = nullptr;
+		IOPriority priority = IOPriority::Streaming;
+		IOCompletionCallback callback;
+	};
+
+	struct AsyncIOStats
+	{
+		uint64_t numCompleted = 0;
+		uint64_t numCancelled = 0;
+		uint64_t numFailed = 0;
+		uint64_t bytesRead = 0;
+		// Number of system calls used to submit and wait for reads, io_uring batches many reads per call
+		uint64_t numSystemCalls = 0;
+		uint32_t maxReadsInFlight = 0;
+	};
+
+	struct AsyncIOCreateInfo
+		:public ObjectCreateInfo
+	{
+		// Threads that run reads (thread pool backend) and completion callbacks, 0 picks one from the core count
+		uint32_t numWorkers = 0;
+		// Maximum number of reads in flight at once
+		uint32_t queueDepth = 64;
+		// Skips io_uring even where it is available
+		bool isThreadPoolForced = false;
+	};
+
+	// Asynchronous file reads with priorities, cancellation and completion callbacks
+	class BLAZE_API AsyncIO
+		:public Object
+	{
+	public:
+		inline AsyncIO() { classID = GetStaticClassID(); }
+		virtual ~AsyncIO() = default;
+
+		// Uses io_uring where the kernel allows it, otherwise falls back to the thread pool
+		static Ref<AsyncIO> Create(const AsyncIOCreateInfo& createInfo);
+
+		constexpr static ClassID GetStaticClassID() { return Details::MakeClassID(Details::InterfaceID::AsyncIO, Details::ImplementationID::Invalid); }
+
+		// Opens a file for reading, files stay open until CloseFile so reads don't pay for opening
+		inline Result OpenFile(const std::string& path, IOFileID& file) { return OpenFile_Impl(path, file); }
+		// Closes a file, reads of the file must have completed
+		inline Result CloseFile(IOFileID file) { return CloseFile_Impl(file); }
+		inline Result GetFileSize(IOFileID file, uint64_t& size) { return GetFileSize_Impl(file, size); }
+
+		// Queues a read, never blocks the calling thread
+		inline Result Read(const IOReadRequest& request, IORequestID& requestID) { return Read_Impl(request, requestID); }
+		// Cancels a read, the callback is still called with Result::Cancelled
+		// Returns Result::NotFound if the read already completed
+		inline Result Cancel(IORequestID requestID) { return Cancel_Impl(requestID); }
+		// Blocks until every queued read has completed and its callback returned
+		inline Result WaitIdle() { return WaitIdle_Impl(); }
+
+		inline AsyncIOBackend GetBackend() { return GetBackend_Impl(); }
+		inline AsyncIOStats GetStats() { return GetStats_Impl(); }
+	private:
+		virtual Result OpenFile_Impl(const std::string& path, IOFileID& file) = 0;
+		virtual Result CloseFile_Impl(IOFileID file) = 0;
+		virtual Result GetFileSize_Impl(IOFileID file, uint64_t& size) = 0;
+		virtual Result Read_Impl(const IOReadRequest& request, IORequestID& requestID) = 0;
+		virtual Result Cancel_Impl(IORequestID requestID) = 0;
+		virtual Result WaitIdle_Impl() = 0;
+		virtual AsyncIOBackend GetBackend_Impl() = 0;
+		virtual AsyncIOStats GetStats_Impl() = 0;
+	};
+}
+
+#endif // BLAZE_ASYNCIO_H
@@ -0,0 +1,99 @@
+#pragma once
+
+#ifndef BLAZE_FILESYSTEM_H
+#define BLAZE_FILESYSTEM_H
+
+#include <Blaze/Core.h>
+#include <Blaze/Object.h>
+#include <Blaze/Jobs/JobSystem.h>
+
+#include <string_view>
+
+namespace Blaze
+{
+	// Default uncompressed size of an archive block, reads decompress whole blocks
+	constexpr uint32_t defaultArchiveBlockSize = 64 * 1024;
+
+	enum class MountType
+	{
+		Null = 0,
+		Invalid = Null,
+		Directory,	// Loose files in a directory on disk
+		Archive		// An archive written by WriteArchive
+	};
+
+	using MountID = uint32_t;
+
+	struct MountStats
+	{
+		uint64_t numReads = 0;
+		// Bytes returned to callers
+		uint64_t bytesRead = 0;
+		// Bytes read from disk, for archives this is compressed data
+		uint64_t bytesReadFromDisk = 0;
+		uint64_t numDiskReads = 0;
+		uint64_t numBlockCacheHits = 0;
+		uint64_t numBlockCacheMisses = 0;
+	};
+
+	// A file to write to an archive
+	struct ArchiveFileDesc
+	{
+		// Path of the file inside the archive, with '/' separators
+		std::string_view path;
+		const void* data = nullptr;
+		size_t size = 0;
+	};
+
+	// Writes an LZ4 block compressed archive, the files are stored in the given order
+	// Files that are loaded together should be next to each other so loading them reads contiguous blocks
+	BLAZE_API Result WriteArchive(const std::string& path, const ArchiveFileDesc* files, size_t numFiles, uint32_t blockSize = defaultArchiveBlockSize);
+
+	struct FileSystemCreateInfo
+		:public ObjectCreateInfo
+	{
+		// Memory for decompressed archive blocks
+		size_t blockCacheSize = 64 * 1024 * 1024;
+		// Decompresses reads spanning several blocks on this job system, eg. GameApp::GetJobSystem()
+		Ref<JobSystem> jobSystem;
+		// Threads that help decompress when there's no job system, 0 picks one from the core count
+		uint32_t numWorkers = 0;
+	};
+
+	// Virtual file system, paths are resolved against the mounts from the most recently mounted back
+	// Paths use '/' separators and are relative to the root, eg. "meshes/rock.bzm"
+	class BLAZE_API FileSystem
+		:public Object
+	{
+	public:
+		inline FileSystem() { classID = GetStaticClassID(); }
+		virtual ~FileSystem() = default;
+
+		static Ref<FileSystem> Create(const FileSystemCreateInfo& createInfo);
+
+		constexpr static ClassID GetStaticClassID() { return Details::MakeClassID(Details::InterfaceID::FileSystem, Details::ImplementationID::Invalid); }
+
+		// Mounts a directory or archive at mountPoint (eg. "" for the root or "dlc/"), later mounts shadow files of earlier ones
+		inline Result Mount(const std::string& mountPoint, const std::string& path, MountType type, MountID& mount) { return Mount_Impl(mountPoint, path, type, mount); }
+		inline Result Unmount(MountID mount) { return Unmount_Impl(mount); }
+
+		inline bool Exists(std::string_view path) { return Exists_Impl(path); }
+		inline Result GetFileSize(std::string_view path, uint64_t& size) { return GetFileSize_Impl(path, size); }
+		// Reads part of a file, bytesRead is less than size at the end of the file
+		inline Result Read(std::string_view path, uint64_t offset, void* dst, size_t size, size_t& bytesRead) { return Read_Impl(path, offset, dst, size, bytesRead); }
+		// Reads a whole file
+		inline Result ReadFile(std::string_view path, std::vector<uint8_t>& data) { return ReadFile_Impl(path, data); }
+
+		inline Result GetMountStats(MountID mount, MountStats& stats) { return GetMountStats_Impl(mount, stats); }
+	private:
+		virtual Result Mount_Impl(const std::string& mountPoint, const std::string& path, MountType type, MountID& mount) = 0;
+		virtual Result Unmount_Impl(MountID mount) = 0;
+		virtual bool Exists_Impl(std::string_view path) = 0;
+		virtual Result GetFileSize_Impl(std::string_view path, uint64_t& size) = 0;
+		virtual Result Read_Impl(std::string_view path, uint64_t offset, void* dst, size_t size, size_t& bytesRead) = 0;
+		virtual Result ReadFile_Impl(std::string_view path, std::vector<uint8_t>& data) = 0;
+		virtual Result GetMountStats_Impl(MountID mount, MountStats& stats) = 0;
+	};
+}
+
+#endif // BLAZE_FILESYSTEM_H
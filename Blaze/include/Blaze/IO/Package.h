@@ -0,0 +1,91 @@
+#pragma once
+
+#ifndef BLAZE_PACKAGE_H
+#define BLAZE_PACKAGE_H
+
+#include <Blaze/Core.h>
+#include <Blaze/Object.h>
+
+#include <string_view>
+
+namespace Blaze
+{
+	// Version of the package format written by WritePackage, packages of other versions fail to open
+	constexpr uint32_t packageVersion = 1;
+	// Blobs start on a page boundary so they can be uploaded or handed to the OS page by page
+	constexpr uint64_t packageBlobAlignment = 4096;
+
+	// Hashes a blob name (FNV-1a), constexpr so names known at compile time cost nothing to look up
+	constexpr uint64_t HashPackageName(std::string_view name)
+	{
+		uint64_t hash = 0xcbf29ce484222325;
+		for (char c : name)
+		{
+			hash ^= static_cast<uint8_t>(c);
+			hash *= 0x00000100000001b3;
+		}
+		// 0 marks an empty slot in the table of contents
+		return hash ? hash : 1;
+	}
+
+	// A blob inside a mapped package
+	struct PackageBlob
+	{
+		// Points into the read-only file mapping, valid as long as the package is alive
+		const void* data = nullptr;
+		size_t size = 0;
+		// User defined type of the blob (eg. vertices, indices, compressed mesh)
+		uint32_t tag = 0;
+	};
+
+	// A blob to write to a package
+	struct PackageBlobDesc
+	{
+		std::string_view name;
+		const void* data = nullptr;
+		size_t size = 0;
+		uint32_t tag = 0;
+	};
+
+	// Writes blobs to a package file, fails if two names hash to the same value
+	BLAZE_API Result WritePackage(const std::string& path, const PackageBlobDesc* blobs, size_t numBlobs);
+
+	struct PackageCreateInfo
+		:public ObjectCreateInfo
+	{
+		std::string path;
+	};
+
+	// A package file mapped into memory, blobs are read straight from the mapping without copies
+	// eg. BufferCreateInfo::data can point at PackageBlob::data
+	class BLAZE_API Package
+		:public Object
+	{
+	public:
+		inline Package() { classID = GetStaticClassID(); }
+		virtual ~Package() = default;
+
+		static Ref<Package> Create(const PackageCreateInfo& createInfo);
+
+		constexpr static ClassID GetStaticClassID() { return Details::MakeClassID(Details::InterfaceID::Package, Details::ImplementationID::Invalid); }
+
+		// Finds a blob by the hash of its name, returns Result::NotFound if the package doesn't contain it
+		inline Result Find(uint64_t nameHash, PackageBlob& blob) { return Find_Impl(nameHash, blob); }
+		// Finds a blob by name
+		inline Result Find(std::string_view name, PackageBlob& blob) { return Find_Impl(HashPackageName(name), blob); }
+
+		// Hints that blobs will be read soon, the OS starts reading them in the background
+		inline Result Prefetch(const PackageBlob* blobs, size_t numBlobs) { return Prefetch_Impl(blobs, numBlobs); }
+		// Hints that blobs won't be read again soon (eg. after they were uploaded), their pages can be dropped
+		inline Result Evict(const PackageBlob* blobs, size_t numBlobs) { return Evict_Impl(blobs, numBlobs); }
+
+		inline uint32_t GetNumBlobs() { return GetNumBlobs_Impl(); }
+	private:
+		virtual Result Find_Impl(uint64_t nameHash, PackageBlob& blob) = 0;
+		virtual Result Prefetch_Impl(const PackageBlob* blobs, size_t numBlobs) = 0;
+		virtual Result Evict_Impl(const PackageBlob* blobs, size_t numBlobs) = 0;
+		virtual uint32_t GetNumBlobs_Impl() = 0;
+	};
+}
+
+#endif // BLAZE_PACKAGE_H
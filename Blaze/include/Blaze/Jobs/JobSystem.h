@@ -0,0 +1,83 @@
+#pragma once
+
+#ifndef BLAZE_JOBSYSTEM_H
+#define BLAZE_JOBSYSTEM_H
+
+#include <Blaze/Core.h>
+#include <Blaze/Object.h>
+
+#include <atomic>
+
+namespace Blaze
+{
+	// Runs on a worker thread, jobs may run more jobs and wait on them
+	using JobFunction = void(*)(void* data);
+
+	struct JobDesc
+	{
+		JobFunction function = nullptr;
+		// Must stay alive until the job ran
+		void* data = nullptr;
+	};
+
+	// Counts the unfinished jobs of Run calls, can be reused once it reached 0
+	// Must stay alive until every job counted by it finished and every wait on it returned
+	struct JobCounter
+	{
+		std::atomic<uint32_t> value{ 0 };
+	};
+
+	struct JobSystemStats
+	{
+		uint64_t numJobsRun = 0;
+		// Jobs a worker took from another worker's queue
+		uint64_t numJobsStolen = 0;
+		// Waits that suspended a job, waits on finished counters don't count
+		uint64_t numJobWaits = 0;
+		// Fibers created so far, each one is a job that was suspended at some point
+		uint32_t numFibers = 0;
+	};
+
+	struct JobSystemCreateInfo
+		:public ObjectCreateInfo
+	{
+		// 0 uses one worker per core, minus one for the thread that owns the job system
+		uint32_t numWorkers = 0;
+		// Stack size of the fibers that run the jobs
+		size_t fiberStackSize = 256 * 1024;
+	};
+
+	// Work stealing job scheduler, jobs run on fibers so waiting on other jobs doesn't block a worker
+	// Every worker has its own queue, idle workers steal from the others
+	class BLAZE_API JobSystem
+		:public Object
+	{
+	public:
+		inline JobSystem() { classID = GetStaticClassID(); }
+		virtual ~JobSystem() = default;
+
+		static Ref<JobSystem> Create(const JobSystemCreateInfo& createInfo);
+
+		constexpr static ClassID GetStaticClassID() { return Details::MakeClassID(Details::InterfaceID::JobSystem, Details::ImplementationID::Invalid); }
+
+		// Queues jobs, counter (if not nullptr) is increased by numJobs and decreased as each job finishes
+		// Jobs queued from a job go on the front of the worker's queue, so the most recent work runs first
+		inline Result Run(const JobDesc* jobs, size_t numJobs, JobCounter* counter = nullptr) { return Run_Impl(jobs, numJobs, counter); }
+		inline Result Run(const JobDesc& job, JobCounter* counter = nullptr) { return Run_Impl(&job, 1, counter); }
+		// Waits until the counter drops to value or below
+		// A job that waits is suspended and its worker runs other jobs, other threads block
+		// If no fiber can be created to suspend to, the job runs other jobs on its own stack until the counter is reached,
+		// or until a resumed job is ready to take over the worker
+		inline Result Wait(JobCounter& counter, uint32_t value = 0) { return Wait_Impl(counter, value); }
+
+		inline uint32_t GetNumWorkers() { return GetNumWorkers_Impl(); }
+		inline JobSystemStats GetStats() { return GetStats_Impl(); }
+	private:
+		virtual Result Run_Impl(const JobDesc* jobs, size_t numJobs, JobCounter* counter) = 0;
+		virtual Result Wait_Impl(JobCounter& counter, uint32_t value) = 0;
+		virtual uint32_t GetNumWorkers_Impl() = 0;
+		virtual JobSystemStats GetStats_Impl() = 0;
+	};
+}
+
+#endif // BLAZE_JOBSYSTEM_H
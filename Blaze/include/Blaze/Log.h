@@ -0,0 +1,275 @@
+#pragma once
+
+#ifndef BLAZE_LOG_H
+#define BLAZE_LOG_H
+
+#include <Blaze/Core.h>
+
+#include <cstring>
+#include <iosfwd>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+#define BLAZE_LOG_LEVEL_TRACE 1
+#define BLAZE_LOG_LEVEL_INFO 2
+#define BLAZE_LOG_LEVEL_WARNING 3
+#define BLAZE_LOG_LEVEL_ERROR 4
+#define BLAZE_LOG_LEVEL_OFF 5
+
+// Messages below this level are compiled out, arguments included
+#ifndef BLAZE_LOG_LEVEL
+#if defined(BLAZE_DEBUG) || defined(_DEBUG)
+#define BLAZE_LOG_LEVEL BLAZE_LOG_LEVEL_TRACE
+#else // ^^^ Debug / Release vvv
+#define BLAZE_LOG_LEVEL BLAZE_LOG_LEVEL_INFO
+#endif // ^^^ Release
+#endif // BLAZE_LOG_LEVEL
+
+namespace Blaze
+{
+	// Bytes of messages every thread can have waiting for the log thread, messages that don't fit are dropped
+	constexpr size_t logRingSize = 64 * 1024;
+
+	enum class LogLevel : uint32_t
+	{
+		Null = 0,
+		Invalid = Null,
+		Trace = BLAZE_LOG_LEVEL_TRACE,
+		Info = BLAZE_LOG_LEVEL_INFO,
+		Warning = BLAZE_LOG_LEVEL_WARNING,
+		Error = BLAZE_LOG_LEVEL_ERROR,
+		NumLevels = Error
+	};
+
+	struct LogConfig
+	{
+		// Writes messages to stdout
+		bool console = true;
+		// File messages are appended to, empty doesn't write one
+		std::string filePath;
+		// Lines kept in memory for Log::GetHistory, eg. for an in-game console or a crash report
+		uint32_t historySize = 256;
+	};
+
+	struct LogStats
+	{
+		uint64_t numMessages = 0;
+		// Messages a thread couldn't fit in its ring, or that were too long for one
+		uint64_t numDropped = 0;
+	};
+
+	namespace Details
+	{
+		// Turns the captured arguments back into values and formats the message, runs on the log thread
+		using LogFormatter = void(*)(std::ostream& stream, const char* format, const uint8_t* data);
+
+		struct LogReservation
+		{
+			void* ring = nullptr;
+			uint8_t* data = nullptr;
+			uint64_t end = 0;
+		};
+
+		// Reserves room for a message's arguments in the calling thread's ring, data is nullptr when it's full
+		BLAZE_API LogReservation BeginLogRecord(LogLevel level, const char* format, LogFormatter formatter, size_t size);
+		BLAZE_API void EndLogRecord(const LogReservation& reservation);
+
+		// A value a message prints, the format string only knows them by position
+		struct LogValue
+		{
+			const void* value;
+			void(*print)(std::ostream& stream, const void* value);
+		};
+
+		BLAZE_API void FormatLogMessage(std::ostream& stream, const char* format, const LogValue* values, size_t numValues);
+		BLAZE_API void PrintLogString(std::ostream& stream, const void* value);
+		BLAZE_API void PrintLogBool(std::ostream& stream, const void* value);
+		BLAZE_API void PrintLogChar(std::ostream& stream, const void* value);
+		BLAZE_API void PrintLogSigned(std::ostream& stream, const void* value);
+		BLAZE_API void PrintLogUnsigned(std::ostream& stream, const void* value);
+		BLAZE_API void PrintLogDouble(std::ostream& stream, const void* value);
+		BLAZE_API void PrintLogPointer(std::ostream& stream, const void* value);
+
+		// How an argument type is captured, numbers and pointers by value and strings by copying their characters
+		template<typename T, typename = void>
+		struct LogArgument
+		{
+			static_assert(sizeof(T) == 0, "Blaze::Log only takes numbers, enums, pointers and strings");
+		};
+
+		template<typename T>
+		struct LogArgument<T, std::enable_if_t<std::is_arithmetic_v<T> || std::is_enum_v<T>>>
+		{
+			// Widened so printing only needs a few functions
+			using Stored = std::conditional_t<std::is_same_v<T, bool>, bool,
+				std::conditional_t<std::is_same_v<T, char>, char,
+				std::conditional_t<std::is_floating_point_v<T>, double,
+				std::conditional_t<std::is_enum_v<T>, int64_t,
+				std::conditional_t<std::is_signed_v<T>, int64_t, uint64_t>>>>>;
+
+			static constexpr size_t GetSize(const T&) { return sizeof(Stored); }
+			static inline void Write(uint8_t*& cursor, const T& value)
+			{
+				const Stored stored = static_cast<Stored>(value);
+				std::memcpy(cursor, &stored, sizeof(Stored));
+				cursor += sizeof(Stored);
+			}
+			static inline Stored Read(const uint8_t*& cursor)
+			{
+				Stored stored;
+				std::memcpy(&stored, cursor, sizeof(Stored));
+				cursor += sizeof(Stored);
+				return stored;
+			}
+			static inline LogValue ToValue(const Stored& stored)
+			{
+				if constexpr (std::is_same_v<Stored, bool>)
+					return { &stored, PrintLogBool };
+				else if constexpr (std::is_same_v<Stored, char>)
+					return { &stored, PrintLogChar };
+				else if constexpr (std::is_same_v<Stored, double>)
+					return { &stored, PrintLogDouble };
+				else if constexpr (std::is_same_v<Stored, int64_t>)
+					return { &stored, PrintLogSigned };
+				else
+					return { &stored, PrintLogUnsigned };
+			}
+		};
+
+		// Strings are copied, the caller's string may be gone by the time the message is written
+		struct LogStringArgument
+		{
+			using Stored = std::string_view;
+
+			static inline size_t GetSize(std::string_view value) { return sizeof(uint32_t) + value.size(); }
+			static inline void Write(uint8_t*& cursor, std::string_view value)
+			{
+				const uint32_t length = static_cast<uint32_t>(value.size());
+				std::memcpy(cursor, &length, sizeof(length));
+				std::memcpy(cursor + sizeof(length), value.data(), length);
+				cursor += sizeof(length) + length;
+			}
+			static inline Stored Read(const uint8_t*& cursor)
+			{
+				uint32_t length;
+				std::memcpy(&length, cursor, sizeof(length));
+				const Stored stored{ reinterpret_cast<const char*>(cursor + sizeof(length)), length };
+				cursor += sizeof(length) + length;
+				return stored;
+			}
+			static inline LogValue ToValue(const Stored& stored) { return { &stored, PrintLogString }; }
+		};
+
+		template<>
+		struct LogArgument<const char*> :LogStringArgument
+		{
+			static inline size_t GetSize(const char* value) { return LogStringArgument::GetSize(value ? value : "(null)"); }
+			static inline void Write(uint8_t*& cursor, const char* value) { LogStringArgument::Write(cursor, value ? value : "(null)"); }
+		};
+		template<>
+		struct LogArgument<char*> :LogArgument<const char*> {};
+		template<>
+		struct LogArgument<std::string_view> :LogStringArgument {};
+		template<>
+		struct LogArgument<std::string> :LogStringArgument {};
+
+		// Other pointers print their address
+		template<typename T>
+		struct LogArgument<T*, std::enable_if_t<!std::is_same_v<std::remove_cv_t<T>, char>>>
+		{
+			using Stored = const void*;
+
+			static constexpr size_t GetSize(T*) { return sizeof(Stored); }
+			static inline void Write(uint8_t*& cursor, T* value)
+			{
+				const Stored stored = value;
+				std::memcpy(cursor, &stored, sizeof(Stored));
+				cursor += sizeof(Stored);
+			}
+			static inline Stored Read(const uint8_t*& cursor)
+			{
+				Stored stored;
+				std::memcpy(&stored, cursor, sizeof(Stored));
+				cursor += sizeof(Stored);
+				return stored;
+			}
+			static inline LogValue ToValue(const Stored& stored) { return { &stored, PrintLogPointer }; }
+		};
+
+		template<typename... Args>
+		void FormatLogRecord(std::ostream& stream, const char* format, const uint8_t* data)
+		{
+			// Braced initialization reads the arguments in order
+			const uint8_t* cursor = data;
+			const std::tuple<typename LogArgument<Args>::Stored...> stored{ LogArgument<Args>::Read(cursor)... };
+
+			std::apply([&](const auto&... values)
+			{
+				const LogValue logValues[] = { LogArgument<Args>::ToValue(values)..., LogValue{ nullptr, nullptr } };
+				FormatLogMessage(stream, format, logValues, sizeof...(Args));
+			}, stored);
+		}
+	}
+
+	// Asynchronous logger, messages are captured into a ring per thread and formatted and written by a log thread
+	// Logging never blocks and doesn't allocate once the thread's ring exists, messages that don't fit are dropped
+	class BLAZE_API Log
+	{
+	public:
+		// Sinks can be changed at any time, messages still waiting go to the new ones
+		// Also starts the log thread again after a Shutdown
+		static void Configure(const LogConfig& config);
+
+		// Each {} in format is replaced by the next argument, {:.N} prints a number with N decimals and {{ is a brace
+		// format has to outlive the message, usually a string literal, BLAZE_LOG_INFO and co. are meant to be used instead
+		template<typename... Args>
+		static inline void Write(LogLevel level, const char* format, const Args&... args)
+		{
+			const size_t size = (Details::LogArgument<std::decay_t<Args>>::GetSize(args) + ... + 0);
+			const Details::LogReservation reservation = Details::BeginLogRecord(level, format, &Details::FormatLogRecord<std::decay_t<Args>...>, size);
+			if (!reservation.data)
+				return;
+
+			uint8_t* cursor = reservation.data;
+			(Details::LogArgument<std::decay_t<Args>>::Write(cursor, args), ...);
+			Details::EndLogRecord(reservation);
+		}
+
+		// Waits until every message logged before the call is written
+		static void Flush();
+		// Writes every message waiting and stops the log thread, called by GameApp before the engine's DLL unloads
+		// Messages logged afterwards are written right away by the thread logging them, until the next Configure
+		static void Shutdown();
+
+		static LogStats GetStats();
+		// The last historySize lines written, oldest first
+		static std::vector<std::string> GetHistory();
+	};
+}
+
+#if BLAZE_LOG_LEVEL <= BLAZE_LOG_LEVEL_TRACE
+#define BLAZE_LOG_TRACE(...) ::Blaze::Log::Write(::Blaze::LogLevel::Trace, __VA_ARGS__)
+#else
+#define BLAZE_LOG_TRACE(...) ((void)0)
+#endif
+
+#if BLAZE_LOG_LEVEL <= BLAZE_LOG_LEVEL_INFO
+#define BLAZE_LOG_INFO(...) ::Blaze::Log::Write(::Blaze::LogLevel::Info, __VA_ARGS__)
+#else
+#define BLAZE_LOG_INFO(...) ((void)0)
+#endif
+
+#if BLAZE_LOG_LEVEL <= BLAZE_LOG_LEVEL_WARNING
+#define BLAZE_LOG_WARNING(...) ::Blaze::Log::Write(::Blaze::LogLevel::Warning, __VA_ARGS__)
+#else
+#define BLAZE_LOG_WARNING(...) ((void)0)
+#endif
+
+#if BLAZE_LOG_LEVEL <= BLAZE_LOG_LEVEL_ERROR
+#define BLAZE_LOG_ERROR(...) ::Blaze::Log::Write(::Blaze::LogLevel::Error, __VA_ARGS__)
+#else
+#define BLAZE_LOG_ERROR(...) ((void)0)
+#endif
+
+#endif // BLAZE_LOG_H
@@ -0,0 +1,38 @@
+#pragma once
+
+#ifndef BLAZE_BATCH_TRANSFORM_H
+#define BLAZE_BATCH_TRANSFORM_H
+
+#include <Blaze/Core.h>
+#include <Blaze/Renderer/Format.h>
+#include <Blaze/Math/Vector.h>
+#include <Blaze/Math/Matrix.h>
+
+namespace Blaze
+{
+	// Kernels for transforming many vectors at once, eg. skinning particles on the CPU or baking static geometry
+	// The structure of arrays kernels process 8 (AVX) or 4 (SSE2, NEON) vectors per instruction with no shuffles,
+	// the strided kernels work on interleaved vertices in place, eg. in memory from Buffer::MapMemory
+	// Input and output may be the same arrays, but must not partially overlap
+
+	// x, y and z in separate arrays, w = 1
+	BLAZE_API void TransformPointsSoA(const Mat4& transform, const float* x, const float* y, const float* z, float* outX, float* outY, float* outZ, size_t count);
+	// x, y and z in separate arrays, w = 0
+	BLAZE_API void TransformVectorsSoA(const Mat4& transform, const float* x, const float* y, const float* z, float* outX, float* outY, float* outZ, size_t count);
+
+	// Strides are in bytes, so positions can be read from and written to interleaved vertices
+	BLAZE_API void TransformPoints(const Mat4& transform, const Vec3* src, size_t srcStride, Vec3* dst, size_t dstStride, size_t count);
+	BLAZE_API void TransformVectors(const Mat4& transform, const Vec3* src, size_t srcStride, Vec3* dst, size_t dstStride, size_t count);
+	BLAZE_API void TransformVec4s(const Mat4& transform, const Vec4* src, size_t srcStride, Vec4* dst, size_t dstStride, size_t count);
+
+	// Converts between interleaved vectors and separate x, y and z arrays
+	BLAZE_API void SplitVec3(const Vec3* src, size_t srcStride, float* x, float* y, float* z, size_t count);
+	BLAZE_API void InterleaveVec3(const float* x, const float* y, const float* z, Vec3* dst, size_t dstStride, size_t count);
+
+	// Transforms one attribute of vertices laid out by format, vertices points to the start of the attribute's binding
+	// R32G32B32_Float attributes are transformed as points, or as directions (w = 0) if isDirection is set,
+	// R32G32B32A32_Float attributes use their own w, other formats return Result::InvalidParam
+	BLAZE_API Result TransformVertexAttribute(const Mat4& transform, void* vertices, size_t vertexCount, const VertexFormat& format, size_t attributeIndex, bool isDirection = false);
+}
+
+#endif // BLAZE_BATCH_TRANSFORM_H
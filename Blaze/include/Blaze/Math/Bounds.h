@@ -0,0 +1,113 @@
+#pragma once
+
+#ifndef BLAZE_BOUNDS_H
+#define BLAZE_BOUNDS_H
+
+#include <Blaze/Core.h>
+#include <Blaze/Math/Vector.h>
+#include <Blaze/Math/Matrix.h>
+
+#include <limits>
+
+namespace Blaze
+{
+	// Axis aligned bounding box, an empty box has min > max so merging anything into it gives that thing's bounds
+	struct AABB
+	{
+		Vec3 min;
+		Vec3 max;
+
+		static constexpr AABB Empty()
+		{
+			return { Vec3{ std::numeric_limits<float>::infinity() }, Vec3{ -std::numeric_limits<float>::infinity() } };
+		}
+
+		constexpr bool IsEmpty() const { return (min.x > max.x) || (min.y > max.y) || (min.z > max.z); }
+		constexpr Vec3 GetCenter() const { return (min + max) * 0.5f; }
+		// Half the size on each axis
+		constexpr Vec3 GetExtents() const { return (max - min) * 0.5f; }
+
+		inline void Merge(const Vec3& point) { min = Min(min, point); max = Max(max, point); }
+		inline void Merge(const AABB& box) { min = Min(min, box.min); max = Max(max, box.max); }
+
+		constexpr bool Contains(const Vec3& point) const
+		{
+			return (point.x >= min.x) && (point.y >= min.y) && (point.z >= min.z) && (point.x <= max.x) && (point.y <= max.y) && (point.z <= max.z);
+		}
+		constexpr bool Intersects(const AABB& box) const
+		{
+			return (box.max.x >= min.x) && (box.max.y >= min.y) && (box.max.z >= min.z) && (box.min.x <= max.x) && (box.min.y <= max.y) && (box.min.z <= max.z);
+		}
+	};
+
+	// Same layout as the sphere at the start of MeshletBounds
+	struct BoundingSphere
+	{
+		Vec3 center;
+		float radius;
+
+		inline bool Contains(const Vec3& point) const { return LengthSquared(point - center) <= radius * radius; }
+		inline bool Intersects(const BoundingSphere& sphere) const
+		{
+			const float radii = radius + sphere.radius;
+			return LengthSquared(sphere.center - center) <= radii * radii;
+		}
+	};
+
+	// Planes (a, b, c, d) with normals pointing inwards, a point is inside if ax + by + cz + d >= 0
+	struct Frustum
+	{
+		enum Plane
+		{
+			Left = 0,
+			Right,
+			Bottom,
+			Top,
+			Near,
+			Far,
+			NumPlanes
+		};
+
+		Vec4 planes[NumPlanes];
+
+		// Extracts normalized planes from a view projection matrix with OpenGL's [-1, 1] depth range
+		BLAZE_API static Frustum FromViewProjection(const Mat4& viewProjection);
+
+		// Conservative, boxes and spheres near a corner outside of two planes still count as intersecting
+		inline bool Intersects(const BoundingSphere& sphere) const
+		{
+			const Vec4 center{ sphere.center, 1.0f };
+			for (const auto& plane : planes)
+			{
+				if (Dot(plane, center) < -sphere.radius)
+					return false;
+			}
+			return true;
+		}
+		inline bool Intersects(const AABB& box) const
+		{
+			// Tests the corner furthest along each plane's normal
+			const Float4 center = Vec4{ box.GetCenter(), 1.0f }.Load();
+			const Float4 extents = Vec4{ box.GetExtents(), 0.0f }.Load();
+			for (const auto& plane : planes)
+			{
+				const Float4 p = plane.Load();
+				if (HorizontalAdd(p * center) + HorizontalAdd(Abs(p) * extents) < 0.0f)
+					return false;
+			}
+			return true;
+		}
+	};
+
+	// Bounds of positions with a stride in bytes between them, eg. straight from interleaved vertices
+	BLAZE_API AABB ComputeBounds(const Vec3* positions, size_t count, size_t stride = sizeof(Vec3));
+	// Sphere around the center of the bounding box, not the smallest possible sphere but close and a single extra pass
+	BLAZE_API BoundingSphere ComputeBoundingSphere(const Vec3* positions, size_t count, size_t stride = sizeof(Vec3));
+
+	// Box around the transformed box, only exact for transforms without rotation
+	BLAZE_API AABB TransformBounds(const AABB& box, const Mat4& transform);
+	// The radius grows with the largest scale of the transform
+	BLAZE_API BoundingSphere TransformBounds(const BoundingSphere& sphere, const Mat4& transform);
+}
+
+#endif // BLAZE_BOUNDS_H
@@ -0,0 +1,113 @@
+#pragma once
+
+#ifndef BLAZE_MATRIX_H
+#define BLAZE_MATRIX_H
+
+#include <Blaze/Core.h>
+#include <Blaze/Math/Vector.h>
+
+namespace Blaze
+{
+	// Column-major like OpenGL, columns[3] is the translation
+	// The layout matches 4 R32G32B32A32_Float instance attributes and the transforms InstanceBatcher takes
+	struct Mat4
+	{
+		Vec4 columns[4];
+
+		Mat4() = default;
+		constexpr Mat4(const Vec4& c0, const Vec4& c1, const Vec4& c2, const Vec4& c3) :columns{ c0, c1, c2, c3 } {}
+
+		// 16 floats in column-major order
+		static inline Mat4 FromData(const float* data) { return { Load4(data), Load4(data + 4), Load4(data + 8), Load4(data + 12) }; }
+
+		static constexpr Mat4 Identity()
+		{
+			return { { 1.0f, 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 0.0f, 1.0f } };
+		}
+		static constexpr Mat4 Translation(const Vec3& t)
+		{
+			return { { 1.0f, 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f, 0.0f }, { t, 1.0f } };
+		}
+		static constexpr Mat4 Scale(const Vec3& s)
+		{
+			return { { s.x, 0.0f, 0.0f, 0.0f }, { 0.0f, s.y, 0.0f, 0.0f }, { 0.0f, 0.0f, s.z, 0.0f }, { 0.0f, 0.0f, 0.0f, 1.0f } };
+		}
+		// Right-handed rotation around a unit axis, see Quat for composing rotations
+		static inline Mat4 Rotation(const Vec3& axis, float angle)
+		{
+			const float c = std::cos(angle);
+			const float s = std::sin(angle);
+			const Vec3 t = axis * (1.0f - c);
+			return {
+				{ t.x * axis.x + c, t.x * axis.y + s * axis.z, t.x * axis.z - s * axis.y, 0.0f },
+				{ t.y * axis.x - s * axis.z, t.y * axis.y + c, t.y * axis.z + s * axis.x, 0.0f },
+				{ t.z * axis.x + s * axis.y, t.z * axis.y - s * axis.x, t.z * axis.z + c, 0.0f },
+				{ 0.0f, 0.0f, 0.0f, 1.0f }
+			};
+		}
+		// Right-handed view looking down -z, depth in [-1, 1] like OpenGL's clip space
+		static inline Mat4 Perspective(float fovY, float aspect, float nearZ, float farZ)
+		{
+			const float f = 1.0f / std::tan(fovY * 0.5f);
+			const float range = 1.0f / (nearZ - farZ);
+			return { { f / aspect, 0.0f, 0.0f, 0.0f }, { 0.0f, f, 0.0f, 0.0f }, { 0.0f, 0.0f, (nearZ + farZ) * range, -1.0f }, { 0.0f, 0.0f, 2.0f * nearZ * farZ * range, 0.0f } };
+		}
+		static inline Mat4 Orthographic(float left, float right, float bottom, float top, float nearZ, float farZ)
+		{
+			const Vec3 scale{ 1.0f / (right - left), 1.0f / (top - bottom), 1.0f / (nearZ - farZ) };
+			return {
+				{ 2.0f * scale.x, 0.0f, 0.0f, 0.0f }, { 0.0f, 2.0f * scale.y, 0.0f, 0.0f }, { 0.0f, 0.0f, 2.0f * scale.z, 0.0f },
+				{ -(right + left) * scale.x, -(top + bottom) * scale.y, (farZ + nearZ) * scale.z, 1.0f }
+			};
+		}
+		static inline Mat4 LookAt(const Vec3& eye, const Vec3& target, const Vec3& up)
+		{
+			const Vec3 f = Normalize(target - eye);
+			const Vec3 s = Normalize(Cross(f, up));
+			const Vec3 u = Cross(s, f);
+			return { { s.x, u.x, -f.x, 0.0f }, { s.y, u.y, -f.y, 0.0f }, { s.z, u.z, -f.z, 0.0f }, { -Dot(s, eye), -Dot(u, eye), Dot(f, eye), 1.0f } };
+		}
+
+		inline float* Data() { return columns[0].Data(); }
+		inline const float* Data() const { return columns[0].Data(); }
+
+		inline Vec4 operator*(const Vec4& v) const
+		{
+			Float4 result = columns[0].Load() * Splat(v.x);
+			result = MulAdd(columns[1].Load(), Splat(v.y), result);
+			result = MulAdd(columns[2].Load(), Splat(v.z), result);
+			return MulAdd(columns[3].Load(), Splat(v.w), result);
+		}
+		inline Mat4 operator*(const Mat4& rhs) const
+		{
+			return { *this * rhs.columns[0], *this * rhs.columns[1], *this * rhs.columns[2], *this * rhs.columns[3] };
+		}
+		inline Mat4& operator*=(const Mat4& rhs) { return *this = *this * rhs; }
+
+		// w = 1, the projective divide is left to the caller
+		inline Vec3 TransformPoint(const Vec3& p) const { return (*this * Vec4{ p, 1.0f }).GetXYZ(); }
+		// w = 0, normals need the inverse transpose when the scale isn't uniform
+		inline Vec3 TransformVector(const Vec3& v) const { return (*this * Vec4{ v, 0.0f }).GetXYZ(); }
+
+		inline bool operator==(const Mat4& rhs) const { return (columns[0] == rhs.columns[0]) && (columns[1] == rhs.columns[1]) && (columns[2] == rhs.columns[2]) && (columns[3] == rhs.columns[3]); }
+		inline bool operator!=(const Mat4& rhs) const { return !(*this == rhs); }
+	};
+
+	inline Mat4 Transpose(const Mat4& m)
+	{
+		const auto& c = m.columns;
+		return {
+			{ c[0].x, c[1].x, c[2].x, c[3].x },
+			{ c[0].y, c[1].y, c[2].y, c[3].y },
+			{ c[0].z, c[1].z, c[2].z, c[3].z },
+			{ c[0].w, c[1].w, c[2].w, c[3].w }
+		};
+	}
+
+	// Returns false and leaves inverse unchanged if the matrix is singular
+	BLAZE_API bool Inverse(const Mat4& m, Mat4& inverse);
+
+	static_assert(sizeof(Mat4) == 16 * sizeof(float), "Matrices must not be padded");
+}
+
+#endif // BLAZE_MATRIX_H
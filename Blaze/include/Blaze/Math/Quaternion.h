@@ -0,0 +1,109 @@
+#pragma once
+
+#ifndef BLAZE_QUATERNION_H
+#define BLAZE_QUATERNION_H
+
+#include <Blaze/Core.h>
+#include <Blaze/Math/Vector.h>
+#include <Blaze/Math/Matrix.h>
+
+namespace Blaze
+{
+	// Rotation as a unit quaternion, w is the real part so it has the layout of a Vec4 (x, y, z, w)
+	struct Quat
+	{
+		float x, y, z, w;
+
+		Quat() = default;
+		constexpr Quat(float x, float y, float z, float w) :x(x), y(y), z(z), w(w) {}
+
+		static constexpr Quat Identity() { return { 0.0f, 0.0f, 0.0f, 1.0f }; }
+		// Right-handed rotation around a unit axis
+		static inline Quat FromAxisAngle(const Vec3& axis, float angle)
+		{
+			const float s = std::sin(angle * 0.5f);
+			return { axis.x * s, axis.y * s, axis.z * s, std::cos(angle * 0.5f) };
+		}
+
+		inline Vec4 ToVec4() const { return { x, y, z, w }; }
+		constexpr Vec3 GetXYZ() const { return { x, y, z }; }
+
+		// Applies rhs first, then this
+		constexpr Quat operator*(const Quat& rhs) const
+		{
+			return {
+				w * rhs.x + x * rhs.w + y * rhs.z - z * rhs.y,
+				w * rhs.y - x * rhs.z + y * rhs.w + z * rhs.x,
+				w * rhs.z + x * rhs.y - y * rhs.x + z * rhs.w,
+				w * rhs.w - x * rhs.x - y * rhs.y - z * rhs.z
+			};
+		}
+		inline Quat& operator*=(const Quat& rhs) { return *this = *this * rhs; }
+
+		// v + 2w(q x v) + 2q x (q x v), cheaper than building the matrix for a single vector
+		constexpr Vec3 Rotate(const Vec3& v) const
+		{
+			const Vec3 t = Cross(GetXYZ(), v) * 2.0f;
+			return v + t * w + Cross(GetXYZ(), t);
+		}
+
+		inline Mat4 ToMat4() const
+		{
+			const float xx = x * x, yy = y * y, zz = z * z;
+			const float xy = x * y, xz = x * z, yz = y * z;
+			const float wx = w * x, wy = w * y, wz = w * z;
+			return {
+				{ 1.0f - 2.0f * (yy + zz), 2.0f * (xy + wz), 2.0f * (xz - wy), 0.0f },
+				{ 2.0f * (xy - wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz + wx), 0.0f },
+				{ 2.0f * (xz + wy), 2.0f * (yz - wx), 1.0f - 2.0f * (xx + yy), 0.0f },
+				{ 0.0f, 0.0f, 0.0f, 1.0f }
+			};
+		}
+
+		constexpr bool operator==(const Quat& rhs) const { return (x == rhs.x) && (y == rhs.y) && (z == rhs.z) && (w == rhs.w); }
+		constexpr bool operator!=(const Quat& rhs) const { return !(*this == rhs); }
+	};
+
+	// The inverse of a unit quaternion
+	constexpr Quat Conjugate(const Quat& q) { return { -q.x, -q.y, -q.z, q.w }; }
+	inline float Dot(const Quat& a, const Quat& b) { return Dot(a.ToVec4(), b.ToVec4()); }
+	inline Quat Normalize(const Quat& q)
+	{
+		const Vec4 v = Normalize(q.ToVec4());
+		return { v.x, v.y, v.z, v.w };
+	}
+
+	// Interpolates along the shorter arc, falls back to a normalized lerp when the rotations are almost the same
+	inline Quat Slerp(const Quat& a, const Quat& b, float t)
+	{
+		float cosTheta = Dot(a, b);
+		const Vec4 end = (cosTheta < 0.0f) ? -b.ToVec4() : b.ToVec4();
+		cosTheta = std::abs(cosTheta);
+
+		Vec4 result;
+		if (cosTheta > 0.9995f)
+			result = Normalize(Lerp(a.ToVec4(), end, t));
+		else
+		{
+			const float theta = std::acos(cosTheta);
+			const float sinTheta = std::sin(theta);
+			result = a.ToVec4() * (std::sin((1.0f - t) * theta) / sinTheta) + end * (std::sin(t * theta) / sinTheta);
+		}
+		return { result.x, result.y, result.z, result.w };
+	}
+
+	// Scales, then rotates, then translates
+	inline Mat4 ComposeTransform(const Vec3& translation, const Quat& rotation, const Vec3& scale)
+	{
+		Mat4 m = rotation.ToMat4();
+		m.columns[0] *= scale.x;
+		m.columns[1] *= scale.y;
+		m.columns[2] *= scale.z;
+		m.columns[3] = { translation, 1.0f };
+		return m;
+	}
+
+	static_assert(sizeof(Quat) == sizeof(Vec4), "Quaternions must have the layout of a Vec4");
+}
+
+#endif // BLAZE_QUATERNION_H
@@ -0,0 +1,175 @@
+#pragma once
+
+#ifndef BLAZE_SIMD_H
+#define BLAZE_SIMD_H
+
+#include <Blaze/Core.h>
+
+#include <cmath>
+#include <algorithm>
+
+#if defined(BLAZE_SIMD_SSE2)
+#include <emmintrin.h>
+#if defined(BLAZE_SIMD_AVX) || defined(BLAZE_SIMD_FMA)
+#include <immintrin.h>
+#endif
+#elif defined(BLAZE_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace Blaze
+{
+	// Four floats in a SIMD register, the math types load into it for their operations and store back
+	// Without SSE2 or NEON the same functions work on a plain array
+	struct Float4
+	{
+#if defined(BLAZE_SIMD_SSE2)
+		__m128 value;
+#elif defined(BLAZE_SIMD_NEON)
+		float32x4_t value;
+#else // ^^^ BLAZE_SIMD_NEON / Scalar vvv
+		float value[4];
+#endif // ^^^ Scalar
+	};
+
+	// Loads and stores don't need any alignment, vertices in mapped memory are only aligned to 4 bytes
+	inline Float4 Load4(const float* src)
+	{
+#if defined(BLAZE_SIMD_SSE2)
+		return { _mm_loadu_ps(src) };
+#elif defined(BLAZE_SIMD_NEON)
+		return { vld1q_f32(src) };
+#else // ^^^ BLAZE_SIMD_NEON / Scalar vvv
+		return { { src[0], src[1], src[2], src[3] } };
+#endif // ^^^ Scalar
+	}
+
+	// Reads exactly 3 floats, w is w, so the last vertex of a buffer can be loaded without reading past it
+	inline Float4 Load3(const float* src, float w = 0.0f)
+	{
+#if defined(BLAZE_SIMD_SSE2)
+		const __m128 xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(src)));
+		const __m128 zw = _mm_unpacklo_ps(_mm_load_ss(src + 2), _mm_set_ss(w));
+		return { _mm_movelh_ps(xy, zw) };
+#elif defined(BLAZE_SIMD_NEON)
+		return { vcombine_f32(vld1_f32(src), vset_lane_f32(w, vld1_dup_f32(src + 2), 1)) };
+#else // ^^^ BLAZE_SIMD_NEON / Scalar vvv
+		return { { src[0], src[1], src[2], w } };
+#endif // ^^^ Scalar
+	}
+
+	inline void Store4(float* dst, Float4 v)
+	{
+#if defined(BLAZE_SIMD_SSE2)
+		_mm_storeu_ps(dst, v.value);
+#elif defined(BLAZE_SIMD_NEON)
+		vst1q_f32(dst, v.value);
+#else // ^^^ BLAZE_SIMD_NEON / Scalar vvv
+		for (int i = 0; i < 4; i++)
+			dst[i] = v.value[i];
+#endif // ^^^ Scalar
+	}
+
+	// Writes exactly 3 floats, see Load3
+	inline void Store3(float* dst, Float4 v)
+	{
+#if defined(BLAZE_SIMD_SSE2)
+		_mm_store_sd(reinterpret_cast<double*>(dst), _mm_castps_pd(v.value));
+		_mm_store_ss(dst + 2, _mm_movehl_ps(v.value, v.value));
+#elif defined(BLAZE_SIMD_NEON)
+		vst1_f32(dst, vget_low_f32(v.value));
+		vst1q_lane_f32(dst + 2, v.value, 2);
+#else // ^^^ BLAZE_SIMD_NEON / Scalar vvv
+		for (int i = 0; i < 3; i++)
+			dst[i] = v.value[i];
+#endif // ^^^ Scalar
+	}
+
+	inline Float4 Splat(float s)
+	{
+#if defined(BLAZE_SIMD_SSE2)
+		return { _mm_set1_ps(s) };
+#elif defined(BLAZE_SIMD_NEON)
+		return { vdupq_n_f32(s) };
+#else // ^^^ BLAZE_SIMD_NEON / Scalar vvv
+		return { { s, s, s, s } };
+#endif // ^^^ Scalar
+	}
+
+	// Lane 0 of the register
+	inline float GetX(Float4 v)
+	{
+#if defined(BLAZE_SIMD_SSE2)
+		return _mm_cvtss_f32(v.value);
+#elif defined(BLAZE_SIMD_NEON)
+		return vgetq_lane_f32(v.value, 0);
+#else // ^^^ BLAZE_SIMD_NEON / Scalar vvv
+		return v.value[0];
+#endif // ^^^ Scalar
+	}
+
+#if defined(BLAZE_SIMD_SSE2)
+#define BLAZE_FLOAT4_OP(name, sse, neon, op) inline Float4 name(Float4 a, Float4 b) { return { sse(a.value, b.value) }; }
+#elif defined(BLAZE_SIMD_NEON)
+#define BLAZE_FLOAT4_OP(name, sse, neon, op) inline Float4 name(Float4 a, Float4 b) { return { neon(a.value, b.value) }; }
+#else // ^^^ BLAZE_SIMD_NEON / Scalar vvv
+#define BLAZE_FLOAT4_OP(name, sse, neon, op) inline Float4 name(Float4 a, Float4 b) { return { { op(a.value[0], b.value[0]), op(a.value[1], b.value[1]), op(a.value[2], b.value[2]), op(a.value[3], b.value[3]) } }; }
+#endif // ^^^ Scalar
+
+	namespace Details
+	{
+		inline float AddScalar(float a, float b) { return a + b; }
+		inline float SubScalar(float a, float b) { return a - b; }
+		inline float MulScalar(float a, float b) { return a * b; }
+		inline float DivScalar(float a, float b) { return a / b; }
+		inline float MinScalar(float a, float b) { return std::min(a, b); }
+		inline float MaxScalar(float a, float b) { return std::max(a, b); }
+	}
+
+	BLAZE_FLOAT4_OP(operator+, _mm_add_ps, vaddq_f32, Details::AddScalar)
+	BLAZE_FLOAT4_OP(operator-, _mm_sub_ps, vsubq_f32, Details::SubScalar)
+	BLAZE_FLOAT4_OP(operator*, _mm_mul_ps, vmulq_f32, Details::MulScalar)
+	BLAZE_FLOAT4_OP(operator/, _mm_div_ps, vdivq_f32, Details::DivScalar)
+	BLAZE_FLOAT4_OP(Min, _mm_min_ps, vminq_f32, Details::MinScalar)
+	BLAZE_FLOAT4_OP(Max, _mm_max_ps, vmaxq_f32, Details::MaxScalar)
+
+#undef BLAZE_FLOAT4_OP
+
+	// a * b + c, fused where the instruction set has it
+	inline Float4 MulAdd(Float4 a, Float4 b, Float4 c)
+	{
+#if defined(BLAZE_SIMD_SSE2) && defined(BLAZE_SIMD_FMA)
+		return { _mm_fmadd_ps(a.value, b.value, c.value) };
+#elif defined(BLAZE_SIMD_NEON)
+		return { vfmaq_f32(c.value, a.value, b.value) };
+#else // ^^^ BLAZE_SIMD_NEON / Other vvv
+		return a * b + c;
+#endif // ^^^ Other
+	}
+
+	inline Float4 Abs(Float4 v)
+	{
+#if defined(BLAZE_SIMD_SSE2)
+		return { _mm_andnot_ps(_mm_set1_ps(-0.0f), v.value) };
+#elif defined(BLAZE_SIMD_NEON)
+		return { vabsq_f32(v.value) };
+#else // ^^^ BLAZE_SIMD_NEON / Scalar vvv
+		return { { std::abs(v.value[0]), std::abs(v.value[1]), std::abs(v.value[2]), std::abs(v.value[3]) } };
+#endif // ^^^ Scalar
+	}
+
+	// Sum of all four lanes
+	inline float HorizontalAdd(Float4 v)
+	{
+#if defined(BLAZE_SIMD_SSE2)
+		const __m128 sum = _mm_add_ps(v.value, _mm_movehl_ps(v.value, v.value));
+		return _mm_cvtss_f32(_mm_add_ss(sum, _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(1, 1, 1, 1))));
+#elif defined(BLAZE_SIMD_NEON)
+		return vaddvq_f32(v.value);
+#else // ^^^ BLAZE_SIMD_NEON / Scalar vvv
+		return (v.value[0] + v.value[1]) + (v.value[2] + v.value[3]);
+#endif // ^^^ Scalar
+	}
+}
+
+#endif // BLAZE_SIMD_H
@@ -0,0 +1,153 @@
+#pragma once
+
+#ifndef BLAZE_VECTOR_H
+#define BLAZE_VECTOR_H
+
+#include <Blaze/Core.h>
+#include <Blaze/Renderer/Format.h>
+#include <Blaze/Math/Simd.h>
+
+#include <type_traits>
+
+namespace Blaze
+{
+	// The vector types are plain floats without padding, so they have the layout of the R32 float formats
+	// and arrays of them can point straight into vertex data or mapped buffer memory
+	struct Vec2
+	{
+		float x, y;
+
+		Vec2() = default;
+		constexpr Vec2(float x, float y) :x(x), y(y) {}
+		constexpr explicit Vec2(float s) :x(s), y(s) {}
+
+		inline float* Data() { return &x; }
+		inline const float* Data() const { return &x; }
+
+		constexpr Vec2 operator-() const { return { -x, -y }; }
+		constexpr Vec2 operator+(const Vec2& rhs) const { return { x + rhs.x, y + rhs.y }; }
+		constexpr Vec2 operator-(const Vec2& rhs) const { return { x - rhs.x, y - rhs.y }; }
+		constexpr Vec2 operator*(const Vec2& rhs) const { return { x * rhs.x, y * rhs.y }; }
+		constexpr Vec2 operator/(const Vec2& rhs) const { return { x / rhs.x, y / rhs.y }; }
+		constexpr Vec2 operator*(float s) const { return { x * s, y * s }; }
+		constexpr Vec2 operator/(float s) const { return { x / s, y / s }; }
+		inline Vec2& operator+=(const Vec2& rhs) { return *this = *this + rhs; }
+		inline Vec2& operator-=(const Vec2& rhs) { return *this = *this - rhs; }
+		inline Vec2& operator*=(const Vec2& rhs) { return *this = *this * rhs; }
+		inline Vec2& operator*=(float s) { return *this = *this * s; }
+		inline Vec2& operator/=(float s) { return *this = *this / s; }
+
+		constexpr bool operator==(const Vec2& rhs) const { return (x == rhs.x) && (y == rhs.y); }
+		constexpr bool operator!=(const Vec2& rhs) const { return !(*this == rhs); }
+	};
+
+	// Three floats, operations stay scalar since a register would waste a lane and need extra loads for the 12 byte layout
+	// Batches of them go through the kernels in BatchTransform.h instead
+	struct Vec3
+	{
+		float x, y, z;
+
+		Vec3() = default;
+		constexpr Vec3(float x, float y, float z) :x(x), y(y), z(z) {}
+		constexpr explicit Vec3(float s) :x(s), y(s), z(s) {}
+
+		inline float* Data() { return &x; }
+		inline const float* Data() const { return &x; }
+
+		constexpr Vec3 operator-() const { return { -x, -y, -z }; }
+		constexpr Vec3 operator+(const Vec3& rhs) const { return { x + rhs.x, y + rhs.y, z + rhs.z }; }
+		constexpr Vec3 operator-(const Vec3& rhs) const { return { x - rhs.x, y - rhs.y, z - rhs.z }; }
+		constexpr Vec3 operator*(const Vec3& rhs) const { return { x * rhs.x, y * rhs.y, z * rhs.z }; }
+		constexpr Vec3 operator/(const Vec3& rhs) const { return { x / rhs.x, y / rhs.y, z / rhs.z }; }
+		constexpr Vec3 operator*(float s) const { return { x * s, y * s, z * s }; }
+		constexpr Vec3 operator/(float s) const { return { x / s, y / s, z / s }; }
+		inline Vec3& operator+=(const Vec3& rhs) { return *this = *this + rhs; }
+		inline Vec3& operator-=(const Vec3& rhs) { return *this = *this - rhs; }
+		inline Vec3& operator*=(const Vec3& rhs) { return *this = *this * rhs; }
+		inline Vec3& operator*=(float s) { return *this = *this * s; }
+		inline Vec3& operator/=(float s) { return *this = *this / s; }
+
+		constexpr bool operator==(const Vec3& rhs) const { return (x == rhs.x) && (y == rhs.y) && (z == rhs.z); }
+		constexpr bool operator!=(const Vec3& rhs) const { return !(*this == rhs); }
+	};
+
+	struct Vec4
+	{
+		float x, y, z, w;
+
+		Vec4() = default;
+		constexpr Vec4(float x, float y, float z, float w) :x(x), y(y), z(z), w(w) {}
+		constexpr Vec4(const Vec3& xyz, float w) :x(xyz.x), y(xyz.y), z(xyz.z), w(w) {}
+		constexpr explicit Vec4(float s) :x(s), y(s), z(s), w(s) {}
+		inline Vec4(Float4 v) { Store4(&x, v); }
+
+		inline float* Data() { return &x; }
+		inline const float* Data() const { return &x; }
+		inline Float4 Load() const { return Load4(&x); }
+		constexpr Vec3 GetXYZ() const { return { x, y, z }; }
+
+		inline Vec4 operator-() const { return Float4{} - Load(); }
+		inline Vec4 operator+(const Vec4& rhs) const { return Load() + rhs.Load(); }
+		inline Vec4 operator-(const Vec4& rhs) const { return Load() - rhs.Load(); }
+		inline Vec4 operator*(const Vec4& rhs) const { return Load() * rhs.Load(); }
+		inline Vec4 operator/(const Vec4& rhs) const { return Load() / rhs.Load(); }
+		inline Vec4 operator*(float s) const { return Load() * Splat(s); }
+		inline Vec4 operator/(float s) const { return Load() / Splat(s); }
+		inline Vec4& operator+=(const Vec4& rhs) { return *this = *this + rhs; }
+		inline Vec4& operator-=(const Vec4& rhs) { return *this = *this - rhs; }
+		inline Vec4& operator*=(const Vec4& rhs) { return *this = *this * rhs; }
+		inline Vec4& operator*=(float s) { return *this = *this * s; }
+		inline Vec4& operator/=(float s) { return *this = *this / s; }
+
+		constexpr bool operator==(const Vec4& rhs) const { return (x == rhs.x) && (y == rhs.y) && (z == rhs.z) && (w == rhs.w); }
+		constexpr bool operator!=(const Vec4& rhs) const { return !(*this == rhs); }
+	};
+
+	constexpr Vec2 operator*(float s, const Vec2& v) { return v * s; }
+	constexpr Vec3 operator*(float s, const Vec3& v) { return v * s; }
+	inline Vec4 operator*(float s, const Vec4& v) { return v * s; }
+
+	constexpr float Dot(const Vec2& a, const Vec2& b) { return a.x * b.x + a.y * b.y; }
+	constexpr float Dot(const Vec3& a, const Vec3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+	inline float Dot(const Vec4& a, const Vec4& b) { return HorizontalAdd(a.Load() * b.Load()); }
+
+	constexpr Vec3 Cross(const Vec3& a, const Vec3& b) { return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x }; }
+
+	template<typename T>
+	inline float LengthSquared(const T& v) { return Dot(v, v); }
+	template<typename T>
+	inline float Length(const T& v) { return std::sqrt(Dot(v, v)); }
+	// Zero vectors stay zero instead of turning into NaN
+	template<typename T>
+	inline T Normalize(const T& v)
+	{
+		const float length = Length(v);
+		return (length > 0.0f) ? v / length : v;
+	}
+	template<typename T>
+	inline T Lerp(const T& a, const T& b, float t) { return a + (b - a) * t; }
+
+	constexpr Vec2 Min(const Vec2& a, const Vec2& b) { return { a.x < b.x ? a.x : b.x, a.y < b.y ? a.y : b.y }; }
+	constexpr Vec2 Max(const Vec2& a, const Vec2& b) { return { a.x > b.x ? a.x : b.x, a.y > b.y ? a.y : b.y }; }
+	constexpr Vec3 Min(const Vec3& a, const Vec3& b) { return { a.x < b.x ? a.x : b.x, a.y < b.y ? a.y : b.y, a.z < b.z ? a.z : b.z }; }
+	constexpr Vec3 Max(const Vec3& a, const Vec3& b) { return { a.x > b.x ? a.x : b.x, a.y > b.y ? a.y : b.y, a.z > b.z ? a.z : b.z }; }
+	inline Vec4 Min(const Vec4& a, const Vec4& b) { return Min(a.Load(), b.Load()); }
+	inline Vec4 Max(const Vec4& a, const Vec4& b) { return Max(a.Load(), b.Load()); }
+
+	// Vertex format of a type, eg. format.PushAttribute({ VertexFormatOf<Vec3>::format }) for a Vec3 position
+	template<typename T>
+	struct VertexFormatOf;
+	template<>
+	struct VertexFormatOf<float> { static constexpr Format format = Format::R32_Float; };
+	template<>
+	struct VertexFormatOf<Vec2> { static constexpr Format format = Format::R32G32_Float; };
+	template<>
+	struct VertexFormatOf<Vec3> { static constexpr Format format = Format::R32G32B32_Float; };
+	template<>
+	struct VertexFormatOf<Vec4> { static constexpr Format format = Format::R32G32B32A32_Float; };
+
+	static_assert((sizeof(Vec2) == 2 * sizeof(float)) && (sizeof(Vec3) == 3 * sizeof(float)) && (sizeof(Vec4) == 4 * sizeof(float)), "Vectors must not be padded");
+	static_assert(std::is_trivially_copyable_v<Vec3> && std::is_trivially_default_constructible_v<Vec3>, "Vectors must be usable on raw vertex memory");
+}
+
+#endif // BLAZE_VECTOR_H
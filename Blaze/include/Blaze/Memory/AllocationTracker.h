@@ -0,0 +1,130 @@
+#pragma once
+
+#ifndef BLAZE_ALLOCATIONTRACKER_H
+#define BLAZE_ALLOCATIONTRACKER_H
+
+#include <Blaze/Core.h>
+
+#include <new>
+
+namespace Blaze
+{
+	// Subsystem an allocation is counted under, set for a thread with BLAZE_ALLOCATION_TAG
+	enum class AllocationTag
+	{
+		Null = 0,
+		Invalid = Null,
+		General,
+		Window,
+		Renderer,
+		IO,
+		Jobs,
+		Game,
+		NumTags = Game
+	};
+
+	struct AllocationCounts
+	{
+		uint64_t numAllocations = 0;
+		uint64_t numBytes = 0;
+	};
+
+	struct AllocationStats
+	{
+		// Allocations per tag in the last frame that ended and since tracking started, indexed by AllocationTag
+		std::array<AllocationCounts, static_cast<size_t>(AllocationTag::NumTags) + 1> lastFrame{};
+		std::array<AllocationCounts, static_cast<size_t>(AllocationTag::NumTags) + 1> total{};
+		// Frees can happen under another tag than their allocation, so live bytes are only tracked for all tags together
+		int64_t liveBytes = 0;
+		int64_t peakLiveBytes = 0;
+		// Allocations made in an allocation-free scope
+		uint64_t numViolations = 0;
+		// False unless the module's operator new is hooked up with BLAZE_ALLOCATION_HOOKS
+		bool isTracking = false;
+	};
+
+	// Called for every allocation in an allocation-free scope, allocations made by the handler itself aren't reported
+	using AllocationViolationHandler = void(*)(size_t size, AllocationTag tag);
+
+	// Counts the heap allocations that go through the hooked global operator new and delete
+	// Hooks are opt-in since replacing operator new is per module, see BLAZE_ALLOCATION_HOOKS
+	class BLAZE_API AllocationTracker
+	{
+	public:
+		// Used by the hooks, memory comes from the C runtime heap so tracked and untracked pointers can be mixed
+		static void* Allocate(size_t size);
+		static void* AllocateAligned(size_t size, size_t alignment);
+		static void Free(void* ptr);
+		static void FreeAligned(void* ptr, size_t alignment);
+
+		// Starts a new frame for the per-frame counts, called once per frame by the game loop
+		static void NextFrame();
+		static AllocationStats GetStats();
+
+		// The default handler writes the violation to the console and breaks into an attached debugger in debug builds
+		static void SetViolationHandler(AllocationViolationHandler handler);
+
+		static AllocationTag GetThreadTag();
+		static void SetThreadTag(AllocationTag tag);
+
+		// Allocation-free scopes nest, any allocation on the thread while one is open is a violation
+		static void BeginAllocationFree();
+		static void EndAllocationFree();
+	};
+
+	// Counts the thread's allocations under a tag for its lifetime, BLAZE_ALLOCATION_TAG is meant to be used instead
+	class AllocationTagScope
+	{
+	public:
+		inline AllocationTagScope(AllocationTag tag) :m_previousTag(AllocationTracker::GetThreadTag()) { AllocationTracker::SetThreadTag(tag); }
+		inline ~AllocationTagScope() { AllocationTracker::SetThreadTag(m_previousTag); }
+
+		AllocationTagScope(const AllocationTagScope&) = delete;
+		AllocationTagScope& operator=(const AllocationTagScope&) = delete;
+	private:
+		AllocationTag m_previousTag;
+	};
+
+	// Reports every heap allocation on the thread during its lifetime as a violation
+	class AllocationFreeScope
+	{
+	public:
+		inline AllocationFreeScope() { AllocationTracker::BeginAllocationFree(); }
+		inline ~AllocationFreeScope() { AllocationTracker::EndAllocationFree(); }
+
+		AllocationFreeScope(const AllocationFreeScope&) = delete;
+		AllocationFreeScope& operator=(const AllocationFreeScope&) = delete;
+	};
+}
+
+#define BLAZE_ALLOCATION_CONCAT_IMPL(a, b) a##b
+#define BLAZE_ALLOCATION_CONCAT(a, b) BLAZE_ALLOCATION_CONCAT_IMPL(a, b)
+
+// Counts the thread's allocations in the rest of the enclosing block under tag
+#define BLAZE_ALLOCATION_TAG(tag) ::Blaze::AllocationTagScope BLAZE_ALLOCATION_CONCAT(blazeAllocationTag, __LINE__){ tag }
+
+// Replaces the global operator new and delete of a module with tracked ones, put it in one source file of the module
+// Blaze itself uses it when built with BLAZE_TRACK_ALLOCATIONS, the game's executable has to use it to be tracked as well
+#define BLAZE_ALLOCATION_HOOKS \
+	void* operator new(size_t size) { if (void* ptr = ::Blaze::AllocationTracker::Allocate(size)) return ptr; throw std::bad_alloc(); } \
+	void* operator new[](size_t size) { if (void* ptr = ::Blaze::AllocationTracker::Allocate(size)) return ptr; throw std::bad_alloc(); } \
+	void* operator new(size_t size, const std::nothrow_t&) noexcept { return ::Blaze::AllocationTracker::Allocate(size); } \
+	void* operator new[](size_t size, const std::nothrow_t&) noexcept { return ::Blaze::AllocationTracker::Allocate(size); } \
+	void* operator new(size_t size, std::align_val_t alignment) { if (void* ptr = ::Blaze::AllocationTracker::AllocateAligned(size, static_cast<size_t>(alignment))) return ptr; throw std::bad_alloc(); } \
+	void* operator new[](size_t size, std::align_val_t alignment) { if (void* ptr = ::Blaze::AllocationTracker::AllocateAligned(size, static_cast<size_t>(alignment))) return ptr; throw std::bad_alloc(); } \
+	void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return ::Blaze::AllocationTracker::AllocateAligned(size, static_cast<size_t>(alignment)); } \
+	void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return ::Blaze::AllocationTracker::AllocateAligned(size, static_cast<size_t>(alignment)); } \
+	void operator delete(void* ptr) noexcept { ::Blaze::AllocationTracker::Free(ptr); } \
+	void operator delete[](void* ptr) noexcept { ::Blaze::AllocationTracker::Free(ptr); } \
+	void operator delete(void* ptr, size_t) noexcept { ::Blaze::AllocationTracker::Free(ptr); } \
+	void operator delete[](void* ptr, size_t) noexcept { ::Blaze::AllocationTracker::Free(ptr); } \
+	void operator delete(void* ptr, const std::nothrow_t&) noexcept { ::Blaze::AllocationTracker::Free(ptr); } \
+	void operator delete[](void* ptr, const std::nothrow_t&) noexcept { ::Blaze::AllocationTracker::Free(ptr); } \
+	void operator delete(void* ptr, std::align_val_t alignment) noexcept { ::Blaze::AllocationTracker::FreeAligned(ptr, static_cast<size_t>(alignment)); } \
+	void operator delete[](void* ptr, std::align_val_t alignment) noexcept { ::Blaze::AllocationTracker::FreeAligned(ptr, static_cast<size_t>(alignment)); } \
+	void operator delete(void* ptr, size_t, std::align_val_t alignment) noexcept { ::Blaze::AllocationTracker::FreeAligned(ptr, static_cast<size_t>(alignment)); } \
+	void operator delete[](void* ptr, size_t, std::align_val_t alignment) noexcept { ::Blaze::AllocationTracker::FreeAligned(ptr, static_cast<size_t>(alignment)); } \
+	void operator delete(void* ptr, std::align_val_t alignment, const std::nothrow_t&) noexcept { ::Blaze::AllocationTracker::FreeAligned(ptr, static_cast<size_t>(alignment)); } \
+	void operator delete[](void* ptr, std::align_val_t alignment, const std::nothrow_t&) noexcept { ::Blaze::AllocationTracker::FreeAligned(ptr, static_cast<size_t>(alignment)); }
+
+#endif // BLAZE_ALLOCATIONTRACKER_H
@@ -0,0 +1,184 @@
+#pragma once
+
+#ifndef BLAZE_ARENA_H
+#define BLAZE_ARENA_H
+
+#include <Blaze/Core.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+
+namespace Blaze
+{
+	// Frames whose transient memory can be alive at once, one being built plus the ones the GPU may still read
+	constexpr uint32_t maxFramesInFlight = 3;
+	// Size of every thread's scratch arena
+	constexpr size_t threadScratchSize = 1024 * 1024;
+
+	namespace Details
+	{
+		inline uintptr_t AlignUp(uintptr_t address, size_t alignment) { return (address + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1); }
+	}
+
+	// Bump allocator over one block of memory, everything is released at once by rewinding it
+	// Not thread safe, see FrameArena for memory shared by threads
+	class BLAZE_API LinearArena
+	{
+	public:
+		// Position in the arena, rewinding to it releases everything allocated after it was taken
+		using Marker = size_t;
+
+		LinearArena() = default;
+		explicit LinearArena(size_t capacity);
+		~LinearArena();
+
+		LinearArena(const LinearArena&) = delete;
+		LinearArena& operator=(const LinearArena&) = delete;
+
+		// Returns nullptr when the arena is full, alignment must be a power of two
+		inline void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t))
+		{
+			const uintptr_t base = reinterpret_cast<uintptr_t>(m_memory);
+			const size_t offset = static_cast<size_t>(Details::AlignUp(base + m_offset, alignment) - base);
+			if ((offset > m_capacity) || (size > m_capacity - offset))
+			{
+				m_numFailedAllocations++;
+				return nullptr;
+			}
+
+			m_offset = offset + size;
+			m_peakUsed = std::max(m_peakUsed, m_offset);
+			return m_memory + offset;
+		}
+
+		template<typename T>
+		inline T* Allocate(size_t count = 1)
+		{
+			if (count > SIZE_MAX / sizeof(T))
+				return nullptr;
+			return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+		}
+
+		// Gives the memory back only if it was the last allocation, which makes growing the last container cheap
+		inline void Deallocate(void* ptr, size_t size)
+		{
+			if (static_cast<uint8_t*>(ptr) + size == m_memory + m_offset)
+				m_offset = static_cast<size_t>(static_cast<uint8_t*>(ptr) - m_memory);
+		}
+
+		inline Marker GetMarker() const { return m_offset; }
+		inline void Rewind(Marker marker) { m_offset = marker; }
+		inline void Reset() { m_offset = 0; }
+
+		inline bool Owns(const void* ptr) const { return (ptr >= m_memory) && (ptr < m_memory + m_capacity); }
+
+		inline size_t GetCapacity() const { return m_capacity; }
+		inline size_t GetUsed() const { return m_offset; }
+		inline size_t GetPeakUsed() const { return m_peakUsed; }
+		inline uint64_t GetNumFailedAllocations() const { return m_numFailedAllocations; }
+	private:
+		uint8_t* m_memory = nullptr;
+		size_t m_capacity = 0;
+		size_t m_offset = 0;
+		size_t m_peakUsed = 0;
+		uint64_t m_numFailedAllocations = 0;
+	};
+
+	struct FrameArenaStats
+	{
+		size_t capacityPerFrame = 0;
+		size_t usedThisFrame = 0;
+		// Most any frame used so far, capacityPerFrame can be tuned to it
+		size_t peakUsed = 0;
+		uint64_t numFailedAllocations = 0;
+	};
+
+	// Transient memory for one frame, allocations are never freed on their own
+	// Each frame in flight has its own block, a block is reused numFramesInFlight frames later
+	class BLAZE_API FrameArena
+	{
+	public:
+		FrameArena() = default;
+		FrameArena(size_t capacityPerFrame, uint32_t numFramesInFlight = 2);
+		~FrameArena();
+
+		FrameArena(const FrameArena&) = delete;
+		FrameArena& operator=(const FrameArena&) = delete;
+
+		// Moves to the next frame's block and releases what was allocated in it numFramesInFlight frames ago
+		// Nothing may allocate during the call, and the caller makes sure the old frame is done (eg. fenced on the GPU)
+		void BeginFrame();
+
+		// Thread safe and lock free, returns nullptr when the frame's block is full
+		inline void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t))
+		{
+			const uintptr_t base = reinterpret_cast<uintptr_t>(m_frameMemory);
+			size_t offset = m_offset.load(std::memory_order_relaxed);
+			size_t alignedOffset;
+			do
+			{
+				alignedOffset = static_cast<size_t>(Details::AlignUp(base + offset, alignment) - base);
+				if ((alignedOffset > m_capacityPerFrame) || (size > m_capacityPerFrame - alignedOffset))
+				{
+					m_numFailedAllocations.fetch_add(1, std::memory_order_relaxed);
+					return nullptr;
+				}
+			} while (!m_offset.compare_exchange_weak(offset, alignedOffset + size, std::memory_order_relaxed));
+
+			return m_frameMemory + alignedOffset;
+		}
+
+		template<typename T>
+		inline T* Allocate(size_t count = 1)
+		{
+			if (count > SIZE_MAX / sizeof(T))
+				return nullptr;
+			return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+		}
+
+		// Frame memory is only released by BeginFrame
+		inline void Deallocate(void* ptr, size_t size) { (void)ptr; (void)size; }
+
+		inline bool Owns(const void* ptr) const { return (ptr >= m_memory) && (ptr < m_memory + m_capacityPerFrame * m_numFramesInFlight); }
+		inline uint32_t GetNumFramesInFlight() const { return m_numFramesInFlight; }
+
+		FrameArenaStats GetStats() const;
+	private:
+		uint8_t* m_memory = nullptr;
+		size_t m_capacityPerFrame = 0;
+		uint32_t m_numFramesInFlight = 0;
+		uint32_t m_frameIndex = 0;
+
+		uint8_t* m_frameMemory = nullptr;
+		std::atomic<size_t> m_offset{ 0 };
+		size_t m_peakUsed = 0;
+		std::atomic<uint64_t> m_numFailedAllocations{ 0 };
+	};
+
+	// The calling thread's scratch arena, created the first time a thread asks for it
+	BLAZE_API LinearArena& GetThreadScratchArena();
+
+	// Temporary allocations on the thread's scratch arena, released when the scope ends
+	// Scopes nest like a stack, a job can't keep one across JobSystem::Wait since it may continue on another thread
+	class ScratchScope
+	{
+	public:
+		inline ScratchScope() :m_arena(GetThreadScratchArena()), m_marker(m_arena.GetMarker()) {}
+		inline ~ScratchScope() { m_arena.Rewind(m_marker); }
+
+		ScratchScope(const ScratchScope&) = delete;
+		ScratchScope& operator=(const ScratchScope&) = delete;
+
+		inline void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t)) { return m_arena.Allocate(size, alignment); }
+		template<typename T>
+		inline T* Allocate(size_t count = 1) { return m_arena.Allocate<T>(count); }
+
+		inline LinearArena& GetArena() { return m_arena; }
+	private:
+		LinearArena& m_arena;
+		LinearArena::Marker m_marker;
+	};
+}
+
+#endif // BLAZE_ARENA_H
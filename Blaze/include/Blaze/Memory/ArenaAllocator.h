@@ -0,0 +1,63 @@
+#pragma once
+
+#ifndef BLAZE_ARENAALLOCATOR_H
+#define BLAZE_ARENAALLOCATOR_H
+
+#include <Blaze/Memory/Arena.h>
+
+#include <new>
+
+namespace Blaze
+{
+	// Lets standard containers allocate from a LinearArena or FrameArena
+	// When the arena is full it falls back to the heap so the container keeps working, the arena counts it as a failed allocation
+	template<typename T, typename Arena>
+	class ArenaAllocator
+	{
+	public:
+		using value_type = T;
+
+		inline ArenaAllocator(Arena& arena) noexcept :m_arena(&arena) {}
+		template<typename U>
+		inline ArenaAllocator(const ArenaAllocator<U, Arena>& other) noexcept :m_arena(other.GetArena()) {}
+
+		inline T* allocate(size_t count)
+		{
+			if (T* ptr = m_arena->template Allocate<T>(count))
+				return ptr;
+			// Plain operator new only guarantees __STDCPP_DEFAULT_NEW_ALIGNMENT__
+			if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+				return static_cast<T*>(::operator new(sizeof(T) * count, std::align_val_t{ alignof(T) }));
+			else
+				return static_cast<T*>(::operator new(sizeof(T) * count));
+		}
+
+		inline void deallocate(T* ptr, size_t count) noexcept
+		{
+			if (m_arena->Owns(ptr))
+				m_arena->Deallocate(ptr, sizeof(T) * count);
+			else if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+				::operator delete(ptr, std::align_val_t{ alignof(T) });
+			else
+				::operator delete(ptr);
+		}
+
+		inline Arena* GetArena() const noexcept { return m_arena; }
+
+		template<typename U>
+		inline bool operator==(const ArenaAllocator<U, Arena>& rhs) const noexcept { return m_arena == rhs.GetArena(); }
+		template<typename U>
+		inline bool operator!=(const ArenaAllocator<U, Arena>& rhs) const noexcept { return m_arena != rhs.GetArena(); }
+	private:
+		Arena* m_arena;
+	};
+
+	// Vector that lives until the frame arena moves past its frame, never destroy one after that
+	template<typename T>
+	using FrameVector = std::vector<T, ArenaAllocator<T, FrameArena>>;
+	// Vector on a scratch arena, usually the one of a ScratchScope
+	template<typename T>
+	using ScratchVector = std::vector<T, ArenaAllocator<T, LinearArena>>;
+}
+
+#endif // BLAZE_ARENAALLOCATOR_H
@@ -0,0 +1,93 @@
+#pragma once
+
+#ifndef BLAZE_MESHCODEC_H
+#define BLAZE_MESHCODEC_H
+
+#include <Blaze/Core.h>
+#include <Blaze/Renderer/Format.h>
+#include <Blaze/Renderer/Buffer.h>
+
+namespace Blaze
+{
+	enum class QuantizationType
+	{
+		Null = 0,
+		Invalid = Null,
+		Float,		// Kept as 32-bit floats
+		UNorm16,	// Remapped from the attribute's bounds to [0, 1], for positions and texture coordinates
+		SNorm16,	// Stored as is, the source has to be in [-1, 1] (eg. normals and tangents)
+		UNorm8,
+		SNorm8
+	};
+
+	struct AttributeQuantization
+	{
+		// Byte offset of the attribute in a source vertex, source attributes are 32-bit floats
+		uint32_t offset;
+		// Number of floats, 1 to 4
+		uint32_t components;
+		QuantizationType type;
+	};
+
+	// Recovers the source value in the shader, value = attribute * scale + bias
+	struct DequantizeTransform
+	{
+		float scale[4];
+		float bias[4];
+	};
+
+	struct QuantizedVertices
+	{
+		std::vector<uint8_t> vertices;
+		// Interleaved attributes in binding 0, each attribute is padded to a multiple of 4 bytes
+		VertexFormat format;
+		// One per attribute
+		std::vector<DequantizeTransform> transforms;
+		uint32_t vertexSize = 0;
+		uint32_t vertexCount = 0;
+	};
+
+	// Describes a compressed mesh without decoding it
+	struct CompressedMeshInfo
+	{
+		VertexFormat format;
+		std::vector<DequantizeTransform> transforms;
+		uint32_t vertexSize = 0;
+		uint32_t vertexCount = 0;
+		uint32_t indexCount = 0;
+		// Format the indices decode to (R16_UInt or R32_UInt)
+		Format indexFormat = Format::R32_UInt;
+		// Decoded sizes, the sizes to create the vertex and index buffers with
+		size_t vertexBufferSize = 0;
+		size_t indexBufferSize = 0;
+	};
+
+	// Quantizes float vertices into the smallest representation of each attribute
+	BLAZE_API Result QuantizeVertices(QuantizedVertices& quantized, const void* vertices, size_t vertexCount, size_t vertexStride,
+		const AttributeQuantization* attributes, size_t numAttributes);
+
+	// Gets the maximum size EncodeVertexBuffer can write
+	BLAZE_API size_t GetVertexBufferEncodeBound(size_t vertexCount, size_t vertexSize);
+	// Compresses vertices with byte-wise deltas between neighbouring vertices, returns the size written or 0 if dst is too small
+	// Works best on quantized vertices in vertex fetch order (see OptimizeVertexFetch)
+	BLAZE_API size_t EncodeVertexBuffer(uint8_t* dst, size_t dstSize, const void* vertices, size_t vertexCount, size_t vertexSize);
+	// Decodes vertices written by EncodeVertexBuffer, dst may be mapped buffer memory
+	BLAZE_API Result DecodeVertexBuffer(void* dst, size_t vertexCount, size_t vertexSize, const uint8_t* src, size_t srcSize);
+
+	// Gets the maximum size EncodeIndexBuffer can write
+	BLAZE_API size_t GetIndexBufferEncodeBound(size_t indexCount);
+	// Compresses indices as zigzagged deltas in a variable number of bytes, returns the size written or 0 if dst is too small
+	BLAZE_API size_t EncodeIndexBuffer(uint8_t* dst, size_t dstSize, const uint32_t* indices, size_t indexCount);
+	// Decodes indices written by EncodeIndexBuffer to 16 or 32-bit indices, dst may be mapped buffer memory
+	BLAZE_API Result DecodeIndexBuffer(void* dst, Format indexFormat, size_t indexCount, const uint8_t* src, size_t srcSize);
+
+	// Writes quantized vertices and their indices to a single compressed blob
+	BLAZE_API Result CompressMesh(std::vector<uint8_t>& compressed, const QuantizedVertices& vertices, const uint32_t* indices, size_t indexCount);
+	// Reads the header of a compressed mesh
+	BLAZE_API Result GetCompressedMeshInfo(const void* compressed, size_t size, CompressedMeshInfo& info);
+	// Decodes a compressed mesh into the memory of the buffers, the buffers get resized to CompressedMeshInfo::vertexBufferSize and indexBufferSize
+	// The index buffer has to be created with CompressedMeshInfo::indexFormat
+	BLAZE_API Result DecompressMesh(const void* compressed, size_t size, const Ref<Buffer>& vertexBuffer, const Ref<Buffer>& indexBuffer);
+}
+
+#endif // BLAZE_MESHCODEC_H
@@ -0,0 +1,65 @@
+#pragma once
+
+#ifndef BLAZE_MESHOPTIMIZER_H
+#define BLAZE_MESHOPTIMIZER_H
+
+#include <Blaze/Core.h>
+#include <Blaze/Renderer/Format.h>
+
+namespace Blaze
+{
+	// Post-transform vertex cache statistics of an index buffer
+	struct VertexCacheStats
+	{
+		// Average cache miss ratio, transformed vertices per triangle (0.5 is ideal for large grids, 3 is the worst)
+		float acmr = 0.0f;
+		// Average transform to vertex ratio, transformed vertices per vertex (1 is ideal)
+		float atvr = 0.0f;
+		uint32_t numTransformedVertices = 0;
+	};
+
+	// Mesh data for OptimizeMesh, indices are triangle lists
+	struct MeshData
+	{
+		std::vector<uint8_t> vertices;
+		std::vector<uint32_t> indices;
+		uint32_t vertexSize = 0;
+		// Offset of the R32G32B32_Float position in a vertex, used for overdraw optimization
+		uint32_t positionOffset = 0;
+	};
+
+	struct MeshOptimizeStats
+	{
+		VertexCacheStats before;
+		VertexCacheStats after;
+		// Smallest index format that can index every vertex
+		Format indexFormat = Format::R32_UInt;
+	};
+
+	// Simulates a FIFO post-transform cache of cacheSize entries
+	BLAZE_API VertexCacheStats AnalyzeVertexCache(const uint32_t* indices, size_t indexCount, size_t vertexCount, uint32_t cacheSize = 16);
+
+	// Reorders triangles for post-transform cache locality (Forsyth's linear-speed algorithm)
+	// dstIndices may be the same as indices
+	BLAZE_API Result OptimizeVertexCache(uint32_t* dstIndices, const uint32_t* indices, size_t indexCount, size_t vertexCount);
+
+	// Reorders clusters of a cache optimized index buffer so outward facing clusters are drawn first, reducing overdraw
+	// The order is kept if the ACMR would get worse than threshold times the input ACMR
+	// dstIndices may not be the same as indices
+	BLAZE_API Result OptimizeOverdraw(uint32_t* dstIndices, const uint32_t* indices, size_t indexCount, const float* positions, size_t vertexCount, size_t positionStride, float threshold = 1.05f);
+
+	// Reorders vertices in the order they are first used and remaps the indices in place, unused vertices are removed
+	// dstVertices must hold vertexCount vertices and may not be the same as vertices, the new vertex count is stored in uniqueVertexCount
+	BLAZE_API Result OptimizeVertexFetch(void* dstVertices, uint32_t* indices, size_t indexCount, const void* vertices, size_t vertexCount, size_t vertexSize, size_t& uniqueVertexCount);
+
+	// Gets the smallest index format (R16_UInt or R32_UInt) that can index vertexCount vertices
+	BLAZE_API Format SelectIndexFormat(size_t vertexCount);
+
+	// Converts 32 bit indices to indexFormat, dst must hold indexCount indices of that format
+	BLAZE_API Result PackIndices(void* dst, Format indexFormat, const uint32_t* indices, size_t indexCount);
+
+	// Runs the vertex cache, overdraw and vertex fetch optimizations and reports the ACMR before and after
+	BLAZE_API Result OptimizeMesh(MeshData& mesh, MeshOptimizeStats* stats = nullptr);
+}
+
+#endif // BLAZE_MESHOPTIMIZER_H
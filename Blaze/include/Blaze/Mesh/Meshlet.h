@@ -0,0 +1,86 @@
+#pragma once
+
+#ifndef BLAZE_MESHLET_H
+#define BLAZE_MESHLET_H
+
+#include <Blaze/Core.h>
+#include <Blaze/Renderer/Format.h>
+#include <Blaze/Renderer/Buffer.h>
+
+namespace Blaze
+{
+	// Default meshlet limits, 64 vertices and 124 triangles keep the local index data of a meshlet at 372 bytes
+	constexpr uint32_t defaultMeshletMaxVertices = 64;
+	constexpr uint32_t defaultMeshletMaxTriangles = 124;
+
+	struct Meshlet
+	{
+		// Offset into MeshletData::vertices
+		uint32_t vertexOffset;
+		// Offset into MeshletData::triangles, in bytes (3 per triangle)
+		uint32_t triangleOffset;
+		uint32_t vertexCount;
+		uint32_t triangleCount;
+	};
+
+	struct MeshletBounds
+	{
+		// Bounding sphere
+		float center[3];
+		float radius;
+		// Normal cone, a cutoff of 1 means the cone is too wide to ever be back-facing
+		float coneAxis[3];
+		float coneCutoff;
+	};
+
+	struct MeshletData
+	{
+		std::vector<Meshlet> meshlets;
+		std::vector<MeshletBounds> bounds;
+		// Global vertex indices used by each meshlet
+		std::vector<uint32_t> vertices;
+		// Meshlet local triangle indices, index into the meshlet's range of vertices
+		std::vector<uint8_t> triangles;
+		// Bounds in groups of 4 meshlets (center x/y/z, radius, cone axis x/y/z, cone cutoff; 4 floats each) for SIMD culling
+		std::vector<float> cullData;
+		// Smallest index format that can index the source vertices
+		Format indexFormat = Format::R32_UInt;
+	};
+
+	struct MeshletCullParams
+	{
+		// Frustum planes (a, b, c, d) with normals pointing inwards, a point is inside if ax + by + cz + d >= 0
+		float frustumPlanes[6][4];
+		float cameraPosition[3];
+		bool isConeCullingEnabled = true;
+	};
+
+	// Reused every frame so culling doesn't allocate once the vectors have grown
+	struct MeshletCullOutput
+	{
+		std::vector<uint32_t> visibleMeshlets;
+		// Indices of the visible meshlets in MeshletData::indexFormat
+		std::vector<uint8_t> indices;
+		uint32_t indexCount = 0;
+	};
+
+	// Splits a triangle list into meshlets, the index order is kept so indices should be vertex cache optimized first
+	BLAZE_API Result BuildMeshlets(MeshletData& meshletData, const uint32_t* indices, size_t indexCount, const float* positions, size_t vertexCount, size_t positionStride,
+		uint32_t maxVertices = defaultMeshletMaxVertices, uint32_t maxTriangles = defaultMeshletMaxTriangles);
+
+	// Extracts normalized frustum planes from a column-major (OpenGL convention) view projection matrix
+	BLAZE_API void ExtractFrustumPlanes(const float viewProjection[16], float frustumPlanes[6][4]);
+
+	// Rejects meshlets outside the frustum or facing away from the camera, and writes the indices of the remaining meshlets to output
+	BLAZE_API Result CullMeshlets(const MeshletData& meshletData, const MeshletCullParams& params, MeshletCullOutput& output);
+
+	// Uploads the culled indices to an index buffer created with MeshletData::indexFormat, draw with DrawIndexed(output.indexCount)
+	inline Result WriteCulledIndices(const MeshletCullOutput& output, const Ref<Buffer>& indexBuffer)
+	{
+		if (!indexBuffer)
+			return Result::InvalidParam;
+		return indexBuffer->Write(output.indices.data(), output.indices.size());
+	}
+}
+
+#endif // BLAZE_MESHLET_H
@@ -99,7 +99,7 @@ namespace Blaze
 
 		Ref<Window> m_window;
 		std::bitset<5> m_buttons;
-		int32_t m_posX, m_posY;
+		int32_t m_posX = 0, m_posY = 0;
 	};
 }
 
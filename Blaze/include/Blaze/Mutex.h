@@ -0,0 +1,88 @@
+#pragma once
+
+#ifndef BLAZE_MUTEX_H
+#define BLAZE_MUTEX_H
+
+#include <Blaze/Core.h>
+#include <Blaze/Profiling/Profiler.h>
+
+#include <atomic>
+#include <iosfwd>
+#include <mutex>
+#include <thread>
+
+namespace Blaze
+{
+	// Contended waits are counted in power of two buckets of nanoseconds, the first is everything under 256ns and the last everything over 4ms
+	constexpr uint32_t mutexWaitBuckets = 16;
+
+	struct MutexStats
+	{
+		const char* name = nullptr;
+		uint64_t numAcquires = 0;
+		// Acquires that had to wait for another thread
+		uint64_t numContended = 0;
+		// Nanoseconds spent waiting in total and at most
+		uint64_t totalWaitTime = 0;
+		uint64_t maxWaitTime = 0;
+		std::array<uint64_t, mutexWaitBuckets> waitHistogram{};
+		// Longest time the lock was held in nanoseconds and the thread that held it
+		uint64_t maxHoldTime = 0;
+		std::thread::id longestHolder;
+	};
+
+	// Drop in for std::mutex that records how contended it is, works with std::lock_guard and std::unique_lock
+	// Without BLAZE_PROFILER it's a bare std::mutex, Blaze and the game have to agree on the define
+	class BLAZE_API Mutex
+	{
+	public:
+#ifdef BLAZE_PROFILER
+		// name must outlive the mutex, usually a string literal
+		Mutex(const char* name = "Unnamed");
+		~Mutex();
+
+		void lock();
+		bool try_lock();
+		void unlock();
+
+		MutexStats GetStats() const;
+		// Stats of every mutex alive
+		static std::vector<MutexStats> GetAllStats();
+#else // ^^^ BLAZE_PROFILER / !BLAZE_PROFILER vvv
+		inline Mutex(const char* name = "Unnamed") { (void)name; }
+
+		inline void lock() { m_mutex.lock(); }
+		inline bool try_lock() { return m_mutex.try_lock(); }
+		inline void unlock() { m_mutex.unlock(); }
+
+		inline MutexStats GetStats() const { return MutexStats{}; }
+		static inline std::vector<MutexStats> GetAllStats() { return {}; }
+#endif // ^^^ !BLAZE_PROFILER
+
+		Mutex(const Mutex&) = delete;
+		Mutex& operator=(const Mutex&) = delete;
+
+		// Writes every mutex alive, the ones that were waited on longest first
+		static void WriteReport(std::ostream& stream);
+	private:
+		std::mutex m_mutex;
+
+#ifdef BLAZE_PROFILER
+		void RecordAcquire(uint64_t waitTime, bool isContended);
+
+		const char* m_name;
+		std::atomic<uint64_t> m_numAcquires{ 0 };
+		std::atomic<uint64_t> m_numContended{ 0 };
+		std::atomic<uint64_t> m_totalWaitTime{ 0 };
+		std::atomic<uint64_t> m_maxWaitTime{ 0 };
+		std::array<std::atomic<uint64_t>, mutexWaitBuckets> m_waitHistogram{};
+
+		// Only written by the thread holding the lock
+		uint64_t m_holdStart = 0;
+		std::atomic<uint64_t> m_maxHoldTime{ 0 };
+		std::atomic<std::thread::id> m_longestHolder;
+#endif // BLAZE_PROFILER
+	};
+}
+
+#endif // BLAZE_MUTEX_H
@@ -15,9 +15,11 @@ namespace Blaze
 	using ClassID = uint32_t;
 	class Object;
 
+#if defined(_WIN32)
 	// Work around or dll-interface warnings
 	BLAZE_STL_EXTERN template class BLAZE_API std::weak_ptr<Object>;
 	BLAZE_STL_EXTERN template class BLAZE_API std::enable_shared_from_this<Object>;
+#endif // _WIN32
 
 	namespace Details
 	{
@@ -28,7 +30,12 @@ namespace Blaze
 			Object = 0x0010,
 			Window = 0x0020,
 			DeviceContext = 0x0030,
-			Buffer = 0x0040
+			Buffer = 0x0040,
+			InstanceBatcher = 0x0050,
+			Package = 0x0060,
+			AsyncIO = 0x0070,
+			FileSystem = 0x0080,
+			JobSystem = 0x0090
 		};
 
 		enum class ImplementationID : uint16_t
@@ -39,6 +46,10 @@ namespace Blaze
 			Win32,
 			OpenGL,
 			WGL,
+			Posix,
+			IOUring,
+			Headless,
+			NumImplementations = Headless
 		};
 
 		// Makes a class ID
@@ -51,6 +62,8 @@ namespace Blaze
 		BLAZE_API uint32_t CreateObjectID(Object* object);
 		// Destroys and unregisters a new object ID
 		BLAZE_API void DestroyObjectID(uint32_t objectID);
+		// Tells the resource census the class of an object, which is only known once the most derived constructor ran
+		BLAZE_API void SetObjectClass(uint32_t objectID, ClassID classID);
 	}
 
 	// A base structure for all blaze create info structures
@@ -67,7 +80,11 @@ namespace Blaze
 		inline virtual ~Object() { Details::DestroyObjectID(m_objectID); }
 
 		// Creates the object
-		inline Result Create(const ObjectCreateInfo& createInfo) { return Create_Impl(createInfo); }
+		inline Result Create(const ObjectCreateInfo& createInfo)
+		{
+			Details::SetObjectClass(m_objectID, classID);
+			return Create_Impl(createInfo);
+		}
 		// Destroys the object
 		inline Result Destroy() { return Destroy_Impl(); }
 
@@ -0,0 +1,100 @@
+#pragma once
+
+#ifndef BLAZE_FLIGHTRECORDER_H
+#define BLAZE_FLIGHTRECORDER_H
+
+#include <Blaze/Core.h>
+#include <Blaze/Profiling/Profiler.h>
+
+#include <string_view>
+
+namespace Blaze
+{
+	// Frames the flight recorder remembers, a few seconds at usual frame rates
+	constexpr uint32_t flightRecorderFrames = 1024;
+
+	// Values the flight recorder sums up for every frame, times are in nanoseconds
+	enum class FlightMetric
+	{
+		Null = 0,
+		Invalid = Null,
+		WindowUpdateTime,
+		NumWindowEvents,
+		NumBufferUploads,
+		BufferUploadBytes,
+		SwapTime,
+		FrameLimiterWaitTime,
+		// Messages from the graphics driver's debug output, only counted when it's enabled
+		NumDebugMessages,
+		NumMetrics = NumDebugMessages
+	};
+
+	struct FlightRecorderConfig
+	{
+		// Frames longer than this many seconds are hitches and get dumped, 0 never dumps
+		double frameBudget = 0.1;
+		// Directory dumps are written to, named BlazeHitch_<frame>.json, empty for the working directory
+		std::string dumpDirectory;
+		// Hitches this many seconds after a dump aren't dumped, so a loading screen doesn't dump every frame
+		double minDumpInterval = 10.0;
+		// Dumps written at most, 0 never dumps
+		uint32_t maxDumps = 8;
+	};
+
+	// One recorded frame, start is on Profiler::GetTimestamp's clock
+	struct FlightFrame
+	{
+		uint64_t frameIndex = 0;
+		uint64_t start = 0;
+		uint64_t duration = 0;
+		std::array<uint64_t, static_cast<size_t>(FlightMetric::NumMetrics) + 1> metrics{};
+	};
+
+	struct FlightRecorderStats
+	{
+		uint64_t numFrames = 0;
+		uint64_t numHitches = 0;
+		uint32_t numDumps = 0;
+	};
+
+	// Always-on ring of the last flightRecorderFrames frames and what the engine did in them
+	// A frame over the budget freezes the ring and writes it as a Chrome trace, so a hitch can be looked at after the fact
+	class BLAZE_API FlightRecorder
+	{
+	public:
+		static void Configure(const FlightRecorderConfig& config);
+
+		// Adds to a metric of the current frame, thread safe
+		static void Add(FlightMetric metric, uint64_t value);
+
+		// Ends the current frame and starts the next one, called once per frame by the thread running the game loop
+		// Dumps the recorded frames if the frame that ended was over the budget
+		static void NextFrame();
+
+		// Writes the recorded frames as Chrome trace JSON, also used for the automatic dumps
+		static Result WriteDump(std::string_view path);
+
+		static FlightRecorderStats GetStats();
+		// The last frame that ended, empty before the second NextFrame
+		static FlightFrame GetLastFrame();
+	};
+
+	// Adds the time of its own lifetime to a metric, BLAZE_FLIGHT_TIMER is meant to be used instead
+	class FlightTimer
+	{
+	public:
+		inline FlightTimer(FlightMetric metric) :m_metric(metric), m_start(Profiler::GetTimestamp()) {}
+		inline ~FlightTimer() { FlightRecorder::Add(m_metric, Profiler::GetTimestamp() - m_start); }
+
+		FlightTimer(const FlightTimer&) = delete;
+		FlightTimer& operator=(const FlightTimer&) = delete;
+	private:
+		FlightMetric m_metric;
+		uint64_t m_start;
+	};
+}
+
+// Times the rest of the enclosing block into a FlightMetric, unlike profile scopes these are never compiled out
+#define BLAZE_FLIGHT_TIMER(metric) ::Blaze::FlightTimer BLAZE_PROFILE_CONCAT(blazeFlightTimer, __LINE__){ metric }
+
+#endif // BLAZE_FLIGHTRECORDER_H
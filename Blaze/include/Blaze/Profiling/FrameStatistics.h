@@ -0,0 +1,71 @@
+#pragma once
+
+#ifndef BLAZE_FRAMESTATISTICS_H
+#define BLAZE_FRAMESTATISTICS_H
+
+#include <Blaze/Core.h>
+
+#include <iosfwd>
+
+namespace Blaze
+{
+	// Frames the frame time statistics are computed over
+	constexpr uint32_t frameTimeWindowSize = 1024;
+
+	enum class FrameTimeSeries
+	{
+		Null = 0,
+		Invalid = Null,
+		// From the start of a frame's CPU work until it's handed to SwapBuffers
+		CPUFrame,
+		// GPU time of a frame, only recorded when the device context's GPU profiler is enabled
+		GPUFrame,
+		// Time between two SwapBuffers returning, what the player sees
+		PresentInterval,
+		NumSeries = PresentInterval
+	};
+
+	// Times are in seconds, over the last frameTimeWindowSize frames
+	struct FrameTimeStats
+	{
+		uint64_t numSamples = 0;
+		double mean = 0.0;
+		double p50 = 0.0;
+		double p95 = 0.0;
+		double p99 = 0.0;
+		double max = 0.0;
+	};
+
+	struct FrameStatisticsConfig
+	{
+		// Seconds between writing a summary to the console, 0 doesn't write any
+		double dumpInterval = 0.0;
+	};
+
+	// Rolling frame time percentiles, fed by SwapBuffers and the GPU profiler
+	class BLAZE_API FrameStatistics
+	{
+	public:
+		static void Configure(const FrameStatisticsConfig& config);
+
+		// Marks the start of a frame's CPU work, without it CPU frames are measured from the last SwapBuffers
+		static void BeginCPUFrame();
+		// Called by SwapBuffers with Profiler::GetTimestamp times from right before and after the swap
+		static void RecordPresent(uint64_t swapStart, uint64_t swapEnd);
+		// Adds a sample in nanoseconds
+		static void Record(FrameTimeSeries series, uint64_t time);
+
+		static FrameTimeStats GetStats(FrameTimeSeries series);
+		// Newest sample in nanoseconds, 0 if there is none yet
+		static uint64_t GetLastSample(FrameTimeSeries series);
+		// Samples recorded since the start, including the ones that already left the window
+		static uint64_t GetNumSamples(FrameTimeSeries series);
+		// Appends the samples recorded after the first numSeen ones to samples and returns the new count to pass next time
+		// Samples that already left the window are skipped, so it has to be called at least every frameTimeWindowSize samples
+		static uint64_t GetNewSamples(FrameTimeSeries series, uint64_t numSeen, std::vector<uint64_t>& samples);
+		// Writes one line per series with samples
+		static void WriteSummary(std::ostream& stream);
+	};
+}
+
+#endif // BLAZE_FRAMESTATISTICS_H
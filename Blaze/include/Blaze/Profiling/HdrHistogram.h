@@ -0,0 +1,39 @@
+#pragma once
+
+#ifndef BLAZE_HDRHISTOGRAM_H
+#define BLAZE_HDRHISTOGRAM_H
+
+#include <Blaze/Core.h>
+
+namespace Blaze
+{
+	// Log-linear histogram in the style of HdrHistogram, every power of two range is split into 64 buckets
+	// Values below 128 are exact, larger ones are kept to within 1/64 of their size, up to maxValue (about 18 minutes in nanoseconds)
+	class BLAZE_API HdrHistogram
+	{
+	public:
+		static constexpr uint64_t maxValue = (uint64_t(1) << 40) - 1;
+
+		HdrHistogram();
+
+		// Values over maxValue are counted as maxValue
+		void Add(uint64_t value);
+		// Takes back a value that was added, used to keep a rolling window
+		void Remove(uint64_t value);
+		void Clear();
+
+		inline uint64_t GetCount() const { return m_count; }
+		inline double GetMean() const { return m_count ? static_cast<double>(m_sum) / m_count : 0.0; }
+		// Highest value that's equivalent to the value at the percentile [0, 100]
+		uint64_t GetPercentile(double percentile) const;
+	private:
+		static size_t GetBucketIndex(uint64_t value);
+		static uint64_t GetBucketHighestValue(size_t index);
+
+		std::vector<uint32_t> m_counts;
+		uint64_t m_count = 0;
+		uint64_t m_sum = 0;
+	};
+}
+
+#endif // BLAZE_HDRHISTOGRAM_H
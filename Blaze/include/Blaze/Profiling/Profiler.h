@@ -0,0 +1,100 @@
+#pragma once
+
+#ifndef BLAZE_PROFILER_H
+#define BLAZE_PROFILER_H
+
+#include <Blaze/Core.h>
+
+#include <iosfwd>
+#include <string_view>
+
+// The profiler is compiled in unless BLAZE_DISABLE_PROFILER is defined, recording can also be paused at runtime
+#ifndef BLAZE_DISABLE_PROFILER
+#define BLAZE_PROFILER
+#endif
+
+namespace Blaze
+{
+	// Scopes each thread keeps, older ones are overwritten
+	constexpr size_t profilerEventsPerThread = 64 * 1024;
+
+	// A finished scope, times are nanoseconds on Profiler::GetTimestamp's clock
+	struct ProfileEvent
+	{
+		// Must outlive the profiler, usually a string literal
+		const char* name = nullptr;
+		uint64_t start = 0;
+		uint64_t end = 0;
+		// Number of scopes that were open around this one on its thread
+		uint32_t depth = 0;
+	};
+
+	// Records nested timing scopes into a lock free buffer per thread and exports them as a Chrome trace
+	class BLAZE_API Profiler
+	{
+	public:
+		static void SetEnabled(bool isEnabled);
+		static bool IsEnabled();
+
+		// Name of the calling thread in the trace
+		static void SetThreadName(std::string_view name);
+
+		// Nanoseconds since the profiler started, steady across threads
+		static uint64_t GetTimestamp();
+
+		// Used by ProfileScope, returns false when nothing is recorded
+		static bool BeginScope(uint64_t& start, uint32_t& depth);
+		static void EndScope(const char* name, uint64_t start, uint32_t depth);
+
+		// Timeline that isn't a thread, eg. the GPU, only one thread may record into a track at a time
+		static uint32_t CreateTrack(std::string_view name);
+		// Adds a scope that was timed some other way, times must be on GetTimestamp's clock
+		static void RecordScope(uint32_t track, const char* name, uint64_t start, uint64_t end, uint32_t depth);
+
+		// Forgets everything recorded so far, threads can keep recording while it runs
+		static void Clear();
+
+		// Writes every thread's recorded scopes as Chrome trace event JSON, opened with chrome://tracing or ui.perfetto.dev
+		static Result WriteChromeTrace(std::ostream& stream);
+		static Result WriteChromeTrace(std::string_view path);
+	};
+
+	// Times its own lifetime, BLAZE_PROFILE_SCOPE is meant to be used instead
+	class ProfileScope
+	{
+	public:
+		inline ProfileScope(const char* name)
+			:m_name(name)
+		{
+			m_isRecording = Profiler::BeginScope(m_start, m_depth);
+		}
+
+		inline ~ProfileScope()
+		{
+			if (m_isRecording)
+				Profiler::EndScope(m_name, m_start, m_depth);
+		}
+
+		ProfileScope(const ProfileScope&) = delete;
+		ProfileScope& operator=(const ProfileScope&) = delete;
+	private:
+		const char* m_name;
+		uint64_t m_start = 0;
+		uint32_t m_depth = 0;
+		bool m_isRecording = false;
+	};
+}
+
+#define BLAZE_PROFILE_CONCAT_IMPL(a, b) a##b
+#define BLAZE_PROFILE_CONCAT(a, b) BLAZE_PROFILE_CONCAT_IMPL(a, b)
+
+#ifdef BLAZE_PROFILER
+// Profiles the rest of the enclosing block, name must outlive the profiler
+#define BLAZE_PROFILE_SCOPE(name) ::Blaze::ProfileScope BLAZE_PROFILE_CONCAT(blazeProfileScope, __LINE__){ name }
+#define BLAZE_PROFILE_FUNCTION() BLAZE_PROFILE_SCOPE(__FUNCTION__)
+#else // ^^^ BLAZE_PROFILER / !BLAZE_PROFILER vvv
+#define BLAZE_PROFILE_SCOPE(name) ((void)0)
+#define BLAZE_PROFILE_FUNCTION() ((void)0)
+#endif // ^^^ !BLAZE_PROFILER
+
+#endif // BLAZE_PROFILER_H
@@ -0,0 +1,103 @@
+#pragma once
+
+#ifndef BLAZE_RESOURCECENSUS_H
+#define BLAZE_RESOURCECENSUS_H
+
+#include <Blaze/Core.h>
+#include <Blaze/Object.h>
+
+#include <iosfwd>
+
+namespace Blaze
+{
+	// Live objects of one class created at one site
+	struct ResourceCensusEntry
+	{
+		ClassID classID = 0;
+		std::string site;
+		uint64_t numObjects = 0;
+		uint64_t cpuBytes = 0;
+		uint64_t gpuBytes = 0;
+	};
+
+	struct ResourceCensusSnapshot
+	{
+		// Sorted by class and site
+		std::vector<ResourceCensusEntry> entries;
+		uint64_t numObjects = 0;
+		uint64_t cpuBytes = 0;
+		uint64_t gpuBytes = 0;
+	};
+
+	// How an entry changed between two snapshots, classes and sites missing in one of them count as empty
+	struct ResourceCensusDelta
+	{
+		ClassID classID = 0;
+		std::string site;
+		int64_t numObjects = 0;
+		int64_t cpuBytes = 0;
+		int64_t gpuBytes = 0;
+	};
+
+	// Totals over every live object, cheap enough to check a budget every frame
+	struct ResourceCensusTotals
+	{
+		uint64_t numObjects = 0;
+		uint64_t cpuBytes = 0;
+		uint64_t gpuBytes = 0;
+	};
+
+	// Keeps track of every live Object in all builds, with the memory implementations report for them
+	// Objects are counted under the creation site of the thread that created them, see BLAZE_RESOURCE_SITE
+	class BLAZE_API ResourceCensus
+	{
+	public:
+		// Sets the memory an object currently holds, replacing what was set before
+		// CPU bytes are what the object allocated for itself, GPU bytes what it allocated through the graphics API
+		static void SetFootprint(Object* object, uint64_t cpuBytes, uint64_t gpuBytes);
+
+		static ResourceCensusTotals GetTotals();
+		static ResourceCensusSnapshot TakeSnapshot();
+		// Entries that changed from before to after, the ones that grew the most GPU memory first
+		static std::vector<ResourceCensusDelta> Diff(const ResourceCensusSnapshot& before, const ResourceCensusSnapshot& after);
+
+		static void WriteReport(std::ostream& stream, const ResourceCensusSnapshot& snapshot);
+		static void WriteDiff(std::ostream& stream, const std::vector<ResourceCensusDelta>& deltas);
+
+		// Readable name of a class, eg. "Buffer (OpenGL)", not GetClassName since windows.h defines that as a macro
+		static std::string GetClassLabel(ClassID classID);
+
+		// site must outlive every object created under it, usually a string literal, nullptr is "Untagged"
+		static const char* GetThreadSite();
+		static void SetThreadSite(const char* site);
+	};
+
+	namespace Details
+	{
+		// Used by the object ID functions, see Details::CreateObjectID
+		void CensusAddObject(uint32_t objectID);
+		void CensusSetClass(uint32_t objectID, ClassID classID);
+		void CensusRemoveObject(uint32_t objectID);
+	}
+
+	// Counts the objects the thread creates under a site for its lifetime, BLAZE_RESOURCE_SITE is meant to be used instead
+	class ResourceSiteScope
+	{
+	public:
+		inline ResourceSiteScope(const char* site) :m_previousSite(ResourceCensus::GetThreadSite()) { ResourceCensus::SetThreadSite(site); }
+		inline ~ResourceSiteScope() { ResourceCensus::SetThreadSite(m_previousSite); }
+
+		ResourceSiteScope(const ResourceSiteScope&) = delete;
+		ResourceSiteScope& operator=(const ResourceSiteScope&) = delete;
+	private:
+		const char* m_previousSite;
+	};
+}
+
+#define BLAZE_RESOURCE_SITE_CONCAT_IMPL(a, b) a##b
+#define BLAZE_RESOURCE_SITE_CONCAT(a, b) BLAZE_RESOURCE_SITE_CONCAT_IMPL(a, b)
+
+// Counts the objects created in the rest of the enclosing block under site
+#define BLAZE_RESOURCE_SITE(site) ::Blaze::ResourceSiteScope BLAZE_RESOURCE_SITE_CONCAT(blazeResourceSite, __LINE__){ site }
+
+#endif // BLAZE_RESOURCECENSUS_H
@@ -0,0 +1,31 @@
+#pragma once
+
+#ifndef BLAZE_TELEMETRY_H
+#define BLAZE_TELEMETRY_H
+
+#include <Blaze/Core.h>
+#include <Blaze/Profiling/TelemetryLayout.h>
+
+#include <string_view>
+
+namespace Blaze
+{
+	// Publishes engine counters and events to a shared memory segment, for monitors in other processes
+	// Nothing is published until Open, after that it costs one seqlocked copy of the counters per frame
+	class BLAZE_API Telemetry
+	{
+	public:
+		// Creates the segment, see defaultTelemetrySegment for how the name is used
+		static Result Open(std::string_view name = defaultTelemetrySegment);
+		// Removes the segment once events being posted on other threads are written, readers still mapping it keep the last values
+		static void Close();
+		static bool IsOpen();
+
+		// Gathers the counters of the frame that ended and publishes them, called once per frame by the game loop
+		static void NextFrame();
+		// Lock free and thread safe, does nothing while closed
+		static void PostEvent(TelemetryEventType type, uint64_t value);
+	};
+}
+
+#endif // BLAZE_TELEMETRY_H
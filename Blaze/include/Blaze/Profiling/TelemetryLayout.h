@@ -0,0 +1,142 @@
+#pragma once
+
+#ifndef BLAZE_TELEMETRYLAYOUT_H
+#define BLAZE_TELEMETRYLAYOUT_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Layout of the shared memory telemetry segment, shared with readers in other processes that don't link Blaze
+// Any change to it has to bump telemetryVersion
+namespace Blaze
+{
+	constexpr uint32_t telemetryMagic = 0x544c5a42; // "BZLT"
+	constexpr uint32_t telemetryVersion = 1;
+	// Events kept in the segment, a reader polling slower than they're posted misses some
+	constexpr uint32_t telemetryEventRingSize = 256;
+	// Segment name used when none is given, "Local\BlazeTelemetry" on Windows and "/BlazeTelemetry" on Posix
+	constexpr const char* defaultTelemetrySegment = "BlazeTelemetry";
+
+	// Counters published once per frame, times are in nanoseconds and per frame values are for the last frame that ended
+	enum class TelemetryCounter : uint32_t
+	{
+		Null = 0,
+		Invalid = Null,
+		FrameIndex,
+		// Profiler::GetTimestamp when the counters were published
+		PublishTime,
+		FrameTime,
+		CPUFrameTime,
+		GPUFrameTime,
+		PresentInterval,
+		NumWindowEvents,
+		NumBufferUploads,
+		BufferUploadBytes,
+		NumObjects,
+		ObjectCPUBytes,
+		ObjectGPUBytes,
+		NumAllocations,
+		AllocatedBytes,
+		LiveHeapBytes,
+		NumCounters = LiveHeapBytes
+	};
+
+	enum class TelemetryEventType : uint32_t
+	{
+		Null = 0,
+		Invalid = Null,
+		// A frame went over the flight recorder's budget, value is its duration
+		Hitch,
+		// The flight recorder wrote a dump, value is the frame it was written for
+		FlightDump,
+		// Posted by the game, value is up to it
+		Marker,
+		NumTypes = Marker
+	};
+
+	using TelemetryCounters = std::array<uint64_t, static_cast<size_t>(TelemetryCounter::NumCounters) + 1>;
+
+	struct TelemetryEvent
+	{
+		uint64_t index = 0;
+		uint64_t timestamp = 0;
+		TelemetryEventType type = TelemetryEventType::Invalid;
+		uint64_t value = 0;
+	};
+
+	// Processes only agree on atomics that don't hide a lock
+	static_assert(std::atomic<uint64_t>::is_always_lock_free, "Telemetry needs lock free 64-bit atomics");
+
+	// Every field is an atomic so writer and readers never race, the seqlocks only make a read consistent
+	struct TelemetryEventSlot
+	{
+		// 2 * index + 1 while event index is written, 2 * index + 2 once it's done
+		std::atomic<uint64_t> sequence;
+		std::atomic<uint64_t> timestamp;
+		std::atomic<uint64_t> type;
+		std::atomic<uint64_t> value;
+	};
+
+	struct TelemetryBlock
+	{
+		// Written last when the segment is set up, a reader has to check it first
+		std::atomic<uint32_t> magic;
+		uint32_t version;
+		uint32_t blockSize;
+		uint32_t processID;
+
+		// Seqlock over the counters, odd while they're written
+		std::atomic<uint64_t> sequence;
+		std::array<std::atomic<uint64_t>, static_cast<size_t>(TelemetryCounter::NumCounters) + 1> counters;
+
+		// Events posted so far, event i is in slot i % telemetryEventRingSize
+		std::atomic<uint64_t> numEvents;
+		std::array<TelemetryEventSlot, telemetryEventRingSize> events;
+	};
+
+	// Checks that a mapped block was set up by a writer with the same layout
+	inline bool IsTelemetryBlockValid(const TelemetryBlock& block)
+	{
+		return (block.magic.load(std::memory_order_acquire) == telemetryMagic) && (block.version == telemetryVersion) && (block.blockSize == sizeof(TelemetryBlock));
+	}
+
+	// Copies a consistent set of counters, false if the writer kept being in the middle of an update
+	inline bool ReadTelemetryCounters(const TelemetryBlock& block, TelemetryCounters& counters)
+	{
+		for (uint32_t attempt = 0; attempt < 64; attempt++)
+		{
+			const uint64_t sequence = block.sequence.load(std::memory_order_acquire);
+			if (sequence & 1)
+				continue;
+
+			for (size_t i = 0; i < counters.size(); i++)
+				counters[i] = block.counters[i].load(std::memory_order_relaxed);
+
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (block.sequence.load(std::memory_order_relaxed) == sequence)
+				return true;
+		}
+		return false;
+	}
+
+	// Copies event index, false if it isn't posted yet or was already overwritten
+	inline bool ReadTelemetryEvent(const TelemetryBlock& block, uint64_t index, TelemetryEvent& event)
+	{
+		const TelemetryEventSlot& slot = block.events[index % telemetryEventRingSize];
+		const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+		if (sequence != 2 * index + 2)
+			return false;
+
+		event.index = index;
+		event.timestamp = slot.timestamp.load(std::memory_order_relaxed);
+		event.type = static_cast<TelemetryEventType>(slot.type.load(std::memory_order_relaxed));
+		event.value = slot.value.load(std::memory_order_relaxed);
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+		return slot.sequence.load(std::memory_order_relaxed) == sequence;
+	}
+}
+
+#endif // BLAZE_TELEMETRYLAYOUT_H
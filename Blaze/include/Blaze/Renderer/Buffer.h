@@ -14,7 +14,8 @@ namespace Blaze
 		Null = 0,
 		Invalid = Null,
 		Vertex,
-		Index
+		Index,
+		Instance	// Per-instance vertex data, bound like a vertex buffer to a binding with a divisor
 	};
 
 	enum class BufferAccess
@@ -22,7 +23,18 @@ namespace Blaze
 		Null = 0,
 		Invalid = Null,
 		Read		= 0x01,
-		Write		= 0x02
+		Write		= 0x02,
+		ReadWrite	= Read | Write // Eg. transforming vertices in place
+	};
+
+	// Hint for how often the contents of a buffer get rewritten
+	enum class BufferUsage
+	{
+		Null = 0,
+		Invalid = Null,
+		Static,		// Written once, drawn many times
+		Dynamic,	// Rewritten occasionally
+		Stream		// Rewritten every frame, eg. animated positions in their own vertex stream
 	};
 
 	struct BufferCreateInfo
@@ -30,7 +42,11 @@ namespace Blaze
 	{
 		Ref<DeviceContext> deviceContext;
 		BufferType type;
-		void* data = nullptr;
+		BufferUsage usage = BufferUsage::Dynamic;
+		// Format of the indices, only used for index buffers (R8_UInt, R16_UInt or R32_UInt)
+		Format indexFormat = Format::R32_UInt;
+		// Initial contents, may point into read-only memory such as a Package blob
+		const void* data = nullptr;
 		size_t size = 0;
 	};
 
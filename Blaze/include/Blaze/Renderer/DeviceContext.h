@@ -6,14 +6,79 @@
 #include <Blaze/Core.h>
 #include <Blaze/Object.h>
 #include <Blaze/Window.h>
+#include <Blaze/Renderer/Format.h>
+#include <Blaze/Profiling/Profiler.h>
 
 namespace Blaze
 {
+	class BLAZE_API Buffer;
+
+	// Frames GPU timings are read back after, queries are only reused once their results had this long to arrive
+	constexpr uint32_t gpuProfilerLatency = 4;
+	// GPU scopes recorded per frame at most, including the one around the whole frame
+	constexpr uint32_t maxGPUScopesPerFrame = 256;
+	// Distinct debug messages kept per device context, messages that don't fit are only counted as dropped
+	constexpr uint32_t maxDebugMessageKinds = 256;
+	// Characters of a debug message's text that are kept, including the terminating null
+	constexpr uint32_t maxDebugMessageLength = 512;
+
 	enum class RenderAPI
 	{
 		Null = 0,
 		Invalid = Null,
-		OpenGL
+		OpenGL,
+		// Keeps buffers in system memory and draws nothing, for benchmarks and tests on machines without a GPU
+		Headless
+	};
+
+	enum class PrimitiveTopology
+	{
+		Null = 0,
+		Invalid = Null,
+		PointList,
+		LineList,
+		LineStrip,
+		TriangleList,
+		TriangleStrip
+	};
+
+	// Who the driver says a debug message came from
+	enum class DebugMessageSource
+	{
+		Null = 0,
+		Invalid = Null,
+		API,
+		WindowSystem,
+		ShaderCompiler,
+		ThirdParty,
+		Application,
+		Other,
+		NumSources = Other
+	};
+
+	enum class DebugMessageType
+	{
+		Null = 0,
+		Invalid = Null,
+		Error,
+		DeprecatedBehavior,
+		UndefinedBehavior,
+		Portability,
+		// Buffer reallocations, implicit syncs, shader recompiles and the like
+		Performance,
+		Other,
+		NumTypes = Other
+	};
+
+	enum class DebugMessageSeverity
+	{
+		Null = 0,
+		Invalid = Null,
+		Notification,
+		Low,
+		Medium,
+		High,
+		NumSeverities = High
 	};
 
 	struct DeviceContextCreateInfo
@@ -22,6 +87,59 @@ namespace Blaze
 		Ref<Window> window;
 		// Set to RenderAPI::Null for default api
 		RenderAPI renderingApi = RenderAPI::Null;
+		// Times GPU scopes and every frame with timer queries, the results show up on the profiler's GPU track
+		bool enableGPUProfiler = false;
+		// Creates a debug context and collects the driver's debug messages, see DeviceContext::GetDebugOutputSummary
+		// Messages are reported from inside the call that caused them, which can slow down the driver
+		bool enableDebugOutput = false;
+	};
+
+	struct VertexArrayCacheStats
+	{
+		// Number of binds that reused an existing vertex array
+		uint64_t hits = 0;
+		// Number of binds that had to build a new vertex array
+		uint64_t misses = 0;
+		// Number of vertex arrays currently cached
+		size_t numVertexArrays = 0;
+	};
+
+	struct GPUProfilerStats
+	{
+		// GPU time of the last frame that was read back in seconds, compared to the CPU frame time it shows which one limits the frame rate
+		double lastFrameTime = 0.0;
+		// Frames whose timings were read back
+		uint64_t numFrames = 0;
+		// Frames whose results weren't ready when their queries were reused, the GPU was more than gpuProfilerLatency frames behind
+		uint64_t numDroppedFrames = 0;
+		// Scopes that didn't fit in maxGPUScopesPerFrame
+		uint64_t numDroppedScopes = 0;
+	};
+
+	// A distinct debug message, messages are told apart by their ID, source, type and the Blaze call they came from
+	struct DebugMessageSummary
+	{
+		uint32_t id = 0;
+		DebugMessageSource source = DebugMessageSource::Invalid;
+		DebugMessageType type = DebugMessageType::Invalid;
+		DebugMessageSeverity severity = DebugMessageSeverity::Invalid;
+		// Blaze call the driver reported the message from, like "Buffer::Write", "Unknown" for calls outside Blaze
+		const char* site = nullptr;
+		// Text of the first message, both strings live as long as the device context
+		const char* message = nullptr;
+		uint64_t frameCount = 0;
+		uint64_t totalCount = 0;
+	};
+
+	// Debug messages of the last frame that ended
+	struct DebugOutputSummary
+	{
+		// Messages of the frame by DebugMessageType
+		std::array<uint64_t, static_cast<size_t>(DebugMessageType::NumTypes) + 1> numMessages{};
+		// Messages whose kind didn't fit in maxDebugMessageKinds since the context was created
+		uint64_t numDropped = 0;
+		// Kinds of message the frame had, most frequent first
+		std::vector<DebugMessageSummary> messages;
 	};
 
 	class BLAZE_API DeviceContext
@@ -37,11 +155,80 @@ namespace Blaze
 
 		inline Result SwapBuffers() { return SwapBuffers_Impl(); }
 
+		// Binds a vertex buffer (and optionally an index buffer) using the layout described by format
+		// Layouts are cached, so binding a layout/buffer combination that has been bound before is a single bind
+		inline Result BindVertexBuffer(const VertexFormat& format, const Ref<Buffer>& vertexBuffer, const Ref<Buffer>& indexBuffer = nullptr) { return BindVertexBuffers_Impl(format, &vertexBuffer, 1, indexBuffer); }
+		// Binds one vertex buffer per binding slot of format, vertexBuffers[i] is used for binding i
+		// Slots without any attributes may be nullptr
+		inline Result BindVertexBuffers(const VertexFormat& format, const Ref<Buffer>* vertexBuffers, uint32_t numVertexBuffers, const Ref<Buffer>& indexBuffer = nullptr) { return BindVertexBuffers_Impl(format, vertexBuffers, numVertexBuffers, indexBuffer); }
+		// Sets the primitive topology used by draws, the default is PrimitiveTopology::TriangleList
+		inline Result SetPrimitiveTopology(PrimitiveTopology topology) { return SetPrimitiveTopology_Impl(topology); }
+
+		// Draws vertices from the bound vertex buffers
+		inline Result Draw(uint32_t vertexCount, uint32_t firstVertex = 0) { return DrawInstanced_Impl(vertexCount, 1, firstVertex); }
+		// Draws indices from the bound index buffer, baseVertex gets added to every index
+		inline Result DrawIndexed(uint32_t indexCount, uint32_t firstIndex = 0, int32_t baseVertex = 0) { return DrawIndexedInstanced_Impl(indexCount, 1, firstIndex, baseVertex); }
+		// Draws several instances in one call, bindings with a divisor advance per instance
+		inline Result DrawInstanced(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex = 0) { return DrawInstanced_Impl(vertexCount, instanceCount, firstVertex); }
+		inline Result DrawIndexedInstanced(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex = 0, int32_t baseVertex = 0) { return DrawIndexedInstanced_Impl(indexCount, instanceCount, firstIndex, baseVertex); }
+
+		// Gets the hit/miss counters of the vertex layout cache
+		inline VertexArrayCacheStats GetVertexArrayCacheStats() { return GetVertexArrayCacheStats_Impl(); }
+
+		// Times the GPU work submitted until the matching EndGPUScope, scopes nest
+		// Does nothing unless the GPU profiler was enabled, name must outlive the profiler
+		inline Result BeginGPUScope(const char* name) { return BeginGPUScope_Impl(name); }
+		inline Result EndGPUScope() { return EndGPUScope_Impl(); }
+		inline GPUProfilerStats GetGPUProfilerStats() { return GetGPUProfilerStats_Impl(); }
+
+		// Gets the driver's debug messages of the last frame, empty unless debug output was enabled and the driver supports it
+		// Every kind of message is also logged the first time it shows up
+		inline DebugOutputSummary GetDebugOutputSummary() { return GetDebugOutputSummary_Impl(); }
+
 		inline RenderAPI GetRenderAPI() { return GetRenderAPI_Impl(); }
 	private:
 		virtual Result SwapBuffers_Impl() = 0;
+		virtual Result BindVertexBuffers_Impl(const VertexFormat& format, const Ref<Buffer>* vertexBuffers, uint32_t numVertexBuffers, const Ref<Buffer>& indexBuffer) = 0;
+		virtual Result SetPrimitiveTopology_Impl(PrimitiveTopology topology) = 0;
+		virtual Result DrawInstanced_Impl(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex) = 0;
+		virtual Result DrawIndexedInstanced_Impl(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t baseVertex) = 0;
+		virtual VertexArrayCacheStats GetVertexArrayCacheStats_Impl() = 0;
+		virtual Result BeginGPUScope_Impl(const char* name) = 0;
+		virtual Result EndGPUScope_Impl() = 0;
+		virtual GPUProfilerStats GetGPUProfilerStats_Impl() = 0;
+		virtual DebugOutputSummary GetDebugOutputSummary_Impl() = 0;
 		virtual RenderAPI GetRenderAPI_Impl() = 0;
 	};
+
+	// Times the GPU work submitted during its lifetime, BLAZE_PROFILE_GPU_SCOPE is meant to be used instead
+	class GPUProfileScope
+	{
+	public:
+		inline GPUProfileScope(DeviceContext& deviceContext, const char* name)
+			:m_deviceContext(deviceContext)
+		{
+			m_isRecording = m_deviceContext.BeginGPUScope(name) == Result::Success;
+		}
+
+		inline ~GPUProfileScope()
+		{
+			if (m_isRecording)
+				m_deviceContext.EndGPUScope();
+		}
+
+		GPUProfileScope(const GPUProfileScope&) = delete;
+		GPUProfileScope& operator=(const GPUProfileScope&) = delete;
+	private:
+		DeviceContext& m_deviceContext;
+		bool m_isRecording;
+	};
 }
 
+#ifdef BLAZE_PROFILER
+// Profiles the GPU work of the rest of the enclosing block, name must outlive the profiler
+#define BLAZE_PROFILE_GPU_SCOPE(deviceContext, name) ::Blaze::GPUProfileScope BLAZE_PROFILE_CONCAT(blazeGPUProfileScope, __LINE__){ deviceContext, name }
+#else // ^^^ BLAZE_PROFILER / !BLAZE_PROFILER vvv
+#define BLAZE_PROFILE_GPU_SCOPE(deviceContext, name) ((void)0)
+#endif // ^^^ !BLAZE_PROFILER
+
 #endif // BLAZE_DEVICECONTEXT_H
\ No newline at end of file
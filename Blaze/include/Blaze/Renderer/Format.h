@@ -6,6 +6,7 @@
 #include <Blaze/Core.h>
 
 #include <cmath>
+#include <initializer_list>
 
 namespace Blaze
 {
@@ -16,6 +17,8 @@ namespace Blaze
 		Float,
 		Int,
 		UInt,
+		UNorm, // Unsigned integer read as a float in [0, 1]
+		SNorm, // Signed integer read as a float in [-1, 1]
 		Signed = Int,
 		Unsigned = UInt
 	};
@@ -70,6 +73,27 @@ namespace Blaze
 		R64G64B64_Float,
 		R64G64B64A64_Float,
 
+#pragma endregion
+
+#pragma region Normalized integer formats
+
+		R8_UNorm,
+		R8G8_UNorm,
+		R8G8B8_UNorm,
+		R8G8B8A8_UNorm,
+		R16_UNorm,
+		R16G16_UNorm,
+		R16G16B16_UNorm,
+		R16G16B16A16_UNorm,
+		R8_SNorm,
+		R8G8_SNorm,
+		R8G8B8_SNorm,
+		R8G8B8A8_SNorm,
+		R16_SNorm,
+		R16G16_SNorm,
+		R16G16B16_SNorm,
+		R16G16B16A16_SNorm,
+
 #pragma endregion
 
 	};
@@ -86,37 +110,125 @@ namespace Blaze
 		BLAZE_API FormatInfo GetFormatInfo(Format format);
 	}
 
+	// Maximum number of vertex buffers a vertex format can source attributes from
+	constexpr uint32_t maxVertexBindings = 16;
+
 	struct VertexAttribute
 	{
 		Format format;
 		size_t offset = 0; // Leave 0 for automatic calculation
+		uint32_t binding = 0; // Vertex buffer slot the attribute is read from
+
+		inline bool operator==(const VertexAttribute& rhs) const { return (format == rhs.format) && (offset == rhs.offset) && (binding == rhs.binding); }
+		inline bool operator!=(const VertexAttribute& rhs) const { return !(*this == rhs); }
 	};
 
+	// Describes one vertex buffer slot of a vertex format
+	struct VertexBinding
+	{
+		size_t stride = 0;
+		uint32_t divisor = 0; // 0 advances every vertex, N advances every N instances
+
+		inline bool operator==(const VertexBinding& rhs) const { return (stride == rhs.stride) && (divisor == rhs.divisor); }
+		inline bool operator!=(const VertexBinding& rhs) const { return !(*this == rhs); }
+	};
+
+	// Attributes can be interleaved in one binding or split across several (structure of arrays),
+	// so passes that only need some attributes (eg. depth-only) can read a single stream
 	class VertexFormat
 	{
 	public:
 		inline Result PushAttribute(const VertexAttribute& attrib)
 		{
-			m_offset = attrib.offset == 0 ? m_offset : attrib.offset;
+			if (attrib.binding >= maxVertexBindings)
+				return Result::InvalidParam;
+
+			if (attrib.binding >= m_bindings.size())
+			{
+				m_bindings.resize(attrib.binding + 1);
+				m_offsets.resize(attrib.binding + 1, 0);
+			}
 
-			m_attibutes.push_back(VertexAttribute{ attrib.format, m_offset });
+			auto& offset = m_offsets[attrib.binding];
+			offset = attrib.offset == 0 ? offset : attrib.offset;
+
+			m_attibutes.push_back(VertexAttribute{ attrib.format, offset, attrib.binding });
+			HashValues({ static_cast<uint64_t>(attrib.format), static_cast<uint64_t>(offset), static_cast<uint64_t>(attrib.binding) });
 
 			auto formatInfo = Details::GetFormatInfo(attrib.format);
-			m_offset += formatInfo.sizeInBytes;
-			m_stride += formatInfo.sizeInBytes;
+			offset += formatInfo.sizeInBytes;
+			m_bindings[attrib.binding].stride += formatInfo.sizeInBytes;
+
+			return Result::Success;
+		}
+		// Pushes an attribute that advances per instance instead of per vertex
+		// The divisor applies to the whole binding, so per-instance attributes shouldn't share a binding with per-vertex ones
+		inline Result PushInstanceAttribute(const VertexAttribute& attrib, uint32_t divisor = 1)
+		{
+			Result res = PushAttribute(attrib);
+			if (res != Result::Success)
+				return res;
+			return SetBindingDivisor(attrib.binding, divisor);
+		}
+		// Sets how often the attributes in a binding advance, see VertexBinding::divisor
+		inline Result SetBindingDivisor(uint32_t binding, uint32_t divisor)
+		{
+			if (binding >= maxVertexBindings)
+				return Result::InvalidParam;
+
+			if (binding >= m_bindings.size())
+			{
+				m_bindings.resize(binding + 1);
+				m_offsets.resize(binding + 1, 0);
+			}
+
+			m_bindings[binding].divisor = divisor;
+			HashValues({ bindingHashTag, static_cast<uint64_t>(binding), static_cast<uint64_t>(divisor) });
 
 			return Result::Success;
 		}
 		inline Result Reset()
 		{
 			m_attibutes.clear();
-			m_stride = 0;
-			m_offset = 0;
+			m_bindings.clear();
+			m_offsets.clear();
+			m_hash = hashSeed;
+
+			return Result::Success;
 		}
+
+		inline const std::vector<VertexAttribute>& GetAttributes() const { return m_attibutes; }
+		// Gets the number of binding slots used, which is the highest used binding + 1
+		inline uint32_t GetNumBindings() const { return static_cast<uint32_t>(m_bindings.size()); }
+		inline VertexBinding GetBinding(uint32_t binding) const { return binding < m_bindings.size() ? m_bindings[binding] : VertexBinding{}; }
+		inline size_t GetStride(uint32_t binding = 0) const { return GetBinding(binding).stride; }
+		// Gets a hash of the format, formats built with the same calls always have the same hash
+		inline uint64_t GetHash() const { return m_hash; }
+
+		inline bool operator==(const VertexFormat& rhs) const { return (m_attibutes == rhs.m_attibutes) && (m_bindings == rhs.m_bindings); }
+		inline bool operator!=(const VertexFormat& rhs) const { return !(*this == rhs); }
 	private:
+		// FNV-1a offset basis and prime
+		static constexpr uint64_t hashSeed = 0xcbf29ce484222325;
+		static constexpr uint64_t hashPrime = 0x00000100000001b3;
+		// Separates divisor changes from attributes in the hash
+		static constexpr uint64_t bindingHashTag = ~0ull;
+
+		// Folds values into the hash, the hash is updated as the format is built so it never has to be recalculated
+		inline void HashValues(std::initializer_list<uint64_t> values)
+		{
+			for (auto value : values)
+			{
+				m_hash ^= value;
+				m_hash *= hashPrime;
+			}
+		}
+
 		std::vector<VertexAttribute> m_attibutes;
-		size_t m_stride;
-		size_t m_offset;
+		std::vector<VertexBinding> m_bindings;
+		// Next automatic offset of each binding
+		std::vector<size_t> m_offsets;
+		uint64_t m_hash = hashSeed;
 	};
 };
 
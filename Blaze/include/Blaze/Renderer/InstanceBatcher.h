@@ -0,0 +1,76 @@
+#pragma once
+
+#ifndef BLAZE_INSTANCEBATCHER_H
+#define BLAZE_INSTANCEBATCHER_H
+
+#include <Blaze/Core.h>
+#include <Blaze/Object.h>
+#include <Blaze/Renderer/DeviceContext.h>
+#include <Blaze/Renderer/Buffer.h>
+#include <Blaze/Renderer/Format.h>
+
+namespace Blaze
+{
+	// A mesh that can be drawn instanced
+	struct InstancedMesh
+	{
+		// Per-vertex attributes plus the per-instance attributes in instanceBinding
+		VertexFormat format;
+		// Vertex buffers indexed by binding, the batcher fills in instanceBinding
+		std::array<Ref<Buffer>, maxVertexBindings> vertexBuffers;
+		// Leave nullptr for non-indexed meshes
+		Ref<Buffer> indexBuffer;
+		// Number of indices, or vertices for non-indexed meshes
+		uint32_t count = 0;
+		uint32_t instanceBinding = 1;
+	};
+
+	// Called before the batches of a material get drawn
+	struct MaterialBinder
+	{
+		typedef Result(*BindMaterial)(uint64_t material, void* data);
+		BindMaterial bindMaterial = nullptr;
+		void* data = nullptr;
+	};
+
+	struct InstanceBatcherStats
+	{
+		// Number of instances the last flush drew
+		uint64_t numInstances = 0;
+		// Number of draw calls the last flush issued
+		uint64_t numDraws = 0;
+	};
+
+	struct InstanceBatcherCreateInfo
+		:public ObjectCreateInfo
+	{
+		Ref<DeviceContext> deviceContext;
+	};
+
+	// Groups instances of identical mesh/material pairs into instanced draws
+	class BLAZE_API InstanceBatcher
+		:public Object
+	{
+	public:
+		inline InstanceBatcher() { classID = GetStaticClassID(); }
+		virtual ~InstanceBatcher() = default;
+
+		static Ref<InstanceBatcher> Create(const InstanceBatcherCreateInfo& createInfo);
+
+		constexpr static ClassID GetStaticClassID() { return Details::MakeClassID(Details::InterfaceID::InstanceBatcher, Details::ImplementationID::Invalid); }
+
+		// Queues an instance of a mesh, instanceData must be mesh.format.GetStride(mesh.instanceBinding) bytes
+		// The mesh must stay alive until the next flush, material is an opaque value passed to the material binder
+		inline Result Submit(const InstancedMesh& mesh, uint64_t material, const void* instanceData) { return Submit_Impl(mesh, material, instanceData); }
+		// Uploads the instance data and issues one draw per mesh/material pair, sorted by material
+		inline Result Flush(MaterialBinder materialBinder = {}) { return Flush_Impl(materialBinder); }
+
+		inline InstanceBatcherStats GetStats() { return GetStats_Impl(); }
+	private:
+		virtual Result Submit_Impl(const InstancedMesh& mesh, uint64_t material, const void* instanceData) = 0;
+		virtual Result Flush_Impl(MaterialBinder materialBinder) = 0;
+		virtual InstanceBatcherStats GetStats_Impl() = 0;
+	};
+}
+
+#endif // BLAZE_INSTANCEBATCHER_H
@@ -10,6 +10,8 @@
 #include <string>
 #include <string_view>
 #include <array>
+#include <algorithm>
+#include <cstring>
 
 namespace Blaze
 {
@@ -19,7 +21,9 @@ namespace Blaze
 	{
 		Null = 0,
 		Invalid = Null,
-		Win32
+		Win32,
+		// Only exists in memory and gets its events from PostEvent, for benchmarks and tests on machines without a display
+		Headless
 	};
 
 #pragma region Window___EventInfo structures
@@ -93,6 +97,12 @@ namespace Blaze
 			std::memcpy(&info, reserved, std::min(sizeof(info), sizeof(reserved)));
 			return info;
 		}
+
+		template<typename WindowEventInfo>
+		void SetWindowEventInfo(const WindowEventInfo& info)
+		{
+			std::memcpy(reserved, &info, std::min(sizeof(info), sizeof(reserved)));
+		}
 	};
 
 	struct WindowEventHandler
@@ -124,6 +134,8 @@ namespace Blaze
 		uint32_t width, height;
 		
 		WindowShowState showState = WindowShowState::Default;
+		// Set to WindowAPI::Null for the platform's window
+		WindowAPI windowAPI = WindowAPI::Null;
 
 		// These event handlers wil get called for all events;
 		std::vector<WindowEventHandler> eventHandlers;
@@ -149,6 +161,8 @@ namespace Blaze
 		inline Result PushEventHandler(WindowEvent::EventCode eventCode, WindowEventHandler eventHandler) { return PushEventHandler_Impl(eventCode, eventHandler); }
 		// Removes an event handler
 		inline Result RemoveEventHandler(WindowEvent::EventCode eventCode, WindowEventHandler eventHandler) { return RemoveEventHandler_Impl(eventCode, eventHandler); }
+		// Queues an event that the next Update dispatches after the system's events, eg. to replay recorded input
+		inline Result PostEvent(const WindowEvent& event) { return PostEvent_Impl(event); }
 
 		// Sets te window title
 		inline Result SetTitle(std::string_view newTitle) { return SetTitle_Impl(newTitle); }
@@ -175,6 +189,7 @@ namespace Blaze
 		virtual bool IsRunning_Impl() = 0;
 		virtual Result PushEventHandler_Impl(WindowEvent::EventCode eventCode, WindowEventHandler eventHandler) = 0;
 		virtual Result RemoveEventHandler_Impl(WindowEvent::EventCode eventCode, WindowEventHandler eventHandler) = 0;
+		virtual Result PostEvent_Impl(const WindowEvent& event) = 0;
 		virtual Result SetTitle_Impl(std::string_view newTitle) = 0;
 		virtual std::string GetTitle_Impl() = 0;
 		virtual Result Resize_Impl(uint32_t width, uint32_t height) = 0;
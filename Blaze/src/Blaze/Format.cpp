@@ -5,7 +5,7 @@ namespace Blaze
 {
 	namespace Details
 	{
-		static constexpr std::array<FormatInfo, 32> formatInfoTable = 
+		static constexpr std::array<FormatInfo, 48> formatInfoTable = 
 		{
 			// Signed integer formats
 			FormatInfo{ 8, 0, 0, 0, FormatType::Int, 1 },
@@ -48,12 +48,33 @@ namespace Blaze
 			FormatInfo{ 64,  0,  0,  0, FormatType::Float, 8 },
 			FormatInfo{ 64, 32,  0,  0, FormatType::Float, 16 },
 			FormatInfo{ 64, 64, 64,  0, FormatType::Float, 24 },
-			FormatInfo{ 64, 64, 64, 64, FormatType::Float, 32 }
+			FormatInfo{ 64, 64, 64, 64, FormatType::Float, 32 },
+
+			// Normalized integer formats
+			FormatInfo{ 8, 0, 0, 0, FormatType::UNorm, 1 },
+			FormatInfo{ 8, 8, 0, 0, FormatType::UNorm, 2 },
+			FormatInfo{ 8, 8, 8, 0, FormatType::UNorm, 3 },
+			FormatInfo{ 8, 8, 8, 8, FormatType::UNorm, 4 },
+
+			FormatInfo{ 16,  0,  0,  0, FormatType::UNorm, 2 },
+			FormatInfo{ 16, 16,  0,  0, FormatType::UNorm, 4 },
+			FormatInfo{ 16, 16, 16,  0, FormatType::UNorm, 6 },
+			FormatInfo{ 16, 16, 16, 16, FormatType::UNorm, 8 },
+
+			FormatInfo{ 8, 0, 0, 0, FormatType::SNorm, 1 },
+			FormatInfo{ 8, 8, 0, 0, FormatType::SNorm, 2 },
+			FormatInfo{ 8, 8, 8, 0, FormatType::SNorm, 3 },
+			FormatInfo{ 8, 8, 8, 8, FormatType::SNorm, 4 },
+
+			FormatInfo{ 16,  0,  0,  0, FormatType::SNorm, 2 },
+			FormatInfo{ 16, 16,  0,  0, FormatType::SNorm, 4 },
+			FormatInfo{ 16, 16, 16,  0, FormatType::SNorm, 6 },
+			FormatInfo{ 16, 16, 16, 16, FormatType::SNorm, 8 }
 		};
 
 		FormatInfo GetFormatInfo(Format format)
 		{
-			if ((static_cast<size_t>(format) - 1) < formatInfoTable.size())
+			if ((static_cast<size_t>(format) - 1) >= formatInfoTable.size())
 				return FormatInfo{ 0, 0, 0, 0, FormatType::Invalid, 0 };
 			return formatInfoTable[static_cast<size_t>(format) - 1];
 		}
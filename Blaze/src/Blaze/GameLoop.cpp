@@ -0,0 +1,212 @@
+#include <pch.h>
+#include <Blaze/GameLoop.h>
+#include <Blaze/Profiling/Profiler.h>
+#include <Blaze/Profiling/FlightRecorder.h>
+
+#include <cmath>
+
+#ifdef BLAZE_SIMD_SSE2
+#include <emmintrin.h>
+#endif // BLAZE_SIMD_SSE2
+
+#if defined(BLAZE_PLATFORM_WIN32) || defined(BLAZE_PLATFORM_WIN64)
+// Windows 10 1803 and later, older SDKs don't define it
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+#endif // BLAZE_PLATFORM_WIN32 || BLAZE_PLATFORM_WIN64
+
+namespace Blaze
+{
+	namespace Details
+	{
+		// Sleeps are measured for this long before the estimate only follows recent sleeps
+		constexpr uint32_t maxSleepSamples = 64;
+
+		static void SpinPause()
+		{
+#ifdef BLAZE_SIMD_SSE2
+			_mm_pause();
+#else // ^^^ BLAZE_SIMD_SSE2 / !BLAZE_SIMD_SSE2 vvv
+			std::this_thread::yield();
+#endif // ^^^ !BLAZE_SIMD_SSE2
+		}
+	}
+
+	FrameLimiter::FrameLimiter(double targetFrameRate)
+	{
+#if defined(BLAZE_PLATFORM_WIN32) || defined(BLAZE_PLATFORM_WIN64)
+		// Plain Sleep rounds up to the 15.6ms system tick unless the whole system's timer resolution is raised
+		m_timer = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+		if (!m_timer)
+			m_timer = CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+#endif // BLAZE_PLATFORM_WIN32 || BLAZE_PLATFORM_WIN64
+
+		SetTargetFrameRate(targetFrameRate);
+	}
+
+	FrameLimiter::~FrameLimiter()
+	{
+#if defined(BLAZE_PLATFORM_WIN32) || defined(BLAZE_PLATFORM_WIN64)
+		if (m_timer)
+			CloseHandle(m_timer);
+#endif // BLAZE_PLATFORM_WIN32 || BLAZE_PLATFORM_WIN64
+	}
+
+	void FrameLimiter::SetTargetFrameRate(double targetFrameRate)
+	{
+		m_targetFrameRate = std::max(targetFrameRate, 0.0);
+		m_framePeriod = (m_targetFrameRate > 0.0) ? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / m_targetFrameRate)) : Clock::duration{ 0 };
+		m_nextFrame = Clock::now();
+	}
+
+	void FrameLimiter::Wait()
+	{
+		const Clock::time_point now = Clock::now();
+		if (m_framePeriod.count() == 0)
+		{
+			m_nextFrame = now;
+			return;
+		}
+
+		m_nextFrame += m_framePeriod;
+		if (now >= m_nextFrame)
+		{
+			// Late, frames are scheduled from now on so a hitch isn't followed by a burst of short frames
+			m_nextFrame = now;
+			return;
+		}
+
+		WaitUntil(m_nextFrame);
+	}
+
+	void FrameLimiter::WaitUntil(Clock::time_point deadline)
+	{
+		// Sleeps as long as the remaining time is safely longer than a sleep, mean plus one standard deviation
+		while (true)
+		{
+			const double remaining = std::chrono::duration<double>(deadline - Clock::now()).count();
+			const double sleepEstimate = m_sleepMean + std::sqrt(m_sleepM2 / m_numSleeps);
+			if (remaining <= sleepEstimate)
+				break;
+
+			SleepOnce();
+		}
+
+		while (Clock::now() < deadline)
+			Details::SpinPause();
+	}
+
+	void FrameLimiter::SleepOnce()
+	{
+		const Clock::time_point start = Clock::now();
+
+#if defined(BLAZE_PLATFORM_WIN32) || defined(BLAZE_PLATFORM_WIN64)
+		if (m_timer)
+		{
+			// Negative due times are relative, in 100ns units
+			LARGE_INTEGER dueTime;
+			dueTime.QuadPart = -10000;
+			if (SetWaitableTimerEx(m_timer, &dueTime, 0, nullptr, nullptr, nullptr, 0))
+				WaitForSingleObject(m_timer, INFINITE);
+			else
+				Sleep(1);
+		}
+		else
+		{
+			Sleep(1);
+		}
+#else // ^^^ Windows (Win32) / Other vvv
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+#endif // ^^^ Other
+
+		const double duration = std::chrono::duration<double>(Clock::now() - start).count();
+
+		// Once there are enough samples the count stops growing, so the estimate follows changes in timer resolution
+		if (m_numSleeps < Details::maxSleepSamples)
+			m_numSleeps++;
+		const double delta = duration - m_sleepMean;
+		m_sleepMean += delta / m_numSleeps;
+		m_sleepM2 += delta * (duration - m_sleepMean);
+		if (m_numSleeps == Details::maxSleepSamples)
+			m_sleepM2 *= static_cast<double>(m_numSleeps - 1) / m_numSleeps;
+	}
+
+	GameLoop::GameLoop(const GameLoopConfig& config)
+		:m_tickPeriod(std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / std::max(config.tickRate, 1.0)))),
+		m_maxTicksPerFrame(std::max(config.maxTicksPerFrame, 1u)), m_frameLimiter(config.targetFrameRate)
+	{
+	}
+
+	uint32_t GameLoop::BeginFrame()
+	{
+		const Clock::time_point now = Clock::now();
+
+		if (m_numFrames != 0)
+		{
+			const Clock::duration frameTime = now - m_frameStart;
+			m_frameTimes[(m_numFrames - 1) % frameStatsWindowSize] = std::chrono::duration<float>(frameTime).count();
+			m_accumulator += frameTime;
+		}
+		m_frameStart = now;
+		m_numFrames++;
+
+		// Whole ticks are taken out of the accumulator, the fraction left over is the interpolation alpha
+		uint64_t numTicks = static_cast<uint64_t>(m_accumulator / m_tickPeriod);
+		m_accumulator -= static_cast<Clock::rep>(numTicks) * m_tickPeriod;
+		if (numTicks > m_maxTicksPerFrame)
+		{
+			m_numDroppedTicks += numTicks - m_maxTicksPerFrame;
+			numTicks = m_maxTicksPerFrame;
+		}
+
+		m_numTicks += numTicks;
+		m_interpolationAlpha = std::chrono::duration<double>(m_accumulator) / std::chrono::duration<double>(m_tickPeriod);
+		return static_cast<uint32_t>(numTicks);
+	}
+
+	void GameLoop::EndFrame()
+	{
+		m_workTimes[(m_numFrames - 1) % frameStatsWindowSize] = std::chrono::duration<float>(Clock::now() - m_frameStart).count();
+
+		BLAZE_PROFILE_SCOPE("FrameLimiter::Wait");
+		BLAZE_FLIGHT_TIMER(FlightMetric::FrameLimiterWaitTime);
+		m_frameLimiter.Wait();
+	}
+
+	FrameStats GameLoop::GetStats() const
+	{
+		FrameStats stats;
+		stats.numFrames = m_numFrames;
+		stats.numTicks = m_numTicks;
+		stats.numDroppedTicks = m_numDroppedTicks;
+
+		// The frame that's running has no frame time yet
+		const size_t numFrameTimes = static_cast<size_t>(std::min<uint64_t>(m_numFrames ? m_numFrames - 1 : 0, frameStatsWindowSize));
+		if (numFrameTimes == 0)
+			return stats;
+
+		stats.lastFrameTime = m_frameTimes[(m_numFrames - 2) % frameStatsWindowSize];
+		stats.minFrameTime = m_frameTimes[0];
+		stats.maxFrameTime = m_frameTimes[0];
+
+		double sum = 0.0;
+		double workSum = 0.0;
+		for (size_t i = 0; i < numFrameTimes; i++)
+		{
+			sum += m_frameTimes[i];
+			workSum += m_workTimes[i];
+			stats.minFrameTime = std::min<double>(stats.minFrameTime, m_frameTimes[i]);
+			stats.maxFrameTime = std::max<double>(stats.maxFrameTime, m_frameTimes[i]);
+		}
+		stats.averageFrameTime = sum / numFrameTimes;
+		stats.averageWorkTime = workSum / numFrameTimes;
+
+		double variance = 0.0;
+		for (size_t i = 0; i < numFrameTimes; i++)
+			variance += (m_frameTimes[i] - stats.averageFrameTime) * (m_frameTimes[i] - stats.averageFrameTime);
+		stats.frameTimeDeviation = std::sqrt(variance / numFrameTimes);
+
+		return stats;
+	}
+}
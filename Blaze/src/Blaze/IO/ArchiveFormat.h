@@ -0,0 +1,56 @@
+#pragma once
+
+#ifndef BLAZE_IO_ARCHIVEFORMAT_H
+#define BLAZE_IO_ARCHIVEFORMAT_H
+
+#include <Blaze/Core.h>
+
+namespace Blaze
+{
+	namespace Details
+	{
+		constexpr uint32_t archiveMagic = 0x52415A42; // "BZAR"
+		constexpr uint32_t archiveVersion = 1;
+
+		// Layout: header, compressed blocks, block table, file table, then the file paths
+		// The files are concatenated into one stream that gets split into blocks, so small files share blocks
+		struct ArchiveHeader
+		{
+			uint32_t magic;
+			uint32_t version;
+			uint32_t blockSize;
+			uint32_t numBlocks;
+			uint32_t numFiles;
+			uint32_t pathsSize;
+			// Uncompressed size of all the files
+			uint64_t streamSize;
+			// Offset of the block table, the file table and paths follow it
+			uint64_t tableOffset;
+		};
+
+		enum class ArchiveBlockFlags : uint32_t
+		{
+			None = 0,
+			// Stored without compression because it didn't compress
+			Uncompressed = 0x01
+		};
+
+		struct ArchiveBlock
+		{
+			uint64_t offset;
+			uint32_t compressedSize;
+			uint32_t flags;
+		};
+
+		struct ArchiveFile
+		{
+			// Offset in the uncompressed stream
+			uint64_t streamOffset;
+			uint64_t size;
+			uint32_t pathOffset;
+			uint32_t pathLength;
+		};
+	}
+}
+
+#endif // BLAZE_IO_ARCHIVEFORMAT_H
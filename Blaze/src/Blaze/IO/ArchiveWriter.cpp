@@ -0,0 +1,99 @@
+#include <pch.h>
+#include <Blaze/IO/FileSystem.h>
+#include "ArchiveFormat.h"
+#include "LZ4.h"
+
+#include <cstring>
+
+namespace Blaze
+{
+	Result WriteArchive(const std::string& path, const ArchiveFileDesc* files, size_t numFiles, uint32_t blockSize)
+	{
+		if ((!files && numFiles) || (numFiles > UINT32_MAX) || (blockSize == 0))
+			return Result::InvalidParam;
+
+		Details::ArchiveHeader header{};
+		header.magic = Details::archiveMagic;
+		header.version = Details::archiveVersion;
+		header.blockSize = blockSize;
+		header.numFiles = static_cast<uint32_t>(numFiles);
+
+		std::vector<Details::ArchiveFile> fileTable(numFiles);
+		std::string paths;
+		for (size_t i = 0; i < numFiles; i++)
+		{
+			if (!files[i].data && files[i].size)
+				return Result::InvalidParam;
+
+			fileTable[i] = Details::ArchiveFile{ header.streamSize, static_cast<uint64_t>(files[i].size), static_cast<uint32_t>(paths.size()), static_cast<uint32_t>(files[i].path.size()) };
+			paths.append(files[i].path);
+			header.streamSize += files[i].size;
+		}
+		header.pathsSize = static_cast<uint32_t>(paths.size());
+
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		if (!file)
+			return Result::SystemError;
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+		// Gathers each block from the files it spans, then compresses it
+		std::vector<Details::ArchiveBlock> blockTable;
+		std::vector<uint8_t> block(blockSize);
+		std::vector<uint8_t> compressed(Details::LZ4CompressBound(blockSize));
+
+		uint64_t offset = sizeof(header);
+		size_t fileIndex = 0;
+		uint64_t fileOffset = 0;
+		for (uint64_t streamOffset = 0; streamOffset < header.streamSize; streamOffset += blockSize)
+		{
+			const size_t blockBytes = static_cast<size_t>(std::min<uint64_t>(blockSize, header.streamSize - streamOffset));
+			for (size_t filled = 0; filled < blockBytes;)
+			{
+				if (fileOffset == files[fileIndex].size)
+				{
+					fileIndex++;
+					fileOffset = 0;
+					continue;
+				}
+
+				size_t count = static_cast<size_t>(std::min<uint64_t>(blockBytes - filled, files[fileIndex].size - fileOffset));
+				std::memcpy(block.data() + filled, reinterpret_cast<const uint8_t*>(files[fileIndex].data) + fileOffset, count);
+				filled += count;
+				fileOffset += count;
+			}
+
+			size_t compressedSize = Details::LZ4Compress(block.data(), blockBytes, compressed.data(), compressed.size());
+			Details::ArchiveBlock blockEntry{ offset, 0, static_cast<uint32_t>(Details::ArchiveBlockFlags::None) };
+			if ((compressedSize == 0) || (compressedSize >= blockBytes))
+			{
+				blockEntry.compressedSize = static_cast<uint32_t>(blockBytes);
+				blockEntry.flags = static_cast<uint32_t>(Details::ArchiveBlockFlags::Uncompressed);
+				file.write(reinterpret_cast<const char*>(block.data()), blockBytes);
+			}
+			else
+			{
+				blockEntry.compressedSize = static_cast<uint32_t>(compressedSize);
+				file.write(reinterpret_cast<const char*>(compressed.data()), compressedSize);
+			}
+
+			blockTable.push_back(blockEntry);
+			offset += blockEntry.compressedSize;
+		}
+
+		if (blockTable.size() > UINT32_MAX)
+			return Result::InvalidParam;
+
+		header.numBlocks = static_cast<uint32_t>(blockTable.size());
+		header.tableOffset = offset;
+
+		file.write(reinterpret_cast<const char*>(blockTable.data()), blockTable.size() * sizeof(Details::ArchiveBlock));
+		file.write(reinterpret_cast<const char*>(fileTable.data()), fileTable.size() * sizeof(Details::ArchiveFile));
+		file.write(paths.data(), paths.size());
+
+		// The header is rewritten now that the table offset is known
+		file.seekp(0);
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+		return file ? Result::Success : Result::SystemError;
+	}
+}
@@ -0,0 +1,190 @@
+#include <pch.h>
+#include "LZ4.h"
+
+#include <cstring>
+
+namespace Blaze
+{
+	namespace Details
+	{
+		// Limits from the LZ4 block format specification
+		constexpr size_t lz4MinMatch = 4;
+		// The last 5 bytes are always literals
+		constexpr size_t lz4LastLiterals = 5;
+		// The last match has to start at least 12 bytes before the end
+		constexpr size_t lz4MatchFindLimit = 12;
+		constexpr size_t lz4MaxOffset = 65535;
+
+		constexpr uint32_t lz4HashLog = 12;
+
+		static uint32_t LZ4Read32(const uint8_t* ptr)
+		{
+			uint32_t value;
+			std::memcpy(&value, ptr, sizeof(value));
+			return value;
+		}
+
+		static uint32_t LZ4Hash(uint32_t sequence)
+		{
+			return (sequence * 2654435761u) >> (32 - lz4HashLog);
+		}
+
+		// Writes the 255 continuation bytes of a literal or match length
+		static uint8_t* LZ4WriteLength(uint8_t* op, size_t length)
+		{
+			for (; length >= 255; length -= 255)
+				*op++ = 255;
+			*op++ = static_cast<uint8_t>(length);
+			return op;
+		}
+
+		// Writes a sequence, matchLength 0 writes the literals at the end of the block
+		static uint8_t* LZ4WriteSequence(uint8_t* op, uint8_t* opEnd, const uint8_t* literals, size_t literalLength, size_t offset, size_t matchLength)
+		{
+			const size_t worstCase = 1 + literalLength + literalLength / 255 + 1 + 2 + matchLength / 255 + 1;
+			if (static_cast<size_t>(opEnd - op) < worstCase)
+				return nullptr;
+
+			uint8_t* token = op++;
+			*token = static_cast<uint8_t>(std::min<size_t>(literalLength, 15) << 4);
+			if (literalLength >= 15)
+				op = LZ4WriteLength(op, literalLength - 15);
+
+			std::memcpy(op, literals, literalLength);
+			op += literalLength;
+
+			if (matchLength == 0)
+				return op;
+
+			*op++ = static_cast<uint8_t>(offset);
+			*op++ = static_cast<uint8_t>(offset >> 8);
+
+			const size_t length = matchLength - lz4MinMatch;
+			*token |= static_cast<uint8_t>(std::min<size_t>(length, 15));
+			if (length >= 15)
+				op = LZ4WriteLength(op, length - 15);
+
+			return op;
+		}
+
+		size_t LZ4Compress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity)
+		{
+			uint8_t* op = dst;
+			uint8_t* const opEnd = dst + dstCapacity;
+			size_t anchor = 0;
+
+			if (srcSize > lz4MatchFindLimit)
+			{
+				// Positions + 1 of the last sequence with each hash, 0 is empty
+				std::array<uint32_t, 1 << lz4HashLog> table{};
+
+				const size_t matchLimit = srcSize - lz4LastLiterals;
+				const size_t matchFindLimit = srcSize - lz4MatchFindLimit;
+
+				size_t ip = 0;
+				while (ip <= matchFindLimit)
+				{
+					const uint32_t sequence = LZ4Read32(src + ip);
+					const uint32_t hash = LZ4Hash(sequence);
+					const size_t candidate = table[hash];
+					table[hash] = static_cast<uint32_t>(ip + 1);
+
+					if ((candidate == 0) || (ip - (candidate - 1) > lz4MaxOffset) || (LZ4Read32(src + candidate - 1) != sequence))
+					{
+						// Skip faster through data that doesn't compress
+						ip += 1 + ((ip - anchor) >> 6);
+						continue;
+					}
+
+					const size_t match = candidate - 1;
+					size_t length = lz4MinMatch;
+					while ((ip + length < matchLimit) && (src[match + length] == src[ip + length]))
+						length++;
+
+					op = LZ4WriteSequence(op, opEnd, src + anchor, ip - anchor, ip - match, length);
+					if (!op)
+						return 0;
+
+					ip += length;
+					anchor = ip;
+				}
+			}
+
+			op = LZ4WriteSequence(op, opEnd, src + anchor, srcSize - anchor, 0, 0);
+			if (!op)
+				return 0;
+
+			return static_cast<size_t>(op - dst);
+		}
+
+		Result LZ4Decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize)
+		{
+			const uint8_t* ip = src;
+			const uint8_t* const ipEnd = src + srcSize;
+			uint8_t* op = dst;
+			uint8_t* const opEnd = dst + dstSize;
+
+			// Reads the continuation bytes of a length
+			auto readLength = [&](size_t& length) -> bool
+			{
+				uint8_t byte;
+				do
+				{
+					if (ip == ipEnd)
+						return false;
+					byte = *ip++;
+					length += byte;
+				} while (byte == 255);
+				return true;
+			};
+
+			while (ip < ipEnd)
+			{
+				const uint8_t token = *ip++;
+
+				size_t literalLength = token >> 4;
+				if ((literalLength == 15) && !readLength(literalLength))
+					return Result::InvalidParam;
+				if ((static_cast<size_t>(ipEnd - ip) < literalLength) || (static_cast<size_t>(opEnd - op) < literalLength))
+					return Result::InvalidParam;
+
+				std::memcpy(op, ip, literalLength);
+				ip += literalLength;
+				op += literalLength;
+
+				// The last sequence only has literals
+				if (ip == ipEnd)
+					break;
+
+				if (ipEnd - ip < 2)
+					return Result::InvalidParam;
+				const size_t offset = ip[0] | (static_cast<size_t>(ip[1]) << 8);
+				ip += 2;
+				if ((offset == 0) || (offset > static_cast<size_t>(op - dst)))
+					return Result::InvalidParam;
+
+				size_t matchLength = token & 15;
+				if ((matchLength == 15) && !readLength(matchLength))
+					return Result::InvalidParam;
+				matchLength += lz4MinMatch;
+				if (static_cast<size_t>(opEnd - op) < matchLength)
+					return Result::InvalidParam;
+
+				const uint8_t* match = op - offset;
+				if (offset >= matchLength)
+				{
+					std::memcpy(op, match, matchLength);
+					op += matchLength;
+				}
+				else
+				{
+					// Overlapping matches repeat the last offset bytes
+					for (size_t i = 0; i < matchLength; i++)
+						*op++ = match[i];
+				}
+			}
+
+			return (op == opEnd) ? Result::Success : Result::InvalidParam;
+		}
+	}
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#ifndef BLAZE_IO_LZ4_H
+#define BLAZE_IO_LZ4_H
+
+#include <Blaze/Core.h>
+#include <Blaze/Error.h>
+
+namespace Blaze
+{
+	namespace Details
+	{
+		// Worst case size of LZ4Compress's output
+		constexpr size_t LZ4CompressBound(size_t srcSize) { return srcSize + srcSize / 255 + 16; }
+
+		// Compresses to the LZ4 block format (no frame), returns the compressed size or 0 if dst is too small
+		size_t LZ4Compress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity);
+		// Decompresses an LZ4 block, dstSize must be the exact decompressed size
+		// Safe against corrupt input, never reads or writes out of bounds
+		Result LZ4Decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize);
+	}
+}
+
+#endif // BLAZE_IO_LZ4_H
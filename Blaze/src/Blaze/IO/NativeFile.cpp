@@ -0,0 +1,117 @@
+#include <pch.h>
+#include "NativeFile.h"
+
+#if defined(BLAZE_PLATFORM_LINUX)
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#endif // BLAZE_PLATFORM_LINUX
+
+namespace Blaze
+{
+	namespace Details
+	{
+#if defined(BLAZE_PLATFORM_WIN32) || defined(BLAZE_PLATFORM_WIN64)
+		Result OpenNativeFile(const std::string& path, NativeFile& file)
+		{
+			std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>> converter;
+			std::wstring pathWide = converter.from_bytes(path);
+
+			HANDLE handle = CreateFileW(pathWide.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+			if (handle == INVALID_HANDLE_VALUE)
+			{
+				DWORD error = GetLastError();
+				return (error == ERROR_FILE_NOT_FOUND) || (error == ERROR_PATH_NOT_FOUND) ? Result::NotFound : Result::SystemError;
+			}
+
+			file = reinterpret_cast<NativeFile>(handle);
+			return Result::Success;
+		}
+
+		void CloseNativeFile(NativeFile file)
+		{
+			if (file != invalidNativeFile)
+				CloseHandle(reinterpret_cast<HANDLE>(file));
+		}
+
+		Result GetNativeFileSize(NativeFile file, uint64_t& size)
+		{
+			LARGE_INTEGER fileSize;
+			if (!GetFileSizeEx(reinterpret_cast<HANDLE>(file), &fileSize))
+				return Result::SystemError;
+
+			size = static_cast<uint64_t>(fileSize.QuadPart);
+			return Result::Success;
+		}
+
+		Result ReadNativeFile(NativeFile file, uint64_t offset, void* dst, size_t size, size_t& bytesRead)
+		{
+			bytesRead = 0;
+			while (bytesRead < size)
+			{
+				// The offset in the OVERLAPPED makes the read positional on a synchronous handle
+				OVERLAPPED overlapped{};
+				overlapped.Offset = static_cast<DWORD>(offset + bytesRead);
+				overlapped.OffsetHigh = static_cast<DWORD>((offset + bytesRead) >> 32);
+
+				DWORD chunk = static_cast<DWORD>(std::min<size_t>(size - bytesRead, 0x40000000));
+				DWORD chunkRead = 0;
+				if (!ReadFile(reinterpret_cast<HANDLE>(file), reinterpret_cast<uint8_t*>(dst) + bytesRead, chunk, &chunkRead, &overlapped))
+					return (GetLastError() == ERROR_HANDLE_EOF) ? Result::Success : Result::SystemError;
+				if (chunkRead == 0)
+					break;
+
+				bytesRead += chunkRead;
+			}
+			return Result::Success;
+		}
+#elif defined(BLAZE_PLATFORM_LINUX) // ^^^ Windows (Win32) / Linux (Posix) vvv
+		Result OpenNativeFile(const std::string& path, NativeFile& file)
+		{
+			int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+			if (fd < 0)
+				return (errno == ENOENT) ? Result::NotFound : Result::SystemError;
+
+			file = static_cast<NativeFile>(fd);
+			return Result::Success;
+		}
+
+		void CloseNativeFile(NativeFile file)
+		{
+			if (file != invalidNativeFile)
+				close(static_cast<int>(file));
+		}
+
+		Result GetNativeFileSize(NativeFile file, uint64_t& size)
+		{
+			struct stat fileStat;
+			if (fstat(static_cast<int>(file), &fileStat) != 0)
+				return Result::SystemError;
+
+			size = static_cast<uint64_t>(fileStat.st_size);
+			return Result::Success;
+		}
+
+		Result ReadNativeFile(NativeFile file, uint64_t offset, void* dst, size_t size, size_t& bytesRead)
+		{
+			bytesRead = 0;
+			while (bytesRead < size)
+			{
+				ssize_t chunkRead = pread(static_cast<int>(file), reinterpret_cast<uint8_t*>(dst) + bytesRead, size - bytesRead, static_cast<off_t>(offset + bytesRead));
+				if (chunkRead < 0)
+				{
+					if (errno == EINTR)
+						continue;
+					return Result::SystemError;
+				}
+				if (chunkRead == 0)
+					break;
+
+				bytesRead += static_cast<size_t>(chunkRead);
+			}
+			return Result::Success;
+		}
+#endif // ^^^ Linux (Posix)
+	}
+}
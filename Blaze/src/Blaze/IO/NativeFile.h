@@ -0,0 +1,26 @@
+#pragma once
+
+#ifndef BLAZE_IO_NATIVEFILE_H
+#define BLAZE_IO_NATIVEFILE_H
+
+#include <Blaze/Core.h>
+#include <Blaze/Error.h>
+
+namespace Blaze
+{
+	namespace Details
+	{
+		// A HANDLE on Windows, a file descriptor elsewhere
+		using NativeFile = intptr_t;
+		constexpr NativeFile invalidNativeFile = -1;
+
+		// Opens a file for reading, the file can be read from several threads at once
+		Result OpenNativeFile(const std::string& path, NativeFile& file);
+		void CloseNativeFile(NativeFile file);
+		Result GetNativeFileSize(NativeFile file, uint64_t& size);
+		// Reads at an offset without moving a shared file pointer, bytesRead is less than size at the end of the file
+		Result ReadNativeFile(NativeFile file, uint64_t offset, void* dst, size_t size, size_t& bytesRead);
+	}
+}
+
+#endif // BLAZE_IO_NATIVEFILE_H
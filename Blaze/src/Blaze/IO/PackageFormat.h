@@ -0,0 +1,106 @@
+#pragma once
+
+#ifndef BLAZE_IO_PACKAGEFORMAT_H
+#define BLAZE_IO_PACKAGEFORMAT_H
+
+#include <Blaze/Core.h>
+#include <Blaze/IO/Package.h>
+
+#include <cstring>
+
+namespace Blaze
+{
+	namespace Details
+	{
+		constexpr uint32_t packageMagic = 0x4B505A42; // "BZPK"
+
+		// Layout: header, table of contents, then the blobs at packageBlobAlignment
+		struct PackageHeader
+		{
+			uint32_t magic;
+			uint32_t version;
+			uint32_t numBlobs;
+			// Number of table of contents slots, a power of 2
+			uint32_t tocCapacity;
+			uint64_t tocOffset;
+			uint64_t fileSize;
+		};
+
+		// Table of contents slot, an open addressing hash table so lookups read the mapping directly
+		struct PackageTocEntry
+		{
+			// 0 for empty slots
+			uint64_t nameHash;
+			uint64_t offset;
+			uint64_t size;
+			uint32_t tag;
+			uint32_t reserved;
+		};
+
+		// Checks that a mapping holds a package this version can read
+		inline Result ValidatePackage(const uint8_t* base, size_t size)
+		{
+			if (size < sizeof(PackageHeader))
+				return Result::InvalidParam;
+
+			PackageHeader header;
+			std::memcpy(&header, base, sizeof(header));
+
+			if ((header.magic != packageMagic) || (header.version != packageVersion) || (header.fileSize != size))
+				return Result::InvalidParam;
+			if ((header.tocCapacity == 0) || (header.tocCapacity & (header.tocCapacity - 1)) || (header.numBlobs > header.tocCapacity))
+				return Result::InvalidParam;
+			if ((header.tocOffset > size) || (static_cast<uint64_t>(header.tocCapacity) * sizeof(PackageTocEntry) > size - header.tocOffset))
+				return Result::InvalidParam;
+
+			return Result::Success;
+		}
+
+		// Looks up a blob in the table of contents of a validated package
+		inline Result FindPackageBlob(const uint8_t* base, size_t size, uint64_t nameHash, PackageBlob& blob)
+		{
+			if (nameHash == 0)
+				return Result::NotFound;
+
+			PackageHeader header;
+			std::memcpy(&header, base, sizeof(header));
+
+			const uint8_t* toc = base + header.tocOffset;
+			const uint32_t mask = header.tocCapacity - 1;
+
+			// Linear probing, the table is at most half full so probe sequences stay short
+			for (uint32_t i = 0, slot = static_cast<uint32_t>(nameHash) & mask; i < header.tocCapacity; i++, slot = (slot + 1) & mask)
+			{
+				PackageTocEntry entry;
+				std::memcpy(&entry, toc + slot * sizeof(PackageTocEntry), sizeof(entry));
+
+				if (entry.nameHash == 0)
+					return Result::NotFound;
+				if (entry.nameHash != nameHash)
+					continue;
+
+				if ((entry.offset > size) || (entry.size > size - entry.offset))
+					return Result::InvalidParam;
+
+				blob.data = base + entry.offset;
+				blob.size = static_cast<size_t>(entry.size);
+				blob.tag = entry.tag;
+				return Result::Success;
+			}
+
+			return Result::NotFound;
+		}
+
+		// Widens a blob to the pages it touches, OS page hints need page-aligned ranges
+		inline void GetPackageBlobPages(const uint8_t* base, const PackageBlob& blob, const uint8_t*& begin, size_t& size)
+		{
+			const size_t offset = static_cast<size_t>(reinterpret_cast<const uint8_t*>(blob.data) - base);
+			const size_t alignedOffset = offset & ~static_cast<size_t>(packageBlobAlignment - 1);
+
+			begin = base + alignedOffset;
+			size = blob.size + (offset - alignedOffset);
+		}
+	}
+}
+
+#endif // BLAZE_IO_PACKAGEFORMAT_H
@@ -0,0 +1,84 @@
+#include <pch.h>
+#include <Blaze/IO/Package.h>
+#include "PackageFormat.h"
+
+namespace Blaze
+{
+	namespace Details
+	{
+		static uint64_t AlignPackageOffset(uint64_t offset)
+		{
+			return (offset + packageBlobAlignment - 1) & ~(packageBlobAlignment - 1);
+		}
+	}
+
+	Result WritePackage(const std::string& path, const PackageBlobDesc* blobs, size_t numBlobs)
+	{
+		if ((!blobs && numBlobs) || (numBlobs > UINT32_MAX / 2))
+			return Result::InvalidParam;
+
+		// Keep the table at most half full
+		uint32_t tocCapacity = 1;
+		while (tocCapacity < numBlobs * 2)
+			tocCapacity <<= 1;
+
+		Details::PackageHeader header;
+		header.magic = Details::packageMagic;
+		header.version = packageVersion;
+		header.numBlobs = static_cast<uint32_t>(numBlobs);
+		header.tocCapacity = tocCapacity;
+		header.tocOffset = sizeof(Details::PackageHeader);
+
+		std::vector<Details::PackageTocEntry> toc(tocCapacity, Details::PackageTocEntry{});
+		std::vector<uint64_t> offsets(numBlobs);
+
+		uint64_t offset = Details::AlignPackageOffset(header.tocOffset + tocCapacity * sizeof(Details::PackageTocEntry));
+		for (size_t i = 0; i < numBlobs; i++)
+		{
+			const auto& blob = blobs[i];
+			if (!blob.data && blob.size)
+				return Result::InvalidParam;
+
+			const uint64_t nameHash = HashPackageName(blob.name);
+			const uint32_t mask = tocCapacity - 1;
+
+			uint32_t slot = static_cast<uint32_t>(nameHash) & mask;
+			for (; toc[slot].nameHash != 0; slot = (slot + 1) & mask)
+			{
+				// Lookups only see the hash, so colliding names can't both be stored
+				if (toc[slot].nameHash == nameHash)
+					return Result::InvalidParam;
+			}
+
+			offsets[i] = offset;
+			toc[slot] = Details::PackageTocEntry{ nameHash, offset, static_cast<uint64_t>(blob.size), blob.tag, 0 };
+			offset = Details::AlignPackageOffset(offset + blob.size);
+		}
+		header.fileSize = offset;
+
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		if (!file)
+			return Result::SystemError;
+
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		file.write(reinterpret_cast<const char*>(toc.data()), toc.size() * sizeof(Details::PackageTocEntry));
+
+		// Pads the file with zeros up to an offset
+		const std::vector<char> padding(packageBlobAlignment, 0);
+		auto padTo = [&](uint64_t target)
+		{
+			uint64_t position = static_cast<uint64_t>(file.tellp());
+			if (target > position)
+				file.write(padding.data(), static_cast<std::streamsize>(target - position));
+		};
+
+		for (size_t i = 0; i < numBlobs; i++)
+		{
+			padTo(offsets[i]);
+			file.write(reinterpret_cast<const char*>(blobs[i].data), static_cast<std::streamsize>(blobs[i].size));
+		}
+		padTo(header.fileSize);
+
+		return file ? Result::Success : Result::SystemError;
+	}
+}
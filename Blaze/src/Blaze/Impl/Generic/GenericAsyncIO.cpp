@@ -0,0 +1,329 @@
+#include <pch.h>
+#include "GenericAsyncIO.h"
+#include <Blaze/Profiling/Profiler.h>
+#include <Blaze/Memory/AllocationTracker.h>
+
+namespace Blaze
+{
+	namespace Generic
+	{
+		GenericAsyncIO::~GenericAsyncIO()
+		{
+			Destroy_Impl();
+		}
+
+		Result GenericAsyncIO::Create_Impl(const ObjectCreateInfo& createInfo)
+		{
+			const auto& info = static_cast<const AsyncIOCreateInfo&>(createInfo);
+			return StartWorkers(info.numWorkers, info.queueDepth, true);
+		}
+
+		Result GenericAsyncIO::Destroy_Impl()
+		{
+			StopWorkers();
+
+			std::lock_guard<std::mutex> guard(m_mutex);
+			for (auto file : m_files)
+				Details::CloseNativeFile(file);
+			m_files.clear();
+
+			return Result::Success;
+		}
+
+		Ref<Object> GenericAsyncIO::CastTo_Impl(ClassID objectID)
+		{
+			constexpr std::array<ClassID, 3> castableIDs = {
+				Object::GetStaticClassID(),
+				AsyncIO::GetStaticClassID(),
+				GetStaticClassID()
+			};
+
+			// Check to make sure the class ID is valid
+			if (std::find(castableIDs.begin(), castableIDs.end(), objectID) == castableIDs.end())
+				return Ref<Object>{ nullptr };
+
+			return shared_from_this();
+		}
+
+		Result GenericAsyncIO::OpenFile_Impl(const std::string& path, IOFileID& file)
+		{
+			Details::NativeFile nativeFile;
+			Result res = Details::OpenNativeFile(path, nativeFile);
+			if (res != Result::Success)
+				return res;
+
+			std::lock_guard<std::mutex> guard(m_mutex);
+
+			// Reuse the slot of a closed file
+			auto it = std::find(m_files.begin(), m_files.end(), Details::invalidNativeFile);
+			if (it == m_files.end())
+				it = m_files.insert(m_files.end(), nativeFile);
+			else
+				*it = nativeFile;
+
+			file = static_cast<IOFileID>(it - m_files.begin()) + 1;
+			return Result::Success;
+		}
+
+		Result GenericAsyncIO::CloseFile_Impl(IOFileID file)
+		{
+			std::lock_guard<std::mutex> guard(m_mutex);
+			if ((file == 0) || (file > m_files.size()) || (m_files[file - 1] == Details::invalidNativeFile))
+				return Result::InvalidParam;
+
+			Details::CloseNativeFile(m_files[file - 1]);
+			m_files[file - 1] = Details::invalidNativeFile;
+			return Result::Success;
+		}
+
+		Result GenericAsyncIO::GetFileSize_Impl(IOFileID file, uint64_t& size)
+		{
+			Details::NativeFile nativeFile;
+			{
+				std::lock_guard<std::mutex> guard(m_mutex);
+				if ((file == 0) || (file > m_files.size()) || (m_files[file - 1] == Details::invalidNativeFile))
+					return Result::InvalidParam;
+				nativeFile = m_files[file - 1];
+			}
+
+			return Details::GetNativeFileSize(nativeFile, size);
+		}
+
+		Result GenericAsyncIO::Read_Impl(const IOReadRequest& request, IORequestID& requestID)
+		{
+			if ((!request.buffer && request.size) || (request.priority == IOPriority::Invalid) || (request.priority > IOPriority::NumPriorities))
+				return Result::InvalidParam;
+
+			std::lock_guard<std::mutex> guard(m_mutex);
+			if (m_workers.empty() || m_isStopping)
+				return Result::Uninitialized;
+			if ((request.file == 0) || (request.file > m_files.size()) || (m_files[request.file - 1] == Details::invalidNativeFile))
+				return Result::InvalidParam;
+
+			auto newRequest = std::make_unique<Request>();
+			newRequest->id = m_nextRequestID++;
+			newRequest->file = m_files[request.file - 1];
+			newRequest->offset = request.offset;
+			newRequest->size = request.size;
+			newRequest->buffer = request.buffer;
+			newRequest->priority = request.priority;
+			newRequest->callback = request.callback;
+
+			requestID = newRequest->id;
+			m_pending[static_cast<size_t>(request.priority) - 1].push_back(newRequest.get());
+			m_requests.emplace(requestID, std::move(newRequest));
+
+			OnReadQueued();
+			return Result::Success;
+		}
+
+		Result GenericAsyncIO::Cancel_Impl(IORequestID requestID)
+		{
+			std::lock_guard<std::mutex> guard(m_mutex);
+
+			Request* request = FindRequest(requestID);
+			if (!request)
+				return Result::NotFound;
+
+			if (request->state == RequestState::Pending)
+			{
+				auto& queue = m_pending[static_cast<size_t>(request->priority) - 1];
+				queue.erase(std::find(queue.begin(), queue.end(), request));
+				PushCompleted(request, Result::Cancelled, 0);
+			}
+			else if (!request->isCancelled)
+			{
+				request->isCancelled = true;
+				OnCancelInFlight(request);
+			}
+
+			return Result::Success;
+		}
+
+		Result GenericAsyncIO::WaitIdle_Impl()
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_idleCondition.wait(lock, [&]() { return m_requests.empty(); });
+			return Result::Success;
+		}
+
+		AsyncIOStats GenericAsyncIO::GetStats_Impl()
+		{
+			std::lock_guard<std::mutex> guard(m_mutex);
+			return m_stats;
+		}
+
+		Result GenericAsyncIO::StartWorkers(uint32_t numWorkers, uint32_t queueDepth, bool isReadingOnWorkers)
+		{
+			if (queueDepth == 0)
+				return Result::InvalidParam;
+
+			// Reads mostly wait on the disk, but callbacks decode on these threads too
+			if (numWorkers == 0)
+				numWorkers = std::max(2u, std::thread::hardware_concurrency() / 2);
+
+			m_queueDepth = queueDepth;
+			m_isReadingOnWorkers = isReadingOnWorkers;
+			m_isStopping = false;
+
+			for (uint32_t i = 0; i < numWorkers; i++)
+				m_workers.emplace_back(&GenericAsyncIO::WorkerMain, this);
+
+			return Result::Success;
+		}
+
+		void GenericAsyncIO::StopWorkers()
+		{
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				if (m_workers.empty())
+					return;
+
+				for (auto& queue : m_pending)
+				{
+					for (auto request : queue)
+						PushCompleted(request, Result::Cancelled, 0);
+					queue.clear();
+				}
+
+				for (auto& request : m_requests)
+				{
+					if ((request.second->state == RequestState::InFlight) && !request.second->isCancelled)
+					{
+						request.second->isCancelled = true;
+						OnCancelInFlight(request.second.get());
+					}
+				}
+
+				m_idleCondition.wait(lock, [&]() { return m_requests.empty(); });
+				m_isStopping = true;
+			}
+
+			m_workerCondition.notify_all();
+			for (auto& worker : m_workers)
+				worker.join();
+			m_workers.clear();
+		}
+
+		bool GenericAsyncIO::HasPending() const
+		{
+			return std::any_of(m_pending.begin(), m_pending.end(), [](const std::deque<Request*>& queue) { return !queue.empty(); });
+		}
+
+		GenericAsyncIO::Request* GenericAsyncIO::FindRequest(IORequestID requestID)
+		{
+			auto it = m_requests.find(requestID);
+			if ((it == m_requests.end()) || (it->second->state == RequestState::Completed))
+				return nullptr;
+			return it->second.get();
+		}
+
+		GenericAsyncIO::Request* GenericAsyncIO::PopPending()
+		{
+			for (auto& queue : m_pending)
+			{
+				if (queue.empty())
+					continue;
+
+				Request* request = queue.front();
+				queue.pop_front();
+
+				request->state = RequestState::InFlight;
+				m_numInFlight++;
+				m_stats.maxReadsInFlight = std::max(m_stats.maxReadsInFlight, m_numInFlight);
+				return request;
+			}
+			return nullptr;
+		}
+
+		void GenericAsyncIO::PushCompleted(Request* request, Result result, size_t bytesRead)
+		{
+			// Data that arrives after a cancel is dropped
+			if (request->isCancelled)
+				result = Result::Cancelled;
+
+			request->state = RequestState::Completed;
+			request->result = result;
+			request->bytesRead = (result == Result::Success) ? bytesRead : 0;
+
+			switch (result)
+			{
+			case Result::Success:
+				m_stats.numCompleted++;
+				m_stats.bytesRead += bytesRead;
+				break;
+			case Result::Cancelled:
+				m_stats.numCancelled++;
+				break;
+			default:
+				m_stats.numFailed++;
+				break;
+			}
+
+			m_completed.push_back(request);
+			m_workerCondition.notify_one();
+		}
+
+		void GenericAsyncIO::OnReadQueued()
+		{
+			if (m_isReadingOnWorkers)
+				m_workerCondition.notify_one();
+		}
+
+		void GenericAsyncIO::WorkerMain()
+		{
+			Profiler::SetThreadName("Async IO Worker");
+			AllocationTracker::SetThreadTag(AllocationTag::IO);
+
+			std::unique_lock<std::mutex> lock(m_mutex);
+			while (true)
+			{
+				m_workerCondition.wait(lock, [&]()
+				{
+					return m_isStopping || !m_completed.empty() || (m_isReadingOnWorkers && (m_numInFlight < m_queueDepth) && HasPending());
+				});
+
+				// Callbacks go first, they release buffers and queue the reads of the next decode stage
+				if (!m_completed.empty())
+				{
+					Request* request = m_completed.front();
+					m_completed.pop_front();
+
+					lock.unlock();
+					RunCallback(request);
+					lock.lock();
+
+					m_requests.erase(request->id);
+					if (m_requests.empty())
+						m_idleCondition.notify_all();
+					continue;
+				}
+
+				if (m_isStopping)
+					return;
+
+				Request* request = PopPending();
+
+				lock.unlock();
+				size_t bytesRead = 0;
+				Result res = Details::ReadNativeFile(request->file, request->offset, request->buffer, request->size, bytesRead);
+				lock.lock();
+
+				m_stats.numSystemCalls++;
+				m_numInFlight--;
+				PushCompleted(request, res, bytesRead);
+			}
+		}
+
+		void GenericAsyncIO::RunCallback(Request* request)
+		{
+			if (request->callback)
+				request->callback(IOReadResult{ request->id, request->result, request->buffer, request->bytesRead });
+		}
+	}
+}
+
+Blaze::Generic::GenericAsyncIO* AllocateGenericAsyncIO()
+{
+	return new Blaze::Generic::GenericAsyncIO();
+}
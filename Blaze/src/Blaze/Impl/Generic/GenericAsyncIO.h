@@ -0,0 +1,124 @@
+#pragma once
+
+#ifndef BLAZE_GENERIC_GENERICASYNCIO_H
+#define BLAZE_GENERIC_GENERICASYNCIO_H
+
+#include <Blaze/Core.h>
+#include <Blaze/Error.h>
+#include <Blaze/IO/AsyncIO.h>
+#include <Blaze/IO/NativeFile.h>
+
+#include <array>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace Blaze
+{
+	namespace Generic
+	{
+		// Thread pool backend, workers pop the highest priority read and block on it
+		// Also owns the request queues and callback workers other backends build on
+		class GenericAsyncIO
+			:public AsyncIO
+		{
+		public:
+			GenericAsyncIO() { classID = GetStaticClassID(); }
+			~GenericAsyncIO();
+
+			constexpr static ClassID GetStaticClassID() { return Details::MakeClassID(Details::InterfaceID::AsyncIO, Details::ImplementationID::Generic); }
+
+			virtual Result Create_Impl(const ObjectCreateInfo& createInfo) override;
+			virtual Result Destroy_Impl() override;
+
+			virtual Ref<Object> CastTo_Impl(ClassID objectID) override;
+
+			virtual Result OpenFile_Impl(const std::string& path, IOFileID& file) override;
+			virtual Result CloseFile_Impl(IOFileID file) override;
+			virtual Result GetFileSize_Impl(IOFileID file, uint64_t& size) override;
+			virtual Result Read_Impl(const IOReadRequest& request, IORequestID& requestID) override;
+			virtual Result Cancel_Impl(IORequestID requestID) override;
+			virtual Result WaitIdle_Impl() override;
+			inline virtual AsyncIOBackend GetBackend_Impl() override { return AsyncIOBackend::ThreadPool; }
+			virtual AsyncIOStats GetStats_Impl() override;
+		protected:
+			enum class RequestState
+			{
+				Pending,
+				InFlight,
+				Completed
+			};
+
+			struct Request
+			{
+				IORequestID id;
+				Details::NativeFile file;
+				uint64_t offset;
+				size_t size;
+				void* buffer;
+				IOPriority priority;
+				IOCompletionCallback callback;
+
+				RequestState state = RequestState::Pending;
+				bool isCancelled = false;
+				Result result = Result::Success;
+				size_t bytesRead = 0;
+			};
+
+			// Starts the workers, when isReadingOnWorkers is false the workers only run callbacks and a derived backend does the reads
+			Result StartWorkers(uint32_t numWorkers, uint32_t queueDepth, bool isReadingOnWorkers);
+			// Cancels everything that is queued, waits for the rest and joins the workers
+			void StopWorkers();
+
+			// The functions below need m_mutex to be locked
+
+			bool HasPending() const;
+			// Finds a request that hasn't completed yet, returns nullptr if there's none with the ID
+			Request* FindRequest(IORequestID requestID);
+			// Pops the highest priority pending read and marks it in flight
+			Request* PopPending();
+			// Hands a finished read to the workers to run its callback
+			void PushCompleted(Request* request, Result result, size_t bytesRead);
+			// Called after a read was queued, wakes whatever does the reads
+			virtual void OnReadQueued();
+			// Called when a read that is in flight gets cancelled
+			inline virtual void OnCancelInFlight(Request* request) { (void)request; }
+
+			std::mutex m_mutex;
+			uint32_t m_queueDepth = 0;
+			uint32_t m_numInFlight = 0;
+			bool m_isStopping = false;
+			AsyncIOStats m_stats;
+		private:
+			void WorkerMain();
+			// Runs the callback of a completed read, m_mutex must be unlocked
+			void RunCallback(Request* request);
+
+			std::condition_variable m_workerCondition;
+			std::condition_variable m_idleCondition;
+			std::array<std::deque<Request*>, static_cast<size_t>(IOPriority::NumPriorities)> m_pending;
+			std::deque<Request*> m_completed;
+			// Owns every request until its callback returned
+			std::unordered_map<IORequestID, std::unique_ptr<Request>> m_requests;
+			// Indexed by IOFileID - 1, closed files are invalidNativeFile
+			std::vector<Details::NativeFile> m_files;
+			std::vector<std::thread> m_workers;
+			IORequestID m_nextRequestID = 1;
+			bool m_isReadingOnWorkers = true;
+		};
+	}
+}
+
+extern "C"
+{
+	// Allocates a generic async io, does not call create
+	// This function is meant for dynamic loading, if implementations ever get split off into separate DLLs
+	// This function is meant for internal use
+	BLAZE_API Blaze::Generic::GenericAsyncIO* AllocateGenericAsyncIO();
+}
+
+#endif // BLAZE_GENERIC_GENERICASYNCIO_H
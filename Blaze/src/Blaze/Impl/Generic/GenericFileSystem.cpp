@@ -0,0 +1,648 @@
+#include <pch.h>
+#include "GenericFileSystem.h"
+#include <Blaze/IO/LZ4.h>
+#include <Blaze/Profiling/Profiler.h>
+#include <Blaze/Memory/AllocationTracker.h>
+
+#include <cstring>
+#include <filesystem>
+
+namespace Blaze
+{
+	namespace Generic
+	{
+		namespace Details
+		{
+			// Turns a path into "a/b/c", returns false for paths that try to leave their mount
+			static bool NormalizePath(std::string_view path, std::string& normalized)
+			{
+				normalized.clear();
+				normalized.reserve(path.size());
+
+				size_t start = 0;
+				while (start <= path.size())
+				{
+					size_t end = path.find_first_of("/\\", start);
+					if (end == std::string_view::npos)
+						end = path.size();
+
+					std::string_view component = path.substr(start, end - start);
+					start = end + 1;
+
+					if (component.empty() || (component == "."))
+						continue;
+					if (component == "..")
+						return false;
+
+					if (!normalized.empty())
+						normalized.push_back('/');
+					normalized.append(component);
+				}
+				return true;
+			}
+		}
+
+		GenericFileSystem::MountPoint::~MountPoint()
+		{
+			Blaze::Details::CloseNativeFile(file);
+		}
+
+		GenericFileSystem::~GenericFileSystem()
+		{
+			Destroy_Impl();
+		}
+
+		Result GenericFileSystem::Create_Impl(const ObjectCreateInfo& createInfo)
+		{
+			const auto& info = static_cast<const FileSystemCreateInfo&>(createInfo);
+
+			m_cacheCapacity = info.blockCacheSize;
+
+			m_jobSystem = info.jobSystem;
+			if (m_jobSystem)
+				return Result::Success;
+
+			// Decompression is short bursts on the reading thread's behalf, leave cores for the game
+			uint32_t numWorkers = info.numWorkers;
+			if (numWorkers == 0)
+				numWorkers = std::max(1u, std::thread::hardware_concurrency() / 2);
+
+			m_isStopping = false;
+			for (uint32_t i = 0; i < numWorkers; i++)
+				m_workers.emplace_back(&GenericFileSystem::WorkerMain, this);
+
+			return Result::Success;
+		}
+
+		Result GenericFileSystem::Destroy_Impl()
+		{
+			{
+				std::lock_guard<std::mutex> guard(m_taskMutex);
+				m_isStopping = true;
+			}
+			m_taskCondition.notify_all();
+			for (auto& worker : m_workers)
+				worker.join();
+			m_workers.clear();
+			m_jobSystem.reset();
+
+			{
+				std::lock_guard<Mutex> guard(m_mountMutex);
+				m_mounts.clear();
+			}
+
+			std::lock_guard<Mutex> guard(m_cacheMutex);
+			m_cache.clear();
+			m_cacheIndex.clear();
+			m_cacheSize = 0;
+
+			return Result::Success;
+		}
+
+		Ref<Object> GenericFileSystem::CastTo_Impl(ClassID objectID)
+		{
+			constexpr std::array<ClassID, 3> castableIDs = {
+				Object::GetStaticClassID(),
+				FileSystem::GetStaticClassID(),
+				GetStaticClassID()
+			};
+
+			// Check to make sure the class ID is valid
+			if (std::find(castableIDs.begin(), castableIDs.end(), objectID) == castableIDs.end())
+				return Ref<Object>{ nullptr };
+
+			return shared_from_this();
+		}
+
+		Result GenericFileSystem::Mount_Impl(const std::string& mountPoint, const std::string& path, MountType type, MountID& mount)
+		{
+			auto newMount = std::make_shared<MountPoint>();
+			newMount->type = type;
+
+			if (!Details::NormalizePath(mountPoint, newMount->mountPoint))
+				return Result::InvalidParam;
+			if (!newMount->mountPoint.empty())
+				newMount->mountPoint.push_back('/');
+
+			switch (type)
+			{
+			case MountType::Directory:
+			{
+				std::error_code error;
+				auto status = std::filesystem::status(path, error);
+				if (status.type() == std::filesystem::file_type::not_found)
+					return Result::NotFound;
+				if (error)
+					return Result::SystemError;
+				if (status.type() != std::filesystem::file_type::directory)
+					return Result::InvalidParam;
+
+				newMount->root = path;
+				if ((newMount->root.back() != '/') && (newMount->root.back() != '\\'))
+					newMount->root.push_back('/');
+				break;
+			}
+			case MountType::Archive:
+			{
+				Result res = LoadArchive(*newMount, path);
+				if (res != Result::Success)
+					return res;
+				break;
+			}
+			default:
+				return Result::InvalidParam;
+			}
+
+			std::lock_guard<Mutex> guard(m_mountMutex);
+			newMount->id = m_nextMountID++;
+			mount = newMount->id;
+			m_mounts.push_back(std::move(newMount));
+
+			return Result::Success;
+		}
+
+		Result GenericFileSystem::Unmount_Impl(MountID mount)
+		{
+			{
+				std::lock_guard<Mutex> guard(m_mountMutex);
+				auto it = std::find_if(m_mounts.begin(), m_mounts.end(), [&](const std::shared_ptr<MountPoint>& mountPoint) { return mountPoint->id == mount; });
+				if (it == m_mounts.end())
+					return Result::NotFound;
+
+				// Reads that already resolved a file keep the mount alive until they're done
+				m_mounts.erase(it);
+			}
+
+			EvictMountBlocks(mount);
+			return Result::Success;
+		}
+
+		bool GenericFileSystem::Exists_Impl(std::string_view path)
+		{
+			ResolvedFile file;
+			return Resolve(path, file) == Result::Success;
+		}
+
+		Result GenericFileSystem::GetFileSize_Impl(std::string_view path, uint64_t& size)
+		{
+			ResolvedFile file;
+			Result res = Resolve(path, file);
+			if (res != Result::Success)
+				return res;
+
+			size = file.size;
+			return Result::Success;
+		}
+
+		Result GenericFileSystem::Read_Impl(std::string_view path, uint64_t offset, void* dst, size_t size, size_t& bytesRead)
+		{
+			bytesRead = 0;
+			if (!dst && size)
+				return Result::InvalidParam;
+
+			ResolvedFile file;
+			Result res = Resolve(path, file);
+			if (res != Result::Success)
+				return res;
+
+			if (file.mount->type == MountType::Archive)
+				res = ReadArchive(file, offset, dst, size, bytesRead);
+			else
+				res = ReadDirectory(file, offset, dst, size, bytesRead);
+
+			file.mount->counters.numReads++;
+			file.mount->counters.bytesRead += bytesRead;
+			return res;
+		}
+
+		Result GenericFileSystem::ReadFile_Impl(std::string_view path, std::vector<uint8_t>& data)
+		{
+			ResolvedFile file;
+			Result res = Resolve(path, file);
+			if (res != Result::Success)
+				return res;
+
+			if (file.size > SIZE_MAX)
+				return Result::AllocationError;
+			data.resize(static_cast<size_t>(file.size));
+
+			size_t bytesRead = 0;
+			if (file.mount->type == MountType::Archive)
+				res = ReadArchive(file, 0, data.data(), data.size(), bytesRead);
+			else
+				res = ReadDirectory(file, 0, data.data(), data.size(), bytesRead);
+
+			// Loose files can change size between the lookup and the read
+			data.resize(bytesRead);
+
+			file.mount->counters.numReads++;
+			file.mount->counters.bytesRead += bytesRead;
+			return res;
+		}
+
+		Result GenericFileSystem::GetMountStats_Impl(MountID mount, MountStats& stats)
+		{
+			std::lock_guard<Mutex> guard(m_mountMutex);
+			auto it = std::find_if(m_mounts.begin(), m_mounts.end(), [&](const std::shared_ptr<MountPoint>& mountPoint) { return mountPoint->id == mount; });
+			if (it == m_mounts.end())
+				return Result::NotFound;
+
+			const MountCounters& counters = (*it)->counters;
+			stats.numReads = counters.numReads;
+			stats.bytesRead = counters.bytesRead;
+			stats.bytesReadFromDisk = counters.bytesReadFromDisk;
+			stats.numDiskReads = counters.numDiskReads;
+			stats.numBlockCacheHits = counters.numBlockCacheHits;
+			stats.numBlockCacheMisses = counters.numBlockCacheMisses;
+			return Result::Success;
+		}
+
+		Result GenericFileSystem::Resolve(std::string_view path, ResolvedFile& file)
+		{
+			std::string normalized;
+			if (!Details::NormalizePath(path, normalized))
+				return Result::InvalidParam;
+
+			// Directory lookups touch the disk, so they happen on a copy of the mount list
+			std::vector<std::shared_ptr<MountPoint>> mounts;
+			{
+				std::lock_guard<Mutex> guard(m_mountMutex);
+				mounts = m_mounts;
+			}
+
+			for (auto it = mounts.rbegin(); it != mounts.rend(); ++it)
+			{
+				const MountPoint& mount = **it;
+				if (normalized.compare(0, mount.mountPoint.size(), mount.mountPoint) != 0)
+					continue;
+
+				std::string relativePath = normalized.substr(mount.mountPoint.size());
+				if (mount.type == MountType::Archive)
+				{
+					auto fileIt = mount.files.find(relativePath);
+					if (fileIt == mount.files.end())
+						continue;
+
+					file.archiveFile = fileIt->second;
+					file.size = fileIt->second.size;
+				}
+				else
+				{
+					Blaze::Details::NativeFile nativeFile;
+					if (Blaze::Details::OpenNativeFile(mount.root + relativePath, nativeFile) != Result::Success)
+						continue;
+
+					Result res = Blaze::Details::GetNativeFileSize(nativeFile, file.size);
+					Blaze::Details::CloseNativeFile(nativeFile);
+					if (res != Result::Success)
+						return res;
+				}
+
+				file.mount = *it;
+				file.relativePath = std::move(relativePath);
+				return Result::Success;
+			}
+
+			return Result::NotFound;
+		}
+
+		Result GenericFileSystem::ReadDirectory(const ResolvedFile& file, uint64_t offset, void* dst, size_t size, size_t& bytesRead)
+		{
+			Blaze::Details::NativeFile nativeFile;
+			Result res = Blaze::Details::OpenNativeFile(file.mount->root + file.relativePath, nativeFile);
+			if (res != Result::Success)
+				return res;
+
+			res = Blaze::Details::ReadNativeFile(nativeFile, offset, dst, size, bytesRead);
+			Blaze::Details::CloseNativeFile(nativeFile);
+
+			file.mount->counters.numDiskReads++;
+			file.mount->counters.bytesReadFromDisk += bytesRead;
+			return res;
+		}
+
+		Result GenericFileSystem::ReadArchive(const ResolvedFile& file, uint64_t offset, void* dst, size_t size, size_t& bytesRead)
+		{
+			MountPoint& mount = *file.mount;
+			const uint64_t blockSize = mount.header.blockSize;
+
+			// Nothing to read, end - 1 below would wrap around for empty ranges at the start of the stream
+			bytesRead = 0;
+			if ((offset >= file.archiveFile.size) || (size == 0))
+				return Result::Success;
+
+			const uint64_t start = file.archiveFile.streamOffset + offset;
+			const uint64_t end = start + std::min<uint64_t>(size, file.archiveFile.size - offset);
+			const uint32_t firstBlock = static_cast<uint32_t>(start / blockSize);
+			const uint32_t numBlocks = static_cast<uint32_t>((end - 1) / blockSize) - firstBlock + 1;
+
+			std::vector<Block> blocks(numBlocks);
+			std::vector<uint32_t> missing;
+			for (uint32_t i = 0; i < numBlocks; i++)
+			{
+				blocks[i] = FindCachedBlock(MakeBlockKey(mount.id, firstBlock + i));
+				if (!blocks[i])
+					missing.push_back(i);
+			}
+
+			mount.counters.numBlockCacheHits += numBlocks - missing.size();
+			mount.counters.numBlockCacheMisses += missing.size();
+
+			if (!missing.empty())
+			{
+				// Blocks are stored back to back, so each run of missing blocks is one read
+				std::vector<std::vector<uint8_t>> runs;
+				std::vector<const uint8_t*> compressedBlocks(missing.size());
+				for (size_t i = 0; i < missing.size();)
+				{
+					size_t runEnd = i + 1;
+					while ((runEnd < missing.size()) && (missing[runEnd] == missing[runEnd - 1] + 1))
+						runEnd++;
+
+					const Blaze::Details::ArchiveBlock& first = mount.blocks[firstBlock + missing[i]];
+					const Blaze::Details::ArchiveBlock& last = mount.blocks[firstBlock + missing[runEnd - 1]];
+					const size_t runSize = static_cast<size_t>(last.offset + last.compressedSize - first.offset);
+
+					std::vector<uint8_t> run(runSize);
+					size_t runRead = 0;
+					Result res = Blaze::Details::ReadNativeFile(mount.file, first.offset, run.data(), runSize, runRead);
+					mount.counters.numDiskReads++;
+					mount.counters.bytesReadFromDisk += runRead;
+					if (res != Result::Success)
+						return res;
+					if (runRead != runSize)
+						return Result::SystemError;
+
+					for (size_t j = i; j < runEnd; j++)
+						compressedBlocks[j] = run.data() + (mount.blocks[firstBlock + missing[j]].offset - first.offset);
+
+					runs.push_back(std::move(run));
+					i = runEnd;
+				}
+
+				std::vector<std::shared_ptr<std::vector<uint8_t>>> decompressed(missing.size());
+				std::vector<Result> results(missing.size(), Result::Success);
+				ParallelFor(missing.size(), [&](size_t i)
+				{
+					const uint32_t blockIndex = firstBlock + missing[i];
+					const Blaze::Details::ArchiveBlock& block = mount.blocks[blockIndex];
+					const size_t blockBytes = static_cast<size_t>(std::min<uint64_t>(blockSize, mount.header.streamSize - blockIndex * blockSize));
+
+					auto data = std::make_shared<std::vector<uint8_t>>(blockBytes);
+					if (block.flags & static_cast<uint32_t>(Blaze::Details::ArchiveBlockFlags::Uncompressed))
+						std::memcpy(data->data(), compressedBlocks[i], blockBytes);
+					else
+						results[i] = Blaze::Details::LZ4Decompress(compressedBlocks[i], block.compressedSize, data->data(), blockBytes);
+
+					decompressed[i] = std::move(data);
+				});
+
+				for (size_t i = 0; i < missing.size(); i++)
+				{
+					if (results[i] != Result::Success)
+						return results[i];
+
+					blocks[missing[i]] = decompressed[i];
+					InsertCachedBlock(MakeBlockKey(mount.id, firstBlock + missing[i]), blocks[missing[i]]);
+				}
+			}
+
+			uint8_t* out = reinterpret_cast<uint8_t*>(dst);
+			for (uint32_t i = 0; i < numBlocks; i++)
+			{
+				const uint64_t blockStart = (firstBlock + static_cast<uint64_t>(i)) * blockSize;
+				const uint64_t copyStart = std::max(start, blockStart);
+				const uint64_t copyEnd = std::min(end, blockStart + blocks[i]->size());
+
+				std::memcpy(out, blocks[i]->data() + (copyStart - blockStart), static_cast<size_t>(copyEnd - copyStart));
+				out += copyEnd - copyStart;
+			}
+
+			bytesRead = static_cast<size_t>(end - start);
+			return Result::Success;
+		}
+
+		Result GenericFileSystem::LoadArchive(MountPoint& mount, const std::string& path)
+		{
+			Result res = Blaze::Details::OpenNativeFile(path, mount.file);
+			if (res != Result::Success)
+				return res;
+
+			uint64_t fileSize;
+			res = Blaze::Details::GetNativeFileSize(mount.file, fileSize);
+			if (res != Result::Success)
+				return res;
+
+			size_t bytesRead = 0;
+			res = Blaze::Details::ReadNativeFile(mount.file, 0, &mount.header, sizeof(mount.header), bytesRead);
+			if (res != Result::Success)
+				return res;
+
+			const Blaze::Details::ArchiveHeader& header = mount.header;
+			if ((bytesRead != sizeof(header)) || (header.magic != Blaze::Details::archiveMagic) || (header.version != Blaze::Details::archiveVersion) || (header.blockSize == 0))
+				return Result::InvalidParam;
+			if (header.numBlocks != (header.streamSize + header.blockSize - 1) / header.blockSize)
+				return Result::InvalidParam;
+
+			const size_t blockTableSize = header.numBlocks * sizeof(Blaze::Details::ArchiveBlock);
+			const size_t fileTableSize = header.numFiles * sizeof(Blaze::Details::ArchiveFile);
+			const uint64_t tablesSize = static_cast<uint64_t>(blockTableSize) + fileTableSize + header.pathsSize;
+			if ((header.tableOffset < sizeof(header)) || (header.tableOffset > fileSize) || (tablesSize > fileSize - header.tableOffset))
+				return Result::InvalidParam;
+
+			// The tables are small and read once, reads after this only touch the blocks they need
+			std::vector<uint8_t> tables(static_cast<size_t>(tablesSize));
+			res = Blaze::Details::ReadNativeFile(mount.file, header.tableOffset, tables.data(), tables.size(), bytesRead);
+			if (res != Result::Success)
+				return res;
+			if (bytesRead != tables.size())
+				return Result::InvalidParam;
+
+			mount.blocks.resize(header.numBlocks);
+			std::memcpy(mount.blocks.data(), tables.data(), blockTableSize);
+			for (uint32_t i = 0; i < header.numBlocks; i++)
+			{
+				const Blaze::Details::ArchiveBlock& block = mount.blocks[i];
+				const uint64_t blockBytes = std::min<uint64_t>(header.blockSize, header.streamSize - static_cast<uint64_t>(i) * header.blockSize);
+				const bool isUncompressed = block.flags & static_cast<uint32_t>(Blaze::Details::ArchiveBlockFlags::Uncompressed);
+
+				if ((block.offset < sizeof(header)) || (block.offset > header.tableOffset) || (block.compressedSize > header.tableOffset - block.offset))
+					return Result::InvalidParam;
+				if (isUncompressed ? (block.compressedSize != blockBytes) : (block.compressedSize > Blaze::Details::LZ4CompressBound(static_cast<size_t>(blockBytes))))
+					return Result::InvalidParam;
+				// Runs of blocks are read with a single read, so they have to be in order
+				if ((i > 0) && (block.offset != mount.blocks[i - 1].offset + mount.blocks[i - 1].compressedSize))
+					return Result::InvalidParam;
+			}
+
+			std::vector<Blaze::Details::ArchiveFile> files(header.numFiles);
+			std::memcpy(files.data(), tables.data() + blockTableSize, fileTableSize);
+			const char* paths = reinterpret_cast<const char*>(tables.data() + blockTableSize + fileTableSize);
+
+			mount.files.reserve(header.numFiles);
+			for (const auto& file : files)
+			{
+				if ((file.streamOffset > header.streamSize) || (file.size > header.streamSize - file.streamOffset))
+					return Result::InvalidParam;
+				if ((file.pathOffset > header.pathsSize) || (file.pathLength > header.pathsSize - file.pathOffset))
+					return Result::InvalidParam;
+
+				// The first file with a path wins, same as the lookups of the tools that wrote it
+				mount.files.emplace(std::string(paths + file.pathOffset, file.pathLength), file);
+			}
+
+			return Result::Success;
+		}
+
+		GenericFileSystem::Block GenericFileSystem::FindCachedBlock(uint64_t key)
+		{
+			std::lock_guard<Mutex> guard(m_cacheMutex);
+			auto it = m_cacheIndex.find(key);
+			if (it == m_cacheIndex.end())
+				return nullptr;
+
+			m_cache.splice(m_cache.begin(), m_cache, it->second);
+			return it->second->data;
+		}
+
+		void GenericFileSystem::InsertCachedBlock(uint64_t key, const Block& block)
+		{
+			if (m_cacheCapacity == 0)
+				return;
+
+			std::lock_guard<Mutex> guard(m_cacheMutex);
+
+			// Another read can decompress the same block at the same time
+			if (m_cacheIndex.find(key) != m_cacheIndex.end())
+				return;
+
+			m_cache.push_front(CachedBlock{ key, block });
+			m_cacheIndex.emplace(key, m_cache.begin());
+			m_cacheSize += block->size();
+
+			// Readers hold their own reference, so evicting a block that's being copied is fine
+			while ((m_cacheSize > m_cacheCapacity) && (m_cache.size() > 1))
+			{
+				const CachedBlock& oldest = m_cache.back();
+				m_cacheSize -= oldest.data->size();
+				m_cacheIndex.erase(oldest.key);
+				m_cache.pop_back();
+			}
+		}
+
+		void GenericFileSystem::EvictMountBlocks(MountID mount)
+		{
+			std::lock_guard<Mutex> guard(m_cacheMutex);
+			for (auto it = m_cache.begin(); it != m_cache.end();)
+			{
+				if ((it->key >> 32) != mount)
+				{
+					++it;
+					continue;
+				}
+
+				m_cacheSize -= it->data->size();
+				m_cacheIndex.erase(it->key);
+				it = m_cache.erase(it);
+			}
+		}
+
+		void GenericFileSystem::ParallelFor(size_t count, const std::function<void(size_t)>& function)
+		{
+			if (m_jobSystem && (count > 1))
+			{
+				struct ParallelJob
+				{
+					const std::function<void(size_t)>* function;
+					size_t index;
+				};
+
+				std::vector<ParallelJob> parallelJobs(count);
+				std::vector<JobDesc> jobs(count);
+				for (size_t i = 0; i < count; i++)
+				{
+					parallelJobs[i] = ParallelJob{ &function, i };
+					jobs[i].function = [](void* data) { auto job = reinterpret_cast<ParallelJob*>(data); (*job->function)(job->index); };
+					jobs[i].data = &parallelJobs[i];
+				}
+
+				JobCounter counter;
+				if (m_jobSystem->Run(jobs.data(), jobs.size(), &counter) == Result::Success)
+				{
+					m_jobSystem->Wait(counter);
+					return;
+				}
+			}
+
+			if (m_workers.empty() || (count <= 1))
+			{
+				for (size_t i = 0; i < count; i++)
+					function(i);
+				return;
+			}
+
+			auto task = std::make_shared<ParallelTask>();
+			task->function = function;
+			task->count = count;
+
+			{
+				std::lock_guard<std::mutex> guard(m_taskMutex);
+				m_tasks.push_back(task);
+			}
+			m_taskCondition.notify_all();
+
+			// The reading thread helps instead of waiting
+			RunParallelTask(*task);
+
+			std::unique_lock<std::mutex> lock(m_taskMutex);
+			auto it = std::find(m_tasks.begin(), m_tasks.end(), task);
+			if (it != m_tasks.end())
+				m_tasks.erase(it);
+			m_taskDoneCondition.wait(lock, [&]() { return task->numDone == task->count; });
+		}
+
+		void GenericFileSystem::WorkerMain()
+		{
+			Profiler::SetThreadName("File System Worker");
+			AllocationTracker::SetThreadTag(AllocationTag::IO);
+
+			std::unique_lock<std::mutex> lock(m_taskMutex);
+			while (true)
+			{
+				m_taskCondition.wait(lock, [&]() { return m_isStopping || !m_tasks.empty(); });
+				if (m_isStopping)
+					return;
+
+				std::shared_ptr<ParallelTask> task = m_tasks.front();
+
+				lock.unlock();
+				RunParallelTask(*task);
+				lock.lock();
+
+				// Every index is claimed, the threads still running it finish on their own
+				auto it = std::find(m_tasks.begin(), m_tasks.end(), task);
+				if (it != m_tasks.end())
+					m_tasks.erase(it);
+			}
+		}
+
+		void GenericFileSystem::RunParallelTask(ParallelTask& task)
+		{
+			for (size_t i = task.nextIndex++; i < task.count; i = task.nextIndex++)
+			{
+				task.function(i);
+
+				if (++task.numDone == task.count)
+				{
+					std::lock_guard<std::mutex> guard(m_taskMutex);
+					m_taskDoneCondition.notify_all();
+				}
+			}
+		}
+	}
+}
+
+Blaze::Generic::GenericFileSystem* AllocateGenericFileSystem()
+{
+	return new Blaze::Generic::GenericFileSystem();
+}
@@ -0,0 +1,157 @@
+#pragma once
+
+#ifndef BLAZE_GENERIC_GENERICFILESYSTEM_H
+#define BLAZE_GENERIC_GENERICFILESYSTEM_H
+
+#include <Blaze/Core.h>
+#include <Blaze/Error.h>
+#include <Blaze/IO/FileSystem.h>
+#include <Blaze/IO/NativeFile.h>
+#include <Blaze/IO/ArchiveFormat.h>
+#include <Blaze/Mutex.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace Blaze
+{
+	namespace Generic
+	{
+		// File system on top of the native file functions, archives are read block by block through an LRU cache
+		class GenericFileSystem
+			:public FileSystem
+		{
+		public:
+			GenericFileSystem() { classID = GetStaticClassID(); }
+			~GenericFileSystem();
+
+			constexpr static ClassID GetStaticClassID() { return Details::MakeClassID(Details::InterfaceID::FileSystem, Details::ImplementationID::Generic); }
+
+			virtual Result Create_Impl(const ObjectCreateInfo& createInfo) override;
+			virtual Result Destroy_Impl() override;
+
+			virtual Ref<Object> CastTo_Impl(ClassID objectID) override;
+
+			virtual Result Mount_Impl(const std::string& mountPoint, const std::string& path, MountType type, MountID& mount) override;
+			virtual Result Unmount_Impl(MountID mount) override;
+			virtual bool Exists_Impl(std::string_view path) override;
+			virtual Result GetFileSize_Impl(std::string_view path, uint64_t& size) override;
+			virtual Result Read_Impl(std::string_view path, uint64_t offset, void* dst, size_t size, size_t& bytesRead) override;
+			virtual Result ReadFile_Impl(std::string_view path, std::vector<uint8_t>& data) override;
+			virtual Result GetMountStats_Impl(MountID mount, MountStats& stats) override;
+		private:
+			struct MountCounters
+			{
+				std::atomic<uint64_t> numReads{ 0 };
+				std::atomic<uint64_t> bytesRead{ 0 };
+				std::atomic<uint64_t> bytesReadFromDisk{ 0 };
+				std::atomic<uint64_t> numDiskReads{ 0 };
+				std::atomic<uint64_t> numBlockCacheHits{ 0 };
+				std::atomic<uint64_t> numBlockCacheMisses{ 0 };
+			};
+
+			struct MountPoint
+			{
+				MountID id;
+				// Normalized, empty for the root or ending in '/'
+				std::string mountPoint;
+				MountType type;
+				// Directory mounts
+				std::string root;
+				// Archive mounts
+				Details::NativeFile file = Details::invalidNativeFile;
+				Details::ArchiveHeader header;
+				std::vector<Details::ArchiveBlock> blocks;
+				std::unordered_map<std::string, Details::ArchiveFile> files;
+
+				MountCounters counters;
+
+				~MountPoint();
+			};
+
+			// A file found in one of the mounts, holds the mount alive while it's read
+			struct ResolvedFile
+			{
+				std::shared_ptr<MountPoint> mount;
+				// Path relative to the mount point
+				std::string relativePath;
+				// Archive mounts
+				Details::ArchiveFile archiveFile;
+				// Directory mounts
+				uint64_t size;
+			};
+
+			using Block = std::shared_ptr<const std::vector<uint8_t>>;
+
+			struct CachedBlock
+			{
+				uint64_t key;
+				Block data;
+			};
+
+			// Work split across the workers and the reading thread, each index is claimed once
+			struct ParallelTask
+			{
+				std::function<void(size_t)> function;
+				size_t count;
+				std::atomic<size_t> nextIndex{ 0 };
+				std::atomic<size_t> numDone{ 0 };
+			};
+
+			Result Resolve(std::string_view path, ResolvedFile& file);
+			Result ReadArchive(const ResolvedFile& file, uint64_t offset, void* dst, size_t size, size_t& bytesRead);
+			Result ReadDirectory(const ResolvedFile& file, uint64_t offset, void* dst, size_t size, size_t& bytesRead);
+			Result LoadArchive(MountPoint& mount, const std::string& path);
+
+			// Block cache keys are the mount ID in the high bits and the block index in the low bits
+			static uint64_t MakeBlockKey(MountID mount, uint32_t block) { return (static_cast<uint64_t>(mount) << 32) | block; }
+			Block FindCachedBlock(uint64_t key);
+			void InsertCachedBlock(uint64_t key, const Block& block);
+			void EvictMountBlocks(MountID mount);
+
+			// Calls function for every index in [0, count), spreading the calls across the workers
+			void ParallelFor(size_t count, const std::function<void(size_t)>& function);
+			void WorkerMain();
+			void RunParallelTask(ParallelTask& task);
+
+			Mutex m_mountMutex{ "File system mounts" };
+			std::vector<std::shared_ptr<MountPoint>> m_mounts;
+			MountID m_nextMountID = 1;
+
+			Mutex m_cacheMutex{ "File system block cache" };
+			// Most recently used at the front
+			std::list<CachedBlock> m_cache;
+			std::unordered_map<uint64_t, std::list<CachedBlock>::iterator> m_cacheIndex;
+			size_t m_cacheSize = 0;
+			size_t m_cacheCapacity = 0;
+
+			// Used instead of the workers when set
+			Ref<JobSystem> m_jobSystem;
+
+			std::mutex m_taskMutex;
+			std::condition_variable m_taskCondition;
+			std::condition_variable m_taskDoneCondition;
+			std::deque<std::shared_ptr<ParallelTask>> m_tasks;
+			std::vector<std::thread> m_workers;
+			bool m_isStopping = false;
+		};
+	}
+}
+
+extern "C"
+{
+	// Allocates a generic file system, does not call create
+	// This function is meant for dynamic loading, if implementations ever get split off into separate DLLs
+	// This function is meant for internal use
+	BLAZE_API Blaze::Generic::GenericFileSystem* AllocateGenericFileSystem();
+}
+
+#endif // BLAZE_GENERIC_GENERICFILESYSTEM_H
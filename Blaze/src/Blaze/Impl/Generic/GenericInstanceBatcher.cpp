@@ -0,0 +1,169 @@
+#include <pch.h>
+#include "GenericInstanceBatcher.h"
+#include <Blaze/Profiling/Profiler.h>
+#include <Blaze/Memory/AllocationTracker.h>
+
+namespace Blaze
+{
+	namespace Generic
+	{
+		GenericInstanceBatcher::~GenericInstanceBatcher()
+		{
+			Destroy_Impl();
+		}
+
+		Result GenericInstanceBatcher::Create_Impl(const ObjectCreateInfo& createInfo)
+		{
+			const auto& info = static_cast<const InstanceBatcherCreateInfo&>(createInfo);
+			if (!info.deviceContext)
+				return Result::InvalidParam;
+
+			m_deviceContext = info.deviceContext;
+			return Result::Success;
+		}
+
+		Result GenericInstanceBatcher::Destroy_Impl()
+		{
+			m_drawList.clear();
+			m_batches.clear();
+			m_deviceContext.reset();
+			return Result::Success;
+		}
+
+		Ref<Object> GenericInstanceBatcher::CastTo_Impl(ClassID objectID)
+		{
+			constexpr std::array<ClassID, 3> castableIDs = {
+				Object::GetStaticClassID(),
+				InstanceBatcher::GetStaticClassID(),
+				GetStaticClassID()
+			};
+
+			// Check to make sure the class ID is valid
+			if (std::find(castableIDs.begin(), castableIDs.end(), objectID) == castableIDs.end())
+				return Ref<Object>{ nullptr };
+
+			return shared_from_this();
+		}
+
+		Result GenericInstanceBatcher::Submit_Impl(const InstancedMesh& mesh, uint64_t material, const void* instanceData)
+		{
+			BLAZE_ALLOCATION_TAG(AllocationTag::Renderer);
+
+			if (!m_deviceContext)
+				return Result::Uninitialized;
+
+			size_t instanceSize = mesh.format.GetStride(mesh.instanceBinding);
+			if ((mesh.instanceBinding >= maxVertexBindings) || !instanceSize || !instanceData)
+				return Result::InvalidParam;
+
+			auto& batch = m_batches[BatchKey{ &mesh, material }];
+			batch.mesh = &mesh;
+			batch.material = material;
+
+			auto bytes = static_cast<const uint8_t*>(instanceData);
+			batch.instanceData.insert(batch.instanceData.end(), bytes, bytes + instanceSize);
+			batch.numInstances++;
+
+			return Result::Success;
+		}
+
+		Result GenericInstanceBatcher::Flush_Impl(MaterialBinder materialBinder)
+		{
+			BLAZE_PROFILE_SCOPE("InstanceBatcher::Flush");
+			BLAZE_ALLOCATION_TAG(AllocationTag::Renderer);
+
+			if (!m_deviceContext)
+				return Result::Uninitialized;
+
+			BLAZE_PROFILE_GPU_SCOPE(*m_deviceContext, "InstanceBatcher::Flush");
+
+			m_stats = {};
+
+			// Collect the batches with instances, and release the ones that stopped being used
+			m_drawList.clear();
+			for (auto it = m_batches.begin(); it != m_batches.end();)
+			{
+				if (it->second.numInstances)
+					m_drawList.push_back(&it->second);
+				else if (++it->second.idleFlushes > maxIdleFlushes)
+				{
+					it = m_batches.erase(it);
+					continue;
+				}
+				++it;
+			}
+
+			// Sort by material so every material only gets bound once
+			std::sort(m_drawList.begin(), m_drawList.end(), [](const Batch* lhs, const Batch* rhs)
+				{
+					return (lhs->material != rhs->material) ? (lhs->material < rhs->material) : (lhs->mesh < rhs->mesh);
+				});
+
+			Result res = Result::Success;
+			bool isMaterialBound = false;
+			uint64_t boundMaterial = 0;
+
+			for (auto* batch : m_drawList)
+			{
+				const auto& mesh = *batch->mesh;
+
+				if (!batch->instanceBuffer)
+				{
+					BufferCreateInfo bufferInfo;
+					bufferInfo.deviceContext = m_deviceContext;
+					bufferInfo.type = BufferType::Instance;
+					bufferInfo.usage = BufferUsage::Stream;
+					batch->instanceBuffer = Buffer::Create(bufferInfo);
+					if (!batch->instanceBuffer)
+					{
+						res = Result::AllocationError;
+						break;
+					}
+				}
+
+				if ((res = batch->instanceBuffer->Write(batch->instanceData.data(), batch->instanceData.size())) != Result::Success)
+					break;
+
+				if (materialBinder.bindMaterial && (!isMaterialBound || (boundMaterial != batch->material)))
+				{
+					if ((res = materialBinder.bindMaterial(batch->material, materialBinder.data)) != Result::Success)
+						break;
+					isMaterialBound = true;
+					boundMaterial = batch->material;
+				}
+
+				auto vertexBuffers = mesh.vertexBuffers;
+				vertexBuffers[mesh.instanceBinding] = batch->instanceBuffer;
+				uint32_t numVertexBuffers = std::max(mesh.format.GetNumBindings(), mesh.instanceBinding + 1);
+
+				if ((res = m_deviceContext->BindVertexBuffers(mesh.format, vertexBuffers.data(), numVertexBuffers, mesh.indexBuffer)) != Result::Success)
+					break;
+
+				if (mesh.indexBuffer)
+					res = m_deviceContext->DrawIndexedInstanced(mesh.count, batch->numInstances);
+				else
+					res = m_deviceContext->DrawInstanced(mesh.count, batch->numInstances);
+				if (res != Result::Success)
+					break;
+
+				m_stats.numInstances += batch->numInstances;
+				m_stats.numDraws++;
+			}
+
+			// Reset every batch for the next frame, even if a draw failed
+			for (auto* batch : m_drawList)
+			{
+				batch->instanceData.clear();
+				batch->numInstances = 0;
+				batch->idleFlushes = 0;
+			}
+
+			return res;
+		}
+	}
+}
+
+Blaze::Generic::GenericInstanceBatcher* AllocateGenericInstanceBatcher()
+{
+	return new Blaze::Generic::GenericInstanceBatcher();
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#ifndef BLAZE_GENERIC_GENERICINSTANCEBATCHER_H
+#define BLAZE_GENERIC_GENERICINSTANCEBATCHER_H
+
+#include <Blaze/Core.h>
+#include <Blaze/Error.h>
+#include <Blaze/Renderer/InstanceBatcher.h>
+
+#include <unordered_map>
+#include <vector>
+
+namespace Blaze
+{
+	namespace Generic
+	{
+		// API independent batcher, only uses the DeviceContext/Buffer interfaces
+		class GenericInstanceBatcher
+			:public InstanceBatcher
+		{
+		public:
+			GenericInstanceBatcher() { classID = GetStaticClassID(); }
+			~GenericInstanceBatcher();
+
+			constexpr static ClassID GetStaticClassID() { return Details::MakeClassID(Details::InterfaceID::InstanceBatcher, Details::ImplementationID::Generic); }
+
+			virtual Result Create_Impl(const ObjectCreateInfo& createInfo) override;
+			virtual Result Destroy_Impl() override;
+
+			virtual Ref<Object> CastTo_Impl(ClassID objectID) override;
+
+			virtual Result Submit_Impl(const InstancedMesh& mesh, uint64_t material, const void* instanceData) override;
+			virtual Result Flush_Impl(MaterialBinder materialBinder) override;
+			inline virtual InstanceBatcherStats GetStats_Impl() override { return m_stats; }
+		private:
+			struct BatchKey
+			{
+				const InstancedMesh* mesh;
+				uint64_t material;
+
+				inline bool operator==(const BatchKey& rhs) const { return (mesh == rhs.mesh) && (material == rhs.material); }
+			};
+
+			struct BatchKeyHasher
+			{
+				inline size_t operator()(const BatchKey& key) const
+				{
+					uint64_t hash = reinterpret_cast<uintptr_t>(key.mesh) ^ (key.material * 0x9e3779b97f4a7c15);
+					return static_cast<size_t>(hash ^ (hash >> 32));
+				}
+			};
+
+			struct Batch
+			{
+				const InstancedMesh* mesh;
+				uint64_t material;
+				// Instance data gets cleared after every flush, but the memory is kept for the next frame
+				std::vector<uint8_t> instanceData;
+				uint32_t numInstances = 0;
+				// Kept across frames so the vertex array cache keeps hitting
+				Ref<Buffer> instanceBuffer;
+				uint32_t idleFlushes = 0;
+			};
+
+			// Batches that haven't been drawn for this many flushes get released
+			static constexpr uint32_t maxIdleFlushes = 60;
+
+			Ref<DeviceContext> m_deviceContext;
+			std::unordered_map<BatchKey, Batch, BatchKeyHasher> m_batches;
+			// Batches to draw in the current flush, kept as a member to reuse the memory
+			std::vector<Batch*> m_drawList;
+			InstanceBatcherStats m_stats;
+		};
+	}
+}
+
+extern "C"
+{
+	// Allocates a generic instance batcher, does not call create
+	// This function is meant for dynamic loading, if implementations ever get split off into separate DLLs
+	// This function is meant for internal use
+	BLAZE_API Blaze::Generic::GenericInstanceBatcher* AllocateGenericInstanceBatcher();
+}
+
+#endif // BLAZE_GENERIC_GENERICINSTANCEBATCHER_H
@@ -0,0 +1,490 @@
+#include <pch.h>
+#include "GenericJobSystem.h"
+#include <Blaze/Profiling/Profiler.h>
+#include <Blaze/Memory/AllocationTracker.h>
+
+namespace Blaze
+{
+	namespace Generic
+	{
+		// Workers look for work this many times before they go to sleep, jobs usually come in bursts
+		constexpr uint32_t numIdleSpins = 64;
+
+		GenericJobSystem::~GenericJobSystem()
+		{
+			Destroy_Impl();
+		}
+
+		Result GenericJobSystem::Create_Impl(const ObjectCreateInfo& createInfo)
+		{
+			const auto& info = static_cast<const JobSystemCreateInfo&>(createInfo);
+			if (info.fiberStackSize == 0)
+				return Result::InvalidParam;
+
+			m_fiberStackSize = info.fiberStackSize;
+
+			uint32_t numWorkers = info.numWorkers;
+			if (numWorkers == 0)
+			{
+				const uint32_t numCores = std::thread::hardware_concurrency();
+				numWorkers = (numCores > 1) ? numCores - 1 : 1;
+			}
+
+			m_isStopping = false;
+
+			// Workers steal from each other, so all of them exist before the first thread starts
+			for (uint32_t i = 0; i < numWorkers; i++)
+			{
+				auto worker = std::make_unique<Worker>();
+				worker->system = this;
+				worker->randomState = (i + 1) * 2654435761u;
+				m_workers.push_back(std::move(worker));
+			}
+
+			for (auto& worker : m_workers)
+				worker->thread = std::thread(&GenericJobSystem::WorkerMain, this, worker.get());
+
+			return Result::Success;
+		}
+
+		Result GenericJobSystem::Destroy_Impl()
+		{
+			if (m_workers.empty())
+				return Result::Success;
+
+			// Queued jobs still run, other threads may be waiting on their counters
+			{
+				std::unique_lock<std::mutex> lock(m_waitMutex);
+				m_numWaiting++;
+				m_numBlockedThreads++;
+				m_waitCondition.wait(lock, [&]() { return m_numUnfinishedJobs == 0; });
+				m_numWaiting--;
+				m_numBlockedThreads--;
+			}
+
+			{
+				std::lock_guard<std::mutex> guard(m_sleepMutex);
+				m_isStopping = true;
+			}
+			m_sleepCondition.notify_all();
+
+			for (auto& worker : m_workers)
+				worker->thread.join();
+			m_workers.clear();
+
+			// Every job finished, so no fiber is in the middle of one
+			std::lock_guard<Mutex> guard(m_fiberMutex);
+			for (auto& fiber : m_fibers)
+				Details::DestroyFiberContext(fiber->context);
+			m_fibers.clear();
+			m_freeFibers.clear();
+			m_readyFibers.clear();
+			m_numReadyFibers = 0;
+
+			return Result::Success;
+		}
+
+		Ref<Object> GenericJobSystem::CastTo_Impl(ClassID objectID)
+		{
+			constexpr std::array<ClassID, 3> castableIDs = {
+				Object::GetStaticClassID(),
+				JobSystem::GetStaticClassID(),
+				GetStaticClassID()
+			};
+
+			// Check to make sure the class ID is valid
+			if (std::find(castableIDs.begin(), castableIDs.end(), objectID) == castableIDs.end())
+				return Ref<Object>{ nullptr };
+
+			return shared_from_this();
+		}
+
+		Result GenericJobSystem::Run_Impl(const JobDesc* jobs, size_t numJobs, JobCounter* counter)
+		{
+			if (!jobs && numJobs)
+				return Result::InvalidParam;
+			if (std::any_of(jobs, jobs + numJobs, [](const JobDesc& job) { return job.function == nullptr; }))
+				return Result::InvalidParam;
+			if (m_workers.empty())
+				return Result::Uninitialized;
+			if (numJobs == 0)
+				return Result::Success;
+
+			// Counted before the jobs are visible, so a job can't finish before it was counted
+			if (counter)
+				counter->value += static_cast<uint32_t>(numJobs);
+			m_numUnfinishedJobs += numJobs;
+
+			// A worker pushes to its own queue where it's cheap and the data is still in its cache
+			Worker* worker = CurrentWorker();
+			if (worker && (worker->system == this))
+			{
+				for (size_t i = 0; i < numJobs; i++)
+					worker->deque.Push(Details::Job{ jobs[i].function, jobs[i].data, counter });
+			}
+			else
+			{
+				std::lock_guard<Mutex> guard(m_queueMutex);
+				for (size_t i = 0; i < numJobs; i++)
+					m_queue.push_back(Details::Job{ jobs[i].function, jobs[i].data, counter });
+				m_queueSize += numJobs;
+			}
+
+			WakeWorkers(numJobs);
+			return Result::Success;
+		}
+
+		Result GenericJobSystem::Wait_Impl(JobCounter& counter, uint32_t value)
+		{
+			if (counter.value.load(std::memory_order_acquire) <= value)
+				return Result::Success;
+
+			Worker* worker = CurrentWorker();
+			if (!worker || (worker->system != this))
+			{
+				// Threads that aren't workers have no fiber to switch from, they block
+				std::unique_lock<std::mutex> lock(m_waitMutex);
+				m_numWaiting++;
+				m_numBlockedThreads++;
+				m_waitCondition.wait(lock, [&]() { return counter.value <= value; });
+				m_numWaiting--;
+				m_numBlockedThreads--;
+				return Result::Success;
+			}
+
+			Fiber* self = worker->currentFiber;
+			Fiber* next = AcquireFiber();
+			if (!next)
+			{
+				// Out of fibers, so the job runs other jobs itself until the counter is reached or a fiber is ready to take over
+				// Returning early would let the caller free data the queued jobs still use
+				while (counter.value.load(std::memory_order_acquire) > value)
+				{
+					// The jobs it waits for may be waiting on suspended fibers, a resumed one is run instead of this
+					next = PopReadyFiber();
+					if (next)
+						break;
+
+					// A job run here may wait and continue on another worker, so the worker is read again every time
+					Details::Job job;
+					if (PopJob(*self->worker, job))
+					{
+						{
+							BLAZE_PROFILE_SCOPE("Job");
+							job.function(job.data);
+						}
+						self->worker->numJobsRun.fetch_add(1, std::memory_order_relaxed);
+						FinishJob(job);
+					}
+					else
+						std::this_thread::yield();
+				}
+				if (!next)
+					return Result::Success;
+				worker = self->worker;
+			}
+
+			worker->numJobWaits.fetch_add(1, std::memory_order_relaxed);
+			worker->pendingAction = PendingAction::WaitFiber;
+			worker->pendingFiber = self;
+			worker->pendingCounter = &counter;
+			worker->pendingValue = value;
+
+			next->worker = worker;
+			worker->currentFiber = next;
+			Details::SwitchFiberContext(self->context, next->context);
+
+			// Resumed, possibly on another worker thread, so only self is used from here on
+			CompleteSwitch(self);
+			return Result::Success;
+		}
+
+		JobSystemStats GenericJobSystem::GetStats_Impl()
+		{
+			JobSystemStats stats;
+			for (auto& worker : m_workers)
+			{
+				stats.numJobsRun += worker->numJobsRun.load(std::memory_order_relaxed);
+				stats.numJobsStolen += worker->numJobsStolen.load(std::memory_order_relaxed);
+				stats.numJobWaits += worker->numJobWaits.load(std::memory_order_relaxed);
+			}
+
+			std::lock_guard<Mutex> guard(m_fiberMutex);
+			stats.numFibers = static_cast<uint32_t>(m_fibers.size());
+			return stats;
+		}
+
+		GenericJobSystem::Worker*& GenericJobSystem::CurrentWorker()
+		{
+			// Only read before a fiber switch, a fiber can continue on another thread after one
+			static thread_local Worker* worker = nullptr;
+			return worker;
+		}
+
+		void GenericJobSystem::WorkerMain(Worker* worker)
+		{
+			CurrentWorker() = worker;
+			Profiler::SetThreadName("Job Worker");
+			AllocationTracker::SetThreadTag(AllocationTag::Jobs);
+
+			if (Details::CreateThreadFiberContext(worker->threadFiber) != Result::Success)
+				return;
+
+			Fiber* fiber = AcquireFiber();
+			if (fiber)
+			{
+				fiber->worker = worker;
+				worker->currentFiber = fiber;
+				Details::SwitchFiberContext(worker->threadFiber, fiber->context);
+			}
+
+			Details::DestroyFiberContext(worker->threadFiber);
+			CurrentWorker() = nullptr;
+		}
+
+		void GenericJobSystem::FiberMain(void* data)
+		{
+			Fiber* self = reinterpret_cast<Fiber*>(data);
+			self->system->CompleteSwitch(self);
+			self->system->RunJobs(self);
+
+			// Back to the thread so it can exit, the fiber itself is destroyed with the job system
+			Details::SwitchFiberContext(self->context, self->worker->threadFiber);
+		}
+
+		void GenericJobSystem::RunJobs(Fiber* self)
+		{
+			uint32_t numSpins = 0;
+			while (!m_isStopping.load(std::memory_order_acquire))
+			{
+				Worker& worker = *self->worker;
+
+				if (Fiber* fiber = PopReadyFiber())
+				{
+					// This fiber isn't waiting on anything, it goes back to the pool
+					worker.pendingAction = PendingAction::FreeFiber;
+					worker.pendingFiber = self;
+
+					fiber->worker = &worker;
+					worker.currentFiber = fiber;
+					Details::SwitchFiberContext(self->context, fiber->context);
+
+					CompleteSwitch(self);
+					numSpins = 0;
+					continue;
+				}
+
+				Details::Job job;
+				if (PopJob(worker, job))
+				{
+					{
+						BLAZE_PROFILE_SCOPE("Job");
+						job.function(job.data);
+					}
+
+					// The job may have waited and continued on another worker
+					self->worker->numJobsRun.fetch_add(1, std::memory_order_relaxed);
+					FinishJob(job);
+					numSpins = 0;
+					continue;
+				}
+
+				if (++numSpins < numIdleSpins)
+				{
+					std::this_thread::yield();
+					continue;
+				}
+
+				numSpins = 0;
+				Sleep();
+			}
+		}
+
+		void GenericJobSystem::CompleteSwitch(Fiber* self)
+		{
+			Worker& worker = *self->worker;
+			const PendingAction action = worker.pendingAction;
+			worker.pendingAction = PendingAction::None;
+
+			switch (action)
+			{
+			case PendingAction::FreeFiber:
+			{
+				std::lock_guard<Mutex> guard(m_fiberMutex);
+				m_freeFibers.push_back(worker.pendingFiber);
+				break;
+			}
+			case PendingAction::WaitFiber:
+			{
+				// The counter is checked again after m_numWaiting was raised, a job finishing in between either sees the waiter or was seen here
+				std::unique_lock<std::mutex> lock(m_waitMutex);
+				m_numWaiting++;
+				if (worker.pendingCounter->value > worker.pendingValue)
+				{
+					m_waitingFibers.push_back(WaitingFiber{ worker.pendingCounter, worker.pendingValue, worker.pendingFiber });
+					break;
+				}
+
+				m_numWaiting--;
+				lock.unlock();
+				PushReadyFiber(worker.pendingFiber);
+				break;
+			}
+			default:
+				break;
+			}
+		}
+
+		bool GenericJobSystem::PopJob(Worker& worker, Details::Job& job)
+		{
+			if (worker.deque.Pop(job))
+				return true;
+
+			if (m_queueSize.load(std::memory_order_relaxed) != 0)
+			{
+				std::lock_guard<Mutex> guard(m_queueMutex);
+				if (!m_queue.empty())
+				{
+					job = m_queue.front();
+					m_queue.pop_front();
+					m_queueSize--;
+					return true;
+				}
+			}
+
+			// Start at a random victim so thieves don't all pile onto the same worker
+			worker.randomState ^= worker.randomState << 13;
+			worker.randomState ^= worker.randomState >> 17;
+			worker.randomState ^= worker.randomState << 5;
+
+			const size_t numWorkers = m_workers.size();
+			const size_t first = worker.randomState % numWorkers;
+			for (size_t i = 0; i < numWorkers; i++)
+			{
+				Worker& victim = *m_workers[(first + i) % numWorkers];
+				if ((&victim != &worker) && victim.deque.Steal(job))
+				{
+					worker.numJobsStolen.fetch_add(1, std::memory_order_relaxed);
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		void GenericJobSystem::FinishJob(const Details::Job& job)
+		{
+			// The counter may be gone as soon as it's decreased, a waiter can see it reach its value and return
+			if (job.counter)
+				job.counter->value--;
+			m_numUnfinishedJobs--;
+
+			if (m_numWaiting != 0)
+				WakeWaiters();
+		}
+
+		bool GenericJobSystem::HasJobs() const
+		{
+			if (m_queueSize.load(std::memory_order_relaxed) != 0)
+				return true;
+			return std::any_of(m_workers.begin(), m_workers.end(), [](const std::unique_ptr<Worker>& worker) { return !worker->deque.IsEmpty(); });
+		}
+
+		void GenericJobSystem::WakeWorkers(size_t count)
+		{
+			// Pairs with the fence in Sleep, either the sleeper sees the work or this sees the sleeper
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (m_numSleeping.load(std::memory_order_relaxed) == 0)
+				return;
+
+			std::lock_guard<std::mutex> guard(m_sleepMutex);
+			if (count > 1)
+				m_sleepCondition.notify_all();
+			else
+				m_sleepCondition.notify_one();
+		}
+
+		void GenericJobSystem::Sleep()
+		{
+			std::unique_lock<std::mutex> lock(m_sleepMutex);
+			m_numSleeping++;
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+
+			if (!m_isStopping && !HasJobs() && (m_numReadyFibers.load(std::memory_order_relaxed) == 0))
+				m_sleepCondition.wait(lock);
+
+			m_numSleeping--;
+		}
+
+		GenericJobSystem::Fiber* GenericJobSystem::AcquireFiber()
+		{
+			std::lock_guard<Mutex> guard(m_fiberMutex);
+			if (!m_freeFibers.empty())
+			{
+				Fiber* fiber = m_freeFibers.back();
+				m_freeFibers.pop_back();
+				return fiber;
+			}
+
+			auto fiber = std::make_unique<Fiber>();
+			fiber->system = this;
+			if (Details::CreateFiberContext(fiber->context, m_fiberStackSize, &GenericJobSystem::FiberMain, fiber.get()) != Result::Success)
+				return nullptr;
+
+			m_fibers.push_back(std::move(fiber));
+			return m_fibers.back().get();
+		}
+
+		void GenericJobSystem::PushReadyFiber(Fiber* fiber)
+		{
+			{
+				std::lock_guard<Mutex> guard(m_readyMutex);
+				m_readyFibers.push_back(fiber);
+				m_numReadyFibers++;
+			}
+			WakeWorkers(1);
+		}
+
+		GenericJobSystem::Fiber* GenericJobSystem::PopReadyFiber()
+		{
+			if (m_numReadyFibers.load(std::memory_order_relaxed) == 0)
+				return nullptr;
+
+			std::lock_guard<Mutex> guard(m_readyMutex);
+			if (m_readyFibers.empty())
+				return nullptr;
+
+			Fiber* fiber = m_readyFibers.front();
+			m_readyFibers.pop_front();
+			m_numReadyFibers--;
+			return fiber;
+		}
+
+		void GenericJobSystem::WakeWaiters()
+		{
+			std::lock_guard<std::mutex> guard(m_waitMutex);
+			for (size_t i = 0; i < m_waitingFibers.size();)
+			{
+				const WaitingFiber& waiting = m_waitingFibers[i];
+				if (waiting.counter->value > waiting.value)
+				{
+					i++;
+					continue;
+				}
+
+				PushReadyFiber(waiting.fiber);
+				m_waitingFibers[i] = m_waitingFibers.back();
+				m_waitingFibers.pop_back();
+				m_numWaiting--;
+			}
+
+			if (m_numBlockedThreads != 0)
+				m_waitCondition.notify_all();
+		}
+	}
+}
+
+Blaze::Generic::GenericJobSystem* AllocateGenericJobSystem()
+{
+	return new Blaze::Generic::GenericJobSystem();
+}
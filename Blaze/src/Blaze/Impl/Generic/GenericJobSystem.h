@@ -0,0 +1,157 @@
+#pragma once
+
+#ifndef BLAZE_GENERIC_GENERICJOBSYSTEM_H
+#define BLAZE_GENERIC_GENERICJOBSYSTEM_H
+
+#include <Blaze/Core.h>
+#include <Blaze/Error.h>
+#include <Blaze/Jobs/JobSystem.h>
+#include <Blaze/Jobs/JobDeque.h>
+#include <Blaze/Jobs/Fiber.h>
+#include <Blaze/Mutex.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Blaze
+{
+	namespace Generic
+	{
+		// Job system on the platform's fibers, every worker thread runs a fiber that pops, steals and runs jobs
+		// A job that waits switches its worker to another fiber, the waiting fiber is resumed by whichever worker is free once the counter is reached
+		class GenericJobSystem
+			:public JobSystem
+		{
+		public:
+			GenericJobSystem() { classID = GetStaticClassID(); }
+			~GenericJobSystem();
+
+			constexpr static ClassID GetStaticClassID() { return Details::MakeClassID(Details::InterfaceID::JobSystem, Details::ImplementationID::Generic); }
+
+			virtual Result Create_Impl(const ObjectCreateInfo& createInfo) override;
+			virtual Result Destroy_Impl() override;
+
+			virtual Ref<Object> CastTo_Impl(ClassID objectID) override;
+
+			virtual Result Run_Impl(const JobDesc* jobs, size_t numJobs, JobCounter* counter) override;
+			virtual Result Wait_Impl(JobCounter& counter, uint32_t value) override;
+			inline virtual uint32_t GetNumWorkers_Impl() override { return static_cast<uint32_t>(m_workers.size()); }
+			virtual JobSystemStats GetStats_Impl() override;
+		private:
+			struct Worker;
+
+			struct Fiber
+			{
+				Details::FiberContext context;
+				GenericJobSystem* system;
+				// The worker running the fiber, fibers move between workers when they're resumed
+				Worker* worker = nullptr;
+			};
+
+			// What the fiber that was switched to does for the fiber that switched away
+			// Done after the switch, since a fiber can't be resumed by another worker while it's still running
+			enum class PendingAction
+			{
+				None,
+				FreeFiber,
+				WaitFiber
+			};
+
+			struct Worker
+			{
+				GenericJobSystem* system = nullptr;
+				std::thread thread;
+				Details::FiberContext threadFiber;
+				Fiber* currentFiber = nullptr;
+				Details::JobDeque deque;
+				uint32_t randomState = 0;
+
+				PendingAction pendingAction = PendingAction::None;
+				Fiber* pendingFiber = nullptr;
+				JobCounter* pendingCounter = nullptr;
+				uint32_t pendingValue = 0;
+
+				std::atomic<uint64_t> numJobsRun{ 0 };
+				std::atomic<uint64_t> numJobsStolen{ 0 };
+				std::atomic<uint64_t> numJobWaits{ 0 };
+			};
+
+			struct WaitingFiber
+			{
+				JobCounter* counter;
+				uint32_t value;
+				Fiber* fiber;
+			};
+
+			// The worker of the calling thread, nullptr on threads that aren't workers
+			static Worker*& CurrentWorker();
+
+			void WorkerMain(Worker* worker);
+			static void FiberMain(void* data);
+			// Runs jobs until the job system stops, self is the fiber this is called on
+			void RunJobs(Fiber* self);
+			// Finishes the pending action of the fiber that switched to self
+			void CompleteSwitch(Fiber* self);
+
+			bool PopJob(Worker& worker, Details::Job& job);
+			void FinishJob(const Details::Job& job);
+			bool HasJobs() const;
+			// Wakes sleeping workers after jobs or fibers became ready
+			void WakeWorkers(size_t count);
+			void Sleep();
+
+			// Takes a fiber from the pool or creates a new one, returns nullptr if a fiber couldn't be created
+			Fiber* AcquireFiber();
+			void PushReadyFiber(Fiber* fiber);
+			Fiber* PopReadyFiber();
+			// Moves the fibers whose counters were reached to the ready queue and wakes blocked threads
+			void WakeWaiters();
+
+			std::vector<std::unique_ptr<Worker>> m_workers;
+			size_t m_fiberStackSize = 0;
+			std::atomic<bool> m_isStopping{ false };
+
+			// Jobs queued from threads that aren't workers
+			Mutex m_queueMutex{ "Job queue" };
+			std::deque<Details::Job> m_queue;
+			std::atomic<size_t> m_queueSize{ 0 };
+
+			Mutex m_fiberMutex{ "Job fiber pool" };
+			std::vector<std::unique_ptr<Fiber>> m_fibers;
+			std::vector<Fiber*> m_freeFibers;
+
+			// Resumed fibers go first, they're holding stacks and usually a caller's critical path
+			Mutex m_readyMutex{ "Job ready fibers" };
+			std::deque<Fiber*> m_readyFibers;
+			std::atomic<size_t> m_numReadyFibers{ 0 };
+
+			std::mutex m_waitMutex;
+			std::condition_variable m_waitCondition;
+			std::vector<WaitingFiber> m_waitingFibers;
+			// Waiting fibers plus blocked threads, finishing jobs only takes m_waitMutex when this isn't 0
+			std::atomic<uint32_t> m_numWaiting{ 0 };
+			uint32_t m_numBlockedThreads = 0;
+			// Jobs that were queued and haven't finished, destroying waits for this to reach 0
+			std::atomic<uint64_t> m_numUnfinishedJobs{ 0 };
+
+			std::mutex m_sleepMutex;
+			std::condition_variable m_sleepCondition;
+			std::atomic<uint32_t> m_numSleeping{ 0 };
+		};
+	}
+}
+
+extern "C"
+{
+	// Allocates a generic job system, does not call create
+	// This function is meant for dynamic loading, if implementations ever get split off into separate DLLs
+	// This function is meant for internal use
+	BLAZE_API Blaze::Generic::GenericJobSystem* AllocateGenericJobSystem();
+}
+
+#endif // BLAZE_GENERIC_GENERICJOBSYSTEM_H
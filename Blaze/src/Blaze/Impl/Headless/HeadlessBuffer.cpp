@@ -0,0 +1,125 @@
+#include <pch.h>
+#include "HeadlessBuffer.h"
+#include <Blaze/Profiling/Profiler.h>
+#include <Blaze/Profiling/FlightRecorder.h>
+#include <Blaze/Memory/AllocationTracker.h>
+#include <Blaze/Profiling/ResourceCensus.h>
+
+#include <cstring>
+
+namespace Blaze
+{
+	namespace Headless
+	{
+		HeadlessBuffer::~HeadlessBuffer()
+		{
+			Destroy_Impl();
+		}
+
+		Result HeadlessBuffer::Create_Impl(const ObjectCreateInfo& createInfo)
+		{
+			BLAZE_ALLOCATION_TAG(AllocationTag::Renderer);
+
+			auto info = static_cast<const BufferCreateInfo&>(createInfo);
+			m_type = info.type;
+			m_indexSize = 0;
+			if (m_type == BufferType::Index)
+			{
+				// Same index formats as the other APIs
+				if ((info.indexFormat != Format::R8_UInt) && (info.indexFormat != Format::R16_UInt) && (info.indexFormat != Format::R32_UInt))
+					return Result::InvalidParam;
+				m_indexSize = Details::GetFormatInfo(info.indexFormat).sizeInBytes;
+			}
+
+			if (info.data && (info.size > 0))
+			{
+				BLAZE_PROFILE_SCOPE("Buffer::Upload");
+				FlightRecorder::Add(FlightMetric::NumBufferUploads, 1);
+				FlightRecorder::Add(FlightMetric::BufferUploadBytes, info.size);
+
+				const uint8_t* data = static_cast<const uint8_t*>(info.data);
+				m_data.assign(data, data + info.size);
+			}
+			// The contents stand in for GPU memory so census diffs match the other APIs
+			ResourceCensus::SetFootprint(this, sizeof(HeadlessBuffer), m_data.size());
+
+			return Result::Success;
+		}
+
+		Result HeadlessBuffer::Destroy_Impl()
+		{
+			m_data.clear();
+			m_data.shrink_to_fit();
+			m_isMapped = false;
+			ResourceCensus::SetFootprint(this, sizeof(HeadlessBuffer), 0);
+			return Result::Success;
+		}
+
+		Ref<Object> HeadlessBuffer::CastTo_Impl(ClassID objectID)
+		{
+			constexpr std::array<ClassID, 3> castableIDs = {
+				Object::GetStaticClassID(),
+				Buffer::GetStaticClassID(),
+				GetStaticClassID()
+			};
+
+			// Check to make sure the class ID is valid
+			if (std::find(castableIDs.begin(), castableIDs.end(), objectID) == castableIDs.end())
+				return Ref<Object>{ nullptr };
+
+			return shared_from_this();
+		}
+
+		Result HeadlessBuffer::Write_Impl(const void* data, size_t sizeInBytes)
+		{
+			BLAZE_PROFILE_SCOPE("Buffer::Write");
+			BLAZE_ALLOCATION_TAG(AllocationTag::Renderer);
+			FlightRecorder::Add(FlightMetric::NumBufferUploads, 1);
+			FlightRecorder::Add(FlightMetric::BufferUploadBytes, sizeInBytes);
+
+			if (m_isMapped)
+				return Result::InvalidParam;
+
+			// Like BufferData, a write replaces the whole buffer
+			if (sizeInBytes != m_data.size())
+			{
+				m_data.resize(sizeInBytes);
+				ResourceCensus::SetFootprint(this, sizeof(HeadlessBuffer), m_data.size());
+			}
+			if (sizeInBytes)
+				std::memcpy(m_data.data(), data, sizeInBytes);
+
+			return Result::Success;
+		}
+
+		Result HeadlessBuffer::MapMemory_Impl(size_t sizeInBytes, BufferAccess access, void*& ptr)
+		{
+			BLAZE_PROFILE_SCOPE("Buffer::MapMemory");
+			(void)access;
+
+			ptr = nullptr;
+			if (m_isMapped || (sizeInBytes > m_data.size()))
+				return Result::InvalidParam;
+
+			m_isMapped = true;
+			ptr = m_data.data();
+			return Result::Success;
+		}
+
+		Result HeadlessBuffer::UnmapMemory_Impl()
+		{
+			BLAZE_PROFILE_SCOPE("Buffer::UnmapMemory");
+
+			if (!m_isMapped)
+				return Result::InvalidParam;
+
+			m_isMapped = false;
+			return Result::Success;
+		}
+	}
+}
+
+Blaze::Headless::HeadlessBuffer* AllocateHeadlessBuffer()
+{
+	return new Blaze::Headless::HeadlessBuffer();
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#ifndef BLAZE_HEADLESS_HEADLESSBUFFER_H
+#define BLAZE_HEADLESS_HEADLESSBUFFER_H
+
+#include <Blaze/Core.h>
+#include <Blaze/Error.h>
+#include <Blaze/Renderer/Buffer.h>
+
+#include <vector>
+
+namespace Blaze
+{
+	namespace Headless
+	{
+		// Buffer kept in system memory, writes and mapped memory go straight to it
+		class HeadlessBuffer
+			:public Buffer
+		{
+		public:
+			HeadlessBuffer() { classID = GetStaticClassID(); }
+			~HeadlessBuffer();
+
+			constexpr static ClassID GetStaticClassID() { return Details::MakeClassID(Details::InterfaceID::Buffer, Details::ImplementationID::Headless); }
+
+			virtual Result Create_Impl(const ObjectCreateInfo& createInfo) override;
+			virtual Result Destroy_Impl() override;
+
+			virtual Ref<Object> CastTo_Impl(ClassID objectID) override;
+
+			virtual Result Write_Impl(const void* data, size_t sizeInBytes) override;
+
+			virtual Result MapMemory_Impl(size_t sizeInBytes, BufferAccess access, void*& ptr) override;
+
+			virtual Result UnmapMemory_Impl() override;
+
+			inline BufferType GetType() const { return m_type; }
+			inline size_t GetSize() const { return m_data.size(); }
+			// Bytes per index, 0 for buffers that aren't index buffers
+			inline uint32_t GetIndexSize() const { return m_indexSize; }
+		private:
+			BufferType m_type = BufferType::Invalid;
+			uint32_t m_indexSize = 0;
+			std::vector<uint8_t> m_data;
+			bool m_isMapped = false;
+		};
+	}
+}
+
+extern "C"
+{
+	// Allocates a headless buffer, does not call create
+	// This function is meant for dynamic loading, if implementations ever get split off into separate DLLs
+	// This function is meant for internal use
+	BLAZE_API Blaze::Headless::HeadlessBuffer* AllocateHeadlessBuffer();
+}
+
+#endif // BLAZE_HEADLESS_HEADLESSBUFFER_H
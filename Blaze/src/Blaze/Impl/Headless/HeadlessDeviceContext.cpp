@@ -0,0 +1,153 @@
+#include <pch.h>
+#include "HeadlessDeviceContext.h"
+#include <Blaze/Profiling/Profiler.h>
+#include <Blaze/Profiling/FlightRecorder.h>
+#include <Blaze/Profiling/FrameStatistics.h>
+
+namespace Blaze
+{
+	namespace Headless
+	{
+		namespace Details
+		{
+			// Gets a headless buffer, nullptr is returned for null buffers
+			static Result GetHeadlessBuffer(const Ref<Buffer>& buffer, Ref<HeadlessBuffer>& headlessBuffer)
+			{
+				headlessBuffer = nullptr;
+				if (!buffer)
+					return Result::Success;
+
+				// Buffers from other APIs can't be bound
+				if (buffer->GetDynamicClassID() != HeadlessBuffer::GetStaticClassID())
+					return Result::InvalidParam;
+
+				headlessBuffer = std::static_pointer_cast<HeadlessBuffer>(buffer);
+				return Result::Success;
+			}
+		}
+
+		Result HeadlessDeviceContext::Create_Impl(const ObjectCreateInfo& createInfo)
+		{
+			(void)createInfo;
+			m_format.Reset();
+			m_vertexBuffers = {};
+			m_indexBuffer = nullptr;
+			m_topology = PrimitiveTopology::TriangleList;
+			m_vertexArrayCacheStats = {};
+			return Result::Success;
+		}
+
+		Result HeadlessDeviceContext::Destroy_Impl()
+		{
+			m_vertexBuffers = {};
+			m_indexBuffer = nullptr;
+			return Result::Success;
+		}
+
+		Ref<Object> HeadlessDeviceContext::CastTo_Impl(ClassID objectID)
+		{
+			constexpr std::array<ClassID, 3> castableIDs = {
+				Object::GetStaticClassID(),
+				DeviceContext::GetStaticClassID(),
+				GetStaticClassID()
+			};
+
+			// Check to make sure the class ID is valid
+			if (std::find(castableIDs.begin(), castableIDs.end(), objectID) == castableIDs.end())
+				return Ref<Object>{ nullptr };
+
+			return shared_from_this();
+		}
+
+		Result HeadlessDeviceContext::SwapBuffers_Impl()
+		{
+			BLAZE_PROFILE_SCOPE("DeviceContext::SwapBuffers");
+			BLAZE_FLIGHT_TIMER(FlightMetric::SwapTime);
+
+			// Presenting takes no time, the frame statistics still need to see the frame end
+			const uint64_t swapTime = Profiler::GetTimestamp();
+			FrameStatistics::RecordPresent(swapTime, swapTime);
+			return Result::Success;
+		}
+
+		Result HeadlessDeviceContext::BindVertexBuffers_Impl(const VertexFormat& format, const Ref<Buffer>* vertexBuffers, uint32_t numVertexBuffers, const Ref<Buffer>& indexBuffer)
+		{
+			Result res;
+
+			if ((numVertexBuffers < format.GetNumBindings()) || (numVertexBuffers > maxVertexBindings))
+				return Result::InvalidParam;
+
+			std::array<Ref<HeadlessBuffer>, maxVertexBindings> headlessBuffers;
+			for (uint32_t i = 0; i < numVertexBuffers; i++)
+			{
+				if ((res = Details::GetHeadlessBuffer(vertexBuffers[i], headlessBuffers[i])) != Result::Success)
+					return res;
+			}
+
+			// Every binding that has attributes needs a buffer
+			for (const auto& attrib : format.GetAttributes())
+			{
+				if (!headlessBuffers[attrib.binding])
+					return Result::InvalidParam;
+			}
+
+			Ref<HeadlessBuffer> headlessIndexBuffer;
+			if ((res = Details::GetHeadlessBuffer(indexBuffer, headlessIndexBuffer)) != Result::Success)
+				return res;
+			if (headlessIndexBuffer && !headlessIndexBuffer->GetIndexSize())
+				return Result::InvalidParam;
+
+			m_format = format;
+			m_vertexBuffers = std::move(headlessBuffers);
+			m_indexBuffer = std::move(headlessIndexBuffer);
+			m_vertexArrayCacheStats.misses++;
+			return Result::Success;
+		}
+
+		Result HeadlessDeviceContext::SetPrimitiveTopology_Impl(PrimitiveTopology topology)
+		{
+			if ((topology <= PrimitiveTopology::Invalid) || (topology > PrimitiveTopology::TriangleStrip))
+				return Result::InvalidParam;
+
+			m_topology = topology;
+			return Result::Success;
+		}
+
+		Result HeadlessDeviceContext::DrawInstanced_Impl(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex)
+		{
+			// Every binding has to hold the vertices or instances the draw reads
+			for (uint32_t i = 0; i < m_format.GetNumBindings(); i++)
+			{
+				if (!m_vertexBuffers[i])
+					continue;
+
+				const VertexBinding binding = m_format.GetBinding(i);
+				const uint64_t numElements = binding.divisor ? (static_cast<uint64_t>(instanceCount) + binding.divisor - 1) / binding.divisor : static_cast<uint64_t>(firstVertex) + vertexCount;
+				if (numElements * binding.stride > m_vertexBuffers[i]->GetSize())
+					return Result::InvalidParam;
+			}
+
+			return Result::Success;
+		}
+
+		Result HeadlessDeviceContext::DrawIndexedInstanced_Impl(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t baseVertex)
+		{
+			(void)instanceCount;
+			(void)baseVertex;
+
+			// An index buffer has to be bound with BindVertexBuffers
+			if (!m_indexBuffer)
+				return Result::InvalidParam;
+
+			if ((static_cast<uint64_t>(firstIndex) + indexCount) * m_indexBuffer->GetIndexSize() > m_indexBuffer->GetSize())
+				return Result::InvalidParam;
+
+			return Result::Success;
+		}
+	}
+}
+
+Blaze::Headless::HeadlessDeviceContext* AllocateHeadlessDeviceContext()
+{
+	return new Blaze::Headless::HeadlessDeviceContext();
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#ifndef BLAZE_HEADLESS_HEADLESSDEVICECONTEXT_H
+#define BLAZE_HEADLESS_HEADLESSDEVICECONTEXT_H
+
+#include <Blaze/Core.h>
+#include <Blaze/Error.h>
+#include <Blaze/Renderer/DeviceContext.h>
+#include <Blaze/Impl/Headless/HeadlessBuffer.h>
+
+namespace Blaze
+{
+	namespace Headless
+	{
+		// Device context without a GPU, binds and draws are validated against the buffers' sizes but nothing is drawn
+		// Swaps still mark frames for the frame statistics, so the CPU side of a frame can be measured on any machine
+		class HeadlessDeviceContext
+			:public DeviceContext
+		{
+		public:
+			inline HeadlessDeviceContext() { classID = GetStaticClassID(); }
+			virtual ~HeadlessDeviceContext() = default;
+
+			static constexpr ClassID GetStaticClassID() { return Details::MakeClassID(Details::InterfaceID::DeviceContext, Details::ImplementationID::Headless); }
+
+			virtual Result Create_Impl(const ObjectCreateInfo& createInfo) override;
+			virtual Result Destroy_Impl() override;
+
+			virtual Ref<Object> CastTo_Impl(ClassID objectID) override;
+
+			inline virtual RenderAPI GetRenderAPI_Impl() override { return RenderAPI::Headless; }
+
+			virtual Result SwapBuffers_Impl() override;
+			virtual Result BindVertexBuffers_Impl(const VertexFormat& format, const Ref<Buffer>* vertexBuffers, uint32_t numVertexBuffers, const Ref<Buffer>& indexBuffer) override;
+			virtual Result SetPrimitiveTopology_Impl(PrimitiveTopology topology) override;
+			virtual Result DrawInstanced_Impl(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex) override;
+			virtual Result DrawIndexedInstanced_Impl(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t baseVertex) override;
+			// There are no vertex arrays, every bind is a miss
+			inline virtual VertexArrayCacheStats GetVertexArrayCacheStats_Impl() override { return m_vertexArrayCacheStats; }
+			// Nothing runs on a GPU, so there's nothing to time or report
+			inline virtual Result BeginGPUScope_Impl(const char* name) override { (void)name; return Result::Success; }
+			inline virtual Result EndGPUScope_Impl() override { return Result::Success; }
+			inline virtual GPUProfilerStats GetGPUProfilerStats_Impl() override { return GPUProfilerStats{}; }
+			inline virtual DebugOutputSummary GetDebugOutputSummary_Impl() override { return DebugOutputSummary{}; }
+		private:
+			// Bound buffers, only kept to validate draws
+			VertexFormat m_format;
+			std::array<Ref<HeadlessBuffer>, maxVertexBindings> m_vertexBuffers;
+			Ref<HeadlessBuffer> m_indexBuffer;
+			PrimitiveTopology m_topology = PrimitiveTopology::TriangleList;
+			VertexArrayCacheStats m_vertexArrayCacheStats;
+		};
+	}
+}
+
+extern "C"
+{
+	// Allocates a headless device context, does not call create
+	// This function is meant for dynamic loading, if implementations ever get split off into separate DLLs
+	// This function is meant for internal use
+	BLAZE_API Blaze::Headless::HeadlessDeviceContext* AllocateHeadlessDeviceContext();
+}
+
+#endif // BLAZE_HEADLESS_HEADLESSDEVICECONTEXT_H
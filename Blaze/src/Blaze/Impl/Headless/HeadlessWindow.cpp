@@ -0,0 +1,170 @@
+#include <pch.h>
+#include "HeadlessWindow.h"
+#include <Blaze/Profiling/Profiler.h>
+#include <Blaze/Profiling/FlightRecorder.h>
+#include <Blaze/Memory/AllocationTracker.h>
+
+namespace Blaze
+{
+	namespace Headless
+	{
+		Result HeadlessWindow::Create_Impl(const ObjectCreateInfo& createInfo)
+		{
+			auto info = static_cast<const WindowCreateInfo&>(createInfo);
+			for (auto& eventHandlers : m_eventHandlers) eventHandlers.clear();
+			m_eventHandlers[0].insert(m_eventHandlers[0].begin(), info.eventHandlers.begin(), info.eventHandlers.end());
+			m_postedEvents.clear();
+
+			m_title = info.wndTitle;
+			m_size = { info.width, info.height };
+			m_position = { info.x, info.y };
+			m_showState = info.showState;
+			m_isRun = true;
+
+			WindowEvent event;
+			event.eventCode = WindowEvent::Create;
+			DispatchEvent(event);
+			return Result::Success;
+		}
+
+		Result HeadlessWindow::Destroy_Impl()
+		{
+			for (auto& eventHandlers : m_eventHandlers)
+				eventHandlers.clear();
+			m_postedEvents.clear();
+			m_isRun = false;
+			return Result::Success;
+		}
+
+		Result HeadlessWindow::Update_Impl()
+		{
+			BLAZE_PROFILE_SCOPE("Window::Update");
+			BLAZE_FLIGHT_TIMER(FlightMetric::WindowUpdateTime);
+			BLAZE_ALLOCATION_TAG(AllocationTag::Window);
+
+			// Events posted by handlers while dispatching wait for the next update
+			m_dispatchedEvents.swap(m_postedEvents);
+			for (const WindowEvent& event : m_dispatchedEvents)
+			{
+				DispatchEvent(event);
+
+				// Like closing a system window, nothing after it is dispatched
+				if (event.eventCode == WindowEvent::Destroy)
+				{
+					m_isRun = false;
+					break;
+				}
+			}
+			m_dispatchedEvents.clear();
+			return Result::Success;
+		}
+
+		Ref<Object> HeadlessWindow::CastTo_Impl(ClassID objectID)
+		{
+			// Array of ids that can be casted to
+			constexpr ClassID castableIDs[]
+			{
+				Object::GetStaticClassID(),
+				Window::GetStaticClassID(),
+				GetStaticClassID() // Include a class ID for this type as well
+			};
+
+			// If the id can be casted to, return a pointer his object
+			for (auto id : castableIDs)
+			{
+				if (id == objectID)
+					return shared_from_this();
+			}
+			return Ref<Object>{ nullptr };
+		}
+
+		Result HeadlessWindow::PushEventHandler_Impl(WindowEvent::EventCode eventCode, WindowEventHandler eventHandler)
+		{
+			m_eventHandlers[static_cast<size_t>(eventCode)].push_back(eventHandler);
+			return Result::Success;
+		}
+
+		Result HeadlessWindow::RemoveEventHandler_Impl(WindowEvent::EventCode eventCode, WindowEventHandler eventHandler)
+		{
+			auto& eventHandlers = m_eventHandlers[static_cast<size_t>(eventCode)];
+
+			// Find the handler
+			auto handlerLocation = std::find(eventHandlers.begin(), eventHandlers.end(), eventHandler);
+			if (handlerLocation == eventHandlers.end())
+				return Result::InvalidParam;
+
+			// Erase the handler
+			eventHandlers.erase(handlerLocation);
+			return Result::Success;
+		}
+
+		Result HeadlessWindow::PostEvent_Impl(const WindowEvent& event)
+		{
+			if ((event.eventCode <= WindowEvent::Invalid) || (event.eventCode > WindowEvent::NumEvents))
+				return Result::InvalidParam;
+
+			m_postedEvents.push_back(event);
+			return Result::Success;
+		}
+
+		void HeadlessWindow::DispatchEvent(const WindowEvent& event)
+		{
+			BLAZE_PROFILE_SCOPE("Window::DispatchEvent");
+			FlightRecorder::Add(FlightMetric::NumWindowEvents, 1);
+
+			// General event handlers
+			for (auto& eventHandler : m_eventHandlers[0])
+				eventHandler.eventHandler(event, eventHandler.data);
+			// Specific event handlers
+			for (auto& eventHandler : m_eventHandlers[static_cast<size_t>(event.eventCode)])
+				eventHandler.eventHandler(event, eventHandler.data);
+		}
+
+		Result HeadlessWindow::SetTitle_Impl(std::string_view newTitle)
+		{
+			BLAZE_ALLOCATION_TAG(AllocationTag::Window);
+
+			m_title = newTitle;
+			return Result::Success;
+		}
+
+		Result HeadlessWindow::Resize_Impl(uint32_t width, uint32_t height)
+		{
+			m_size = { width, height };
+
+			WindowEvent event;
+			event.eventCode = WindowEvent::Resize;
+			event.SetWindowEventInfo(WindowResizeEventInfo{ width, height });
+			DispatchEvent(event);
+			return Result::Success;
+		}
+
+		Result HeadlessWindow::Move_Impl(int32_t x, int32_t y)
+		{
+			m_position = { x, y };
+
+			WindowEvent event;
+			event.eventCode = WindowEvent::Move;
+			event.SetWindowEventInfo(WindowMoveEventInfo{ x, y });
+			DispatchEvent(event);
+			return Result::Success;
+		}
+
+		Result HeadlessWindow::SetShowState_Impl(WindowShowState showState)
+		{
+			if (showState == WindowShowState::Invalid)
+				return Result::InvalidParam;
+
+			m_showState = showState;
+			return Result::Success;
+		}
+	}
+}
+
+extern "C"
+{
+	Blaze::Headless::HeadlessWindow* AllocateHeadlessWindow()
+	{
+		return new Blaze::Headless::HeadlessWindow();
+	}
+}
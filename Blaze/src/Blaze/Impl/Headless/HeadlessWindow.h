@@ -0,0 +1,79 @@
+#pragma once
+
+#ifndef BLAZE_HEADLESS_HEADLESSWINDOW_H
+#define BLAZE_HEADLESS_HEADLESSWINDOW_H
+
+#include <Blaze/Core.h>
+#include <Blaze/Error.h>
+#include <Blaze/Window.h>
+
+#include <vector>
+#include <array>
+
+namespace Blaze
+{
+	namespace Headless
+	{
+		// Window without a display, it only changes when told to and its input comes from PostEvent
+		// Resizing, moving and destroying it dispatch the same events a system window would
+		class HeadlessWindow
+			:public Window
+		{
+		public:
+			inline HeadlessWindow() { classID = GetStaticClassID(); }
+
+			virtual Result Create_Impl(const ObjectCreateInfo& createInfo) override;
+			virtual Result Destroy_Impl() override;
+
+			constexpr static ClassID GetStaticClassID() { return Details::MakeClassID(Details::InterfaceID::Window, Details::ImplementationID::Headless); }
+
+			virtual Result Update_Impl() override;
+			inline virtual bool IsRunning_Impl() override { return m_isRun; }
+
+			virtual Ref<Object> CastTo_Impl(ClassID objectID) override;
+
+			virtual Result PushEventHandler_Impl(WindowEvent::EventCode eventCode, WindowEventHandler eventHandler) override;
+			virtual Result RemoveEventHandler_Impl(WindowEvent::EventCode eventCode, WindowEventHandler eventHandler) override;
+			virtual Result PostEvent_Impl(const WindowEvent& event) override;
+
+			virtual Result SetTitle_Impl(std::string_view newTitle) override;
+			inline virtual std::string GetTitle_Impl() override { return m_title; }
+
+			virtual Result Resize_Impl(uint32_t width, uint32_t height) override;
+			inline virtual std::array<uint32_t, 2> GetWindowSize_Impl() override { return m_size; }
+			inline virtual std::array<uint32_t, 2> GetClientSize_Impl() override { return m_size; }
+
+			virtual Result Move_Impl(int32_t x, int32_t y) override;
+			inline virtual std::array<int32_t, 2> GetPosition_Impl() override { return m_position; }
+
+			virtual Result SetShowState_Impl(WindowShowState showState) override;
+			inline virtual WindowShowState GetShowState_Impl() override { return m_showState; }
+
+			inline virtual WindowAPI GetWindowAPI_Impl() override { return WindowAPI::Headless; }
+		private:
+			void DispatchEvent(const WindowEvent& event);
+
+			// One vector for each event, extra one for all events
+			std::array<std::vector<WindowEventHandler>, WindowEvent::NumEvents + 1> m_eventHandlers;
+			// Events from PostEvent, dispatched by the next Update
+			std::vector<WindowEvent> m_postedEvents;
+			std::vector<WindowEvent> m_dispatchedEvents;
+
+			std::string m_title;
+			std::array<uint32_t, 2> m_size{};
+			std::array<int32_t, 2> m_position{};
+			WindowShowState m_showState = WindowShowState::Default;
+			bool m_isRun = false;
+		};
+	}
+}
+
+extern "C"
+{
+	// Allocates a headless window, does not call create
+	// This function is meant for dynamic loading, if implementations ever get split off into separate DLLs
+	// This function is meant for internal use
+	BLAZE_API Blaze::Headless::HeadlessWindow* AllocateHeadlessWindow();
+}
+
+#endif // BLAZE_HEADLESS_HEADLESSWINDOW_H
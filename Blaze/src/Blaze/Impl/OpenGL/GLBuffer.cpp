@@ -1,5 +1,10 @@
 #include <pch.h>
 #include "GLBuffer.h"
+#include <Blaze/Profiling/Profiler.h>
+#include <Blaze/Profiling/FlightRecorder.h>
+#include <Blaze/Memory/AllocationTracker.h>
+#include <Blaze/Profiling/ResourceCensus.h>
+#include <Blaze/Impl/OpenGL/GLDebugOutput.h>
 #include <glad/gl.h>
 
 namespace Blaze
@@ -8,18 +13,34 @@ namespace Blaze
 	{
 		namespace Details
 		{
-			static GLenum BufferTypeToGLTarget(BufferType type)
+			// Target used for uploads, binding GL_ELEMENT_ARRAY_BUFFER would modify whatever vertex array is bound
+			constexpr GLenum uploadTarget = GL_COPY_WRITE_BUFFER;
+
+			static GLenum BufferUsageToGLUsage(BufferUsage usage)
 			{
-				constexpr std::array<GLenum, 2> translationTable =
+				constexpr std::array<GLenum, 3> translationTable =
 				{
-					GL_ARRAY_BUFFER,
-					GL_ELEMENT_ARRAY_BUFFER
+					GL_STATIC_DRAW,
+					GL_DYNAMIC_DRAW,
+					GL_STREAM_DRAW
 				};
 
-				if ((static_cast<size_t>(type) < 1) || (static_cast<size_t>(type) >= translationTable.size()))
-					return 0;
+				if ((static_cast<size_t>(usage) < 1) || (static_cast<size_t>(usage) > translationTable.size()))
+					return GL_DYNAMIC_DRAW;
 
-				return translationTable[static_cast<size_t>(type) - 1];
+				return translationTable[static_cast<size_t>(usage) - 1];
+			}
+
+			// Returns 0 for formats that can't be used as indices
+			static GLenum IndexFormatToGLType(Format format)
+			{
+				switch (format)
+				{
+				case Format::R8_UInt: return GL_UNSIGNED_BYTE;
+				case Format::R16_UInt: return GL_UNSIGNED_SHORT;
+				case Format::R32_UInt: return GL_UNSIGNED_INT;
+				default: return 0;
+				}
 			}
 
 			static GLenum BufferAccessToGLAccess(BufferAccess access)
@@ -31,7 +52,7 @@ namespace Blaze
 					GL_READ_WRITE
 				};
 
-				if ((static_cast<size_t>(access) < 1) || (static_cast<size_t>(access) >= translationTable.size()))
+				if ((static_cast<size_t>(access) < 1) || (static_cast<size_t>(access) > translationTable.size()))
 					return 0;
 
 				return translationTable[static_cast<size_t>(access) - 1];
@@ -49,17 +70,28 @@ namespace Blaze
 			m_deviceContext = info.deviceContext->CastTo<GLDeviceContext>();
 			m_gl = m_deviceContext->GetGL();
 			m_type = info.type;
+			m_usage = Details::BufferUsageToGLUsage(info.usage);
+			m_indexType = Details::IndexFormatToGLType(info.indexFormat);
+
+			if ((m_type == BufferType::Index) && !m_indexType)
+				return Result::InvalidParam;
 
+			GLDebugSiteScope debugSite("Buffer::Create");
 			m_deviceContext->MakeCurrent();
 
 			m_gl.GenBuffers(1, &m_bufferID);
 
 			if (info.data && (info.size > 0))
 			{
-				GLenum target = Details::BufferTypeToGLTarget(m_type);
-				m_gl.BindBuffer(target, m_bufferID);
-				m_gl.BufferData(target, info.size, info.data, GL_DYNAMIC_DRAW);
+				BLAZE_PROFILE_SCOPE("Buffer::Upload");
+				FlightRecorder::Add(FlightMetric::NumBufferUploads, 1);
+				FlightRecorder::Add(FlightMetric::BufferUploadBytes, info.size);
+
+				m_gl.BindBuffer(Details::uploadTarget, m_bufferID);
+				m_gl.BufferData(Details::uploadTarget, info.size, info.data, m_usage);
+				m_size = info.size;
 			}
+			ResourceCensus::SetFootprint(this, sizeof(GLBuffer), m_size);
 
 			return Result::Success;
 		}
@@ -68,12 +100,16 @@ namespace Blaze
 		{
 			if (m_bufferID)
 			{
-				m_deviceContext->MakeCurrent();
+				GLDebugSiteScope debugSite("Buffer::Destroy");
+
+				// Cached vertex arrays would keep referencing the deleted buffer
+				m_deviceContext->InvalidateVertexArrays(m_bufferID);
 
-				GLenum target = Details::BufferTypeToGLTarget(m_type);
-				m_gl.BindBuffer(target, m_bufferID);
+				m_deviceContext->MakeCurrent();
 				m_gl.DeleteBuffers(1, &m_bufferID);
 				m_bufferID = 0;
+				m_size = 0;
+				ResourceCensus::SetFootprint(this, sizeof(GLBuffer), 0);
 			}
 			else
 				Result::Uninitialized;
@@ -98,34 +134,58 @@ namespace Blaze
 
 		Result GLBuffer::Write_Impl(const void* data, size_t sizeInBytes)
 		{
+			BLAZE_PROFILE_SCOPE("Buffer::Write");
+			BLAZE_ALLOCATION_TAG(AllocationTag::Renderer);
+			FlightRecorder::Add(FlightMetric::NumBufferUploads, 1);
+			FlightRecorder::Add(FlightMetric::BufferUploadBytes, sizeInBytes);
+			GLDebugSiteScope debugSite("Buffer::Write");
+
 			m_deviceContext->MakeCurrent();
 
-			GLenum target = Details::BufferTypeToGLTarget(m_type);
-			m_gl.BindBuffer(target, m_bufferID);
-			m_gl.BufferData(target, sizeInBytes, data, GL_DYNAMIC_DRAW);
+			m_gl.BindBuffer(Details::uploadTarget, m_bufferID);
+			m_gl.BufferData(Details::uploadTarget, sizeInBytes, data, m_usage);
+
+			// Most writes refill the buffer at the same size, the census only needs to hear about new sizes
+			if (sizeInBytes != m_size)
+			{
+				m_size = sizeInBytes;
+				ResourceCensus::SetFootprint(this, sizeof(GLBuffer), m_size);
+			}
 
 			return Result::Success;
 		}
 
 		Result GLBuffer::MapMemory_Impl(size_t sizeInBytes, BufferAccess access, void*& ptr)
 		{
-			m_deviceContext->MakeCurrent();
+			BLAZE_PROFILE_SCOPE("Buffer::MapMemory");
 
-			GLenum target = Details::BufferTypeToGLTarget(m_type);
+			ptr = nullptr;
 			GLenum glAccess = Details::BufferAccessToGLAccess(access);
-			m_gl.BindBuffer(target, m_bufferID);
-			ptr = m_gl.MapBuffer(target, glAccess);
+			if (!glAccess)
+				return Result::InvalidParam;
+
+			// Mapping a buffer the GPU still uses is where drivers report implicit synchronization
+			GLDebugSiteScope debugSite("Buffer::MapMemory");
+			m_deviceContext->MakeCurrent();
+
+			m_gl.BindBuffer(Details::uploadTarget, m_bufferID);
+			ptr = m_gl.MapBuffer(Details::uploadTarget, glAccess);
+			// Eg. the buffer is already mapped or has no storage yet
+			if (!ptr)
+				return Result::SystemError;
 
 			return Result::Success;
 		}
 
 		Result GLBuffer::UnmapMemory_Impl()
 		{
+			BLAZE_PROFILE_SCOPE("Buffer::UnmapMemory");
+			GLDebugSiteScope debugSite("Buffer::UnmapMemory");
+
 			m_deviceContext->MakeCurrent();
 
-			GLenum target = Details::BufferTypeToGLTarget(m_type);
-			m_gl.BindBuffer(target, m_bufferID);
-			m_gl.UnmapBuffer(target);
+			m_gl.BindBuffer(Details::uploadTarget, m_bufferID);
+			m_gl.UnmapBuffer(Details::uploadTarget);
 
 			return Result::Success;
 		}
@@ -31,12 +31,21 @@ namespace Blaze
 			virtual Result MapMemory_Impl(size_t sizeInBytes, BufferAccess access, void*& ptr) override;
 
 			virtual Result UnmapMemory_Impl() override;
+
+			inline unsigned int GetBufferID() { return m_bufferID; }
+			inline BufferType GetType() { return m_type; }
+			// Gets the OpenGL type of the indices (GL_UNSIGNED_SHORT, etc.)
+			inline unsigned int GetIndexType() { return m_indexType; }
 		private:
 
 			Ref<GLDeviceContext> m_deviceContext;
 			GladGLContext m_gl;
 			BufferType m_type;
-			unsigned int m_bufferID;
+			unsigned int m_usage;
+			unsigned int m_indexType;
+			unsigned int m_bufferID = 0;
+			// Bytes the last BufferData call allocated
+			size_t m_size = 0;
 		};
 	}
 }
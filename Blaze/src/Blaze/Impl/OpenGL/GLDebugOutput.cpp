@@ -0,0 +1,240 @@
+#include <pch.h>
+#include "GLDebugOutput.h"
+#include <Blaze/Log.h>
+#include <Blaze/Profiling/FlightRecorder.h>
+#include <glad/gl.h>
+
+#include <cstring>
+
+namespace Blaze
+{
+	namespace OpenGL
+	{
+		namespace Details
+		{
+			// Site of messages reported outside of any GLDebugSiteScope, like the driver's own threads
+			constexpr const char* unknownDebugSite = "Unknown";
+
+			constexpr std::array<const char*, static_cast<size_t>(DebugMessageSource::NumSources) + 1> debugSourceNames =
+			{
+				"Invalid",
+				"API",
+				"Window System",
+				"Shader Compiler",
+				"Third Party",
+				"Application",
+				"Other"
+			};
+
+			constexpr std::array<const char*, static_cast<size_t>(DebugMessageType::NumTypes) + 1> debugTypeNames =
+			{
+				"Invalid",
+				"Error",
+				"Deprecated Behavior",
+				"Undefined Behavior",
+				"Portability",
+				"Performance",
+				"Other"
+			};
+
+			static DebugMessageSource GLToDebugSource(GLenum source)
+			{
+				switch (source)
+				{
+				case GL_DEBUG_SOURCE_API: return DebugMessageSource::API;
+				case GL_DEBUG_SOURCE_WINDOW_SYSTEM: return DebugMessageSource::WindowSystem;
+				case GL_DEBUG_SOURCE_SHADER_COMPILER: return DebugMessageSource::ShaderCompiler;
+				case GL_DEBUG_SOURCE_THIRD_PARTY: return DebugMessageSource::ThirdParty;
+				case GL_DEBUG_SOURCE_APPLICATION: return DebugMessageSource::Application;
+				default: return DebugMessageSource::Other;
+				}
+			}
+
+			static DebugMessageType GLToDebugType(GLenum type)
+			{
+				switch (type)
+				{
+				case GL_DEBUG_TYPE_ERROR: return DebugMessageType::Error;
+				case GL_DEBUG_TYPE_DEPRECATED_BEHAVIOR: return DebugMessageType::DeprecatedBehavior;
+				case GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR: return DebugMessageType::UndefinedBehavior;
+				case GL_DEBUG_TYPE_PORTABILITY: return DebugMessageType::Portability;
+				case GL_DEBUG_TYPE_PERFORMANCE: return DebugMessageType::Performance;
+				default: return DebugMessageType::Other;
+				}
+			}
+
+			static DebugMessageSeverity GLToDebugSeverity(GLenum severity)
+			{
+				switch (severity)
+				{
+				case GL_DEBUG_SEVERITY_HIGH: return DebugMessageSeverity::High;
+				case GL_DEBUG_SEVERITY_MEDIUM: return DebugMessageSeverity::Medium;
+				case GL_DEBUG_SEVERITY_LOW: return DebugMessageSeverity::Low;
+				default: return DebugMessageSeverity::Notification;
+				}
+			}
+
+			// Tells distinct messages apart, 0 is left for empty slots
+			static uint64_t MakeDebugMessageKey(GLenum source, GLenum type, GLuint id, const char* site)
+			{
+				uint64_t key = (static_cast<uint64_t>(id) << 32) ^ (static_cast<uint64_t>(source) << 16) ^ static_cast<uint64_t>(type);
+				key ^= reinterpret_cast<uintptr_t>(site) * 0x9e3779b97f4a7c15ull;
+				key ^= key >> 29;
+				key *= 0xbf58476d1ce4e5b9ull;
+				key ^= key >> 32;
+				return key ? key : 1;
+			}
+		}
+
+		Result GLDebugOutput::Initialize(GladGLContext& gl)
+		{
+			if (m_isInitialized)
+				return Result::Success;
+
+			// Debug output is core since OpenGL 4.3, the 3.3 context needs KHR_debug
+			if (!gl.KHR_debug || !gl.DebugMessageCallback || !gl.DebugMessageControl)
+				return Result::Uninitialized;
+
+			GLint contextFlags = 0;
+			gl.GetIntegerv(GL_CONTEXT_FLAGS, &contextFlags);
+			if (!(contextFlags & GL_CONTEXT_FLAG_DEBUG_BIT))
+				return Result::Uninitialized;
+
+			for (Slot& slot : m_slots)
+			{
+				slot.key.store(0, std::memory_order_relaxed);
+				slot.state.store(emptySlot, std::memory_order_relaxed);
+				slot.count.store(0, std::memory_order_relaxed);
+				slot.lastCount = 0;
+				slot.isLogged = false;
+			}
+			m_numDropped.store(0, std::memory_order_relaxed);
+			m_summary = {};
+			m_summary.messages.reserve(maxDebugMessageKinds);
+
+			// Synchronous output calls back from inside the offending call, on the thread that made it, so its site is known
+			gl.Enable(GL_DEBUG_OUTPUT);
+			gl.Enable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+			gl.DebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DONT_CARE, 0, nullptr, GL_TRUE);
+			gl.DebugMessageCallback(&GLDebugOutput::OnMessage, this);
+
+			m_isInitialized = true;
+			return Result::Success;
+		}
+
+		void GLDebugOutput::Shutdown(GladGLContext& gl)
+		{
+			if (!m_isInitialized)
+				return;
+
+			gl.DebugMessageCallback(nullptr, nullptr);
+			gl.Disable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+			gl.Disable(GL_DEBUG_OUTPUT);
+			m_isInitialized = false;
+		}
+
+		void GLAD_API_PTR GLDebugOutput::OnMessage(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar* message, const void* userParam)
+		{
+			const_cast<GLDebugOutput*>(static_cast<const GLDebugOutput*>(userParam))->AddMessage(source, type, id, severity, length, message);
+		}
+
+		void GLDebugOutput::AddMessage(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar* message)
+		{
+			// Runs inside the driver, so it must not block or allocate, the table is open addressed and slots are never freed
+			FlightRecorder::Add(FlightMetric::NumDebugMessages, 1);
+
+			const char* site = GLDebugSiteScope::GetCurrentSite();
+			if (!site)
+				site = Details::unknownDebugSite;
+			const uint64_t key = Details::MakeDebugMessageKey(source, type, id, site);
+
+			for (uint32_t probe = 0; probe < maxDebugMessageKinds; probe++)
+			{
+				Slot& slot = m_slots[(key + probe) % maxDebugMessageKinds];
+
+				uint64_t slotKey = slot.key.load(std::memory_order_acquire);
+				if ((slotKey == 0) && slot.key.compare_exchange_strong(slotKey, key, std::memory_order_acq_rel))
+				{
+					slot.state.store(writingSlot, std::memory_order_relaxed);
+					slot.info.id = id;
+					slot.info.source = Details::GLToDebugSource(source);
+					slot.info.type = Details::GLToDebugType(type);
+					slot.info.severity = Details::GLToDebugSeverity(severity);
+					slot.info.site = site;
+
+					// length doesn't count the null and is negative when the driver only null terminates
+					size_t messageLength = (length >= 0) ? static_cast<size_t>(length) : std::strlen(message);
+					messageLength = std::min(messageLength, slot.message.size() - 1);
+					std::memcpy(slot.message.data(), message, messageLength);
+					slot.message[messageLength] = '\0';
+					slot.info.message = slot.message.data();
+
+					slot.state.store(readySlot, std::memory_order_release);
+					slotKey = key;
+				}
+
+				if (slotKey == key)
+				{
+					slot.count.fetch_add(1, std::memory_order_relaxed);
+					return;
+				}
+			}
+
+			m_numDropped.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		void GLDebugOutput::EndFrame()
+		{
+			if (!m_isInitialized)
+				return;
+
+			m_summary.numMessages.fill(0);
+			m_summary.messages.clear();
+			m_summary.numDropped = m_numDropped.load(std::memory_order_relaxed);
+
+			for (Slot& slot : m_slots)
+			{
+				if (slot.state.load(std::memory_order_acquire) != readySlot)
+					continue;
+
+				const uint64_t count = slot.count.load(std::memory_order_relaxed);
+				const uint64_t frameCount = count - slot.lastCount;
+				slot.lastCount = count;
+				if (!frameCount)
+					continue;
+
+				DebugMessageSummary info = slot.info;
+				info.frameCount = frameCount;
+				info.totalCount = count;
+				m_summary.numMessages[static_cast<size_t>(info.type)] += frameCount;
+				m_summary.messages.push_back(info);
+
+				// Every kind of message is logged once, the counts say how often it came back
+				if (!slot.isLogged)
+				{
+					slot.isLogged = true;
+					const char* sourceName = Details::debugSourceNames[static_cast<size_t>(info.source)];
+					const char* typeName = Details::debugTypeNames[static_cast<size_t>(info.type)];
+					switch (info.severity)
+					{
+					case DebugMessageSeverity::High:
+						BLAZE_LOG_ERROR("OpenGL {} {} message {} in {}: {}", sourceName, typeName, info.id, info.site, info.message);
+						break;
+					case DebugMessageSeverity::Medium:
+					case DebugMessageSeverity::Low:
+						BLAZE_LOG_WARNING("OpenGL {} {} message {} in {}: {}", sourceName, typeName, info.id, info.site, info.message);
+						break;
+					default:
+						BLAZE_LOG_TRACE("OpenGL {} {} message {} in {}: {}", sourceName, typeName, info.id, info.site, info.message);
+						break;
+					}
+				}
+			}
+
+			std::sort(m_summary.messages.begin(), m_summary.messages.end(), [](const DebugMessageSummary& a, const DebugMessageSummary& b)
+			{
+				return a.frameCount > b.frameCount;
+			});
+		}
+	}
+}
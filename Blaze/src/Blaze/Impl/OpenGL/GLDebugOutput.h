@@ -0,0 +1,92 @@
+#pragma once
+
+#ifndef BLAZE_OPENGL_GLDEBUGOUTPUT_H
+#define BLAZE_OPENGL_GLDEBUGOUTPUT_H
+
+#include <Blaze/Core.h>
+#include <Blaze/Error.h>
+#include <Blaze/Renderer/DeviceContext.h>
+
+#include <array>
+#include <atomic>
+
+namespace Blaze
+{
+	namespace OpenGL
+	{
+		// Marks the GL calls made during its lifetime as coming from site, site must be a string literal
+		class GLDebugSiteScope
+		{
+		public:
+			inline explicit GLDebugSiteScope(const char* site)
+				:m_previousSite(m_currentSite)
+			{
+				m_currentSite = site;
+			}
+
+			inline ~GLDebugSiteScope() { m_currentSite = m_previousSite; }
+
+			GLDebugSiteScope(const GLDebugSiteScope&) = delete;
+			GLDebugSiteScope& operator=(const GLDebugSiteScope&) = delete;
+
+			// Site of the calling thread, nullptr outside of any scope
+			static inline const char* GetCurrentSite() { return m_currentSite; }
+		private:
+			// Debug messages are reported from inside the GL call that caused them, so this is the call they came from
+			static inline thread_local const char* m_currentSite = nullptr;
+
+			const char* m_previousSite;
+		};
+
+		// Collects KHR_debug messages into a fixed table of distinct messages
+		// The driver's callback only claims a slot and bumps counters, the messages are logged and summed up once per frame
+		// Like the GPU profiler it doesn't make any context current, the owning device context must be current when initializing it
+		class GLDebugOutput
+		{
+		public:
+			GLDebugOutput() = default;
+			GLDebugOutput(const GLDebugOutput&) = delete;
+			GLDebugOutput& operator=(const GLDebugOutput&) = delete;
+
+			// Installs the callback, fails if the context wasn't created with the debug flag or has no KHR_debug
+			Result Initialize(GladGLContext& gl);
+			// Removes the callback, has to be called before the context is deleted
+			void Shutdown(GladGLContext& gl);
+			inline bool IsInitialized() const { return m_isInitialized; }
+
+			// Logs messages seen for the first time and builds the frame's summary, called by the device context once per frame
+			void EndFrame();
+
+			inline DebugOutputSummary GetSummary() const { return m_summary; }
+		private:
+			// Slot states, a slot is only read once it's ready
+			static constexpr uint32_t emptySlot = 0;
+			static constexpr uint32_t writingSlot = 1;
+			static constexpr uint32_t readySlot = 2;
+
+			struct Slot
+			{
+				// Written by the callback
+				std::atomic<uint64_t> key{ 0 };
+				std::atomic<uint32_t> state{ emptySlot };
+				std::atomic<uint64_t> count{ 0 };
+				DebugMessageSummary info;
+				std::array<char, maxDebugMessageLength> message{};
+
+				// Only touched by EndFrame
+				uint64_t lastCount = 0;
+				bool isLogged = false;
+			};
+
+			static void GLAD_API_PTR OnMessage(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar* message, const void* userParam);
+			void AddMessage(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar* message);
+
+			bool m_isInitialized = false;
+			std::array<Slot, maxDebugMessageKinds> m_slots;
+			std::atomic<uint64_t> m_numDropped{ 0 };
+			DebugOutputSummary m_summary;
+		};
+	}
+}
+
+#endif // BLAZE_OPENGL_GLDEBUGOUTPUT_H
@@ -1,13 +1,175 @@
 #include <pch.h>
 #include "GLDeviceContext.h"
+#if defined(BLAZE_PLATFORM_WIN32) || defined(BLAZE_PLATFORM_WIN64)
 #include <Blaze/Impl/OpenGL/WGL/WGLDeviceContext.h>
+#endif // BLAZE_PLATFORM_WIN32 || BLAZE_PLATFORM_WIN64
+#include <Blaze/Impl/OpenGL/GLBuffer.h>
+
+namespace Blaze
+{
+	namespace OpenGL
+	{
+		namespace Details
+		{
+			// Gets the OpenGL name of a buffer, 0 is returned for null buffers
+			static Result GetGLBufferID(const Ref<Buffer>& buffer, unsigned int& bufferID)
+			{
+				bufferID = 0;
+				if (!buffer)
+					return Result::Success;
+
+				// Buffers from other APIs can't be bound
+				if (buffer->GetDynamicClassID() != GLBuffer::GetStaticClassID())
+					return Result::InvalidParam;
+
+				bufferID = static_cast<GLBuffer*>(buffer.get())->GetBufferID();
+				return Result::Success;
+			}
+		}
+
+		Result GLDeviceContext::BindVertexBuffers_Impl(const VertexFormat& format, const Ref<Buffer>* vertexBuffers, uint32_t numVertexBuffers, const Ref<Buffer>& indexBuffer)
+		{
+			GLDebugSiteScope debugSite("DeviceContext::BindVertexBuffers");
+			Result res;
+
+			if ((numVertexBuffers < format.GetNumBindings()) || (numVertexBuffers > maxVertexBindings))
+				return Result::InvalidParam;
+
+			GLVertexArrayCache::BufferIDs vertexBufferIDs = {};
+			for (uint32_t i = 0; i < numVertexBuffers; i++)
+			{
+				if ((res = Details::GetGLBufferID(vertexBuffers[i], vertexBufferIDs[i])) != Result::Success)
+					return res;
+			}
+
+			// Every binding that has attributes needs a buffer
+			for (const auto& attrib : format.GetAttributes())
+			{
+				if (!vertexBufferIDs[attrib.binding])
+					return Result::InvalidParam;
+			}
+
+			unsigned int indexBufferID;
+			if ((res = Details::GetGLBufferID(indexBuffer, indexBufferID)) != Result::Success)
+				return res;
+
+			res = MakeCurrent();
+			if (res != Result::Success)
+				return res;
+
+			res = m_vertexArrayCache.Bind(m_gl, format, vertexBufferIDs, indexBufferID);
+			if (res != Result::Success)
+				return res;
+
+			// Indexed draws need the type of the bound indices
+			m_indexType = indexBuffer ? static_cast<GLBuffer*>(indexBuffer.get())->GetIndexType() : 0;
+			return Result::Success;
+		}
+
+		Result GLDeviceContext::SetPrimitiveTopology_Impl(PrimitiveTopology topology)
+		{
+			GLDebugSiteScope debugSite("DeviceContext::SetPrimitiveTopology");
+			constexpr std::array<GLenum, 5> translationTable =
+			{
+				GL_POINTS,
+				GL_LINES,
+				GL_LINE_STRIP,
+				GL_TRIANGLES,
+				GL_TRIANGLE_STRIP
+			};
+
+			if ((static_cast<size_t>(topology) < 1) || (static_cast<size_t>(topology) > translationTable.size()))
+				return Result::InvalidParam;
+
+			m_topology = translationTable[static_cast<size_t>(topology) - 1];
+			return Result::Success;
+		}
+
+		Result GLDeviceContext::DrawInstanced_Impl(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex)
+		{
+			GLDebugSiteScope debugSite("DeviceContext::Draw");
+			Result res = MakeCurrent();
+			if (res != Result::Success)
+				return res;
+
+			if (instanceCount == 1)
+				m_gl.DrawArrays(m_topology, static_cast<GLint>(firstVertex), static_cast<GLsizei>(vertexCount));
+			else
+				m_gl.DrawArraysInstanced(m_topology, static_cast<GLint>(firstVertex), static_cast<GLsizei>(vertexCount), static_cast<GLsizei>(instanceCount));
+
+			return Result::Success;
+		}
+
+		Result GLDeviceContext::DrawIndexedInstanced_Impl(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t baseVertex)
+		{
+			// An index buffer has to be bound with BindVertexBuffers
+			if (!m_indexType)
+				return Result::InvalidParam;
+
+			GLDebugSiteScope debugSite("DeviceContext::DrawIndexed");
+			Result res = MakeCurrent();
+			if (res != Result::Success)
+				return res;
+
+			size_t indexSize = (m_indexType == GL_UNSIGNED_BYTE) ? 1 : (m_indexType == GL_UNSIGNED_SHORT) ? 2 : 4;
+			const void* offset = reinterpret_cast<const void*>(static_cast<size_t>(firstIndex) * indexSize);
+
+			if (instanceCount == 1)
+				m_gl.DrawElementsBaseVertex(m_topology, static_cast<GLsizei>(indexCount), m_indexType, offset, baseVertex);
+			else
+				m_gl.DrawElementsInstancedBaseVertex(m_topology, static_cast<GLsizei>(indexCount), m_indexType, offset, static_cast<GLsizei>(instanceCount), baseVertex);
+
+			return Result::Success;
+		}
+
+		Result GLDeviceContext::BeginGPUScope_Impl(const char* name)
+		{
+			if (!m_gpuProfiler.IsInitialized())
+				return Result::Success;
+
+			GLDebugSiteScope debugSite("DeviceContext::BeginGPUScope");
+			Result res = MakeCurrent();
+			if (res != Result::Success)
+				return res;
+
+			return m_gpuProfiler.BeginScope(m_gl, name);
+		}
+
+		Result GLDeviceContext::EndGPUScope_Impl()
+		{
+			if (!m_gpuProfiler.IsInitialized())
+				return Result::Success;
+
+			GLDebugSiteScope debugSite("DeviceContext::EndGPUScope");
+			Result res = MakeCurrent();
+			if (res != Result::Success)
+				return res;
+
+			return m_gpuProfiler.EndScope(m_gl);
+		}
+
+		Result GLDeviceContext::InvalidateVertexArrays(unsigned int bufferID)
+		{
+			Result res = MakeCurrent();
+			if (res != Result::Success)
+				return res;
+
+			m_vertexArrayCache.Invalidate(m_gl, bufferID);
+			return Result::Success;
+		}
+	}
+}
 
 Blaze::OpenGL::GLDeviceContext* AllocateOpenGLDeviceContext(Blaze::WindowAPI windowAPI)
 {
 	switch (windowAPI)
 	{
+#if defined(BLAZE_PLATFORM_WIN32) || defined(BLAZE_PLATFORM_WIN64)
 	case Blaze::WindowAPI::Win32:
 		return new Blaze::OpenGL::WGLDeviceContext();
+#endif // BLAZE_PLATFORM_WIN32 || BLAZE_PLATFORM_WIN64
+	default:
+		break;
 	}
 
     return nullptr;
@@ -7,6 +7,9 @@
 #include <Blaze/Error.h>
 #include <Blaze/Renderer/DeviceContext.h>
 #include <Blaze/Window.h>
+#include <Blaze/Impl/OpenGL/GLVertexArrayCache.h>
+#include <Blaze/Impl/OpenGL/GLGPUProfiler.h>
+#include <Blaze/Impl/OpenGL/GLDebugOutput.h>
 
 namespace Blaze
 {
@@ -24,6 +27,16 @@ namespace Blaze
 
 			inline virtual RenderAPI GetRenderAPI_Impl() override { return RenderAPI::OpenGL; }
 
+			virtual Result BindVertexBuffers_Impl(const VertexFormat& format, const Ref<Buffer>* vertexBuffers, uint32_t numVertexBuffers, const Ref<Buffer>& indexBuffer) override;
+			virtual Result SetPrimitiveTopology_Impl(PrimitiveTopology topology) override;
+			virtual Result DrawInstanced_Impl(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex) override;
+			virtual Result DrawIndexedInstanced_Impl(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t baseVertex) override;
+			inline virtual VertexArrayCacheStats GetVertexArrayCacheStats_Impl() override { return m_vertexArrayCache.GetStats(); }
+			virtual Result BeginGPUScope_Impl(const char* name) override;
+			virtual Result EndGPUScope_Impl() override;
+			inline virtual GPUProfilerStats GetGPUProfilerStats_Impl() override { return m_gpuProfiler.GetStats(); }
+			inline virtual DebugOutputSummary GetDebugOutputSummary_Impl() override { return m_debugOutput.GetSummary(); }
+
 			// Makes the this context current
 			inline Result MakeCurrent() { return MakeCurrent_Impl(); }
 			// Makes this context obselete if it is current
@@ -32,12 +45,21 @@ namespace Blaze
 			inline bool IsCurrent() { return IsCurrent_Impl(); }
 
 			inline GladGLContext GetGL() { return m_gl; }
+
+			// Removes all cached vertex arrays that reference the buffer, called by GLBuffer before the buffer is deleted
+			Result InvalidateVertexArrays(unsigned int bufferID);
 		protected:
 			virtual Result MakeCurrent_Impl() = 0;
 			virtual Result MakeObsolete_Impl() = 0;
 			virtual bool IsCurrent_Impl() = 0;
 
 			GladGLContext m_gl;
+			GLVertexArrayCache m_vertexArrayCache;
+			GLGPUProfiler m_gpuProfiler;
+			GLDebugOutput m_debugOutput;
+			// Draw state, OpenGL enums
+			unsigned int m_topology = GL_TRIANGLES;
+			unsigned int m_indexType = 0;
 		};
 	}
 }
@@ -0,0 +1,173 @@
+#include <pch.h>
+#include "GLGPUProfiler.h"
+#include <Blaze/Profiling/FrameStatistics.h>
+#include <glad/gl.h>
+
+namespace Blaze
+{
+	namespace OpenGL
+	{
+		namespace Details
+		{
+			// Name of the scope around each whole frame
+			constexpr const char* frameScopeName = "GPU Frame";
+		}
+
+		Result GLGPUProfiler::Initialize(GladGLContext& gl)
+		{
+			if (m_isInitialized)
+				return Result::Success;
+
+			// Timer queries are core since OpenGL 3.3
+			if (!gl.QueryCounter || !gl.GetQueryObjectui64v || !gl.GetInteger64v)
+				return Result::Uninitialized;
+
+			for (auto& frame : m_frames)
+			{
+				gl.GenQueries(static_cast<GLsizei>(frame.queries.size()), frame.queries.data());
+				frame.numScopes = 0;
+			}
+
+			m_track = Profiler::CreateTrack("GPU");
+			m_stats = {};
+			m_frameIndex = 0;
+			m_numOpenScopes = 0;
+			m_numDroppedOpenScopes = 0;
+			m_isInitialized = true;
+
+			Calibrate(gl);
+			BeginScope(gl, Details::frameScopeName);
+			return Result::Success;
+		}
+
+		void GLGPUProfiler::Shutdown(GladGLContext& gl)
+		{
+			if (!m_isInitialized)
+				return;
+
+			for (auto& frame : m_frames)
+				gl.DeleteQueries(static_cast<GLsizei>(frame.queries.size()), frame.queries.data());
+			m_isInitialized = false;
+		}
+
+		Result GLGPUProfiler::BeginScope(GladGLContext& gl, const char* name)
+		{
+			if (!m_isInitialized)
+				return Result::Success;
+
+			Frame& frame = m_frames[m_frameIndex];
+			if ((m_numOpenScopes == maxScopeDepth) || (frame.numScopes == maxGPUScopesPerFrame))
+			{
+				// Still counted as open so EndScope pairs up with the right scope
+				m_stats.numDroppedScopes++;
+				if (m_numOpenScopes == maxScopeDepth)
+					m_numDroppedOpenScopes++;
+				else
+					m_openScopes[m_numOpenScopes++] = invalidScope;
+				return Result::Success;
+			}
+
+			const uint32_t scopeIndex = frame.numScopes++;
+			frame.scopes[scopeIndex] = Scope{ name, m_numOpenScopes };
+			gl.QueryCounter(frame.queries[scopeIndex * 2], GL_TIMESTAMP);
+
+			m_openScopes[m_numOpenScopes++] = scopeIndex;
+			return Result::Success;
+		}
+
+		Result GLGPUProfiler::EndScope(GladGLContext& gl)
+		{
+			if (!m_isInitialized)
+				return Result::Success;
+
+			if (m_numDroppedOpenScopes)
+			{
+				m_numDroppedOpenScopes--;
+				return Result::Success;
+			}
+
+			// The frame's own scope is only ended by EndFrame
+			if (m_numOpenScopes <= 1)
+				return Result::InvalidParam;
+
+			const uint32_t scopeIndex = m_openScopes[--m_numOpenScopes];
+			if (scopeIndex != invalidScope)
+				gl.QueryCounter(m_frames[m_frameIndex].queries[scopeIndex * 2 + 1], GL_TIMESTAMP);
+			return Result::Success;
+		}
+
+		void GLGPUProfiler::EndFrame(GladGLContext& gl)
+		{
+			if (!m_isInitialized)
+				return;
+
+			m_numDroppedOpenScopes = 0;
+			while (m_numOpenScopes > 1)
+				EndScope(gl);
+
+			// The frame scope's end is the last query of the frame
+			m_numOpenScopes = 0;
+			gl.QueryCounter(m_frames[m_frameIndex].queries[1], GL_TIMESTAMP);
+		}
+
+		void GLGPUProfiler::BeginFrame(GladGLContext& gl)
+		{
+			if (!m_isInitialized)
+				return;
+
+			if (++m_framesSinceCalibration >= calibrationInterval)
+				Calibrate(gl);
+
+			m_frameIndex = (m_frameIndex + 1) % gpuProfilerLatency;
+			Frame& frame = m_frames[m_frameIndex];
+			if (frame.numScopes)
+				ReadFrame(gl, frame);
+
+			frame.numScopes = 0;
+			BeginScope(gl, Details::frameScopeName);
+		}
+
+		void GLGPUProfiler::Calibrate(GladGLContext& gl)
+		{
+			// Reading GL_TIMESTAMP gets the GPU's time once the commands before it are issued, without waiting for them to finish
+			GLint64 gpuTime = 0;
+			gl.GetInteger64v(GL_TIMESTAMP, &gpuTime);
+			const uint64_t cpuTime = Profiler::GetTimestamp();
+
+			m_clockOffset = static_cast<int64_t>(cpuTime) - static_cast<int64_t>(gpuTime);
+			m_framesSinceCalibration = 0;
+		}
+
+		void GLGPUProfiler::ReadFrame(GladGLContext& gl, Frame& frame)
+		{
+			// Queries finish in order, so once the last one is available all of them are
+			GLint isAvailable = GL_FALSE;
+			gl.GetQueryObjectiv(frame.queries[1], GL_QUERY_RESULT_AVAILABLE, &isAvailable);
+			if (!isAvailable)
+			{
+				m_stats.numDroppedFrames++;
+				return;
+			}
+
+			for (uint32_t i = 0; i < frame.numScopes; i++)
+			{
+				GLuint64 start = 0;
+				GLuint64 end = 0;
+				gl.GetQueryObjectui64v(frame.queries[i * 2], GL_QUERY_RESULT, &start);
+				gl.GetQueryObjectui64v(frame.queries[i * 2 + 1], GL_QUERY_RESULT, &end);
+				if (end < start)
+					end = start;
+
+				Profiler::RecordScope(m_track, frame.scopes[i].name, static_cast<uint64_t>(static_cast<int64_t>(start) + m_clockOffset),
+					static_cast<uint64_t>(static_cast<int64_t>(end) + m_clockOffset), frame.scopes[i].depth);
+
+				if (i == 0)
+				{
+					m_stats.lastFrameTime = static_cast<double>(end - start) * 1e-9;
+					FrameStatistics::Record(FrameTimeSeries::GPUFrame, end - start);
+				}
+			}
+			m_stats.numFrames++;
+		}
+	}
+}
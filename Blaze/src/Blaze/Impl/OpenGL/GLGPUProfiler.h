@@ -0,0 +1,84 @@
+#pragma once
+
+#ifndef BLAZE_OPENGL_GLGPUPROFILER_H
+#define BLAZE_OPENGL_GLGPUPROFILER_H
+
+#include <Blaze/Core.h>
+#include <Blaze/Error.h>
+#include <Blaze/Renderer/DeviceContext.h>
+
+#include <array>
+
+namespace Blaze
+{
+	namespace OpenGL
+	{
+		// Times GPU scopes with GL_TIMESTAMP queries from a ring of gpuProfilerLatency frames
+		// A frame's queries are read when the ring comes back around to it, so reading them never waits on the GPU
+		// The profiler doesn't make any context current, the owning device context must be current when calling into it
+		class GLGPUProfiler
+		{
+		public:
+			// Scopes nested deeper than this are dropped
+			static constexpr uint32_t maxScopeDepth = 32;
+			// Frames between measuring the offset from GPU to CPU time again, the two clocks drift apart slowly
+			static constexpr uint32_t calibrationInterval = 256;
+
+			GLGPUProfiler() = default;
+			GLGPUProfiler(const GLGPUProfiler&) = delete;
+			GLGPUProfiler& operator=(const GLGPUProfiler&) = delete;
+
+			// Creates the queries and starts timing the first frame
+			Result Initialize(GladGLContext& gl);
+			// Deletes the queries, results that weren't read yet are lost
+			void Shutdown(GladGLContext& gl);
+			inline bool IsInitialized() const { return m_isInitialized; }
+
+			Result BeginScope(GladGLContext& gl, const char* name);
+			Result EndScope(GladGLContext& gl);
+
+			// Ends the frame's scope and closes the scopes left open, called right before the swap
+			void EndFrame(GladGLContext& gl);
+			// Reads back the frame the ring comes back to and starts timing the next frame, called right after the swap
+			void BeginFrame(GladGLContext& gl);
+
+			inline GPUProfilerStats GetStats() const { return m_stats; }
+		private:
+			struct Scope
+			{
+				const char* name;
+				uint32_t depth;
+			};
+
+			// Scope i is timed by queries 2 * i and 2 * i + 1
+			struct Frame
+			{
+				std::array<unsigned int, maxGPUScopesPerFrame * 2> queries{};
+				std::array<Scope, maxGPUScopesPerFrame> scopes{};
+				uint32_t numScopes = 0;
+			};
+
+			void Calibrate(GladGLContext& gl);
+			void ReadFrame(GladGLContext& gl, Frame& frame);
+
+			bool m_isInitialized = false;
+			std::array<Frame, gpuProfilerLatency> m_frames;
+			uint32_t m_frameIndex = 0;
+
+			// Scopes that are still open, invalidScope for ones that were dropped
+			static constexpr uint32_t invalidScope = UINT32_MAX;
+			std::array<uint32_t, maxScopeDepth> m_openScopes{};
+			uint32_t m_numOpenScopes = 0;
+			uint32_t m_numDroppedOpenScopes = 0;
+
+			// Added to GPU timestamps to get Profiler::GetTimestamp time
+			int64_t m_clockOffset = 0;
+			uint32_t m_framesSinceCalibration = 0;
+			uint32_t m_track = 0;
+
+			GPUProfilerStats m_stats;
+		};
+	}
+}
+
+#endif // BLAZE_OPENGL_GLGPUPROFILER_H
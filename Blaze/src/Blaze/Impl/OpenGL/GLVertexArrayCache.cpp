@@ -0,0 +1,162 @@
+#include <pch.h>
+#include "GLVertexArrayCache.h"
+#include <glad/gl.h>
+
+namespace Blaze
+{
+	namespace OpenGL
+	{
+		namespace Details
+		{
+			struct GLAttributeFormat
+			{
+				GLint components;
+				GLenum type;
+				// Integer attributes must go through glVertexAttribIPointer
+				bool isInteger;
+				bool isNormalized;
+			};
+
+			static GLAttributeFormat FormatToGLAttributeFormat(Format format)
+			{
+				auto formatInfo = Blaze::Details::GetFormatInfo(format);
+
+				GLAttributeFormat attribFormat;
+				attribFormat.components = (formatInfo.redBits ? 1 : 0) + (formatInfo.greenBits ? 1 : 0) + (formatInfo.blueBits ? 1 : 0) + (formatInfo.alphaBits ? 1 : 0);
+				attribFormat.isInteger = (formatInfo.formatType == FormatType::Int) || (formatInfo.formatType == FormatType::UInt);
+				attribFormat.isNormalized = (formatInfo.formatType == FormatType::UNorm) || (formatInfo.formatType == FormatType::SNorm);
+
+				switch (formatInfo.formatType)
+				{
+				case FormatType::Int:
+				case FormatType::SNorm:
+					attribFormat.type = (formatInfo.redBits == 8) ? GL_BYTE : (formatInfo.redBits == 16) ? GL_SHORT : GL_INT;
+					break;
+				case FormatType::UInt:
+				case FormatType::UNorm:
+					attribFormat.type = (formatInfo.redBits == 8) ? GL_UNSIGNED_BYTE : (formatInfo.redBits == 16) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+					break;
+				case FormatType::Float:
+					// NOTE: doubles get converted to floats, glVertexAttribLPointer needs OpenGL 4.1
+					attribFormat.type = (formatInfo.redBits == 64) ? GL_DOUBLE : GL_FLOAT;
+					break;
+				default:
+					attribFormat.type = 0;
+					break;
+				}
+
+				return attribFormat;
+			}
+		}
+
+		Result GLVertexArrayCache::Bind(GladGLContext& gl, const VertexFormat& format, const BufferIDs& vertexBufferIDs, unsigned int indexBufferID)
+		{
+			Key key{ format.GetHash(), vertexBufferIDs, indexBufferID };
+
+			auto entry = m_vertexArrays.find(key);
+			if ((entry != m_vertexArrays.end()) && (entry->second.format == format))
+			{
+				m_hits++;
+
+				// No need to bind the vertex array if it already is
+				if (entry->second.vertexArrayID != m_boundVertexArrayID)
+				{
+					gl.BindVertexArray(entry->second.vertexArrayID);
+					m_boundVertexArrayID = entry->second.vertexArrayID;
+				}
+				return Result::Success;
+			}
+
+			m_misses++;
+
+			// Hash collision, the old vertex array gets replaced
+			if (entry != m_vertexArrays.end())
+			{
+				gl.DeleteVertexArrays(1, &entry->second.vertexArrayID);
+				m_vertexArrays.erase(entry);
+			}
+
+			unsigned int vertexArrayID;
+			Result res = Build(gl, format, vertexBufferIDs, indexBufferID, vertexArrayID);
+			if (res != Result::Success)
+			{
+				// Build leaves no vertex array bound on failure
+				m_boundVertexArrayID = 0;
+				return res;
+			}
+
+			m_vertexArrays.emplace(key, Entry{ vertexArrayID, format });
+			m_boundVertexArrayID = vertexArrayID;
+			return Result::Success;
+		}
+
+		void GLVertexArrayCache::Invalidate(GladGLContext& gl, unsigned int bufferID)
+		{
+			for (auto it = m_vertexArrays.begin(); it != m_vertexArrays.end();)
+			{
+				const auto& vertexBufferIDs = it->first.vertexBufferIDs;
+				if ((std::find(vertexBufferIDs.begin(), vertexBufferIDs.end(), bufferID) != vertexBufferIDs.end()) || (it->first.indexBufferID == bufferID))
+				{
+					if (it->second.vertexArrayID == m_boundVertexArrayID)
+					{
+						gl.BindVertexArray(0);
+						m_boundVertexArrayID = 0;
+					}
+					gl.DeleteVertexArrays(1, &it->second.vertexArrayID);
+					it = m_vertexArrays.erase(it);
+				}
+				else
+					++it;
+			}
+		}
+
+		void GLVertexArrayCache::Clear(GladGLContext& gl)
+		{
+			gl.BindVertexArray(0);
+			m_boundVertexArrayID = 0;
+
+			for (auto& [key, entry] : m_vertexArrays)
+				gl.DeleteVertexArrays(1, &entry.vertexArrayID);
+			m_vertexArrays.clear();
+		}
+
+		Result GLVertexArrayCache::Build(GladGLContext& gl, const VertexFormat& format, const BufferIDs& vertexBufferIDs, unsigned int indexBufferID, unsigned int& vertexArrayID)
+		{
+			gl.GenVertexArrays(1, &vertexArrayID);
+			if (!vertexArrayID)
+				return Result::AllocationError;
+
+			gl.BindVertexArray(vertexArrayID);
+			// The element array binding is part of the vertex array state
+			gl.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBufferID);
+
+			const auto& attributes = format.GetAttributes();
+			for (GLuint i = 0; i < static_cast<GLuint>(attributes.size()); i++)
+			{
+				auto attribFormat = Details::FormatToGLAttributeFormat(attributes[i].format);
+				if (!attribFormat.type)
+				{
+					gl.BindVertexArray(0);
+					gl.DeleteVertexArrays(1, &vertexArrayID);
+					return Result::InvalidParam;
+				}
+
+				auto binding = format.GetBinding(attributes[i].binding);
+				const auto stride = static_cast<GLsizei>(binding.stride);
+				const void* offset = reinterpret_cast<const void*>(attributes[i].offset);
+
+				// glVertexAttrib*Pointer captures the buffer bound to GL_ARRAY_BUFFER
+				gl.BindBuffer(GL_ARRAY_BUFFER, vertexBufferIDs[attributes[i].binding]);
+
+				gl.EnableVertexAttribArray(i);
+				if (attribFormat.isInteger)
+					gl.VertexAttribIPointer(i, attribFormat.components, attribFormat.type, stride, offset);
+				else
+					gl.VertexAttribPointer(i, attribFormat.components, attribFormat.type, attribFormat.isNormalized ? GL_TRUE : GL_FALSE, stride, offset);
+				gl.VertexAttribDivisor(i, binding.divisor);
+			}
+
+			return Result::Success;
+		}
+	}
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#ifndef BLAZE_OPENGL_GLVERTEXARRAYCACHE_H
+#define BLAZE_OPENGL_GLVERTEXARRAYCACHE_H
+
+#include <Blaze/Core.h>
+#include <Blaze/Error.h>
+#include <Blaze/Renderer/Format.h>
+#include <Blaze/Renderer/DeviceContext.h>
+
+#include <unordered_map>
+#include <array>
+
+namespace Blaze
+{
+	namespace OpenGL
+	{
+		// Maps vertex layout + buffer combinations to prebuilt vertex array objects
+		// The cache doesn't make any context current, the owning device context must be current when calling into it
+		class GLVertexArrayCache
+		{
+		public:
+			// OpenGL buffer names indexed by vertex binding, 0 for unused bindings
+			using BufferIDs = std::array<unsigned int, maxVertexBindings>;
+
+			GLVertexArrayCache() = default;
+			GLVertexArrayCache(const GLVertexArrayCache&) = delete;
+			GLVertexArrayCache& operator=(const GLVertexArrayCache&) = delete;
+
+			// Binds the vertex array for the layout/buffers, building it if it isn't cached yet
+			Result Bind(GladGLContext& gl, const VertexFormat& format, const BufferIDs& vertexBufferIDs, unsigned int indexBufferID);
+			// Deletes every vertex array that references the buffer, must be called before a buffer is deleted
+			void Invalidate(GladGLContext& gl, unsigned int bufferID);
+			// Deletes all vertex arrays
+			void Clear(GladGLContext& gl);
+
+			inline VertexArrayCacheStats GetStats() const { return VertexArrayCacheStats{ m_hits, m_misses, m_vertexArrays.size() }; }
+		private:
+			struct Key
+			{
+				uint64_t formatHash;
+				BufferIDs vertexBufferIDs;
+				unsigned int indexBufferID;
+
+				inline bool operator==(const Key& rhs) const { return (formatHash == rhs.formatHash) && (vertexBufferIDs == rhs.vertexBufferIDs) && (indexBufferID == rhs.indexBufferID); }
+			};
+
+			struct KeyHasher
+			{
+				inline size_t operator()(const Key& key) const
+				{
+					uint64_t hash = key.formatHash ^ key.indexBufferID;
+					for (auto bufferID : key.vertexBufferIDs)
+					{
+						hash ^= bufferID;
+						hash *= 0x9e3779b97f4a7c15;
+					}
+					return static_cast<size_t>(hash ^ (hash >> 32));
+				}
+			};
+
+			struct Entry
+			{
+				unsigned int vertexArrayID;
+				// Kept to resolve hash collisions
+				VertexFormat format;
+			};
+
+			static Result Build(GladGLContext& gl, const VertexFormat& format, const BufferIDs& vertexBufferIDs, unsigned int indexBufferID, unsigned int& vertexArrayID);
+
+			std::unordered_map<Key, Entry, KeyHasher> m_vertexArrays;
+			unsigned int m_boundVertexArrayID = 0;
+
+			uint64_t m_hits = 0;
+			uint64_t m_misses = 0;
+		};
+	}
+}
+
+#endif // BLAZE_OPENGL_GLVERTEXARRAYCACHE_H
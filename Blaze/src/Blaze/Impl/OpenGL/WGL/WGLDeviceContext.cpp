@@ -1,5 +1,10 @@
 #include "pch.h"
 #include "WGLDeviceContext.h"
+#include <Blaze/Log.h>
+#include <Blaze/Profiling/Profiler.h>
+#include <Blaze/Profiling/FlightRecorder.h>
+#include <Blaze/Profiling/FrameStatistics.h>
+#include <Blaze/Memory/AllocationTracker.h>
 
 namespace Blaze
 {
@@ -125,12 +130,13 @@ namespace Blaze
 			if (!SetPixelFormat(m_hdc, pixelFormat, &pfd))
 				return Result::SystemError;
 
-			// Attributes for context creation
-			constexpr std::array<int, 7> contextAttribs =
+			// Attributes for context creation, debug contexts are only asked for when debug output is enabled
+			const std::array<int, 9> contextAttribs =
 			{
 				WGL_CONTEXT_MAJOR_VERSION_ARB, requestedGLVersion[0],
 				WGL_CONTEXT_MINOR_VERSION_ARB, requestedGLVersion[1],
 				WGL_CONTEXT_PROFILE_MASK_ARB, WGL_CONTEXT_CORE_PROFILE_BIT_ARB,
+				WGL_CONTEXT_FLAGS_ARB, info.enableDebugOutput ? WGL_CONTEXT_DEBUG_BIT_ARB : 0,
 				0
 			};
 			
@@ -149,7 +155,15 @@ namespace Blaze
 				return Result::UnknownError;
 
 			// Print out OpenGL information (OpenGL version + GLSL version)
-			std::cout << "[Blaze:Info]: OpenGL info: \n\t OpenGL Version: " << m_gl.GetString(GL_VERSION) << "\n\t GLSL Version : " << m_gl.GetString(GL_SHADING_LANGUAGE_VERSION) << '\n';
+			BLAZE_LOG_INFO("OpenGL info: \n\t OpenGL Version: {}\n\t GLSL Version : {}", reinterpret_cast<const char*>(m_gl.GetString(GL_VERSION)), reinterpret_cast<const char*>(m_gl.GetString(GL_SHADING_LANGUAGE_VERSION)));
+
+			// Without timer queries the context still works, GPU scopes just aren't timed
+			if (info.enableGPUProfiler)
+				m_gpuProfiler.Initialize(m_gl);
+
+			// Same for debug output, a driver without KHR_debug just never reports anything
+			if (info.enableDebugOutput && (m_debugOutput.Initialize(m_gl) != Result::Success))
+				BLAZE_LOG_WARNING("OpenGL debug output isn't supported by the driver");
 
 			return Result::Success;
 		}
@@ -158,6 +172,15 @@ namespace Blaze
 		{
 			Result res;
 
+			// Delete the cached vertex arrays and timer queries while the context is still alive
+			if (m_hglrc && (MakeCurrent_Impl() == Result::Success))
+			{
+				GLDebugSiteScope debugSite("DeviceContext::Destroy");
+				m_vertexArrayCache.Clear(m_gl);
+				m_gpuProfiler.Shutdown(m_gl);
+				m_debugOutput.Shutdown(m_gl);
+			}
+
 			// Make the context obsolete
 			res = MakeObsolete_Impl();
 			if (res != Result::Success)
@@ -176,7 +199,27 @@ namespace Blaze
 
 		Result WGLDeviceContext::SwapBuffers_Impl()
 		{
-			if (!::SwapBuffers(m_hdc))
+			BLAZE_PROFILE_SCOPE("DeviceContext::SwapBuffers");
+			BLAZE_FLIGHT_TIMER(FlightMetric::SwapTime);
+			BLAZE_ALLOCATION_TAG(AllocationTag::Renderer);
+			GLDebugSiteScope debugSite("DeviceContext::SwapBuffers");
+
+			// The swap itself isn't part of either frame's GPU time
+			const bool isProfilingGPU = m_gpuProfiler.IsInitialized() && (MakeCurrent_Impl() == Result::Success);
+			if (isProfilingGPU)
+				m_gpuProfiler.EndFrame(m_gl);
+
+			const uint64_t swapStart = Profiler::GetTimestamp();
+			const bool isSwapped = ::SwapBuffers(m_hdc);
+			FrameStatistics::RecordPresent(swapStart, Profiler::GetTimestamp());
+
+			if (isProfilingGPU)
+				m_gpuProfiler.BeginFrame(m_gl);
+
+			// Messages reported by the swap count towards the frame that just ended
+			m_debugOutput.EndFrame();
+
+			if (!isSwapped)
 				return Result::SystemError;
 
 			return Result::Success;
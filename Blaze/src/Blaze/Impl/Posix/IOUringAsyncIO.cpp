@@ -0,0 +1,341 @@
+#include <pch.h>
+#include "IOUringAsyncIO.h"
+#include <Blaze/Profiling/Profiler.h>
+#include <Blaze/Memory/AllocationTracker.h>
+
+#ifdef BLAZE_PLATFORM_LINUX
+
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+
+namespace Blaze
+{
+	namespace Posix
+	{
+		IOUringAsyncIO::~IOUringAsyncIO()
+		{
+			Destroy_Impl();
+		}
+
+		Result IOUringAsyncIO::Create_Impl(const ObjectCreateInfo& createInfo)
+		{
+			const auto& info = static_cast<const AsyncIOCreateInfo&>(createInfo);
+			if (info.queueDepth == 0)
+				return Result::InvalidParam;
+
+			// One extra entry for the wake up read and one for cancels
+			Result res = CreateRing(info.queueDepth + 2);
+			if (res != Result::Success)
+			{
+				DestroyRing();
+				return res;
+			}
+
+			res = StartWorkers(info.numWorkers, info.queueDepth, false);
+			if (res != Result::Success)
+			{
+				DestroyRing();
+				return res;
+			}
+
+			m_isRingStopping = false;
+			m_ringThread = std::thread(&IOUringAsyncIO::RingMain, this);
+
+			return Result::Success;
+		}
+
+		Result IOUringAsyncIO::Destroy_Impl()
+		{
+			// The ring thread keeps running until the workers have drained every read
+			StopWorkers();
+
+			{
+				std::lock_guard<std::mutex> guard(m_mutex);
+				m_isRingStopping = true;
+				if (m_ringThread.joinable())
+					Wake();
+			}
+
+			if (m_ringThread.joinable())
+				m_ringThread.join();
+			DestroyRing();
+
+			return GenericAsyncIO::Destroy_Impl();
+		}
+
+		Ref<Object> IOUringAsyncIO::CastTo_Impl(ClassID objectID)
+		{
+			constexpr std::array<ClassID, 4> castableIDs = {
+				Object::GetStaticClassID(),
+				AsyncIO::GetStaticClassID(),
+				Generic::GenericAsyncIO::GetStaticClassID(),
+				GetStaticClassID()
+			};
+
+			// Check to make sure the class ID is valid
+			if (std::find(castableIDs.begin(), castableIDs.end(), objectID) == castableIDs.end())
+				return Ref<Object>{ nullptr };
+
+			return shared_from_this();
+		}
+
+		void IOUringAsyncIO::OnReadQueued()
+		{
+			Wake();
+		}
+
+		void IOUringAsyncIO::OnCancelInFlight(Request* request)
+		{
+			m_cancels.push_back(request->id);
+			Wake();
+		}
+
+		Result IOUringAsyncIO::CreateRing(uint32_t entries)
+		{
+			io_uring_params params{};
+			m_ringFile = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+			if (m_ringFile < 0)
+				return Result::SystemError;
+
+			m_submissionRingSize = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+			m_completionRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+			// Newer kernels map both rings with one mmap
+			const bool isSingleMmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+			if (isSingleMmap)
+				m_submissionRingSize = m_completionRingSize = std::max(m_submissionRingSize, m_completionRingSize);
+
+			m_submissionRing = mmap(nullptr, m_submissionRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ringFile, IORING_OFF_SQ_RING);
+			if (m_submissionRing == MAP_FAILED)
+			{
+				m_submissionRing = nullptr;
+				return Result::SystemError;
+			}
+
+			if (isSingleMmap)
+				m_completionRing = m_submissionRing;
+			else
+			{
+				m_completionRing = mmap(nullptr, m_completionRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ringFile, IORING_OFF_CQ_RING);
+				if (m_completionRing == MAP_FAILED)
+				{
+					m_completionRing = nullptr;
+					return Result::SystemError;
+				}
+			}
+
+			m_submissionEntriesSize = params.sq_entries * sizeof(io_uring_sqe);
+			void* submissionEntries = mmap(nullptr, m_submissionEntriesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ringFile, IORING_OFF_SQES);
+			if (submissionEntries == MAP_FAILED)
+				return Result::SystemError;
+			m_submissionEntries = reinterpret_cast<io_uring_sqe*>(submissionEntries);
+
+			uint8_t* submissionRing = reinterpret_cast<uint8_t*>(m_submissionRing);
+			m_submissionHead = reinterpret_cast<uint32_t*>(submissionRing + params.sq_off.head);
+			m_submissionTail = reinterpret_cast<uint32_t*>(submissionRing + params.sq_off.tail);
+			m_submissionMask = *reinterpret_cast<uint32_t*>(submissionRing + params.sq_off.ring_mask);
+			m_submissionEntryCount = params.sq_entries;
+			m_submissionArray = reinterpret_cast<uint32_t*>(submissionRing + params.sq_off.array);
+
+			uint8_t* completionRing = reinterpret_cast<uint8_t*>(m_completionRing);
+			m_completionHead = reinterpret_cast<uint32_t*>(completionRing + params.cq_off.head);
+			m_completionTail = reinterpret_cast<uint32_t*>(completionRing + params.cq_off.tail);
+			m_completionMask = *reinterpret_cast<uint32_t*>(completionRing + params.cq_off.ring_mask);
+			m_completionEntries = reinterpret_cast<io_uring_cqe*>(completionRing + params.cq_off.cqes);
+
+			m_wakeFile = eventfd(0, EFD_CLOEXEC);
+			if (m_wakeFile < 0)
+				return Result::SystemError;
+
+			m_numUnsubmitted = 0;
+			return Result::Success;
+		}
+
+		void IOUringAsyncIO::DestroyRing()
+		{
+			if (m_submissionEntries)
+				munmap(m_submissionEntries, m_submissionEntriesSize);
+			if (m_completionRing && (m_completionRing != m_submissionRing))
+				munmap(m_completionRing, m_completionRingSize);
+			if (m_submissionRing)
+				munmap(m_submissionRing, m_submissionRingSize);
+			if (m_ringFile >= 0)
+				close(m_ringFile);
+			if (m_wakeFile >= 0)
+				close(m_wakeFile);
+
+			m_submissionEntries = nullptr;
+			m_completionRing = nullptr;
+			m_submissionRing = nullptr;
+			m_ringFile = -1;
+			m_wakeFile = -1;
+		}
+
+		void IOUringAsyncIO::RingMain()
+		{
+			Profiler::SetThreadName("IO Ring");
+			AllocationTracker::SetThreadTag(AllocationTag::IO);
+
+			bool isWakeArmed = false;
+
+			std::unique_lock<std::mutex> lock(m_mutex);
+			while (true)
+			{
+				// A read of the eventfd is always in the ring, so new reads and cancels interrupt the wait for completions
+				if (!isWakeArmed)
+				{
+					if (io_uring_sqe* entry = GetSubmissionEntry())
+					{
+						entry->opcode = IORING_OP_READ;
+						entry->fd = m_wakeFile;
+						entry->addr = reinterpret_cast<uint64_t>(&m_wakeValue);
+						entry->len = sizeof(m_wakeValue);
+						entry->user_data = wakeUserData;
+						isWakeArmed = true;
+					}
+				}
+
+				while (!m_cancels.empty())
+				{
+					io_uring_sqe* entry = GetSubmissionEntry();
+					if (!entry)
+						break;
+
+					entry->opcode = IORING_OP_ASYNC_CANCEL;
+					entry->fd = -1;
+					entry->addr = m_cancels.back();
+					entry->user_data = cancelUserData;
+					m_cancels.pop_back();
+				}
+
+				// Reads that came back short are still in flight, they continue before new ones start
+				while (!m_resubmits.empty())
+				{
+					// The cancel of a read waiting here found nothing in the kernel, so it's completed here instead
+					Request* request = m_resubmits.back();
+					if (request->isCancelled)
+					{
+						m_resubmits.pop_back();
+						m_numInFlight--;
+						PushCompleted(request, Result::Cancelled, 0);
+						continue;
+					}
+
+					io_uring_sqe* entry = GetSubmissionEntry();
+					if (!entry)
+						break;
+
+					PrepareRead(entry, request);
+					m_resubmits.pop_back();
+				}
+
+				// Pending reads come out highest priority first, prefetches only fill what's left of the queue depth
+				while ((m_numInFlight < m_queueDepth) && HasPending())
+				{
+					io_uring_sqe* entry = GetSubmissionEntry();
+					if (!entry)
+						break;
+
+					PrepareRead(entry, PopPending());
+				}
+
+				if (m_isRingStopping && (m_numInFlight == 0))
+					break;
+
+				// Submit everything and wait for at least one completion in a single system call
+				const uint32_t numToSubmit = m_numUnsubmitted;
+				lock.unlock();
+				int numSubmitted = static_cast<int>(syscall(__NR_io_uring_enter, m_ringFile, numToSubmit, 1, IORING_ENTER_GETEVENTS, nullptr, 0));
+				lock.lock();
+
+				m_stats.numSystemCalls++;
+				if (numSubmitted > 0)
+					m_numUnsubmitted -= std::min(static_cast<uint32_t>(numSubmitted), m_numUnsubmitted);
+
+				uint32_t head = *m_completionHead;
+				const uint32_t tail = __atomic_load_n(m_completionTail, __ATOMIC_ACQUIRE);
+				for (; head != tail; head++)
+				{
+					const io_uring_cqe& completion = m_completionEntries[head & m_completionMask];
+					if (completion.user_data == wakeUserData)
+					{
+						isWakeArmed = false;
+						continue;
+					}
+					if (completion.user_data == cancelUserData)
+						continue;
+
+					Request* request = FindRequest(completion.user_data);
+					if (!request)
+						continue;
+
+					// Interrupted and short reads continue where they stopped, like ReadNativeFile, only a read of 0 bytes is the end of the file
+					const bool isInterrupted = (completion.res == -EINTR) || (completion.res == -EAGAIN);
+					if (completion.res > 0)
+						request->bytesRead += static_cast<size_t>(completion.res);
+					if (!request->isCancelled && (isInterrupted || ((completion.res > 0) && (request->bytesRead < request->size))))
+					{
+						m_resubmits.push_back(request);
+						continue;
+					}
+
+					m_numInFlight--;
+					if ((completion.res < 0) && !isInterrupted)
+						PushCompleted(request, (completion.res == -ECANCELED) ? Result::Cancelled : Result::SystemError, 0);
+					else
+						PushCompleted(request, Result::Success, request->bytesRead);
+				}
+				__atomic_store_n(m_completionHead, head, __ATOMIC_RELEASE);
+			}
+		}
+
+		void IOUringAsyncIO::Wake()
+		{
+			uint64_t value = 1;
+			while ((write(m_wakeFile, &value, sizeof(value)) < 0) && (errno == EINTR));
+		}
+
+		void IOUringAsyncIO::PrepareRead(io_uring_sqe* entry, Request* request)
+		{
+			// A single read returns at most about 2 GiB, so large requests are read in chunks
+			const size_t chunkSize = std::min(request->size - request->bytesRead, maxReadChunkSize);
+
+			entry->opcode = IORING_OP_READ;
+			entry->fd = static_cast<int>(request->file);
+			entry->off = request->offset + request->bytesRead;
+			entry->addr = reinterpret_cast<uint64_t>(static_cast<uint8_t*>(request->buffer) + request->bytesRead);
+			entry->len = static_cast<uint32_t>(chunkSize);
+			entry->user_data = request->id;
+		}
+
+		io_uring_sqe* IOUringAsyncIO::GetSubmissionEntry()
+		{
+			const uint32_t head = __atomic_load_n(m_submissionHead, __ATOMIC_ACQUIRE);
+			const uint32_t tail = *m_submissionTail;
+			if (tail - head >= m_submissionEntryCount)
+				return nullptr;
+
+			const uint32_t index = tail & m_submissionMask;
+			io_uring_sqe* entry = &m_submissionEntries[index];
+			std::memset(entry, 0, sizeof(io_uring_sqe));
+
+			// The entry is filled in before the next io_uring_enter, which is when the kernel reads it
+			m_submissionArray[index] = index;
+			__atomic_store_n(m_submissionTail, tail + 1, __ATOMIC_RELEASE);
+			m_numUnsubmitted++;
+
+			return entry;
+		}
+	}
+}
+
+Blaze::Posix::IOUringAsyncIO* AllocateIOUringAsyncIO()
+{
+	return new Blaze::Posix::IOUringAsyncIO();
+}
+
+#endif // BLAZE_PLATFORM_LINUX
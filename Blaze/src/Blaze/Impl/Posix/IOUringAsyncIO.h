@@ -0,0 +1,100 @@
+#pragma once
+
+#ifndef BLAZE_POSIX_IOURINGASYNCIO_H
+#define BLAZE_POSIX_IOURINGASYNCIO_H
+
+#include <Blaze/Core.h>
+#include <Blaze/Error.h>
+#include <Blaze/Impl/Generic/GenericAsyncIO.h>
+
+#ifdef BLAZE_PLATFORM_LINUX
+
+#include <linux/io_uring.h>
+
+namespace Blaze
+{
+	namespace Posix
+	{
+		// Submits reads to an io_uring from one thread, completions are handed to the generic workers for the callbacks
+		// Talks to the kernel directly, so liburing isn't needed
+		class IOUringAsyncIO
+			:public Generic::GenericAsyncIO
+		{
+		public:
+			inline IOUringAsyncIO() { classID = GetStaticClassID(); }
+			~IOUringAsyncIO();
+
+			constexpr static ClassID GetStaticClassID() { return Details::MakeClassID(Details::InterfaceID::AsyncIO, Details::ImplementationID::IOUring); }
+
+			virtual Result Create_Impl(const ObjectCreateInfo& createInfo) override;
+			virtual Result Destroy_Impl() override;
+
+			virtual Ref<Object> CastTo_Impl(ClassID objectID) override;
+
+			inline virtual AsyncIOBackend GetBackend_Impl() override { return AsyncIOBackend::IOUring; }
+		private:
+			// user_data of the eventfd read that wakes the ring thread, request IDs start at 1
+			static constexpr uint64_t wakeUserData = 0;
+			// user_data of cancel operations, their completions are ignored
+			static constexpr uint64_t cancelUserData = ~0ull;
+			// Largest read submitted at once, the same chunks ReadNativeFile uses on Windows
+			static constexpr size_t maxReadChunkSize = 0x40000000;
+
+			virtual void OnReadQueued() override;
+			virtual void OnCancelInFlight(Request* request) override;
+
+			Result CreateRing(uint32_t entries);
+			void DestroyRing();
+			void RingMain();
+			void Wake();
+
+			// Fills in a read of the part of the request that hasn't been read yet, Request::bytesRead counts what has
+			void PrepareRead(io_uring_sqe* entry, Request* request);
+			// Gets the next free submission entry, or nullptr if the submission queue is full
+			io_uring_sqe* GetSubmissionEntry();
+
+			int m_ringFile = -1;
+			int m_wakeFile = -1;
+			uint64_t m_wakeValue = 0;
+
+			void* m_submissionRing = nullptr;
+			size_t m_submissionRingSize = 0;
+			void* m_completionRing = nullptr;
+			size_t m_completionRingSize = 0;
+			io_uring_sqe* m_submissionEntries = nullptr;
+			size_t m_submissionEntriesSize = 0;
+
+			uint32_t* m_submissionHead = nullptr;
+			uint32_t* m_submissionTail = nullptr;
+			uint32_t m_submissionMask = 0;
+			uint32_t m_submissionEntryCount = 0;
+			uint32_t* m_submissionArray = nullptr;
+			uint32_t* m_completionHead = nullptr;
+			uint32_t* m_completionTail = nullptr;
+			uint32_t m_completionMask = 0;
+			io_uring_cqe* m_completionEntries = nullptr;
+
+			// Entries written since the last io_uring_enter
+			uint32_t m_numUnsubmitted = 0;
+
+			// In-flight reads to cancel, guarded by m_mutex
+			std::vector<IORequestID> m_cancels;
+			// In-flight reads that came back short or interrupted and have to be submitted again, guarded by m_mutex
+			std::vector<Request*> m_resubmits;
+			std::thread m_ringThread;
+			bool m_isRingStopping = false;
+		};
+	}
+}
+
+extern "C"
+{
+	// Allocates an io_uring async io, does not call create
+	// This function is meant for dynamic loading, if implementations ever get split off into separate DLLs
+	// This function is meant for internal use
+	BLAZE_API Blaze::Posix::IOUringAsyncIO* AllocateIOUringAsyncIO();
+}
+
+#endif // BLAZE_PLATFORM_LINUX
+
+#endif // BLAZE_POSIX_IOURINGASYNCIO_H
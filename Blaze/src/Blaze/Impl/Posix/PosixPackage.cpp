@@ -0,0 +1,141 @@
+#include <pch.h>
+#include "PosixPackage.h"
+
+#ifdef BLAZE_PLATFORM_LINUX
+
+#include <Blaze/IO/PackageFormat.h>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace Blaze
+{
+	namespace Posix
+	{
+		PosixPackage::~PosixPackage()
+		{
+			Destroy_Impl();
+		}
+
+		Result PosixPackage::Create_Impl(const ObjectCreateInfo& createInfo)
+		{
+			const auto& info = static_cast<const PackageCreateInfo&>(createInfo);
+
+			m_file = open(info.path.c_str(), O_RDONLY | O_CLOEXEC);
+			if (m_file < 0)
+				return Result::SystemError;
+
+			struct stat fileStat;
+			if ((fstat(m_file, &fileStat) != 0) || (fileStat.st_size == 0))
+			{
+				Destroy_Impl();
+				return Result::SystemError;
+			}
+			m_size = static_cast<size_t>(fileStat.st_size);
+
+			void* view = mmap(nullptr, m_size, PROT_READ, MAP_SHARED, m_file, 0);
+			if (view == MAP_FAILED)
+			{
+				Destroy_Impl();
+				return Result::SystemError;
+			}
+			m_view = reinterpret_cast<const uint8_t*>(view);
+
+			Result res = Details::ValidatePackage(m_view, m_size);
+			if (res != Result::Success)
+			{
+				Destroy_Impl();
+				return res;
+			}
+
+			return Result::Success;
+		}
+
+		Result PosixPackage::Destroy_Impl()
+		{
+			if (m_view)
+				munmap(const_cast<uint8_t*>(m_view), m_size);
+			if (m_file >= 0)
+				close(m_file);
+
+			m_view = nullptr;
+			m_file = -1;
+			m_size = 0;
+
+			return Result::Success;
+		}
+
+		Ref<Object> PosixPackage::CastTo_Impl(ClassID objectID)
+		{
+			constexpr std::array<ClassID, 3> castableIDs = {
+				Object::GetStaticClassID(),
+				Package::GetStaticClassID(),
+				GetStaticClassID()
+			};
+
+			// Check to make sure the class ID is valid
+			if (std::find(castableIDs.begin(), castableIDs.end(), objectID) == castableIDs.end())
+				return Ref<Object>{ nullptr };
+
+			return shared_from_this();
+		}
+
+		Result PosixPackage::Find_Impl(uint64_t nameHash, PackageBlob& blob)
+		{
+			if (!m_view)
+				return Result::Uninitialized;
+
+			return Details::FindPackageBlob(m_view, m_size, nameHash, blob);
+		}
+
+		Result PosixPackage::Prefetch_Impl(const PackageBlob* blobs, size_t numBlobs)
+		{
+			return Advise(blobs, numBlobs, MADV_WILLNEED);
+		}
+
+		Result PosixPackage::Evict_Impl(const PackageBlob* blobs, size_t numBlobs)
+		{
+			// The mapping is read-only and file backed, dropped pages get read back from the file if they're touched again
+			return Advise(blobs, numBlobs, MADV_DONTNEED);
+		}
+
+		uint32_t PosixPackage::GetNumBlobs_Impl()
+		{
+			if (!m_view)
+				return 0;
+
+			Details::PackageHeader header;
+			std::memcpy(&header, m_view, sizeof(header));
+			return header.numBlobs;
+		}
+
+		Result PosixPackage::Advise(const PackageBlob* blobs, size_t numBlobs, int advice)
+		{
+			if (!m_view)
+				return Result::Uninitialized;
+			if (!blobs && numBlobs)
+				return Result::InvalidParam;
+
+			for (size_t i = 0; i < numBlobs; i++)
+			{
+				const uint8_t* begin;
+				size_t size;
+				Details::GetPackageBlobPages(m_view, blobs[i], begin, size);
+
+				if (size && (madvise(const_cast<uint8_t*>(begin), size, advice) != 0))
+					return Result::SystemError;
+			}
+
+			return Result::Success;
+		}
+	}
+}
+
+Blaze::Posix::PosixPackage* AllocatePosixPackage()
+{
+	return new Blaze::Posix::PosixPackage();
+}
+
+#endif // BLAZE_PLATFORM_LINUX
@@ -0,0 +1,55 @@
+#pragma once
+
+#ifndef BLAZE_POSIX_POSIXPACKAGE_H
+#define BLAZE_POSIX_POSIXPACKAGE_H
+
+#include <Blaze/Core.h>
+#include <Blaze/Error.h>
+#include <Blaze/IO/Package.h>
+
+#ifdef BLAZE_PLATFORM_LINUX
+
+namespace Blaze
+{
+	namespace Posix
+	{
+		// Maps the package with a read-only mmap
+		class PosixPackage
+			:public Package
+		{
+		public:
+			inline PosixPackage() { classID = GetStaticClassID(); }
+			~PosixPackage();
+
+			virtual Result Create_Impl(const ObjectCreateInfo& createInfo) override;
+			virtual Result Destroy_Impl() override;
+
+			constexpr static ClassID GetStaticClassID() { return Details::MakeClassID(Details::InterfaceID::Package, Details::ImplementationID::Posix); }
+
+			virtual Ref<Object> CastTo_Impl(ClassID objectID) override;
+
+			virtual Result Find_Impl(uint64_t nameHash, PackageBlob& blob) override;
+			virtual Result Prefetch_Impl(const PackageBlob* blobs, size_t numBlobs) override;
+			virtual Result Evict_Impl(const PackageBlob* blobs, size_t numBlobs) override;
+			virtual uint32_t GetNumBlobs_Impl() override;
+		private:
+			Result Advise(const PackageBlob* blobs, size_t numBlobs, int advice);
+
+			int m_file = -1;
+			const uint8_t* m_view = nullptr;
+			size_t m_size = 0;
+		};
+	}
+}
+
+extern "C"
+{
+	// Allocates a posix package, does not call create
+	// This function is meant for dynamic loading, if implementations ever get split off into separate DLLs
+	// This function is meant for internal use
+	BLAZE_API Blaze::Posix::PosixPackage* AllocatePosixPackage();
+}
+
+#endif // BLAZE_PLATFORM_LINUX
+
+#endif // BLAZE_POSIX_POSIXPACKAGE_H
@@ -0,0 +1,185 @@
+#include <pch.h>
+#include "Win32Package.h"
+#include <Blaze/IO/PackageFormat.h>
+
+namespace Blaze
+{
+	namespace Win32
+	{
+		namespace Details
+		{
+			// Matches WIN32_MEMORY_RANGE_ENTRY, which is only declared when targeting Windows 8
+			struct MemoryRangeEntry
+			{
+				void* virtualAddress;
+				SIZE_T numberOfBytes;
+			};
+
+			typedef BOOL(WINAPI* PrefetchVirtualMemoryProc)(HANDLE process, ULONG_PTR numEntries, MemoryRangeEntry* entries, ULONG flags);
+
+			// PrefetchVirtualMemory is looked up at runtime so the package still works on Windows 7, where prefetching is skipped
+			static PrefetchVirtualMemoryProc GetPrefetchVirtualMemory()
+			{
+				static PrefetchVirtualMemoryProc prefetchVirtualMemory = reinterpret_cast<PrefetchVirtualMemoryProc>(
+					reinterpret_cast<void*>(GetProcAddress(GetModuleHandleW(L"kernel32.dll"), "PrefetchVirtualMemory")));
+				return prefetchVirtualMemory;
+			}
+		}
+
+		Win32Package::~Win32Package()
+		{
+			Destroy_Impl();
+		}
+
+		Result Win32Package::Create_Impl(const ObjectCreateInfo& createInfo)
+		{
+			const auto& info = static_cast<const PackageCreateInfo&>(createInfo);
+
+			std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>> converter;
+			std::wstring pathWide = converter.from_bytes(info.path);
+
+			m_file = CreateFileW(pathWide.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+			if (m_file == INVALID_HANDLE_VALUE)
+				return Result::SystemError;
+
+			LARGE_INTEGER fileSize;
+			if (!GetFileSizeEx(m_file, &fileSize) || (fileSize.QuadPart == 0))
+			{
+				Destroy_Impl();
+				return Result::SystemError;
+			}
+			m_size = static_cast<size_t>(fileSize.QuadPart);
+
+			m_mapping = CreateFileMappingW(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (!m_mapping)
+			{
+				Destroy_Impl();
+				return Result::SystemError;
+			}
+
+			m_view = reinterpret_cast<const uint8_t*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+			if (!m_view)
+			{
+				Destroy_Impl();
+				return Result::SystemError;
+			}
+
+			Result res = Blaze::Details::ValidatePackage(m_view, m_size);
+			if (res != Result::Success)
+			{
+				Destroy_Impl();
+				return res;
+			}
+
+			return Result::Success;
+		}
+
+		Result Win32Package::Destroy_Impl()
+		{
+			if (m_view)
+				UnmapViewOfFile(m_view);
+			if (m_mapping)
+				CloseHandle(m_mapping);
+			if (m_file != INVALID_HANDLE_VALUE)
+				CloseHandle(m_file);
+
+			m_view = nullptr;
+			m_mapping = nullptr;
+			m_file = INVALID_HANDLE_VALUE;
+			m_size = 0;
+
+			return Result::Success;
+		}
+
+		Ref<Object> Win32Package::CastTo_Impl(ClassID objectID)
+		{
+			constexpr std::array<ClassID, 3> castableIDs = {
+				Object::GetStaticClassID(),
+				Package::GetStaticClassID(),
+				GetStaticClassID()
+			};
+
+			// Check to make sure the class ID is valid
+			if (std::find(castableIDs.begin(), castableIDs.end(), objectID) == castableIDs.end())
+				return Ref<Object>{ nullptr };
+
+			return shared_from_this();
+		}
+
+		Result Win32Package::Find_Impl(uint64_t nameHash, PackageBlob& blob)
+		{
+			if (!m_view)
+				return Result::Uninitialized;
+
+			return Blaze::Details::FindPackageBlob(m_view, m_size, nameHash, blob);
+		}
+
+		Result Win32Package::Prefetch_Impl(const PackageBlob* blobs, size_t numBlobs)
+		{
+			if (!m_view)
+				return Result::Uninitialized;
+			if (!blobs && numBlobs)
+				return Result::InvalidParam;
+
+			auto prefetchVirtualMemory = Details::GetPrefetchVirtualMemory();
+			if (!prefetchVirtualMemory)
+				return Result::Success;
+
+			std::vector<Details::MemoryRangeEntry> ranges;
+			ranges.reserve(numBlobs);
+			for (size_t i = 0; i < numBlobs; i++)
+			{
+				const uint8_t* begin;
+				size_t size;
+				Blaze::Details::GetPackageBlobPages(m_view, blobs[i], begin, size);
+				if (size)
+					ranges.push_back(Details::MemoryRangeEntry{ const_cast<uint8_t*>(begin), size });
+			}
+
+			if (ranges.empty())
+				return Result::Success;
+
+			// One call for all the blobs, the kernel issues the reads together
+			if (!prefetchVirtualMemory(GetCurrentProcess(), ranges.size(), ranges.data(), 0))
+				return Result::SystemError;
+
+			return Result::Success;
+		}
+
+		Result Win32Package::Evict_Impl(const PackageBlob* blobs, size_t numBlobs)
+		{
+			if (!m_view)
+				return Result::Uninitialized;
+			if (!blobs && numBlobs)
+				return Result::InvalidParam;
+
+			for (size_t i = 0; i < numBlobs; i++)
+			{
+				const uint8_t* begin;
+				size_t size;
+				Blaze::Details::GetPackageBlobPages(m_view, blobs[i], begin, size);
+
+				// Unlocking pages that aren't locked removes them from the working set, it reports ERROR_NOT_LOCKED which is expected
+				if (size)
+					VirtualUnlock(const_cast<uint8_t*>(begin), size);
+			}
+
+			return Result::Success;
+		}
+
+		uint32_t Win32Package::GetNumBlobs_Impl()
+		{
+			if (!m_view)
+				return 0;
+
+			Blaze::Details::PackageHeader header;
+			std::memcpy(&header, m_view, sizeof(header));
+			return header.numBlobs;
+		}
+	}
+}
+
+Blaze::Win32::Win32Package* AllocateWin32Package()
+{
+	return new Blaze::Win32::Win32Package();
+}
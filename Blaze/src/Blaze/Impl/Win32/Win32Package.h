@@ -0,0 +1,54 @@
+#pragma once
+
+#ifndef BLAZE_WIN32_WIN32PACKAGE_H
+#define BLAZE_WIN32_WIN32PACKAGE_H
+
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+
+#include <Blaze/Core.h>
+#include <Blaze/Error.h>
+#include <Blaze/IO/Package.h>
+
+namespace Blaze
+{
+	namespace Win32
+	{
+		// Maps the package with a read-only file mapping
+		class Win32Package
+			:public Package
+		{
+		public:
+			inline Win32Package() { classID = GetStaticClassID(); }
+			~Win32Package();
+
+			virtual Result Create_Impl(const ObjectCreateInfo& createInfo) override;
+			virtual Result Destroy_Impl() override;
+
+			constexpr static ClassID GetStaticClassID() { return Details::MakeClassID(Details::InterfaceID::Package, Details::ImplementationID::Win32); }
+
+			virtual Ref<Object> CastTo_Impl(ClassID objectID) override;
+
+			virtual Result Find_Impl(uint64_t nameHash, PackageBlob& blob) override;
+			virtual Result Prefetch_Impl(const PackageBlob* blobs, size_t numBlobs) override;
+			virtual Result Evict_Impl(const PackageBlob* blobs, size_t numBlobs) override;
+			virtual uint32_t GetNumBlobs_Impl() override;
+		private:
+			HANDLE m_file = INVALID_HANDLE_VALUE;
+			HANDLE m_mapping = nullptr;
+			const uint8_t* m_view = nullptr;
+			size_t m_size = 0;
+		};
+	}
+}
+
+extern "C"
+{
+	// Allocates a win32 package, does not call create
+	// This function is meant for dynamic loading, if implementations ever get split off into separate DLLs
+	// This function is meant for internal use
+	BLAZE_API Blaze::Win32::Win32Package* AllocateWin32Package();
+}
+
+#endif // BLAZE_WIN32_WIN32PACKAGE_H
@@ -1,5 +1,8 @@
 #include <pch.h>
 #include "Win32Window.h"
+#include <Blaze/Profiling/Profiler.h>
+#include <Blaze/Profiling/FlightRecorder.h>
+#include <Blaze/Memory/AllocationTracker.h>
 
 namespace Blaze
 {
@@ -7,16 +10,16 @@ namespace Blaze
 	{
 		ATOM Win32Window::s_windowClassAtom = 0;
 		HINSTANCE Win32Window::s_hInstance = nullptr;
-		std::mutex Win32Window::s_windowClassInfoMutex{};
+		Mutex Win32Window::s_windowClassInfoMutex{ "Win32 window class" };
 
 		Result Win32Window::Create_Impl(const ObjectCreateInfo& createInfo)
 		{
 			auto info = static_cast<const WindowCreateInfo&>(createInfo);
-			for (auto eventHandlers : m_eventHandlers) eventHandlers.clear();
+			for (auto& eventHandlers : m_eventHandlers) eventHandlers.clear();
 			m_eventHandlers[0].insert(m_eventHandlers[0].begin(), info.eventHandlers.begin(), info.eventHandlers.end());
 
 			{
-				std::lock_guard<std::mutex> guard(s_windowClassInfoMutex);
+				std::lock_guard<Mutex> guard(s_windowClassInfoMutex);
 
 				if (!s_hInstance)
 					s_hInstance = GetModuleHandleW(nullptr);
@@ -77,19 +80,30 @@ namespace Blaze
 		{
 			if (!DestroyWindow(m_hWnd))
 				Result::SystemError;
-			for (auto eventHandlers : m_eventHandlers)
+			for (auto& eventHandlers : m_eventHandlers)
 				eventHandlers.clear();
+			m_postedEvents.clear();
 			return Result::Success;
 		}
 
 		Result Win32Window::Update_Impl()
 		{
+			BLAZE_PROFILE_SCOPE("Window::Update");
+			BLAZE_FLIGHT_TIMER(FlightMetric::WindowUpdateTime);
+			BLAZE_ALLOCATION_TAG(AllocationTag::Window);
+
 			MSG msg;
 			while (PeekMessageW(&msg, m_hWnd, 0, 0, PM_REMOVE))
 			{
 				TranslateMessage(&msg);
 				DispatchMessageW(&msg);
 			}
+
+			// Events posted by handlers while dispatching wait for the next update
+			m_dispatchedEvents.swap(m_postedEvents);
+			for (const WindowEvent& event : m_dispatchedEvents)
+				DispatchEvent(event);
+			m_dispatchedEvents.clear();
 			return Result::Success;
 		}
 
@@ -125,7 +139,7 @@ namespace Blaze
 
 		Result Win32Window::RemoveEventHandler_Impl(WindowEvent::EventCode eventCode, WindowEventHandler eventHandler)
 		{
-			auto eventHandlers = m_eventHandlers[static_cast<size_t>(eventCode)];
+			auto& eventHandlers = m_eventHandlers[static_cast<size_t>(eventCode)];
 
 			// Find the handler
 			auto handlerLocation = std::find(eventHandlers.begin(), eventHandlers.end(), eventHandler);
@@ -137,8 +151,32 @@ namespace Blaze
 			return Result::Success;
 		}
 
+		Result Win32Window::PostEvent_Impl(const WindowEvent& event)
+		{
+			if ((event.eventCode <= WindowEvent::Invalid) || (event.eventCode > WindowEvent::NumEvents))
+				return Result::InvalidParam;
+
+			m_postedEvents.push_back(event);
+			return Result::Success;
+		}
+
+		void Win32Window::DispatchEvent(const WindowEvent& event)
+		{
+			BLAZE_PROFILE_SCOPE("Window::DispatchEvent");
+			FlightRecorder::Add(FlightMetric::NumWindowEvents, 1);
+
+			// General event handlers
+			for (auto& eventHandler : m_eventHandlers[0])
+				eventHandler.eventHandler(event, eventHandler.data);
+			// Specific event handlers
+			for (auto& eventHandler : m_eventHandlers[static_cast<size_t>(event.eventCode)])
+				eventHandler.eventHandler(event, eventHandler.data);
+		}
+
 		Result Win32Window::SetTitle_Impl(std::string_view newTitle)
 		{
+			BLAZE_ALLOCATION_TAG(AllocationTag::Window);
+
 			std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>> converter;
 			std::wstring titleWide = converter.from_bytes(&(*newTitle.begin()), &(*newTitle.end()));
 			SetWindowTextW(m_hWnd, titleWide.data());
@@ -147,6 +185,8 @@ namespace Blaze
 
 		std::string Win32Window::GetTitle_Impl()
 		{
+			BLAZE_ALLOCATION_TAG(AllocationTag::Window);
+
 			// Get the length of he title
 			SetLastError(0);
 			size_t titleLength = GetWindowTextLengthW(m_hWnd);
@@ -263,12 +303,7 @@ namespace Blaze
 
 				if (event.eventCode != WindowEvent::Invalid)
 				{
-					// General event handlers
-					for (auto& eventHandler : window->m_eventHandlers[0])
-						eventHandler.eventHandler(event, eventHandler.data);
-					// Specific event handlers
-					for (auto& eventHandler : window->m_eventHandlers[static_cast<size_t>(event.eventCode)])
-						eventHandler.eventHandler(event, eventHandler.data);
+					window->DispatchEvent(event);
 
 					switch (msg)
 					{
@@ -11,6 +11,7 @@
 #include <Blaze/Error.h>
 #include <Blaze/Window.h>
 #include <Blaze/InputBase.h>
+#include <Blaze/Mutex.h>
 
 #include <vector>
 #include <array>
@@ -40,6 +41,7 @@ namespace Blaze
 
 			virtual Result PushEventHandler_Impl(WindowEvent::EventCode eventCode, WindowEventHandler eventHandler) override;
 			virtual Result RemoveEventHandler_Impl(WindowEvent::EventCode eventCode, WindowEventHandler eventHandler) override;
+			virtual Result PostEvent_Impl(const WindowEvent& event) override;
 
 			virtual Result SetTitle_Impl(std::string_view newTitle) override;
 			virtual std::string GetTitle_Impl() override;
@@ -61,13 +63,17 @@ namespace Blaze
 			static LRESULT __stdcall WndProc(HWND hWnd, UINT msg, WPARAM wparam, LPARAM lparam);
 			static WindowEvent TranslateWindowEvent(HWND hWnd, UINT msg, WPARAM wparam, LPARAM lparam);
 			static KeyCode TranslateKeycode(WPARAM wparam, LPARAM lparam);
+			void DispatchEvent(const WindowEvent& event);
 
 			static ATOM s_windowClassAtom;
 			static HINSTANCE s_hInstance;
-			static std::mutex s_windowClassInfoMutex;
+			static Mutex s_windowClassInfoMutex;
 			
 			// One vector for each event, extra one for all events
 			std::array<std::vector<WindowEventHandler>, WindowEvent::NumEvents + 1> m_eventHandlers;
+			// Events from PostEvent, dispatched by the next Update
+			std::vector<WindowEvent> m_postedEvents;
+			std::vector<WindowEvent> m_dispatchedEvents;
 
 			HWND m_hWnd;
 			bool m_isRun;
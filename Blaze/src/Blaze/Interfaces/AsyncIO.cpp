@@ -0,0 +1,31 @@
+#include <pch.h>
+#include <Blaze/IO/AsyncIO.h>
+#include <Blaze/Impl/Generic/GenericAsyncIO.h>
+
+#if defined(BLAZE_PLATFORM_LINUX)
+#include <Blaze/Impl/Posix/IOUringAsyncIO.h>
+#endif // BLAZE_PLATFORM_LINUX
+
+namespace Blaze
+{
+	Ref<AsyncIO> AsyncIO::Create(const AsyncIOCreateInfo& createInfo)
+	{
+#if defined(BLAZE_PLATFORM_LINUX)
+		// io_uring can be missing or blocked (old kernels, containers), the thread pool works everywhere
+		if (!createInfo.isThreadPoolForced)
+		{
+			Ref<AsyncIO> ptr{ AllocateIOUringAsyncIO() };
+			if (ptr->Object::Create(static_cast<const ObjectCreateInfo&>(createInfo)) == Result::Success)
+				return ptr;
+		}
+#endif // BLAZE_PLATFORM_LINUX
+		// TODO: Add an I/O completion port backend for Windows
+
+		Ref<AsyncIO> ptr{ AllocateGenericAsyncIO() };
+
+		if (ptr->Object::Create(static_cast<const ObjectCreateInfo&>(createInfo)) != Result::Success)
+			return Ref<AsyncIO>{ nullptr };
+
+		return ptr;
+	}
+}
@@ -1,6 +1,7 @@
 #include <pch.h>
 #include <Blaze/Renderer/Buffer.h>
 #include <Blaze/Impl/OpenGL/GLBuffer.h>
+#include <Blaze/Impl/Headless/HeadlessBuffer.h>
 
 namespace Blaze
 {
@@ -13,6 +14,9 @@ namespace Blaze
         case RenderAPI::OpenGL:
             ptr = Ref<Buffer>{ AllocateOpenGLBuffer() };
             break;
+        case RenderAPI::Headless:
+            ptr = Ref<Buffer>{ AllocateHeadlessBuffer() };
+            break;
         default:
             return Ref<Buffer>{ nullptr };
         }
@@ -1,15 +1,17 @@
 #include <pch.h>
 #include <Blaze/Renderer/DeviceContext.h>
 #include <Blaze/Impl/OpenGL/GLDeviceContext.h>
+#include <Blaze/Impl/Headless/HeadlessDeviceContext.h>
 
 namespace Blaze
 {
 	namespace Details
 	{
+		// The first one is the default, headless works everywhere
 #ifdef BLAZE_PLATFORM_WIN64
-		constexpr std::array<RenderAPI, 1> renderAPIs{ RenderAPI::OpenGL };
+		constexpr std::array<RenderAPI, 2> renderAPIs{ RenderAPI::OpenGL, RenderAPI::Headless };
 #else
-		constexpr std::array<RenderAPI, 0> renderAPIs {};
+		constexpr std::array<RenderAPI, 1> renderAPIs{ RenderAPI::Headless };
 #endif
 	}
 
@@ -31,10 +33,17 @@ namespace Blaze
 		case RenderAPI::OpenGL:
 			ptr = Ref<DeviceContext>{ AllocateOpenGLDeviceContext(info.window->GetWindowAPI()) };
 			break;
+		case RenderAPI::Headless:
+			ptr = Ref<DeviceContext>{ AllocateHeadlessDeviceContext() };
+			break;
 		default:
 			return Ref<DeviceContext>{ nullptr };
 		}
 
+		// The API may not support the window, like OpenGL on a headless window
+		if (!ptr)
+			return Ref<DeviceContext>{ nullptr };
+
 		ptr->Object::Create(static_cast<const ObjectCreateInfo&>(info));
 
 		return ptr;
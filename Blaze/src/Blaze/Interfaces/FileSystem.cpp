@@ -0,0 +1,16 @@
+#include <pch.h>
+#include <Blaze/IO/FileSystem.h>
+#include <Blaze/Impl/Generic/GenericFileSystem.h>
+
+namespace Blaze
+{
+	Ref<FileSystem> FileSystem::Create(const FileSystemCreateInfo& createInfo)
+	{
+		Ref<FileSystem> ptr{ AllocateGenericFileSystem() };
+
+		if (ptr->Object::Create(static_cast<const ObjectCreateInfo&>(createInfo)) != Result::Success)
+			return Ref<FileSystem>{ nullptr };
+
+		return ptr;
+	}
+}
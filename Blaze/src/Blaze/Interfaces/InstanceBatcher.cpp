@@ -0,0 +1,16 @@
+#include <pch.h>
+#include <Blaze/Renderer/InstanceBatcher.h>
+#include <Blaze/Impl/Generic/GenericInstanceBatcher.h>
+
+namespace Blaze
+{
+	Ref<InstanceBatcher> InstanceBatcher::Create(const InstanceBatcherCreateInfo& createInfo)
+	{
+		Ref<InstanceBatcher> ptr{ AllocateGenericInstanceBatcher() };
+
+		if (ptr->Object::Create(static_cast<const ObjectCreateInfo&>(createInfo)) != Result::Success)
+			return Ref<InstanceBatcher>{ nullptr };
+
+		return ptr;
+	}
+}
@@ -0,0 +1,16 @@
+#include <pch.h>
+#include <Blaze/Jobs/JobSystem.h>
+#include <Blaze/Impl/Generic/GenericJobSystem.h>
+
+namespace Blaze
+{
+	Ref<JobSystem> JobSystem::Create(const JobSystemCreateInfo& createInfo)
+	{
+		Ref<JobSystem> ptr{ AllocateGenericJobSystem() };
+
+		if (ptr->Object::Create(static_cast<const ObjectCreateInfo&>(createInfo)) != Result::Success)
+			return Ref<JobSystem>{ nullptr };
+
+		return ptr;
+	}
+}
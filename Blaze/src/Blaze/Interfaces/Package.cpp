@@ -0,0 +1,28 @@
+#include <pch.h>
+#include <Blaze/IO/Package.h>
+
+#if defined(BLAZE_PLATFORM_WIN32) || defined(BLAZE_PLATFORM_WIN64)
+#include <Blaze/Impl/Win32/Win32Package.h>
+#elif defined(BLAZE_PLATFORM_LINUX) // ^^^ Windows (Win32) / Linux (Posix) vvv
+#include <Blaze/Impl/Posix/PosixPackage.h>
+#endif // ^^^ Linux (Posix)
+
+namespace Blaze
+{
+	Ref<Package> Package::Create(const PackageCreateInfo& createInfo)
+	{
+#if defined(BLAZE_PLATFORM_WIN32) || defined(BLAZE_PLATFORM_WIN64)
+		Ref<Package> ptr{ AllocateWin32Package() };
+#elif defined(BLAZE_PLATFORM_LINUX) // ^^^ Windows (Win32) / Linux (Posix) vvv
+		Ref<Package> ptr{ AllocatePosixPackage() };
+#else // ^^^ Linux (Posix) / Invalid platform vvv
+		// TODO: Add other platforms
+		Ref<Package> ptr{ nullptr };
+#endif // ^^^ Invalid platform
+
+		if (!ptr || (ptr->Object::Create(static_cast<const ObjectCreateInfo&>(createInfo)) != Result::Success))
+			return Ref<Package>{ nullptr };
+
+		return ptr;
+	}
+}
@@ -1,6 +1,9 @@
 #include <pch.h>
 #include <Blaze/Window.h>
+#include <Blaze/Impl/Headless/HeadlessWindow.h>
+#if defined(BLAZE_PLATFORM_WIN32) || defined(BLAZE_PLATFORM_WIN64)
 #include <Blaze/Impl/Win32/Win32Window.h>
+#endif // BLAZE_PLATFORM_WIN32 || BLAZE_PLATFORM_WIN64
 
 namespace Blaze
 {
@@ -17,11 +20,19 @@ namespace Blaze
 	{
 		Ref<Window> ptr;
 
-		switch (Details::windowAPI)
+		// Use the platform's window if an API isn't specified
+		const WindowAPI windowAPI = (createInfo.windowAPI == WindowAPI::Null) ? Details::windowAPI : createInfo.windowAPI;
+
+		switch (windowAPI)
 		{
+#if defined(BLAZE_PLATFORM_WIN32) || defined(BLAZE_PLATFORM_WIN64)
 		case WindowAPI::Win32:
 			ptr = Ref<Window>{ AllocateWin32Window() };
 			break;
+#endif // BLAZE_PLATFORM_WIN32 || BLAZE_PLATFORM_WIN64
+		case WindowAPI::Headless:
+			ptr = Ref<Window>{ AllocateHeadlessWindow() };
+			break;
 			// TODO: Add cases for other platforms
 		default:
 			return Ref<Window>{ nullptr };
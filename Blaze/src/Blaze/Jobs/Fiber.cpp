@@ -0,0 +1,122 @@
+#include <pch.h>
+#include "Fiber.h"
+
+#if defined(BLAZE_PLATFORM_LINUX)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif // BLAZE_PLATFORM_LINUX
+
+namespace Blaze
+{
+	namespace Details
+	{
+#if defined(BLAZE_PLATFORM_WIN32) || defined(BLAZE_PLATFORM_WIN64)
+		static VOID WINAPI FiberEntry(LPVOID parameter)
+		{
+			FiberContext* context = reinterpret_cast<FiberContext*>(parameter);
+			context->function(context->data);
+		}
+
+		Result CreateThreadFiberContext(FiberContext& context)
+		{
+			context.fiber = ConvertThreadToFiber(nullptr);
+			if (!context.fiber)
+				return Result::SystemError;
+
+			context.isThreadFiber = true;
+			return Result::Success;
+		}
+
+		Result CreateFiberContext(FiberContext& context, size_t stackSize, FiberFunction function, void* data)
+		{
+			context.function = function;
+			context.data = data;
+			context.isThreadFiber = false;
+
+			// Only the reserve is given, the stack is committed as it grows
+			context.fiber = CreateFiberEx(0, stackSize, 0, &FiberEntry, &context);
+			if (!context.fiber)
+				return Result::SystemError;
+
+			return Result::Success;
+		}
+
+		void DestroyFiberContext(FiberContext& context)
+		{
+			if (!context.fiber)
+				return;
+
+			if (context.isThreadFiber)
+				ConvertFiberToThread();
+			else
+				DeleteFiber(context.fiber);
+			context.fiber = nullptr;
+		}
+
+		void SwitchFiberContext(FiberContext& from, FiberContext& to)
+		{
+			// Windows keeps track of the running fiber itself
+			(void)from;
+			SwitchToFiber(to.fiber);
+		}
+#elif defined(BLAZE_PLATFORM_LINUX) // ^^^ Windows (Win32) / Linux (Posix) vvv
+		// makecontext only passes ints, so the context pointer is split in two
+		static void FiberEntry(int low, int high)
+		{
+			uintptr_t address = (static_cast<uintptr_t>(static_cast<uint32_t>(high)) << 32) | static_cast<uint32_t>(low);
+			FiberContext* context = reinterpret_cast<FiberContext*>(address);
+			context->function(context->data);
+		}
+
+		Result CreateThreadFiberContext(FiberContext& context)
+		{
+			context.isThreadFiber = true;
+			return Result::Success;
+		}
+
+		Result CreateFiberContext(FiberContext& context, size_t stackSize, FiberFunction function, void* data)
+		{
+			const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+			stackSize = (stackSize + pageSize - 1) / pageSize * pageSize;
+
+			// A guard page below the stack turns an overflow into a crash instead of corrupting memory
+			void* memory = mmap(nullptr, stackSize + pageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if (memory == MAP_FAILED)
+				return Result::AllocationError;
+			mprotect(memory, pageSize, PROT_NONE);
+
+			if (getcontext(&context.context) != 0)
+			{
+				munmap(memory, stackSize + pageSize);
+				return Result::SystemError;
+			}
+
+			context.stack = memory;
+			context.stackSize = stackSize + pageSize;
+			context.function = function;
+			context.data = data;
+			context.isThreadFiber = false;
+
+			context.context.uc_stack.ss_sp = reinterpret_cast<uint8_t*>(memory) + pageSize;
+			context.context.uc_stack.ss_size = stackSize;
+			context.context.uc_link = nullptr;
+
+			const uintptr_t address = reinterpret_cast<uintptr_t>(&context);
+			makecontext(&context.context, reinterpret_cast<void(*)()>(&FiberEntry), 2, static_cast<int>(static_cast<uint32_t>(address)), static_cast<int>(static_cast<uint32_t>(address >> 32)));
+			return Result::Success;
+		}
+
+		void DestroyFiberContext(FiberContext& context)
+		{
+			if (context.stack)
+				munmap(context.stack, context.stackSize);
+			context.stack = nullptr;
+		}
+
+		void SwitchFiberContext(FiberContext& from, FiberContext& to)
+		{
+			swapcontext(&from.context, &to.context);
+		}
+#endif // ^^^ Linux (Posix)
+	}
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#ifndef BLAZE_JOBS_FIBER_H
+#define BLAZE_JOBS_FIBER_H
+
+#include <Blaze/Core.h>
+#include <Blaze/Error.h>
+
+#if defined(BLAZE_PLATFORM_LINUX)
+#include <ucontext.h>
+#endif // BLAZE_PLATFORM_LINUX
+
+namespace Blaze
+{
+	namespace Details
+	{
+		using FiberFunction = void(*)(void* data);
+
+		// An execution context with its own stack, switching between fibers never enters the kernel on Windows
+		struct FiberContext
+		{
+#if defined(BLAZE_PLATFORM_WIN32) || defined(BLAZE_PLATFORM_WIN64)
+			void* fiber = nullptr;
+#elif defined(BLAZE_PLATFORM_LINUX) // ^^^ Windows (Win32) / Linux (Posix) vvv
+			ucontext_t context;
+			void* stack = nullptr;
+			size_t stackSize = 0;
+#endif // ^^^ Linux (Posix)
+			FiberFunction function = nullptr;
+			void* data = nullptr;
+			bool isThreadFiber = false;
+		};
+
+		// Turns the calling thread into a fiber so it can switch to other fibers
+		Result CreateThreadFiberContext(FiberContext& context);
+		// Creates a fiber that calls function when it's first switched to, function must never return
+		// The context is referenced by the fiber, so it can't move until it's destroyed
+		Result CreateFiberContext(FiberContext& context, size_t stackSize, FiberFunction function, void* data);
+		// Destroys a fiber, a thread fiber has to be destroyed on its own thread
+		void DestroyFiberContext(FiberContext& context);
+		// Saves the running fiber to from and continues to
+		void SwitchFiberContext(FiberContext& from, FiberContext& to);
+	}
+}
+
+#endif // BLAZE_JOBS_FIBER_H
@@ -0,0 +1,151 @@
+#pragma once
+
+#ifndef BLAZE_JOBS_JOBDEQUE_H
+#define BLAZE_JOBS_JOBDEQUE_H
+
+#include <Blaze/Core.h>
+#include <Blaze/Jobs/JobSystem.h>
+
+#include <atomic>
+
+namespace Blaze
+{
+	namespace Details
+	{
+		struct Job
+		{
+			JobFunction function;
+			void* data;
+			JobCounter* counter;
+		};
+
+		// Chase-Lev work stealing deque (Lê et al. 2013 for the memory orders)
+		// The owning worker pushes and pops at the bottom, other workers steal from the top
+		class JobDeque
+		{
+		public:
+			JobDeque()
+			{
+				m_buffers.push_back(std::make_unique<Buffer>(initialCapacity));
+				m_buffer.store(m_buffers.back().get(), std::memory_order_relaxed);
+			}
+
+			JobDeque(const JobDeque&) = delete;
+			JobDeque& operator=(const JobDeque&) = delete;
+
+			// Owner only
+			void Push(const Job& job)
+			{
+				const int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+				const int64_t top = m_top.load(std::memory_order_acquire);
+				Buffer* buffer = m_buffer.load(std::memory_order_relaxed);
+
+				if (bottom - top > static_cast<int64_t>(buffer->mask))
+					buffer = Grow(buffer, top, bottom);
+
+				buffer->Store(bottom, job);
+				std::atomic_thread_fence(std::memory_order_release);
+				m_bottom.store(bottom + 1, std::memory_order_relaxed);
+			}
+
+			// Owner only, takes the most recently pushed job
+			bool Pop(Job& job)
+			{
+				const int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+				Buffer* buffer = m_buffer.load(std::memory_order_relaxed);
+				m_bottom.store(bottom, std::memory_order_relaxed);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				int64_t top = m_top.load(std::memory_order_relaxed);
+
+				if (top > bottom)
+				{
+					m_bottom.store(bottom + 1, std::memory_order_relaxed);
+					return false;
+				}
+
+				job = buffer->Load(bottom);
+				if (top == bottom)
+				{
+					// The last job, race the thieves for it
+					const bool isWon = m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+					m_bottom.store(bottom + 1, std::memory_order_relaxed);
+					return isWon;
+				}
+				return true;
+			}
+
+			// Any thread, takes the oldest job
+			bool Steal(Job& job)
+			{
+				int64_t top = m_top.load(std::memory_order_acquire);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				const int64_t bottom = m_bottom.load(std::memory_order_acquire);
+				if (top >= bottom)
+					return false;
+
+				Buffer* buffer = m_buffer.load(std::memory_order_acquire);
+				job = buffer->Load(top);
+				return m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+			}
+
+			// Any thread, may be out of date by the time it returns
+			bool IsEmpty() const
+			{
+				return m_bottom.load(std::memory_order_relaxed) <= m_top.load(std::memory_order_relaxed);
+			}
+		private:
+			constexpr static size_t initialCapacity = 256;
+
+			// Slots are atomic since a thief can read a slot while the owner writes it, the thief then loses the CAS on top
+			struct Slot
+			{
+				std::atomic<JobFunction> function;
+				std::atomic<void*> data;
+				std::atomic<JobCounter*> counter;
+			};
+
+			struct Buffer
+			{
+				explicit Buffer(size_t capacity) :mask(capacity - 1), slots(std::make_unique<Slot[]>(capacity)) {}
+
+				void Store(int64_t index, const Job& job)
+				{
+					Slot& slot = slots[static_cast<size_t>(index) & mask];
+					slot.function.store(job.function, std::memory_order_relaxed);
+					slot.data.store(job.data, std::memory_order_relaxed);
+					slot.counter.store(job.counter, std::memory_order_relaxed);
+				}
+
+				Job Load(int64_t index) const
+				{
+					const Slot& slot = slots[static_cast<size_t>(index) & mask];
+					return Job{ slot.function.load(std::memory_order_relaxed), slot.data.load(std::memory_order_relaxed), slot.counter.load(std::memory_order_relaxed) };
+				}
+
+				size_t mask;
+				std::unique_ptr<Slot[]> slots;
+			};
+
+			Buffer* Grow(Buffer* buffer, int64_t top, int64_t bottom)
+			{
+				auto newBuffer = std::make_unique<Buffer>((buffer->mask + 1) * 2);
+				for (int64_t i = top; i < bottom; i++)
+					newBuffer->Store(i, buffer->Load(i));
+
+				// Thieves may still be reading the old buffer, it's kept until the deque is destroyed
+				Buffer* result = newBuffer.get();
+				m_buffers.push_back(std::move(newBuffer));
+				m_buffer.store(result, std::memory_order_release);
+				return result;
+			}
+
+			// Top and bottom are on their own cache lines, thieves hammer top while the owner works on bottom
+			alignas(64) std::atomic<int64_t> m_top{ 0 };
+			alignas(64) std::atomic<int64_t> m_bottom{ 0 };
+			alignas(64) std::atomic<Buffer*> m_buffer{ nullptr };
+			std::vector<std::unique_ptr<Buffer>> m_buffers;
+		};
+	}
+}
+
+#endif // BLAZE_JOBS_JOBDEQUE_H
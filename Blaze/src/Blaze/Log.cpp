@@ -0,0 +1,478 @@
+#include <pch.h>
+#include <Blaze/Log.h>
+#include <Blaze/Memory/Arena.h>
+#include <Blaze/Profiling/Profiler.h>
+#include <Blaze/Memory/AllocationTracker.h>
+
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <iomanip>
+
+namespace Blaze
+{
+	namespace Details
+	{
+		constexpr size_t numLogLevels = static_cast<size_t>(LogLevel::NumLevels) + 1;
+
+		constexpr std::array<const char*, numLogLevels> logLevelNames =
+		{
+			"Invalid",
+			"Trace",
+			"Info",
+			"Warning",
+			"Error"
+		};
+
+		struct LogRecordHeader
+		{
+			// nullptr marks padding up to the end of the ring
+			LogFormatter formatter;
+			const char* format;
+			uint32_t size;
+			LogLevel level;
+		};
+
+		constexpr size_t logRecordAlignment = alignof(LogRecordHeader);
+
+		// Single producer single consumer ring, the owning thread writes and the log thread reads
+		struct LogRing
+		{
+			std::unique_ptr<uint8_t[]> buffer{ new uint8_t[logRingSize] };
+			alignas(64) std::atomic<uint64_t> writePosition{ 0 };
+			alignas(64) std::atomic<uint64_t> readPosition{ 0 };
+			std::atomic<uint64_t> numDropped{ 0 };
+			// Set when the owning thread exits, the ring is released once it's empty
+			std::atomic<bool> isClosed{ false };
+		};
+
+		struct LogState
+		{
+			LogState()
+			{
+				Start();
+			}
+
+			~LogState()
+			{
+				Stop();
+			}
+
+			// Starts the log thread if it isn't running, eg. for the next GameApp after a Shutdown
+			void Start()
+			{
+				std::lock_guard<std::mutex> threadLock(threadMutex);
+				if (thread.joinable())
+					return;
+
+				isSleeping.store(false, std::memory_order_relaxed);
+				isRunning.store(true, std::memory_order_release);
+				thread = std::thread([this]() { Run(); });
+			}
+
+			void Stop()
+			{
+				std::lock_guard<std::mutex> threadLock(threadMutex);
+				{
+					std::lock_guard<std::mutex> lock(mutex);
+					isRunning.store(false, std::memory_order_release);
+				}
+				condition.notify_all();
+				if (thread.joinable())
+					thread.join();
+			}
+
+			// Wakes the log thread if it's sleeping, called after a record was written
+			void Wake()
+			{
+				// Pairs with the fence in Run, either the log thread sees the new record or this sees it sleeping
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				if (!isSleeping.load(std::memory_order_relaxed) || !isSleeping.exchange(false, std::memory_order_relaxed))
+					return;
+
+				// Taking the mutex makes sure the log thread is either waiting or hasn't checked isSleeping yet
+				{
+					std::lock_guard<std::mutex> lock(mutex);
+				}
+				condition.notify_one();
+			}
+
+			void Run();
+			// Writes out everything the rings have and returns whether there was anything, the mutex has to be held
+			bool Drain();
+			// Whether any ring has records that haven't been written yet
+			bool HasRecords();
+			void WriteLine(LogLevel level, const std::string& message);
+
+			std::mutex mutex;
+			std::condition_variable condition;
+			std::condition_variable flushCondition;
+			// Once it's false the log thread is gone and messages are written by the thread logging them
+			std::atomic<bool> isRunning{ false };
+			// Set while the log thread waits for records, only the first record after that wakes it
+			std::atomic<bool> isSleeping{ false };
+			uint64_t numFlushRequests = 0;
+			uint64_t numFlushesDone = 0;
+
+			LogConfig config;
+			std::ofstream file;
+			std::deque<std::string> history;
+
+			std::mutex ringMutex;
+			std::vector<std::shared_ptr<LogRing>> rings;
+
+			std::atomic<uint64_t> numMessages{ 0 };
+			uint64_t numDroppedReported = 0;
+			std::atomic<uint64_t> numDropped{ 0 };
+
+			// Guards starting and stopping the thread
+			std::mutex threadMutex;
+			// Declared last so everything it uses exists before it starts
+			std::thread thread;
+		};
+
+		static LogState& GetLogState()
+		{
+			static LogState state;
+			return state;
+		}
+
+		// Registers the thread's ring on its first message and closes it when the thread exits
+		struct ThreadLogRing
+		{
+			~ThreadLogRing()
+			{
+				if (ring)
+					ring->isClosed.store(true, std::memory_order_release);
+			}
+
+			LogRing* Get()
+			{
+				if (!ring)
+				{
+					ring = std::make_shared<LogRing>();
+					LogState& state = GetLogState();
+					std::lock_guard<std::mutex> lock(state.ringMutex);
+					state.rings.push_back(ring);
+				}
+				return ring.get();
+			}
+
+			std::shared_ptr<LogRing> ring;
+		};
+
+		static thread_local ThreadLogRing threadLogRing;
+
+		LogReservation BeginLogRecord(LogLevel level, const char* format, LogFormatter formatter, size_t size)
+		{
+			LogRing& ring = *threadLogRing.Get();
+			const size_t recordSize = static_cast<size_t>(AlignUp(sizeof(LogRecordHeader) + size, logRecordAlignment));
+
+			// Too long for the ring, like a huge string argument
+			if (recordSize > logRingSize / 4)
+			{
+				ring.numDropped.fetch_add(1, std::memory_order_relaxed);
+				return LogReservation{};
+			}
+
+			uint64_t position = ring.writePosition.load(std::memory_order_relaxed);
+			const uint64_t readPosition = ring.readPosition.load(std::memory_order_acquire);
+
+			// Records never wrap around, the rest of the ring is skipped instead
+			const size_t offset = static_cast<size_t>(position % logRingSize);
+			const size_t contiguous = logRingSize - offset;
+			const size_t padding = (contiguous < recordSize) ? contiguous : 0;
+			if (position + padding + recordSize - readPosition > logRingSize)
+			{
+				ring.numDropped.fetch_add(1, std::memory_order_relaxed);
+				return LogReservation{};
+			}
+
+			if (padding)
+			{
+				// Padding too short for a header is recognized by its length alone
+				if (padding >= sizeof(LogRecordHeader))
+				{
+					LogRecordHeader header{ nullptr, nullptr, static_cast<uint32_t>(padding), LogLevel::Invalid };
+					std::memcpy(ring.buffer.get() + offset, &header, sizeof(header));
+				}
+				position += padding;
+			}
+
+			uint8_t* record = ring.buffer.get() + static_cast<size_t>(position % logRingSize);
+			const LogRecordHeader header{ formatter, format, static_cast<uint32_t>(recordSize), level };
+			std::memcpy(record, &header, sizeof(header));
+
+			LogReservation reservation;
+			reservation.ring = &ring;
+			reservation.data = record + sizeof(LogRecordHeader);
+			reservation.end = position + recordSize;
+			return reservation;
+		}
+
+		void EndLogRecord(const LogReservation& reservation)
+		{
+			static_cast<LogRing*>(reservation.ring)->writePosition.store(reservation.end, std::memory_order_release);
+
+			LogState& state = GetLogState();
+			if (!state.isRunning.load(std::memory_order_acquire))
+			{
+				std::lock_guard<std::mutex> lock(state.mutex);
+				state.Drain();
+			}
+			else
+				state.Wake();
+		}
+
+		void FormatLogMessage(std::ostream& stream, const char* format, const LogValue* values, size_t numValues)
+		{
+			size_t nextValue = 0;
+			for (const char* c = format; *c; c++)
+			{
+				if ((c[0] == '{') && (c[1] == '{'))
+				{
+					stream << '{';
+					c++;
+					continue;
+				}
+				if ((c[0] == '}') && (c[1] == '}'))
+				{
+					stream << '}';
+					c++;
+					continue;
+				}
+				if (c[0] != '{')
+				{
+					stream << c[0];
+					continue;
+				}
+
+				// {} or {:.N}
+				const char* end = std::strchr(c, '}');
+				if (!end)
+				{
+					stream << c;
+					break;
+				}
+
+				int precision = -1;
+				if ((c[1] == ':') && (c[2] == '.'))
+					precision = std::atoi(c + 3);
+
+				if (nextValue < numValues)
+				{
+					const std::ios_base::fmtflags flags = stream.flags();
+					const std::streamsize oldPrecision = stream.precision();
+					if (precision >= 0)
+						stream << std::fixed << std::setprecision(precision);
+
+					values[nextValue].print(stream, values[nextValue].value);
+
+					stream.flags(flags);
+					stream.precision(oldPrecision);
+				}
+				else
+					stream << "{?}";
+
+				nextValue++;
+				c = end;
+			}
+		}
+
+		void PrintLogString(std::ostream& stream, const void* value) { stream << *static_cast<const std::string_view*>(value); }
+		void PrintLogBool(std::ostream& stream, const void* value) { stream << (*static_cast<const bool*>(value) ? "true" : "false"); }
+		void PrintLogChar(std::ostream& stream, const void* value) { stream << *static_cast<const char*>(value); }
+		void PrintLogSigned(std::ostream& stream, const void* value) { stream << *static_cast<const int64_t*>(value); }
+		void PrintLogUnsigned(std::ostream& stream, const void* value) { stream << *static_cast<const uint64_t*>(value); }
+		void PrintLogDouble(std::ostream& stream, const void* value) { stream << *static_cast<const double*>(value); }
+		void PrintLogPointer(std::ostream& stream, const void* value) { stream << *static_cast<const void* const*>(value); }
+
+		void LogState::Run()
+		{
+			Profiler::SetThreadName("Log Writer");
+			BLAZE_ALLOCATION_TAG(AllocationTag::IO);
+
+			std::unique_lock<std::mutex> lock(mutex);
+			while (true)
+			{
+				// Flushes are counted before draining, so everything logged before a request is written when it's answered
+				const uint64_t numFlushes = numFlushRequests;
+				const bool wasRunning = isRunning.load(std::memory_order_relaxed);
+				const bool hadMessages = Drain();
+
+				if (numFlushes != numFlushesDone)
+				{
+					numFlushesDone = numFlushes;
+					flushCondition.notify_all();
+				}
+
+				if (!wasRunning)
+					break;
+				if (hadMessages)
+					continue;
+
+				// Nothing left, so the thread sleeps until a record arrives instead of polling
+				isSleeping.store(true, std::memory_order_relaxed);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				if (HasRecords())
+				{
+					isSleeping.store(false, std::memory_order_relaxed);
+					continue;
+				}
+
+				condition.wait(lock, [this]()
+				{
+					return !isSleeping.load(std::memory_order_relaxed) || !isRunning.load(std::memory_order_relaxed) || (numFlushRequests != numFlushesDone);
+				});
+				isSleeping.store(false, std::memory_order_relaxed);
+			}
+		}
+
+		bool LogState::HasRecords()
+		{
+			std::lock_guard<std::mutex> lock(ringMutex);
+			return std::any_of(rings.begin(), rings.end(), [](const std::shared_ptr<LogRing>& ring)
+			{
+				return ring->readPosition.load(std::memory_order_relaxed) != ring->writePosition.load(std::memory_order_acquire);
+			});
+		}
+
+		bool LogState::Drain()
+		{
+			// Rings can be registered while draining, they're picked up next time
+			std::vector<std::shared_ptr<LogRing>> drainRings;
+			{
+				std::lock_guard<std::mutex> lock(ringMutex);
+				drainRings = rings;
+			}
+
+			std::ostringstream message;
+			bool hadMessages = false;
+			for (const std::shared_ptr<LogRing>& ring : drainRings)
+			{
+				numDropped.fetch_add(ring->numDropped.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+
+				uint64_t position = ring->readPosition.load(std::memory_order_relaxed);
+				const uint64_t writePosition = ring->writePosition.load(std::memory_order_acquire);
+				while (position != writePosition)
+				{
+					const size_t offset = static_cast<size_t>(position % logRingSize);
+					const size_t contiguous = logRingSize - offset;
+					if (contiguous < sizeof(LogRecordHeader))
+					{
+						position += contiguous;
+						continue;
+					}
+
+					LogRecordHeader header;
+					std::memcpy(&header, ring->buffer.get() + offset, sizeof(header));
+					if (!header.formatter)
+					{
+						position += contiguous;
+						continue;
+					}
+
+					message.str(std::string{});
+					header.formatter(message, header.format, ring->buffer.get() + offset + sizeof(LogRecordHeader));
+					WriteLine(header.level, message.str());
+					numMessages.fetch_add(1, std::memory_order_relaxed);
+
+					position += header.size;
+					hadMessages = true;
+				}
+				ring->readPosition.store(position, std::memory_order_release);
+			}
+
+			const uint64_t dropped = numDropped.load(std::memory_order_relaxed);
+			if (dropped != numDroppedReported)
+			{
+				WriteLine(LogLevel::Warning, "Dropped " + std::to_string(dropped - numDroppedReported) + " log messages");
+				numDroppedReported = dropped;
+			}
+
+			if (hadMessages && config.console)
+				std::fflush(stdout);
+			if (hadMessages && file.is_open())
+				file.flush();
+
+			// Rings of threads that exited are released once everything in them is written
+			std::lock_guard<std::mutex> lock(ringMutex);
+			rings.erase(std::remove_if(rings.begin(), rings.end(), [](const std::shared_ptr<LogRing>& ring)
+			{
+				return ring->isClosed.load(std::memory_order_acquire) && (ring->readPosition.load(std::memory_order_relaxed) == ring->writePosition.load(std::memory_order_acquire));
+			}), rings.end());
+
+			return hadMessages;
+		}
+
+		void LogState::WriteLine(LogLevel level, const std::string& message)
+		{
+			const size_t levelIndex = std::min(static_cast<size_t>(level), numLogLevels - 1);
+			const std::string line = std::string("[Blaze:") + logLevelNames[levelIndex] + "]: " + message + '\n';
+
+			if (config.console)
+				std::fwrite(line.data(), 1, line.size(), stdout);
+			if (file.is_open())
+				file.write(line.data(), line.size());
+
+			if (config.historySize)
+			{
+				history.push_back(line);
+				while (history.size() > config.historySize)
+					history.pop_front();
+			}
+		}
+	}
+
+	void Log::Configure(const LogConfig& config)
+	{
+		Details::LogState& state = Details::GetLogState();
+		{
+			std::lock_guard<std::mutex> lock(state.mutex);
+			state.config = config;
+
+			state.file.close();
+			if (!config.filePath.empty())
+				state.file.open(config.filePath, std::ios::out | std::ios::app);
+			while (state.history.size() > config.historySize)
+				state.history.pop_front();
+		}
+
+		// A GameApp created after another one was destroyed logs asynchronously again
+		state.Start();
+	}
+
+	void Log::Flush()
+	{
+		Details::LogState& state = Details::GetLogState();
+		std::unique_lock<std::mutex> lock(state.mutex);
+		if (!state.isRunning.load(std::memory_order_relaxed))
+			return;
+
+		const uint64_t request = ++state.numFlushRequests;
+		state.condition.notify_all();
+		state.flushCondition.wait(lock, [&]() { return state.numFlushesDone >= request; });
+	}
+
+	void Log::Shutdown()
+	{
+		Details::GetLogState().Stop();
+	}
+
+	LogStats Log::GetStats()
+	{
+		Details::LogState& state = Details::GetLogState();
+
+		LogStats stats;
+		stats.numMessages = state.numMessages.load(std::memory_order_relaxed);
+		stats.numDropped = state.numDropped.load(std::memory_order_relaxed);
+		return stats;
+	}
+
+	std::vector<std::string> Log::GetHistory()
+	{
+		Details::LogState& state = Details::GetLogState();
+		std::lock_guard<std::mutex> lock(state.mutex);
+		return std::vector<std::string>(state.history.begin(), state.history.end());
+	}
+}
@@ -0,0 +1,169 @@
+#include <pch.h>
+#include <Blaze/Math/BatchTransform.h>
+
+namespace Blaze
+{
+	namespace Details
+	{
+		template<typename T>
+		static T* OffsetElement(T* base, size_t index, size_t stride)
+		{
+			using Byte = std::conditional_t<std::is_const_v<T>, const uint8_t, uint8_t>;
+			return reinterpret_cast<T*>(reinterpret_cast<Byte*>(base) + index * stride);
+		}
+
+		// w is 1 for points and 0 for vectors, so vectors skip the translation column
+		static void TransformSoA(const Mat4& transform, float w, const float* x, const float* y, const float* z, float* outX, float* outY, float* outZ, size_t count)
+		{
+			const auto& c = transform.columns;
+			size_t i = 0;
+
+#ifdef BLAZE_SIMD_AVX
+			{
+				const __m256 m[3][4] = {
+					{ _mm256_set1_ps(c[0].x), _mm256_set1_ps(c[1].x), _mm256_set1_ps(c[2].x), _mm256_set1_ps(c[3].x * w) },
+					{ _mm256_set1_ps(c[0].y), _mm256_set1_ps(c[1].y), _mm256_set1_ps(c[2].y), _mm256_set1_ps(c[3].y * w) },
+					{ _mm256_set1_ps(c[0].z), _mm256_set1_ps(c[1].z), _mm256_set1_ps(c[2].z), _mm256_set1_ps(c[3].z * w) }
+				};
+				for (; i + 8 <= count; i += 8)
+				{
+					const __m256 vx = _mm256_loadu_ps(x + i);
+					const __m256 vy = _mm256_loadu_ps(y + i);
+					const __m256 vz = _mm256_loadu_ps(z + i);
+
+					__m256 r[3];
+					for (int row = 0; row < 3; row++)
+					{
+#ifdef BLAZE_SIMD_FMA
+						r[row] = _mm256_fmadd_ps(m[row][0], vx, _mm256_fmadd_ps(m[row][1], vy, _mm256_fmadd_ps(m[row][2], vz, m[row][3])));
+#else // ^^^ BLAZE_SIMD_FMA / !BLAZE_SIMD_FMA vvv
+						r[row] = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m[row][0], vx), _mm256_mul_ps(m[row][1], vy)), _mm256_add_ps(_mm256_mul_ps(m[row][2], vz), m[row][3]));
+#endif // ^^^ !BLAZE_SIMD_FMA
+					}
+
+					// All inputs are loaded before storing, so in place transforms read the original values
+					_mm256_storeu_ps(outX + i, r[0]);
+					_mm256_storeu_ps(outY + i, r[1]);
+					_mm256_storeu_ps(outZ + i, r[2]);
+				}
+			}
+#endif // BLAZE_SIMD_AVX
+
+			const Float4 m[3][4] = {
+				{ Splat(c[0].x), Splat(c[1].x), Splat(c[2].x), Splat(c[3].x * w) },
+				{ Splat(c[0].y), Splat(c[1].y), Splat(c[2].y), Splat(c[3].y * w) },
+				{ Splat(c[0].z), Splat(c[1].z), Splat(c[2].z), Splat(c[3].z * w) }
+			};
+			for (; i + 4 <= count; i += 4)
+			{
+				const Float4 vx = Load4(x + i);
+				const Float4 vy = Load4(y + i);
+				const Float4 vz = Load4(z + i);
+
+				Float4 r[3];
+				for (int row = 0; row < 3; row++)
+					r[row] = MulAdd(m[row][0], vx, MulAdd(m[row][1], vy, MulAdd(m[row][2], vz, m[row][3])));
+
+				Store4(outX + i, r[0]);
+				Store4(outY + i, r[1]);
+				Store4(outZ + i, r[2]);
+			}
+
+			for (; i < count; i++)
+			{
+				const Vec3 v{ x[i], y[i], z[i] };
+				const Vec3 r = (w != 0.0f) ? transform.TransformPoint(v) : transform.TransformVector(v);
+				outX[i] = r.x;
+				outY[i] = r.y;
+				outZ[i] = r.z;
+			}
+		}
+
+		static void TransformStrided(const Mat4& transform, float w, const Vec3* src, size_t srcStride, Vec3* dst, size_t dstStride, size_t count)
+		{
+			const Float4 c0 = transform.columns[0].Load();
+			const Float4 c1 = transform.columns[1].Load();
+			const Float4 c2 = transform.columns[2].Load();
+			const Float4 c3 = transform.columns[3].Load() * Splat(w);
+
+			for (size_t i = 0; i < count; i++)
+			{
+				const float* v = OffsetElement(src, i, srcStride)->Data();
+				const Float4 r = MulAdd(c0, Splat(v[0]), MulAdd(c1, Splat(v[1]), MulAdd(c2, Splat(v[2]), c3)));
+				Store3(OffsetElement(dst, i, dstStride)->Data(), r);
+			}
+		}
+	}
+
+	void TransformPointsSoA(const Mat4& transform, const float* x, const float* y, const float* z, float* outX, float* outY, float* outZ, size_t count)
+	{
+		Details::TransformSoA(transform, 1.0f, x, y, z, outX, outY, outZ, count);
+	}
+
+	void TransformVectorsSoA(const Mat4& transform, const float* x, const float* y, const float* z, float* outX, float* outY, float* outZ, size_t count)
+	{
+		Details::TransformSoA(transform, 0.0f, x, y, z, outX, outY, outZ, count);
+	}
+
+	void TransformPoints(const Mat4& transform, const Vec3* src, size_t srcStride, Vec3* dst, size_t dstStride, size_t count)
+	{
+		Details::TransformStrided(transform, 1.0f, src, srcStride, dst, dstStride, count);
+	}
+
+	void TransformVectors(const Mat4& transform, const Vec3* src, size_t srcStride, Vec3* dst, size_t dstStride, size_t count)
+	{
+		Details::TransformStrided(transform, 0.0f, src, srcStride, dst, dstStride, count);
+	}
+
+	void TransformVec4s(const Mat4& transform, const Vec4* src, size_t srcStride, Vec4* dst, size_t dstStride, size_t count)
+	{
+		for (size_t i = 0; i < count; i++)
+			*Details::OffsetElement(dst, i, dstStride) = transform * *Details::OffsetElement(src, i, srcStride);
+	}
+
+	void SplitVec3(const Vec3* src, size_t srcStride, float* x, float* y, float* z, size_t count)
+	{
+		for (size_t i = 0; i < count; i++)
+		{
+			const Vec3& v = *Details::OffsetElement(src, i, srcStride);
+			x[i] = v.x;
+			y[i] = v.y;
+			z[i] = v.z;
+		}
+	}
+
+	void InterleaveVec3(const float* x, const float* y, const float* z, Vec3* dst, size_t dstStride, size_t count)
+	{
+		for (size_t i = 0; i < count; i++)
+			*Details::OffsetElement(dst, i, dstStride) = { x[i], y[i], z[i] };
+	}
+
+	Result TransformVertexAttribute(const Mat4& transform, void* vertices, size_t vertexCount, const VertexFormat& format, size_t attributeIndex, bool isDirection)
+	{
+		const auto& attributes = format.GetAttributes();
+		if (!vertices || (attributeIndex >= attributes.size()))
+			return Result::InvalidParam;
+
+		const VertexAttribute& attribute = attributes[attributeIndex];
+		const size_t stride = format.GetStride(attribute.binding);
+		uint8_t* data = static_cast<uint8_t*>(vertices) + attribute.offset;
+
+		switch (attribute.format)
+		{
+		case VertexFormatOf<Vec3>::format:
+		{
+			Vec3* positions = reinterpret_cast<Vec3*>(data);
+			Details::TransformStrided(transform, isDirection ? 0.0f : 1.0f, positions, stride, positions, stride, vertexCount);
+			return Result::Success;
+		}
+		case VertexFormatOf<Vec4>::format:
+		{
+			Vec4* values = reinterpret_cast<Vec4*>(data);
+			TransformVec4s(transform, values, stride, values, stride, vertexCount);
+			return Result::Success;
+		}
+		default:
+			return Result::InvalidParam;
+		}
+	}
+}
@@ -0,0 +1,97 @@
+#include <pch.h>
+#include <Blaze/Math/Bounds.h>
+
+namespace Blaze
+{
+	namespace Details
+	{
+		static const Vec3* OffsetVec3(const Vec3* positions, size_t index, size_t stride)
+		{
+			return reinterpret_cast<const Vec3*>(reinterpret_cast<const uint8_t*>(positions) + index * stride);
+		}
+	}
+
+	Frustum Frustum::FromViewProjection(const Mat4& viewProjection)
+	{
+		// Gribb/Hartmann, the planes are sums and differences of the last row with the others
+		const Mat4 rows = Transpose(viewProjection);
+		const Vec4& w = rows.columns[3];
+
+		Frustum frustum;
+		frustum.planes[Left] = w + rows.columns[0];
+		frustum.planes[Right] = w - rows.columns[0];
+		frustum.planes[Bottom] = w + rows.columns[1];
+		frustum.planes[Top] = w - rows.columns[1];
+		frustum.planes[Near] = w + rows.columns[2];
+		frustum.planes[Far] = w - rows.columns[2];
+
+		for (auto& plane : frustum.planes)
+		{
+			const float length = Length(plane.GetXYZ());
+			if (length > 0.0f)
+				plane /= length;
+		}
+		return frustum;
+	}
+
+	AABB ComputeBounds(const Vec3* positions, size_t count, size_t stride)
+	{
+		if (count == 0)
+			return AABB::Empty();
+
+		Float4 min = Load3(positions->Data());
+		Float4 max = min;
+		for (size_t i = 1; i < count; i++)
+		{
+			const Float4 p = Load3(Details::OffsetVec3(positions, i, stride)->Data());
+			min = Min(min, p);
+			max = Max(max, p);
+		}
+
+		AABB bounds;
+		Store3(bounds.min.Data(), min);
+		Store3(bounds.max.Data(), max);
+		return bounds;
+	}
+
+	BoundingSphere ComputeBoundingSphere(const Vec3* positions, size_t count, size_t stride)
+	{
+		if (count == 0)
+			return { Vec3{ 0.0f }, 0.0f };
+
+		const Float4 center = Vec4{ ComputeBounds(positions, count, stride).GetCenter(), 0.0f }.Load();
+		Float4 maxDistanceSquared{};
+		for (size_t i = 0; i < count; i++)
+		{
+			const Float4 d = Load3(Details::OffsetVec3(positions, i, stride)->Data()) - center;
+			maxDistanceSquared = Max(maxDistanceSquared, Splat(HorizontalAdd(d * d)));
+		}
+
+		BoundingSphere sphere;
+		Store3(sphere.center.Data(), center);
+		sphere.radius = std::sqrt(GetX(maxDistanceSquared));
+		return sphere;
+	}
+
+	AABB TransformBounds(const AABB& box, const Mat4& transform)
+	{
+		if (box.IsEmpty())
+			return box;
+
+		// Arvo's method, the new extents are the old ones through the absolute values of the rotation and scale
+		const Vec3 center = transform.TransformPoint(box.GetCenter());
+		const Vec3 extents = box.GetExtents();
+		Float4 newExtents = Abs(transform.columns[0].Load()) * Splat(extents.x);
+		newExtents = MulAdd(Abs(transform.columns[1].Load()), Splat(extents.y), newExtents);
+		newExtents = MulAdd(Abs(transform.columns[2].Load()), Splat(extents.z), newExtents);
+
+		const Vec3 halfSize = Vec4{ newExtents }.GetXYZ();
+		return { center - halfSize, center + halfSize };
+	}
+
+	BoundingSphere TransformBounds(const BoundingSphere& sphere, const Mat4& transform)
+	{
+		const float maxScaleSquared = std::max({ LengthSquared(transform.columns[0].GetXYZ()), LengthSquared(transform.columns[1].GetXYZ()), LengthSquared(transform.columns[2].GetXYZ()) });
+		return { transform.TransformPoint(sphere.center), sphere.radius * std::sqrt(maxScaleSquared) };
+	}
+}
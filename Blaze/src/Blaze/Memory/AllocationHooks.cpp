@@ -0,0 +1,7 @@
+#include <pch.h>
+#include <Blaze/Memory/AllocationTracker.h>
+
+// Only Blaze's own allocations, the game's executable needs BLAZE_ALLOCATION_HOOKS in one of its own source files
+#ifdef BLAZE_TRACK_ALLOCATIONS
+BLAZE_ALLOCATION_HOOKS
+#endif // BLAZE_TRACK_ALLOCATIONS
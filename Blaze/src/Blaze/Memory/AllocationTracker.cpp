@@ -0,0 +1,199 @@
+#include <pch.h>
+#include <Blaze/Memory/AllocationTracker.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <malloc.h>
+
+namespace Blaze
+{
+	namespace Details
+	{
+		constexpr size_t numAllocationTags = static_cast<size_t>(AllocationTag::NumTags) + 1;
+
+		constexpr std::array<const char*, numAllocationTags> allocationTagNames =
+		{
+			"Invalid",
+			"General",
+			"Window",
+			"Renderer",
+			"IO",
+			"Jobs",
+			"Game"
+		};
+
+		static void DefaultAllocationViolationHandler(size_t size, AllocationTag tag)
+		{
+#ifdef BLAZE_DEBUG
+			std::fprintf(stderr, "[Blaze:Error]: %zu byte heap allocation (%s) in an allocation-free scope\n", size, allocationTagNames[static_cast<size_t>(tag)]);
+#if defined(BLAZE_PLATFORM_WIN32) || defined(BLAZE_PLATFORM_WIN64)
+			if (IsDebuggerPresent())
+				DebugBreak();
+#endif // BLAZE_PLATFORM_WIN32 || BLAZE_PLATFORM_WIN64
+#else // ^^^ BLAZE_DEBUG / !BLAZE_DEBUG vvv
+			(void)size;
+			(void)tag;
+#endif // ^^^ !BLAZE_DEBUG
+		}
+
+		// Plain globals with constant initialization, operator new can be called before any constructor runs
+		struct AtomicAllocationCounts
+		{
+			std::atomic<uint64_t> numAllocations{ 0 };
+			std::atomic<uint64_t> numBytes{ 0 };
+		};
+
+		static std::array<AtomicAllocationCounts, numAllocationTags> currentFrameAllocations;
+		static std::array<AtomicAllocationCounts, numAllocationTags> lastFrameAllocations;
+		static std::array<AtomicAllocationCounts, numAllocationTags> totalAllocations;
+		static std::atomic<int64_t> liveBytes{ 0 };
+		static std::atomic<int64_t> peakLiveBytes{ 0 };
+		static std::atomic<uint64_t> numViolations{ 0 };
+		static std::atomic<bool> isTracking{ false };
+		static std::atomic<AllocationViolationHandler> violationHandler{ DefaultAllocationViolationHandler };
+
+		static thread_local AllocationTag threadTag = AllocationTag::General;
+		static thread_local uint32_t allocationFreeDepth = 0;
+		static thread_local bool isInViolationHandler = false;
+
+		static size_t GetAllocationSize(void* ptr, size_t alignment)
+		{
+#if defined(BLAZE_PLATFORM_WIN32) || defined(BLAZE_PLATFORM_WIN64)
+			return alignment ? _aligned_msize(ptr, alignment, 0) : _msize(ptr);
+#elif defined(BLAZE_PLATFORM_LINUX) // ^^^ Windows (Win32) / Linux (Posix) vvv
+			(void)alignment;
+			return malloc_usable_size(ptr);
+#endif // ^^^ Linux (Posix)
+		}
+
+		static void CountAllocation(void* ptr, size_t alignment)
+		{
+			if (!isTracking.load(std::memory_order_relaxed))
+				isTracking.store(true, std::memory_order_relaxed);
+
+			const size_t size = GetAllocationSize(ptr, alignment);
+			const size_t tag = static_cast<size_t>(threadTag);
+			currentFrameAllocations[tag].numAllocations.fetch_add(1, std::memory_order_relaxed);
+			currentFrameAllocations[tag].numBytes.fetch_add(size, std::memory_order_relaxed);
+			totalAllocations[tag].numAllocations.fetch_add(1, std::memory_order_relaxed);
+			totalAllocations[tag].numBytes.fetch_add(size, std::memory_order_relaxed);
+
+			const int64_t live = liveBytes.fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed) + static_cast<int64_t>(size);
+			int64_t peak = peakLiveBytes.load(std::memory_order_relaxed);
+			while ((live > peak) && !peakLiveBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed));
+
+			if (allocationFreeDepth && !isInViolationHandler)
+			{
+				numViolations.fetch_add(1, std::memory_order_relaxed);
+
+				isInViolationHandler = true;
+				violationHandler.load(std::memory_order_relaxed)(size, threadTag);
+				isInViolationHandler = false;
+			}
+		}
+
+		static void CountFree(void* ptr, size_t alignment)
+		{
+			liveBytes.fetch_sub(static_cast<int64_t>(GetAllocationSize(ptr, alignment)), std::memory_order_relaxed);
+		}
+	}
+
+	void* AllocationTracker::Allocate(size_t size)
+	{
+		void* ptr = std::malloc(size ? size : 1);
+		if (ptr)
+			Details::CountAllocation(ptr, 0);
+		return ptr;
+	}
+
+	void* AllocationTracker::AllocateAligned(size_t size, size_t alignment)
+	{
+		size = size ? size : 1;
+#if defined(BLAZE_PLATFORM_WIN32) || defined(BLAZE_PLATFORM_WIN64)
+		void* ptr = _aligned_malloc(size, alignment);
+#elif defined(BLAZE_PLATFORM_LINUX) // ^^^ Windows (Win32) / Linux (Posix) vvv
+		void* ptr = nullptr;
+		if (posix_memalign(&ptr, std::max(alignment, sizeof(void*)), size) != 0)
+			ptr = nullptr;
+#endif // ^^^ Linux (Posix)
+		if (ptr)
+			Details::CountAllocation(ptr, alignment);
+		return ptr;
+	}
+
+	void AllocationTracker::Free(void* ptr)
+	{
+		if (!ptr)
+			return;
+
+		Details::CountFree(ptr, 0);
+		std::free(ptr);
+	}
+
+	void AllocationTracker::FreeAligned(void* ptr, size_t alignment)
+	{
+		if (!ptr)
+			return;
+
+		Details::CountFree(ptr, alignment);
+#if defined(BLAZE_PLATFORM_WIN32) || defined(BLAZE_PLATFORM_WIN64)
+		_aligned_free(ptr);
+#elif defined(BLAZE_PLATFORM_LINUX) // ^^^ Windows (Win32) / Linux (Posix) vvv
+		std::free(ptr);
+#endif // ^^^ Linux (Posix)
+	}
+
+	void AllocationTracker::NextFrame()
+	{
+		for (size_t i = 0; i < Details::numAllocationTags; i++)
+		{
+			Details::lastFrameAllocations[i].numAllocations.store(Details::currentFrameAllocations[i].numAllocations.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+			Details::lastFrameAllocations[i].numBytes.store(Details::currentFrameAllocations[i].numBytes.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+		}
+	}
+
+	AllocationStats AllocationTracker::GetStats()
+	{
+		AllocationStats stats;
+		for (size_t i = 0; i < Details::numAllocationTags; i++)
+		{
+			stats.lastFrame[i].numAllocations = Details::lastFrameAllocations[i].numAllocations.load(std::memory_order_relaxed);
+			stats.lastFrame[i].numBytes = Details::lastFrameAllocations[i].numBytes.load(std::memory_order_relaxed);
+			stats.total[i].numAllocations = Details::totalAllocations[i].numAllocations.load(std::memory_order_relaxed);
+			stats.total[i].numBytes = Details::totalAllocations[i].numBytes.load(std::memory_order_relaxed);
+		}
+		stats.liveBytes = Details::liveBytes.load(std::memory_order_relaxed);
+		stats.peakLiveBytes = Details::peakLiveBytes.load(std::memory_order_relaxed);
+		stats.numViolations = Details::numViolations.load(std::memory_order_relaxed);
+		stats.isTracking = Details::isTracking.load(std::memory_order_relaxed);
+		return stats;
+	}
+
+	void AllocationTracker::SetViolationHandler(AllocationViolationHandler handler)
+	{
+		Details::violationHandler.store(handler ? handler : Details::DefaultAllocationViolationHandler, std::memory_order_relaxed);
+	}
+
+	AllocationTag AllocationTracker::GetThreadTag()
+	{
+		return Details::threadTag;
+	}
+
+	void AllocationTracker::SetThreadTag(AllocationTag tag)
+	{
+		if ((tag == AllocationTag::Invalid) || (static_cast<size_t>(tag) >= Details::numAllocationTags))
+			tag = AllocationTag::General;
+		Details::threadTag = tag;
+	}
+
+	void AllocationTracker::BeginAllocationFree()
+	{
+		Details::allocationFreeDepth++;
+	}
+
+	void AllocationTracker::EndAllocationFree()
+	{
+		if (Details::allocationFreeDepth)
+			Details::allocationFreeDepth--;
+	}
+}
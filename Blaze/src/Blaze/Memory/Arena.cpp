@@ -0,0 +1,80 @@
+#include <pch.h>
+#include <Blaze/Memory/Arena.h>
+
+namespace Blaze
+{
+	namespace Details
+	{
+		// Blocks start on a cache line so allocations from different threads don't share one by accident
+		constexpr size_t arenaAlignment = 64;
+
+		static uint8_t* AllocateArenaMemory(size_t size)
+		{
+			if (size == 0)
+				return nullptr;
+			return static_cast<uint8_t*>(::operator new(size, std::align_val_t{ arenaAlignment }, std::nothrow));
+		}
+
+		static void FreeArenaMemory(uint8_t* memory)
+		{
+			if (memory)
+				::operator delete(memory, std::align_val_t{ arenaAlignment });
+		}
+	}
+
+	LinearArena::LinearArena(size_t capacity)
+	{
+		m_memory = Details::AllocateArenaMemory(capacity);
+		m_capacity = m_memory ? capacity : 0;
+	}
+
+	LinearArena::~LinearArena()
+	{
+		Details::FreeArenaMemory(m_memory);
+	}
+
+	FrameArena::FrameArena(size_t capacityPerFrame, uint32_t numFramesInFlight)
+	{
+		// Blocks are rounded up so every frame's block starts aligned
+		capacityPerFrame = static_cast<size_t>(Details::AlignUp(capacityPerFrame, Details::arenaAlignment));
+		numFramesInFlight = std::clamp(numFramesInFlight, 1u, maxFramesInFlight);
+
+		m_memory = Details::AllocateArenaMemory(capacityPerFrame * numFramesInFlight);
+		m_capacityPerFrame = m_memory ? capacityPerFrame : 0;
+		m_numFramesInFlight = numFramesInFlight;
+		m_frameMemory = m_memory;
+	}
+
+	FrameArena::~FrameArena()
+	{
+		Details::FreeArenaMemory(m_memory);
+	}
+
+	void FrameArena::BeginFrame()
+	{
+		if (m_numFramesInFlight == 0)
+			return;
+
+		m_peakUsed = std::max(m_peakUsed, m_offset.load(std::memory_order_relaxed));
+
+		m_frameIndex = (m_frameIndex + 1) % m_numFramesInFlight;
+		m_frameMemory = m_memory + m_capacityPerFrame * m_frameIndex;
+		m_offset.store(0, std::memory_order_relaxed);
+	}
+
+	FrameArenaStats FrameArena::GetStats() const
+	{
+		FrameArenaStats stats;
+		stats.capacityPerFrame = m_capacityPerFrame;
+		stats.usedThisFrame = m_offset.load(std::memory_order_relaxed);
+		stats.peakUsed = std::max(m_peakUsed, stats.usedThisFrame);
+		stats.numFailedAllocations = m_numFailedAllocations.load(std::memory_order_relaxed);
+		return stats;
+	}
+
+	LinearArena& GetThreadScratchArena()
+	{
+		thread_local LinearArena arena(threadScratchSize);
+		return arena;
+	}
+}
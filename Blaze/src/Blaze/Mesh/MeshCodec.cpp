@@ -0,0 +1,682 @@
+#include <pch.h>
+#include <Blaze/Mesh/MeshCodec.h>
+#include <Blaze/Mesh/MeshOptimizer.h>
+
+#include <cmath>
+#include <cstring>
+
+#ifdef BLAZE_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace Blaze
+{
+	namespace Details
+	{
+		// Vertices are encoded in blocks of 16, one SSE register holds a byte of every vertex in a block
+		constexpr size_t vertexBlockSize = 16;
+		constexpr size_t maxEncodedVertexSize = 256;
+
+		constexpr uint8_t vertexStreamTag = 0xA0;
+		constexpr uint8_t indexStreamTag = 0xB0;
+
+		constexpr uint32_t compressedMeshMagic = 0x434D5A42; // "BZMC"
+		constexpr uint32_t compressedMeshVersion = 1;
+		constexpr uint32_t maxCompressedMeshAttributes = 16;
+
+		struct CompressedMeshHeader
+		{
+			uint32_t magic;
+			uint32_t version;
+			uint32_t vertexCount;
+			uint32_t vertexSize;
+			uint32_t indexCount;
+			uint32_t indexFormat;
+			uint32_t numAttributes;
+			uint32_t vertexDataSize;
+			uint32_t indexDataSize;
+		};
+
+		// Attributes follow the header
+		struct CompressedMeshAttribute
+		{
+			uint32_t format;
+			DequantizeTransform transform;
+		};
+
+		// Formats of the quantized attributes by component count, attributes are padded so every attribute stays 4-byte aligned
+		static constexpr std::array<Format, 4> floatFormats = { Format::R32_Float, Format::R32G32_Float, Format::R32G32B32_Float, Format::R32G32B32A32_Float };
+		static constexpr std::array<Format, 4> unorm16Formats = { Format::R16G16_UNorm, Format::R16G16_UNorm, Format::R16G16B16A16_UNorm, Format::R16G16B16A16_UNorm };
+		static constexpr std::array<Format, 4> snorm16Formats = { Format::R16G16_SNorm, Format::R16G16_SNorm, Format::R16G16B16A16_SNorm, Format::R16G16B16A16_SNorm };
+		static constexpr std::array<Format, 4> unorm8Formats = { Format::R8G8B8A8_UNorm, Format::R8G8B8A8_UNorm, Format::R8G8B8A8_UNorm, Format::R8G8B8A8_UNorm };
+		static constexpr std::array<Format, 4> snorm8Formats = { Format::R8G8B8A8_SNorm, Format::R8G8B8A8_SNorm, Format::R8G8B8A8_SNorm, Format::R8G8B8A8_SNorm };
+
+		static Format GetQuantizedFormat(QuantizationType type, uint32_t components)
+		{
+			switch (type)
+			{
+			case QuantizationType::Float:
+				return floatFormats[components - 1];
+			case QuantizationType::UNorm16:
+				return unorm16Formats[components - 1];
+			case QuantizationType::SNorm16:
+				return snorm16Formats[components - 1];
+			case QuantizationType::UNorm8:
+				return unorm8Formats[components - 1];
+			case QuantizationType::SNorm8:
+				return snorm8Formats[components - 1];
+			default:
+				return Format::Invalid;
+			}
+		}
+
+		template<typename T>
+		static void StoreValue(uint8_t* dst, T value)
+		{
+			std::memcpy(dst, &value, sizeof(T));
+		}
+
+		template<typename T>
+		static T LoadValue(const uint8_t* src)
+		{
+			T value;
+			std::memcpy(&value, src, sizeof(T));
+			return value;
+		}
+
+		static uint8_t ZigzagEncode8(uint8_t delta)
+		{
+			return static_cast<uint8_t>((delta << 1) ^ static_cast<uint8_t>(static_cast<int8_t>(delta) >> 7));
+		}
+
+		static uint32_t ZigzagEncode32(int32_t delta)
+		{
+			return (static_cast<uint32_t>(delta) << 1) ^ static_cast<uint32_t>(delta >> 31);
+		}
+
+		static int32_t ZigzagDecode32(uint32_t value)
+		{
+			return static_cast<int32_t>((value >> 1) ^ (0u - (value & 1)));
+		}
+
+		// Bits per value of an encoded byte lane, selected by the 2-bit mode in the block header
+		static constexpr std::array<uint32_t, 4> laneModeBits = { 0, 2, 4, 8 };
+
+		static size_t GetVertexBlockHeaderSize(size_t vertexSize)
+		{
+			return (vertexSize + 3) / 4;
+		}
+
+		// Encodes byte k of every vertex in a block, returns the lane's mode
+		static uint32_t EncodeVertexLane(uint8_t*& dst, const uint8_t* values)
+		{
+			uint8_t bits = 0;
+			for (size_t i = 0; i < vertexBlockSize; i++)
+				bits |= values[i];
+
+			uint32_t mode = (bits == 0) ? 0 : (bits < 4) ? 1 : (bits < 16) ? 2 : 3;
+			switch (mode)
+			{
+			case 1:
+				for (size_t i = 0; i < vertexBlockSize; i += 4)
+					*dst++ = static_cast<uint8_t>(values[i] | (values[i + 1] << 2) | (values[i + 2] << 4) | (values[i + 3] << 6));
+				break;
+			case 2:
+				for (size_t i = 0; i < vertexBlockSize; i += 2)
+					*dst++ = static_cast<uint8_t>(values[i] | (values[i + 1] << 4));
+				break;
+			case 3:
+				std::memcpy(dst, values, vertexBlockSize);
+				dst += vertexBlockSize;
+				break;
+			default:
+				break;
+			}
+			return mode;
+		}
+
+#ifdef BLAZE_SIMD_SSE2
+		// Decodes one byte lane of a block, prev is the lane's last byte of the previous block
+		static __m128i DecodeVertexLane(const uint8_t*& src, uint32_t mode, __m128i prev)
+		{
+			const __m128i mask2 = _mm_set1_epi8(0x03);
+			const __m128i mask4 = _mm_set1_epi8(0x0F);
+
+			__m128i values;
+			switch (mode)
+			{
+			case 1:
+			{
+				__m128i packed = _mm_cvtsi32_si128(LoadValue<int32_t>(src));
+				__m128i v0 = _mm_and_si128(packed, mask2);
+				__m128i v1 = _mm_and_si128(_mm_srli_epi16(packed, 2), mask2);
+				__m128i v2 = _mm_and_si128(_mm_srli_epi16(packed, 4), mask2);
+				__m128i v3 = _mm_and_si128(_mm_srli_epi16(packed, 6), mask2);
+				values = _mm_unpacklo_epi16(_mm_unpacklo_epi8(v0, v1), _mm_unpacklo_epi8(v2, v3));
+				src += 4;
+				break;
+			}
+			case 2:
+			{
+				__m128i packed = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src));
+				values = _mm_unpacklo_epi8(_mm_and_si128(packed, mask4), _mm_and_si128(_mm_srli_epi16(packed, 4), mask4));
+				src += 8;
+				break;
+			}
+			case 3:
+				values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+				src += vertexBlockSize;
+				break;
+			default:
+				values = _mm_setzero_si128();
+				break;
+			}
+
+			// Undo the zigzag, (v >> 1) ^ -(v & 1)
+			__m128i deltas = _mm_xor_si128(_mm_and_si128(_mm_srli_epi16(values, 1), _mm_set1_epi8(0x7F)),
+				_mm_sub_epi8(_mm_setzero_si128(), _mm_and_si128(values, _mm_set1_epi8(0x01))));
+
+			// Prefix sum of the deltas
+			deltas = _mm_add_epi8(deltas, _mm_slli_si128(deltas, 1));
+			deltas = _mm_add_epi8(deltas, _mm_slli_si128(deltas, 2));
+			deltas = _mm_add_epi8(deltas, _mm_slli_si128(deltas, 4));
+			deltas = _mm_add_epi8(deltas, _mm_slli_si128(deltas, 8));
+
+			// Broadcast the last byte of prev
+			__m128i base = _mm_unpackhi_epi8(prev, prev);
+			base = _mm_shufflehi_epi16(base, 0xFF);
+			base = _mm_unpackhi_epi64(base, base);
+
+			return _mm_add_epi8(deltas, base);
+		}
+
+		// Scatters 4 decoded lanes of a full block to 4 consecutive bytes of 16 vertices
+		static void StoreVertexLanes4(uint8_t* dst, size_t vertexSize, __m128i a, __m128i b, __m128i c, __m128i d)
+		{
+			__m128i ab0 = _mm_unpacklo_epi8(a, b);
+			__m128i ab1 = _mm_unpackhi_epi8(a, b);
+			__m128i cd0 = _mm_unpacklo_epi8(c, d);
+			__m128i cd1 = _mm_unpackhi_epi8(c, d);
+
+			const __m128i quads[4] = { _mm_unpacklo_epi16(ab0, cd0), _mm_unpackhi_epi16(ab0, cd0), _mm_unpacklo_epi16(ab1, cd1), _mm_unpackhi_epi16(ab1, cd1) };
+			for (const auto& quad : quads)
+			{
+				StoreValue(dst, _mm_cvtsi128_si32(quad));
+				StoreValue(dst + vertexSize, _mm_cvtsi128_si32(_mm_srli_si128(quad, 4)));
+				StoreValue(dst + vertexSize * 2, _mm_cvtsi128_si32(_mm_srli_si128(quad, 8)));
+				StoreValue(dst + vertexSize * 3, _mm_cvtsi128_si32(_mm_srli_si128(quad, 12)));
+				dst += vertexSize * 4;
+			}
+		}
+#else // ^^^ BLAZE_SIMD_SSE2 / !BLAZE_SIMD_SSE2 vvv
+		static void DecodeVertexLane(const uint8_t*& src, uint32_t mode, uint8_t prev, uint8_t* values)
+		{
+			switch (mode)
+			{
+			case 1:
+				for (size_t i = 0; i < vertexBlockSize; i += 4, src++)
+				{
+					values[i + 0] = *src & 0x03;
+					values[i + 1] = (*src >> 2) & 0x03;
+					values[i + 2] = (*src >> 4) & 0x03;
+					values[i + 3] = (*src >> 6) & 0x03;
+				}
+				break;
+			case 2:
+				for (size_t i = 0; i < vertexBlockSize; i += 2, src++)
+				{
+					values[i + 0] = *src & 0x0F;
+					values[i + 1] = *src >> 4;
+				}
+				break;
+			case 3:
+				std::memcpy(values, src, vertexBlockSize);
+				src += vertexBlockSize;
+				break;
+			default:
+				std::memset(values, 0, vertexBlockSize);
+				break;
+			}
+
+			for (size_t i = 0; i < vertexBlockSize; i++)
+			{
+				prev = static_cast<uint8_t>(prev + ((values[i] >> 1) ^ (0u - (values[i] & 1))));
+				values[i] = prev;
+			}
+		}
+#endif // ^^^ !BLAZE_SIMD_SSE2
+	}
+
+	Result QuantizeVertices(QuantizedVertices& quantized, const void* vertices, size_t vertexCount, size_t vertexStride,
+		const AttributeQuantization* attributes, size_t numAttributes)
+	{
+		if (!vertices || !attributes || (numAttributes == 0) || (numAttributes > Details::maxCompressedMeshAttributes) || (vertexCount > UINT32_MAX))
+			return Result::InvalidParam;
+
+		quantized.format.Reset();
+		quantized.transforms.assign(numAttributes, DequantizeTransform{});
+
+		std::vector<uint32_t> dstOffsets(numAttributes);
+		uint32_t vertexSize = 0;
+		for (size_t a = 0; a < numAttributes; a++)
+		{
+			const auto& attribute = attributes[a];
+			if ((attribute.components == 0) || (attribute.components > 4) || (attribute.offset + attribute.components * sizeof(float) > vertexStride))
+				return Result::InvalidParam;
+
+			Format format = Details::GetQuantizedFormat(attribute.type, attribute.components);
+			if (format == Format::Invalid)
+				return Result::InvalidParam;
+
+			dstOffsets[a] = vertexSize;
+			vertexSize += Details::GetFormatInfo(format).sizeInBytes;
+			quantized.format.PushAttribute(VertexAttribute{ format });
+		}
+
+		quantized.vertexSize = vertexSize;
+		quantized.vertexCount = static_cast<uint32_t>(vertexCount);
+		quantized.vertices.assign(vertexCount * vertexSize, 0);
+
+		auto getSource = [&](size_t vertex, const AttributeQuantization& attribute)
+		{
+			return reinterpret_cast<const float*>(reinterpret_cast<const uint8_t*>(vertices) + vertex * vertexStride + attribute.offset);
+		};
+
+		for (size_t a = 0; a < numAttributes; a++)
+		{
+			const auto& attribute = attributes[a];
+			auto& transform = quantized.transforms[a];
+
+			// Unsigned attributes are remapped from their bounds, so the precision follows the size of the mesh instead of the float range
+			float min[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+			float max[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+			if ((attribute.type == QuantizationType::UNorm16) || (attribute.type == QuantizationType::UNorm8))
+			{
+				for (uint32_t c = 0; c < attribute.components; c++)
+				{
+					min[c] = INFINITY;
+					max[c] = -INFINITY;
+				}
+				for (size_t v = 0; v < vertexCount; v++)
+				{
+					const float* src = getSource(v, attribute);
+					for (uint32_t c = 0; c < attribute.components; c++)
+					{
+						min[c] = std::min(min[c], src[c]);
+						max[c] = std::max(max[c], src[c]);
+					}
+				}
+			}
+
+			for (uint32_t c = 0; c < attribute.components; c++)
+			{
+				transform.scale[c] = (attribute.type == QuantizationType::UNorm16) || (attribute.type == QuantizationType::UNorm8) ? max[c] - min[c] : 1.0f;
+				transform.bias[c] = min[c];
+			}
+
+			uint8_t* dst = quantized.vertices.data() + dstOffsets[a];
+			for (size_t v = 0; v < vertexCount; v++, dst += vertexSize)
+			{
+				const float* src = getSource(v, attribute);
+				for (uint32_t c = 0; c < attribute.components; c++)
+				{
+					float unorm = transform.scale[c] > 0.0f ? (src[c] - min[c]) / transform.scale[c] : 0.0f;
+					float snorm = std::min(std::max(src[c], -1.0f), 1.0f);
+
+					switch (attribute.type)
+					{
+					case QuantizationType::Float:
+						Details::StoreValue(dst + c * sizeof(float), src[c]);
+						break;
+					case QuantizationType::UNorm16:
+						Details::StoreValue(dst + c * sizeof(uint16_t), static_cast<uint16_t>(std::lround(unorm * UINT16_MAX)));
+						break;
+					case QuantizationType::SNorm16:
+						Details::StoreValue(dst + c * sizeof(int16_t), static_cast<int16_t>(std::lround(snorm * INT16_MAX)));
+						break;
+					case QuantizationType::UNorm8:
+						dst[c] = static_cast<uint8_t>(std::lround(unorm * UINT8_MAX));
+						break;
+					case QuantizationType::SNorm8:
+						dst[c] = static_cast<uint8_t>(static_cast<int8_t>(std::lround(snorm * INT8_MAX)));
+						break;
+					default:
+						break;
+					}
+				}
+			}
+		}
+
+		return Result::Success;
+	}
+
+	size_t GetVertexBufferEncodeBound(size_t vertexCount, size_t vertexSize)
+	{
+		size_t numBlocks = (vertexCount + Details::vertexBlockSize - 1) / Details::vertexBlockSize;
+		return 1 + numBlocks * (Details::GetVertexBlockHeaderSize(vertexSize) + vertexSize * Details::vertexBlockSize);
+	}
+
+	size_t EncodeVertexBuffer(uint8_t* dst, size_t dstSize, const void* vertices, size_t vertexCount, size_t vertexSize)
+	{
+		if (!dst || (!vertices && vertexCount) || (vertexSize == 0) || (vertexSize > Details::maxEncodedVertexSize))
+			return 0;
+
+		const size_t headerSize = Details::GetVertexBlockHeaderSize(vertexSize);
+		const uint8_t* src = reinterpret_cast<const uint8_t*>(vertices);
+		uint8_t* const dstBegin = dst;
+		uint8_t* const dstEnd = dst + dstSize;
+
+		if (dstSize < 1)
+			return 0;
+		*dst++ = Details::vertexStreamTag;
+
+		std::array<uint8_t, Details::maxEncodedVertexSize> prev = {};
+		std::array<uint8_t, Details::vertexBlockSize> values;
+
+		for (size_t first = 0; first < vertexCount; first += Details::vertexBlockSize)
+		{
+			const size_t count = std::min(Details::vertexBlockSize, vertexCount - first);
+			if (static_cast<size_t>(dstEnd - dst) < headerSize + vertexSize * Details::vertexBlockSize)
+				return 0;
+
+			uint8_t* header = dst;
+			std::memset(header, 0, headerSize);
+			dst += headerSize;
+
+			for (size_t k = 0; k < vertexSize; k++)
+			{
+				// Missing vertices in the last block repeat the last vertex, which encodes to zeros
+				uint8_t last = prev[k];
+				for (size_t i = 0; i < Details::vertexBlockSize; i++)
+				{
+					uint8_t value = src[(first + std::min(i, count - 1)) * vertexSize + k];
+					values[i] = Details::ZigzagEncode8(static_cast<uint8_t>(value - last));
+					last = value;
+				}
+				prev[k] = last;
+
+				uint32_t mode = Details::EncodeVertexLane(dst, values.data());
+				header[k / 4] |= static_cast<uint8_t>(mode << ((k % 4) * 2));
+			}
+		}
+
+		return static_cast<size_t>(dst - dstBegin);
+	}
+
+	Result DecodeVertexBuffer(void* dst, size_t vertexCount, size_t vertexSize, const uint8_t* src, size_t srcSize)
+	{
+		if ((!dst && vertexCount) || !src || (vertexSize == 0) || (vertexSize > Details::maxEncodedVertexSize))
+			return Result::InvalidParam;
+		if ((srcSize < 1) || (src[0] != Details::vertexStreamTag))
+			return Result::InvalidParam;
+
+		const size_t headerSize = Details::GetVertexBlockHeaderSize(vertexSize);
+		const uint8_t* const srcEnd = src + srcSize;
+		uint8_t* out = reinterpret_cast<uint8_t*>(dst);
+		src++;
+
+		// Lanes are decoded to a transposed block first, then scattered to the vertices
+		alignas(16) std::array<uint8_t, Details::maxEncodedVertexSize * Details::vertexBlockSize> block = {};
+
+		for (size_t first = 0; first < vertexCount; first += Details::vertexBlockSize)
+		{
+			const size_t count = std::min(Details::vertexBlockSize, vertexCount - first);
+			if (static_cast<size_t>(srcEnd - src) < headerSize)
+				return Result::InvalidParam;
+
+			const uint8_t* header = src;
+			src += headerSize;
+
+			// Size of the block's lanes, checked up front so the lanes can be decoded without bounds checks
+			size_t blockSize = 0;
+			for (size_t k = 0; k < vertexSize; k++)
+				blockSize += Details::laneModeBits[(header[k / 4] >> ((k % 4) * 2)) & 3] * 2;
+			if (static_cast<size_t>(srcEnd - src) < blockSize)
+				return Result::InvalidParam;
+
+			for (size_t k = 0; k < vertexSize; k++)
+			{
+				uint32_t mode = (header[k / 4] >> ((k % 4) * 2)) & 3;
+				uint8_t* lane = &block[k * Details::vertexBlockSize];
+#ifdef BLAZE_SIMD_SSE2
+				__m128i prev = _mm_load_si128(reinterpret_cast<const __m128i*>(lane));
+				_mm_store_si128(reinterpret_cast<__m128i*>(lane), Details::DecodeVertexLane(src, mode, prev));
+#else // ^^^ BLAZE_SIMD_SSE2 / !BLAZE_SIMD_SSE2 vvv
+				Details::DecodeVertexLane(src, mode, lane[Details::vertexBlockSize - 1], lane);
+#endif // ^^^ !BLAZE_SIMD_SSE2
+			}
+
+			uint8_t* blockOut = out + first * vertexSize;
+			size_t k = 0;
+#ifdef BLAZE_SIMD_SSE2
+			if (count == Details::vertexBlockSize)
+			{
+				for (; k + 4 <= vertexSize; k += 4)
+				{
+					const __m128i* lanes = reinterpret_cast<const __m128i*>(&block[k * Details::vertexBlockSize]);
+					Details::StoreVertexLanes4(blockOut + k, vertexSize, _mm_load_si128(lanes), _mm_load_si128(lanes + 1), _mm_load_si128(lanes + 2), _mm_load_si128(lanes + 3));
+				}
+			}
+#endif // BLAZE_SIMD_SSE2
+			for (; k < vertexSize; k++)
+			{
+				const uint8_t* lane = &block[k * Details::vertexBlockSize];
+				for (size_t i = 0; i < count; i++)
+					blockOut[i * vertexSize + k] = lane[i];
+			}
+		}
+
+		return Result::Success;
+	}
+
+	size_t GetIndexBufferEncodeBound(size_t indexCount)
+	{
+		// 5 bytes per index at most
+		return 1 + indexCount * 5;
+	}
+
+	size_t EncodeIndexBuffer(uint8_t* dst, size_t dstSize, const uint32_t* indices, size_t indexCount)
+	{
+		if (!dst || (!indices && indexCount))
+			return 0;
+
+		uint8_t* const dstBegin = dst;
+		uint8_t* const dstEnd = dst + dstSize;
+
+		if (dstSize < 1)
+			return 0;
+		*dst++ = Details::indexStreamTag;
+
+		// Deltas are taken from the next unseen vertex, after OptimizeVertexFetch new vertices always encode to 0
+		// and reused vertices are close behind, so most indices fit in a single byte
+		uint32_t next = 0;
+		for (size_t i = 0; i < indexCount; i++)
+		{
+			uint32_t value = Details::ZigzagEncode32(static_cast<int32_t>(indices[i] - next));
+			next = std::max(next, indices[i] + 1);
+
+			do
+			{
+				if (dst == dstEnd)
+					return 0;
+				*dst++ = static_cast<uint8_t>((value & 0x7F) | (value >= 0x80 ? 0x80 : 0));
+				value >>= 7;
+			} while (value);
+		}
+
+		return static_cast<size_t>(dst - dstBegin);
+	}
+
+	Result DecodeIndexBuffer(void* dst, Format indexFormat, size_t indexCount, const uint8_t* src, size_t srcSize)
+	{
+		if ((!dst && indexCount) || !src || ((indexFormat != Format::R16_UInt) && (indexFormat != Format::R32_UInt)))
+			return Result::InvalidParam;
+		if ((srcSize < 1) || (src[0] != Details::indexStreamTag))
+			return Result::InvalidParam;
+
+		const uint8_t* const srcEnd = src + srcSize;
+		src++;
+
+		auto decode = [&](auto* out) -> Result
+		{
+			using IndexType = std::remove_pointer_t<decltype(out)>;
+
+			uint32_t next = 0;
+			for (size_t i = 0; i < indexCount; i++)
+			{
+				// Every index is at least a byte, the fast path avoids the loop for the common single byte case
+				if (src == srcEnd)
+					return Result::InvalidParam;
+
+				uint32_t value = *src++;
+				if (value & 0x80)
+				{
+					value &= 0x7F;
+					for (uint32_t shift = 7; ; shift += 7)
+					{
+						if ((src == srcEnd) || (shift > 28))
+							return Result::InvalidParam;
+						uint8_t byte = *src++;
+						value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+						if (!(byte & 0x80))
+							break;
+					}
+				}
+
+				uint32_t index = next + static_cast<uint32_t>(Details::ZigzagDecode32(value));
+				next = std::max(next, index + 1);
+				out[i] = static_cast<IndexType>(index);
+			}
+			return Result::Success;
+		};
+
+		if (indexFormat == Format::R16_UInt)
+			return decode(reinterpret_cast<uint16_t*>(dst));
+		return decode(reinterpret_cast<uint32_t*>(dst));
+	}
+
+	Result CompressMesh(std::vector<uint8_t>& compressed, const QuantizedVertices& vertices, const uint32_t* indices, size_t indexCount)
+	{
+		if (!indices || (vertices.vertexSize == 0) || (vertices.vertices.size() != static_cast<size_t>(vertices.vertexCount) * vertices.vertexSize) ||
+			(vertices.transforms.size() != vertices.format.GetAttributes().size()) || (indexCount > UINT32_MAX))
+			return Result::InvalidParam;
+
+		for (size_t i = 0; i < indexCount; i++)
+		{
+			if (indices[i] >= vertices.vertexCount)
+				return Result::InvalidParam;
+		}
+
+		const auto& attributes = vertices.format.GetAttributes();
+		const size_t tableSize = sizeof(Details::CompressedMeshHeader) + attributes.size() * sizeof(Details::CompressedMeshAttribute);
+
+		compressed.resize(tableSize + GetVertexBufferEncodeBound(vertices.vertexCount, vertices.vertexSize) + GetIndexBufferEncodeBound(indexCount));
+
+		size_t vertexDataSize = EncodeVertexBuffer(compressed.data() + tableSize, compressed.size() - tableSize, vertices.vertices.data(), vertices.vertexCount, vertices.vertexSize);
+		if (vertexDataSize == 0)
+			return Result::InvalidParam;
+
+		size_t indexDataOffset = tableSize + vertexDataSize;
+		size_t indexDataSize = EncodeIndexBuffer(compressed.data() + indexDataOffset, compressed.size() - indexDataOffset, indices, indexCount);
+		if (indexDataSize == 0)
+			return Result::InvalidParam;
+
+		compressed.resize(indexDataOffset + indexDataSize);
+
+		Details::CompressedMeshHeader header;
+		header.magic = Details::compressedMeshMagic;
+		header.version = Details::compressedMeshVersion;
+		header.vertexCount = vertices.vertexCount;
+		header.vertexSize = vertices.vertexSize;
+		header.indexCount = static_cast<uint32_t>(indexCount);
+		header.indexFormat = static_cast<uint32_t>(SelectIndexFormat(vertices.vertexCount));
+		header.numAttributes = static_cast<uint32_t>(attributes.size());
+		header.vertexDataSize = static_cast<uint32_t>(vertexDataSize);
+		header.indexDataSize = static_cast<uint32_t>(indexDataSize);
+		std::memcpy(compressed.data(), &header, sizeof(header));
+
+		for (size_t a = 0; a < attributes.size(); a++)
+		{
+			Details::CompressedMeshAttribute attribute{ static_cast<uint32_t>(attributes[a].format), vertices.transforms[a] };
+			std::memcpy(compressed.data() + sizeof(header) + a * sizeof(attribute), &attribute, sizeof(attribute));
+		}
+
+		return Result::Success;
+	}
+
+	Result GetCompressedMeshInfo(const void* compressed, size_t size, CompressedMeshInfo& info)
+	{
+		if (!compressed || (size < sizeof(Details::CompressedMeshHeader)))
+			return Result::InvalidParam;
+
+		const uint8_t* data = reinterpret_cast<const uint8_t*>(compressed);
+		auto header = Details::LoadValue<Details::CompressedMeshHeader>(data);
+		if ((header.magic != Details::compressedMeshMagic) || (header.version != Details::compressedMeshVersion) || (header.numAttributes > Details::maxCompressedMeshAttributes))
+			return Result::InvalidParam;
+
+		const size_t tableSize = sizeof(header) + header.numAttributes * sizeof(Details::CompressedMeshAttribute);
+		if (size < tableSize + static_cast<size_t>(header.vertexDataSize) + header.indexDataSize)
+			return Result::InvalidParam;
+
+		info.format.Reset();
+		info.transforms.resize(header.numAttributes);
+		for (uint32_t a = 0; a < header.numAttributes; a++)
+		{
+			auto attribute = Details::LoadValue<Details::CompressedMeshAttribute>(data + sizeof(header) + a * sizeof(Details::CompressedMeshAttribute));
+			if (info.format.PushAttribute(VertexAttribute{ static_cast<Format>(attribute.format) }) != Result::Success)
+				return Result::InvalidParam;
+			info.transforms[a] = attribute.transform;
+		}
+
+		info.vertexSize = header.vertexSize;
+		info.vertexCount = header.vertexCount;
+		info.indexCount = header.indexCount;
+		info.indexFormat = static_cast<Format>(header.indexFormat);
+		info.vertexBufferSize = static_cast<size_t>(header.vertexCount) * header.vertexSize;
+		info.indexBufferSize = static_cast<size_t>(header.indexCount) * Details::GetFormatInfo(info.indexFormat).sizeInBytes;
+
+		if (info.format.GetStride() != info.vertexSize)
+			return Result::InvalidParam;
+
+		return Result::Success;
+	}
+
+	Result DecompressMesh(const void* compressed, size_t size, const Ref<Buffer>& vertexBuffer, const Ref<Buffer>& indexBuffer)
+	{
+		if (!vertexBuffer || !indexBuffer)
+			return Result::InvalidParam;
+
+		CompressedMeshInfo info;
+		Result res = GetCompressedMeshInfo(compressed, size, info);
+		if (res != Result::Success)
+			return res;
+
+		const uint8_t* data = reinterpret_cast<const uint8_t*>(compressed);
+		auto header = Details::LoadValue<Details::CompressedMeshHeader>(data);
+		const uint8_t* vertexData = data + sizeof(header) + header.numAttributes * sizeof(Details::CompressedMeshAttribute);
+		const uint8_t* indexData = vertexData + header.vertexDataSize;
+
+		// Allocate the storage, then decode straight into the mapped memory so the decoded mesh never needs a staging copy
+		auto decodeToBuffer = [](const Ref<Buffer>& buffer, size_t bufferSize, auto decode) -> Result
+		{
+			Result res = buffer->Write(nullptr, bufferSize);
+			if (res != Result::Success)
+				return res;
+
+			void* ptr = nullptr;
+			res = buffer->MapMemory(bufferSize, BufferAccess::Write, ptr);
+			if (res != Result::Success)
+				return res;
+
+			Result decodeRes = decode(ptr);
+			res = buffer->UnmapMemory();
+			return (decodeRes != Result::Success) ? decodeRes : res;
+		};
+
+		res = decodeToBuffer(vertexBuffer, info.vertexBufferSize, [&](void* ptr) { return DecodeVertexBuffer(ptr, info.vertexCount, info.vertexSize, vertexData, header.vertexDataSize); });
+		if (res != Result::Success)
+			return res;
+
+		return decodeToBuffer(indexBuffer, info.indexBufferSize, [&](void* ptr) { return DecodeIndexBuffer(ptr, info.indexFormat, info.indexCount, indexData, header.indexDataSize); });
+	}
+}
@@ -0,0 +1,461 @@
+#include <pch.h>
+#include <Blaze/Mesh/MeshOptimizer.h>
+
+#include <cmath>
+#include <cstring>
+
+namespace Blaze
+{
+	namespace Details
+	{
+		// Size of the LRU cache simulated by the vertex cache optimizer
+		constexpr uint32_t optimizerCacheSize = 32;
+		// Vertices with more live triangles than this all get the same valence score
+		constexpr uint32_t maxValence = 32;
+
+		// Forsyth's vertex scoring tables, precomputed since the scores only depend on the cache position and valence
+		struct VertexScoreTables
+		{
+			VertexScoreTables()
+			{
+				for (uint32_t i = 0; i < optimizerCacheSize; i++)
+				{
+					// The last triangle's vertices get a fixed score so the optimizer doesn't prefer reusing them over other cached vertices
+					if (i < 3)
+						cacheScores[i] = 0.75f;
+					else
+						cacheScores[i] = std::pow(1.0f - static_cast<float>(i - 3) / static_cast<float>(optimizerCacheSize - 3), 1.5f);
+				}
+
+				// Low valence vertices get boosted so the optimizer finishes them off instead of leaving lone triangles
+				valenceScores[0] = 0.0f;
+				for (uint32_t i = 1; i <= maxValence; i++)
+					valenceScores[i] = 2.0f / std::sqrt(static_cast<float>(i));
+			}
+
+			inline float GetScore(int32_t cachePosition, uint32_t liveTriangles) const
+			{
+				// Vertices without any triangles left won't be used again
+				if (!liveTriangles)
+					return -1.0f;
+
+				float score = (cachePosition >= 0) ? cacheScores[cachePosition] : 0.0f;
+				return score + valenceScores[std::min(liveTriangles, maxValence)];
+			}
+
+			std::array<float, optimizerCacheSize> cacheScores;
+			std::array<float, maxValence + 1> valenceScores;
+		};
+
+		static const VertexScoreTables vertexScoreTables;
+
+		// Vertex to triangle adjacency, the triangles of vertex v are triangles[offsets[v]] to triangles[offsets[v] + counts[v]]
+		struct TriangleAdjacency
+		{
+			TriangleAdjacency(const uint32_t* indices, size_t indexCount, size_t vertexCount)
+				:counts(vertexCount, 0), offsets(vertexCount, 0), triangles(indexCount)
+			{
+				for (size_t i = 0; i < indexCount; i++)
+					counts[indices[i]]++;
+
+				uint32_t offset = 0;
+				for (size_t v = 0; v < vertexCount; v++)
+				{
+					offsets[v] = offset;
+					offset += counts[v];
+				}
+
+				std::vector<uint32_t> fill(offsets);
+				for (size_t i = 0; i < indexCount; i++)
+					triangles[fill[indices[i]]++] = static_cast<uint32_t>(i / 3);
+			}
+
+			std::vector<uint32_t> counts;
+			std::vector<uint32_t> offsets;
+			std::vector<uint32_t> triangles;
+		};
+
+		static bool ValidateIndices(const uint32_t* indices, size_t indexCount, size_t vertexCount)
+		{
+			if (!indices || (indexCount % 3))
+				return false;
+
+			for (size_t i = 0; i < indexCount; i++)
+			{
+				if (indices[i] >= vertexCount)
+					return false;
+			}
+			return true;
+		}
+	}
+
+	VertexCacheStats AnalyzeVertexCache(const uint32_t* indices, size_t indexCount, size_t vertexCount, uint32_t cacheSize)
+	{
+		VertexCacheStats stats;
+		if (!indices || !indexCount || !vertexCount || !cacheSize)
+			return stats;
+
+		// Timestamp based FIFO, a vertex is in the cache if it was inserted less than cacheSize misses ago
+		std::vector<uint32_t> insertTimes(vertexCount, 0);
+		uint32_t time = cacheSize + 1;
+
+		for (size_t i = 0; i < indexCount; i++)
+		{
+			uint32_t index = indices[i];
+			if (index >= vertexCount)
+				continue;
+
+			if (time - insertTimes[index] > cacheSize)
+			{
+				insertTimes[index] = time++;
+				stats.numTransformedVertices++;
+			}
+		}
+
+		stats.acmr = static_cast<float>(stats.numTransformedVertices) / static_cast<float>(indexCount / 3);
+		stats.atvr = static_cast<float>(stats.numTransformedVertices) / static_cast<float>(vertexCount);
+		return stats;
+	}
+
+	Result OptimizeVertexCache(uint32_t* dstIndices, const uint32_t* indices, size_t indexCount, size_t vertexCount)
+	{
+		using namespace Details;
+
+		if (!dstIndices || !ValidateIndices(indices, indexCount, vertexCount))
+			return Result::InvalidParam;
+
+		const size_t triangleCount = indexCount / 3;
+		if (!triangleCount)
+			return Result::Success;
+
+		// Copy the input so dstIndices can be the same buffer
+		std::vector<uint32_t> input(indices, indices + indexCount);
+		TriangleAdjacency adjacency(input.data(), indexCount, vertexCount);
+
+		std::vector<uint32_t> liveTriangles(adjacency.counts);
+		std::vector<int32_t> cachePositions(vertexCount, -1);
+		std::vector<float> vertexScores(vertexCount);
+		for (size_t v = 0; v < vertexCount; v++)
+			vertexScores[v] = vertexScoreTables.GetScore(-1, liveTriangles[v]);
+
+		std::vector<float> triangleScores(triangleCount);
+		std::vector<bool> isEmitted(triangleCount, false);
+		for (size_t t = 0; t < triangleCount; t++)
+			triangleScores[t] = vertexScores[input[t * 3 + 0]] + vertexScores[input[t * 3 + 1]] + vertexScores[input[t * 3 + 2]];
+
+		// Start with the best triangle overall
+		uint32_t bestTriangle = static_cast<uint32_t>(std::max_element(triangleScores.begin(), triangleScores.end()) - triangleScores.begin());
+
+		// Holds 3 extra entries, the vertices pushed out by the newest triangle
+		std::array<uint32_t, optimizerCacheSize + 3> cache;
+		std::array<uint32_t, optimizerCacheSize + 3> newCache;
+		size_t cacheCount = 0;
+
+		size_t scanCursor = 0;
+		size_t outputTriangle = 0;
+
+		while (true)
+		{
+			// Fall back to the next triangle in the input when no cached vertex has triangles left
+			if (bestTriangle == UINT32_MAX)
+			{
+				while ((scanCursor < triangleCount) && isEmitted[scanCursor])
+					scanCursor++;
+				if (scanCursor == triangleCount)
+					break;
+				bestTriangle = static_cast<uint32_t>(scanCursor);
+			}
+
+			const uint32_t* triangle = &input[bestTriangle * 3];
+			std::copy(triangle, triangle + 3, &dstIndices[outputTriangle * 3]);
+			outputTriangle++;
+			isEmitted[bestTriangle] = true;
+
+			// Remove the triangle from its vertices' live triangle lists
+			for (uint32_t k = 0; k < 3; k++)
+			{
+				uint32_t v = triangle[k];
+				uint32_t* begin = &adjacency.triangles[adjacency.offsets[v]];
+				uint32_t* end = begin + liveTriangles[v];
+				uint32_t* it = std::find(begin, end, bestTriangle);
+				std::swap(*it, *(end - 1));
+				liveTriangles[v]--;
+			}
+
+			// Move the triangle's vertices to the front of the cache
+			size_t newCacheCount = 0;
+			for (uint32_t k = 0; k < 3; k++)
+			{
+				// Degenerate triangles would add the same vertex twice
+				if (std::find(newCache.begin(), newCache.begin() + newCacheCount, triangle[k]) == newCache.begin() + newCacheCount)
+					newCache[newCacheCount++] = triangle[k];
+			}
+			for (size_t i = 0; i < cacheCount; i++)
+			{
+				uint32_t v = cache[i];
+				if ((v != triangle[0]) && (v != triangle[1]) && (v != triangle[2]))
+					newCache[newCacheCount++] = v;
+			}
+			std::swap(cache, newCache);
+			cacheCount = std::min<size_t>(newCacheCount, optimizerCacheSize + 3);
+
+			// Rescore the cached vertices and their triangles, the best of those gets emitted next
+			for (size_t i = 0; i < cacheCount; i++)
+			{
+				uint32_t v = cache[i];
+				cachePositions[v] = (i < optimizerCacheSize) ? static_cast<int32_t>(i) : -1;
+				vertexScores[v] = vertexScoreTables.GetScore(cachePositions[v], liveTriangles[v]);
+			}
+
+			bestTriangle = UINT32_MAX;
+			float bestScore = 0.0f;
+			for (size_t i = 0; i < cacheCount; i++)
+			{
+				uint32_t v = cache[i];
+				const uint32_t* vertexTriangles = &adjacency.triangles[adjacency.offsets[v]];
+				for (uint32_t j = 0; j < liveTriangles[v]; j++)
+				{
+					uint32_t t = vertexTriangles[j];
+					float score = vertexScores[input[t * 3 + 0]] + vertexScores[input[t * 3 + 1]] + vertexScores[input[t * 3 + 2]];
+					triangleScores[t] = score;
+					if (score > bestScore)
+					{
+						bestScore = score;
+						bestTriangle = t;
+					}
+				}
+			}
+
+			// Vertices that fell out of the cache are only kept for one step
+			cacheCount = std::min<size_t>(cacheCount, optimizerCacheSize);
+		}
+
+		return Result::Success;
+	}
+
+	Result OptimizeOverdraw(uint32_t* dstIndices, const uint32_t* indices, size_t indexCount, const float* positions, size_t vertexCount, size_t positionStride, float threshold)
+	{
+		if (!dstIndices || (dstIndices == indices) || !positions || (positionStride < sizeof(float) * 3) || !Details::ValidateIndices(indices, indexCount, vertexCount))
+			return Result::InvalidParam;
+
+		const size_t triangleCount = indexCount / 3;
+		if (!triangleCount)
+			return Result::Success;
+
+		auto getPosition = [&](uint32_t index)
+		{
+			return reinterpret_cast<const float*>(reinterpret_cast<const uint8_t*>(positions) + index * positionStride);
+		};
+
+		// Split into clusters where the cache would have to start over (every vertex of a triangle misses)
+		// Reordering whole clusters keeps most of the cache locality
+		constexpr uint32_t cacheSize = 16;
+		constexpr size_t minClusterSize = 8;
+
+		std::vector<size_t> clusterStarts;
+		{
+			std::vector<uint32_t> insertTimes(vertexCount, 0);
+			uint32_t time = cacheSize + 1;
+			size_t lastStart = 0;
+
+			for (size_t t = 0; t < triangleCount; t++)
+			{
+				uint32_t misses = 0;
+				for (uint32_t k = 0; k < 3; k++)
+				{
+					uint32_t index = indices[t * 3 + k];
+					if (time - insertTimes[index] > cacheSize)
+					{
+						insertTimes[index] = time++;
+						misses++;
+					}
+				}
+
+				if ((t == 0) || ((misses == 3) && (t - lastStart >= minClusterSize)))
+				{
+					clusterStarts.push_back(t);
+					lastStart = t;
+				}
+			}
+		}
+
+		// Mesh centroid, weighted by triangle area
+		float meshCentroid[3] = { 0.0f, 0.0f, 0.0f };
+		float meshArea = 0.0f;
+
+		struct Cluster
+		{
+			size_t start, count;
+			float centroid[3];
+			float normal[3];
+			float sortKey;
+		};
+		std::vector<Cluster> clusters(clusterStarts.size());
+
+		for (size_t c = 0; c < clusters.size(); c++)
+		{
+			auto& cluster = clusters[c];
+			cluster.start = clusterStarts[c];
+			cluster.count = ((c + 1 < clusterStarts.size()) ? clusterStarts[c + 1] : triangleCount) - cluster.start;
+
+			float area = 0.0f;
+			float centroid[3] = { 0.0f, 0.0f, 0.0f };
+			float normal[3] = { 0.0f, 0.0f, 0.0f };
+
+			for (size_t t = cluster.start; t < cluster.start + cluster.count; t++)
+			{
+				const float* p0 = getPosition(indices[t * 3 + 0]);
+				const float* p1 = getPosition(indices[t * 3 + 1]);
+				const float* p2 = getPosition(indices[t * 3 + 2]);
+
+				float e1[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+				float e2[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+				// Length of the cross product is twice the area, so the sum is an area weighted normal
+				float n[3] = { e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0] };
+				float triangleArea = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+
+				for (int i = 0; i < 3; i++)
+				{
+					centroid[i] += (p0[i] + p1[i] + p2[i]) * (triangleArea / 3.0f);
+					normal[i] += n[i];
+				}
+				area += triangleArea;
+			}
+
+			float invArea = (area > 0.0f) ? 1.0f / area : 0.0f;
+			float normalLength = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+			float invNormalLength = (normalLength > 0.0f) ? 1.0f / normalLength : 0.0f;
+
+			for (int i = 0; i < 3; i++)
+			{
+				cluster.centroid[i] = centroid[i] * invArea;
+				cluster.normal[i] = normal[i] * invNormalLength;
+				meshCentroid[i] += centroid[i];
+			}
+			meshArea += area;
+		}
+
+		for (int i = 0; i < 3; i++)
+			meshCentroid[i] = (meshArea > 0.0f) ? meshCentroid[i] / meshArea : 0.0f;
+
+		// Clusters facing away from the center are likely to occlude the rest, so they get drawn first
+		for (auto& cluster : clusters)
+		{
+			cluster.sortKey =
+				(cluster.centroid[0] - meshCentroid[0]) * cluster.normal[0] +
+				(cluster.centroid[1] - meshCentroid[1]) * cluster.normal[1] +
+				(cluster.centroid[2] - meshCentroid[2]) * cluster.normal[2];
+		}
+		std::stable_sort(clusters.begin(), clusters.end(), [](const Cluster& lhs, const Cluster& rhs) { return lhs.sortKey > rhs.sortKey; });
+
+		size_t offset = 0;
+		for (const auto& cluster : clusters)
+		{
+			std::copy(&indices[cluster.start * 3], &indices[(cluster.start + cluster.count) * 3], &dstIndices[offset]);
+			offset += cluster.count * 3;
+		}
+
+		// Keep the input order if the cache efficiency suffers too much
+		float inputACMR = AnalyzeVertexCache(indices, indexCount, vertexCount).acmr;
+		float outputACMR = AnalyzeVertexCache(dstIndices, indexCount, vertexCount).acmr;
+		if (outputACMR > inputACMR * threshold)
+			std::copy(indices, indices + indexCount, dstIndices);
+
+		return Result::Success;
+	}
+
+	Result OptimizeVertexFetch(void* dstVertices, uint32_t* indices, size_t indexCount, const void* vertices, size_t vertexCount, size_t vertexSize, size_t& uniqueVertexCount)
+	{
+		if (!dstVertices || !vertices || (dstVertices == vertices) || !vertexSize || !Details::ValidateIndices(indices, indexCount, vertexCount))
+			return Result::InvalidParam;
+
+		auto src = static_cast<const uint8_t*>(vertices);
+		auto dst = static_cast<uint8_t*>(dstVertices);
+
+		std::vector<uint32_t> remap(vertexCount, UINT32_MAX);
+		uint32_t nextVertex = 0;
+
+		for (size_t i = 0; i < indexCount; i++)
+		{
+			uint32_t& newIndex = remap[indices[i]];
+			if (newIndex == UINT32_MAX)
+			{
+				newIndex = nextVertex++;
+				std::memcpy(dst + newIndex * vertexSize, src + indices[i] * vertexSize, vertexSize);
+			}
+			indices[i] = newIndex;
+		}
+
+		uniqueVertexCount = nextVertex;
+		return Result::Success;
+	}
+
+	Format SelectIndexFormat(size_t vertexCount)
+	{
+		return (vertexCount <= (static_cast<size_t>(UINT16_MAX) + 1)) ? Format::R16_UInt : Format::R32_UInt;
+	}
+
+	Result PackIndices(void* dst, Format indexFormat, const uint32_t* indices, size_t indexCount)
+	{
+		if (!dst || !indices)
+			return Result::InvalidParam;
+
+		switch (indexFormat)
+		{
+		case Format::R16_UInt:
+		{
+			auto dst16 = static_cast<uint16_t*>(dst);
+			for (size_t i = 0; i < indexCount; i++)
+			{
+				if (indices[i] > UINT16_MAX)
+					return Result::InvalidParam;
+				dst16[i] = static_cast<uint16_t>(indices[i]);
+			}
+			return Result::Success;
+		}
+		case Format::R32_UInt:
+			std::memcpy(dst, indices, indexCount * sizeof(uint32_t));
+			return Result::Success;
+		default:
+			return Result::InvalidParam;
+		}
+	}
+
+	Result OptimizeMesh(MeshData& mesh, MeshOptimizeStats* stats)
+	{
+		Result res;
+
+		if (!mesh.vertexSize || (mesh.vertices.size() % mesh.vertexSize) || (mesh.positionOffset + sizeof(float) * 3 > mesh.vertexSize))
+			return Result::InvalidParam;
+
+		const size_t vertexCount = mesh.vertices.size() / mesh.vertexSize;
+		const size_t indexCount = mesh.indices.size();
+
+		if (stats)
+			stats->before = AnalyzeVertexCache(mesh.indices.data(), indexCount, vertexCount);
+
+		if ((res = OptimizeVertexCache(mesh.indices.data(), mesh.indices.data(), indexCount, vertexCount)) != Result::Success)
+			return res;
+
+		std::vector<uint32_t> reordered(indexCount);
+		const float* positions = reinterpret_cast<const float*>(mesh.vertices.data() + mesh.positionOffset);
+		if ((res = OptimizeOverdraw(reordered.data(), mesh.indices.data(), indexCount, positions, vertexCount, mesh.vertexSize)) != Result::Success)
+			return res;
+		mesh.indices.swap(reordered);
+
+		std::vector<uint8_t> vertices(mesh.vertices.size());
+		size_t uniqueVertexCount;
+		if ((res = OptimizeVertexFetch(vertices.data(), mesh.indices.data(), indexCount, mesh.vertices.data(), vertexCount, mesh.vertexSize, uniqueVertexCount)) != Result::Success)
+			return res;
+		vertices.resize(uniqueVertexCount * mesh.vertexSize);
+		mesh.vertices.swap(vertices);
+
+		if (stats)
+		{
+			stats->after = AnalyzeVertexCache(mesh.indices.data(), indexCount, uniqueVertexCount);
+			stats->indexFormat = SelectIndexFormat(uniqueVertexCount);
+		}
+
+		return Result::Success;
+	}
+}
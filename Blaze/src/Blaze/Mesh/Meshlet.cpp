@@ -0,0 +1,309 @@
+#include <pch.h>
+#include <Blaze/Mesh/Meshlet.h>
+#include <Blaze/Mesh/MeshOptimizer.h>
+#include <Blaze/Math/Bounds.h>
+
+#include <cmath>
+#include <cstring>
+
+#ifdef BLAZE_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace Blaze
+{
+	namespace Details
+	{
+		// Floats per group of 4 meshlets in MeshletData::cullData
+		constexpr size_t meshletCullGroupSize = 8 * 4;
+
+		static void ComputeMeshletBounds(MeshletBounds& bounds, const Meshlet& meshlet, const MeshletData& meshletData, const float* positions, size_t positionStride)
+		{
+			auto getPosition = [&](uint32_t localIndex)
+			{
+				uint32_t index = meshletData.vertices[meshlet.vertexOffset + localIndex];
+				return reinterpret_cast<const float*>(reinterpret_cast<const uint8_t*>(positions) + index * positionStride);
+			};
+
+			// Bounding sphere centered on the bounding box
+			float min[3] = { INFINITY, INFINITY, INFINITY };
+			float max[3] = { -INFINITY, -INFINITY, -INFINITY };
+			for (uint32_t v = 0; v < meshlet.vertexCount; v++)
+			{
+				const float* p = getPosition(v);
+				for (int i = 0; i < 3; i++)
+				{
+					min[i] = std::min(min[i], p[i]);
+					max[i] = std::max(max[i], p[i]);
+				}
+			}
+
+			float radiusSquared = 0.0f;
+			for (int i = 0; i < 3; i++)
+				bounds.center[i] = (min[i] + max[i]) * 0.5f;
+			for (uint32_t v = 0; v < meshlet.vertexCount; v++)
+			{
+				const float* p = getPosition(v);
+				float d[3] = { p[0] - bounds.center[0], p[1] - bounds.center[1], p[2] - bounds.center[2] };
+				radiusSquared = std::max(radiusSquared, d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+			}
+			bounds.radius = std::sqrt(radiusSquared);
+
+			// Normal cone, the axis is the average normal and the cutoff comes from the normal furthest from it
+			std::vector<std::array<float, 3>> normals;
+			normals.reserve(meshlet.triangleCount);
+			float axis[3] = { 0.0f, 0.0f, 0.0f };
+
+			for (uint32_t t = 0; t < meshlet.triangleCount; t++)
+			{
+				const uint8_t* triangle = &meshletData.triangles[meshlet.triangleOffset + t * 3];
+				const float* p0 = getPosition(triangle[0]);
+				const float* p1 = getPosition(triangle[1]);
+				const float* p2 = getPosition(triangle[2]);
+
+				float e1[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+				float e2[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+				float n[3] = { e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0] };
+				float length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+
+				// Degenerate triangles can't face any direction
+				if (length <= 0.0f)
+					continue;
+
+				normals.push_back({ n[0] / length, n[1] / length, n[2] / length });
+				for (int i = 0; i < 3; i++)
+					axis[i] += normals.back()[i];
+			}
+
+			float axisLength = std::sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+			float minDot = 1.0f;
+			if (axisLength > 0.0f)
+			{
+				for (int i = 0; i < 3; i++)
+					axis[i] /= axisLength;
+				for (const auto& n : normals)
+					minDot = std::min(minDot, n[0] * axis[0] + n[1] * axis[1] + n[2] * axis[2]);
+			}
+			else
+				minDot = -1.0f;
+
+			for (int i = 0; i < 3; i++)
+				bounds.coneAxis[i] = axis[i];
+
+			// Cones close to or wider than a hemisphere can always be seen from somewhere, a cutoff of 1 never passes the test
+			bounds.coneCutoff = (minDot <= 0.1f) ? 1.0f : std::sqrt(1.0f - minDot * minDot);
+		}
+
+		static void BuildCullData(MeshletData& meshletData)
+		{
+			const size_t numGroups = (meshletData.bounds.size() + 3) / 4;
+			meshletData.cullData.assign(numGroups * meshletCullGroupSize, 0.0f);
+
+			for (size_t m = 0; m < meshletData.bounds.size(); m++)
+			{
+				const auto& bounds = meshletData.bounds[m];
+				float* group = &meshletData.cullData[(m / 4) * meshletCullGroupSize];
+				size_t lane = m % 4;
+
+				const float values[8] = {
+					bounds.center[0], bounds.center[1], bounds.center[2], bounds.radius,
+					bounds.coneAxis[0], bounds.coneAxis[1], bounds.coneAxis[2], bounds.coneCutoff
+				};
+				for (size_t i = 0; i < 8; i++)
+					group[i * 4 + lane] = values[i];
+			}
+		}
+
+		static void EmitMeshletIndices(const MeshletData& meshletData, const Meshlet& meshlet, uint8_t* dst, size_t indexSize)
+		{
+			const uint32_t* vertices = &meshletData.vertices[meshlet.vertexOffset];
+			const uint8_t* triangles = &meshletData.triangles[meshlet.triangleOffset];
+			const uint32_t indexCount = meshlet.triangleCount * 3;
+
+			if (indexSize == sizeof(uint16_t))
+			{
+				auto dst16 = reinterpret_cast<uint16_t*>(dst);
+				for (uint32_t i = 0; i < indexCount; i++)
+					dst16[i] = static_cast<uint16_t>(vertices[triangles[i]]);
+			}
+			else
+			{
+				auto dst32 = reinterpret_cast<uint32_t*>(dst);
+				for (uint32_t i = 0; i < indexCount; i++)
+					dst32[i] = vertices[triangles[i]];
+			}
+		}
+
+		// Returns a bit mask of the visible meshlets in a group of 4
+		static uint32_t CullMeshletGroup(const float* group, const MeshletCullParams& params)
+		{
+#ifdef BLAZE_SIMD_SSE2
+			const __m128 centerX = _mm_loadu_ps(group + 0);
+			const __m128 centerY = _mm_loadu_ps(group + 4);
+			const __m128 centerZ = _mm_loadu_ps(group + 8);
+			const __m128 radius = _mm_loadu_ps(group + 12);
+			const __m128 negRadius = _mm_sub_ps(_mm_setzero_ps(), radius);
+
+			__m128 visible = _mm_castsi128_ps(_mm_set1_epi32(-1));
+			for (const auto& plane : params.frustumPlanes)
+			{
+				__m128 distance = _mm_add_ps(
+					_mm_add_ps(_mm_mul_ps(centerX, _mm_set1_ps(plane[0])), _mm_mul_ps(centerY, _mm_set1_ps(plane[1]))),
+					_mm_add_ps(_mm_mul_ps(centerZ, _mm_set1_ps(plane[2])), _mm_set1_ps(plane[3])));
+				visible = _mm_and_ps(visible, _mm_cmpge_ps(distance, negRadius));
+			}
+
+			if (params.isConeCullingEnabled)
+			{
+				const __m128 axisX = _mm_loadu_ps(group + 16);
+				const __m128 axisY = _mm_loadu_ps(group + 20);
+				const __m128 axisZ = _mm_loadu_ps(group + 24);
+				const __m128 cutoff = _mm_loadu_ps(group + 28);
+
+				__m128 dx = _mm_sub_ps(centerX, _mm_set1_ps(params.cameraPosition[0]));
+				__m128 dy = _mm_sub_ps(centerY, _mm_set1_ps(params.cameraPosition[1]));
+				__m128 dz = _mm_sub_ps(centerZ, _mm_set1_ps(params.cameraPosition[2]));
+
+				__m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, axisX), _mm_mul_ps(dy, axisY)), _mm_mul_ps(dz, axisZ));
+				__m128 distance = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz)));
+
+				// Back-facing if dot(center - camera, axis) >= cutoff * |center - camera| + radius
+				__m128 isBackFacing = _mm_cmpge_ps(dot, _mm_add_ps(_mm_mul_ps(cutoff, distance), radius));
+				visible = _mm_andnot_ps(isBackFacing, visible);
+			}
+
+			return static_cast<uint32_t>(_mm_movemask_ps(visible));
+#else // ^^^ BLAZE_SIMD_SSE2 / !BLAZE_SIMD_SSE2 vvv
+			uint32_t mask = 0;
+			for (uint32_t lane = 0; lane < 4; lane++)
+			{
+				const float center[3] = { group[0 + lane], group[4 + lane], group[8 + lane] };
+				const float radius = group[12 + lane];
+
+				bool isVisible = true;
+				for (const auto& plane : params.frustumPlanes)
+					isVisible = isVisible && (center[0] * plane[0] + center[1] * plane[1] + center[2] * plane[2] + plane[3] >= -radius);
+
+				if (isVisible && params.isConeCullingEnabled)
+				{
+					float d[3] = { center[0] - params.cameraPosition[0], center[1] - params.cameraPosition[1], center[2] - params.cameraPosition[2] };
+					float dot = d[0] * group[16 + lane] + d[1] * group[20 + lane] + d[2] * group[24 + lane];
+					float distance = std::sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+					isVisible = dot < group[28 + lane] * distance + radius;
+				}
+
+				mask |= (isVisible ? 1u : 0u) << lane;
+			}
+			return mask;
+#endif // ^^^ !BLAZE_SIMD_SSE2
+		}
+	}
+
+	Result BuildMeshlets(MeshletData& meshletData, const uint32_t* indices, size_t indexCount, const float* positions, size_t vertexCount, size_t positionStride, uint32_t maxVertices, uint32_t maxTriangles)
+	{
+		// Local indices are stored in a byte, 0xff is reserved
+		if (!indices || (indexCount % 3) || !positions || (positionStride < sizeof(float) * 3) || (maxVertices < 3) || (maxVertices > 255) || !maxTriangles)
+			return Result::InvalidParam;
+
+		meshletData = MeshletData{};
+		meshletData.indexFormat = SelectIndexFormat(vertexCount);
+
+		// Local index of every vertex in the current meshlet, 0xff if the vertex isn't in it
+		std::vector<uint8_t> localIndices(vertexCount, 0xff);
+		Meshlet meshlet = { 0, 0, 0, 0 };
+
+		auto finishMeshlet = [&]()
+		{
+			if (!meshlet.triangleCount)
+				return;
+
+			for (uint32_t v = 0; v < meshlet.vertexCount; v++)
+				localIndices[meshletData.vertices[meshlet.vertexOffset + v]] = 0xff;
+
+			meshletData.meshlets.push_back(meshlet);
+			meshlet = { static_cast<uint32_t>(meshletData.vertices.size()), static_cast<uint32_t>(meshletData.triangles.size()), 0, 0 };
+		};
+
+		for (size_t i = 0; i < indexCount; i += 3)
+		{
+			const uint32_t a = indices[i + 0], b = indices[i + 1], c = indices[i + 2];
+			if ((a >= vertexCount) || (b >= vertexCount) || (c >= vertexCount))
+				return Result::InvalidParam;
+
+			uint32_t newVertices = 0;
+			newVertices += (localIndices[a] == 0xff) ? 1 : 0;
+			newVertices += ((localIndices[b] == 0xff) && (b != a)) ? 1 : 0;
+			newVertices += ((localIndices[c] == 0xff) && (c != a) && (c != b)) ? 1 : 0;
+			if ((meshlet.vertexCount + newVertices > maxVertices) || (meshlet.triangleCount + 1 > maxTriangles))
+				finishMeshlet();
+
+			for (uint32_t index : { a, b, c })
+			{
+				if (localIndices[index] == 0xff)
+				{
+					localIndices[index] = static_cast<uint8_t>(meshlet.vertexCount++);
+					meshletData.vertices.push_back(index);
+				}
+				meshletData.triangles.push_back(localIndices[index]);
+			}
+			meshlet.triangleCount++;
+		}
+		finishMeshlet();
+
+		meshletData.bounds.resize(meshletData.meshlets.size());
+		for (size_t m = 0; m < meshletData.meshlets.size(); m++)
+			Details::ComputeMeshletBounds(meshletData.bounds[m], meshletData.meshlets[m], meshletData, positions, positionStride);
+
+		Details::BuildCullData(meshletData);
+
+		return Result::Success;
+	}
+
+	void ExtractFrustumPlanes(const float viewProjection[16], float frustumPlanes[6][4])
+	{
+		const Frustum frustum = Frustum::FromViewProjection(Mat4::FromData(viewProjection));
+		std::memcpy(frustumPlanes, frustum.planes, sizeof(frustum.planes));
+	}
+
+	Result CullMeshlets(const MeshletData& meshletData, const MeshletCullParams& params, MeshletCullOutput& output)
+	{
+		const size_t numMeshlets = meshletData.meshlets.size();
+		if (meshletData.cullData.size() < ((numMeshlets + 3) / 4) * Details::meshletCullGroupSize)
+			return Result::InvalidParam;
+
+		output.visibleMeshlets.clear();
+		output.indexCount = 0;
+
+		for (size_t group = 0; group * 4 < numMeshlets; group++)
+		{
+			uint32_t mask = Details::CullMeshletGroup(&meshletData.cullData[group * Details::meshletCullGroupSize], params);
+
+			// The last group can be partially filled
+			size_t lanes = std::min<size_t>(4, numMeshlets - group * 4);
+			mask &= (1u << lanes) - 1;
+
+			for (uint32_t lane = 0; mask; lane++, mask >>= 1)
+			{
+				if (mask & 1)
+				{
+					uint32_t m = static_cast<uint32_t>(group * 4 + lane);
+					output.visibleMeshlets.push_back(m);
+					output.indexCount += meshletData.meshlets[m].triangleCount * 3;
+				}
+			}
+		}
+
+		const size_t indexSize = (meshletData.indexFormat == Format::R16_UInt) ? sizeof(uint16_t) : sizeof(uint32_t);
+		output.indices.resize(output.indexCount * indexSize);
+
+		size_t offset = 0;
+		for (uint32_t m : output.visibleMeshlets)
+		{
+			const auto& meshlet = meshletData.meshlets[m];
+			Details::EmitMeshletIndices(meshletData, meshlet, output.indices.data() + offset, indexSize);
+			offset += meshlet.triangleCount * 3 * indexSize;
+		}
+
+		return Result::Success;
+	}
+}
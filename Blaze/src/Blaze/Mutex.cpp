@@ -0,0 +1,146 @@
+#include <pch.h>
+#include <Blaze/Mutex.h>
+
+#include <iomanip>
+
+namespace Blaze
+{
+	namespace Details
+	{
+#ifdef BLAZE_PROFILER
+		// Every mutex alive, guarded by a plain mutex so the registry doesn't record itself
+		struct MutexRegistry
+		{
+			std::mutex mutex;
+			std::vector<Mutex*> mutexes;
+		};
+
+		static MutexRegistry& GetMutexRegistry()
+		{
+			static MutexRegistry registry;
+			return registry;
+		}
+
+		static uint32_t GetMutexWaitBucket(uint64_t waitTime)
+		{
+			// 2^8 = 256ns is the top of the first bucket
+			uint32_t bucket = 0;
+			for (waitTime >>= 8; waitTime && (bucket < mutexWaitBuckets - 1); waitTime >>= 1)
+				bucket++;
+			return bucket;
+		}
+#endif // BLAZE_PROFILER
+	}
+
+#ifdef BLAZE_PROFILER
+	Mutex::Mutex(const char* name)
+		:m_name(name)
+	{
+		Details::MutexRegistry& registry = Details::GetMutexRegistry();
+		std::lock_guard<std::mutex> lock(registry.mutex);
+		registry.mutexes.push_back(this);
+	}
+
+	Mutex::~Mutex()
+	{
+		Details::MutexRegistry& registry = Details::GetMutexRegistry();
+		std::lock_guard<std::mutex> lock(registry.mutex);
+		registry.mutexes.erase(std::remove(registry.mutexes.begin(), registry.mutexes.end(), this), registry.mutexes.end());
+	}
+
+	void Mutex::lock()
+	{
+		// The uncontended case costs a try_lock and a timestamp for the hold time
+		if (m_mutex.try_lock())
+		{
+			RecordAcquire(0, false);
+			return;
+		}
+
+		const uint64_t waitStart = Profiler::GetTimestamp();
+		m_mutex.lock();
+		RecordAcquire(Profiler::GetTimestamp() - waitStart, true);
+	}
+
+	bool Mutex::try_lock()
+	{
+		if (!m_mutex.try_lock())
+			return false;
+
+		RecordAcquire(0, false);
+		return true;
+	}
+
+	void Mutex::unlock()
+	{
+		const uint64_t holdTime = Profiler::GetTimestamp() - m_holdStart;
+		if (holdTime > m_maxHoldTime.load(std::memory_order_relaxed))
+		{
+			m_maxHoldTime.store(holdTime, std::memory_order_relaxed);
+			m_longestHolder.store(std::this_thread::get_id(), std::memory_order_relaxed);
+		}
+
+		m_mutex.unlock();
+	}
+
+	MutexStats Mutex::GetStats() const
+	{
+		MutexStats stats;
+		stats.name = m_name;
+		stats.numAcquires = m_numAcquires.load(std::memory_order_relaxed);
+		stats.numContended = m_numContended.load(std::memory_order_relaxed);
+		stats.totalWaitTime = m_totalWaitTime.load(std::memory_order_relaxed);
+		stats.maxWaitTime = m_maxWaitTime.load(std::memory_order_relaxed);
+		for (uint32_t i = 0; i < mutexWaitBuckets; i++)
+			stats.waitHistogram[i] = m_waitHistogram[i].load(std::memory_order_relaxed);
+
+		// The two are written separately, while the lock is busy they can belong to different holds
+		stats.maxHoldTime = m_maxHoldTime.load(std::memory_order_relaxed);
+		stats.longestHolder = m_longestHolder.load(std::memory_order_relaxed);
+		return stats;
+	}
+
+	std::vector<MutexStats> Mutex::GetAllStats()
+	{
+		Details::MutexRegistry& registry = Details::GetMutexRegistry();
+		std::lock_guard<std::mutex> lock(registry.mutex);
+
+		std::vector<MutexStats> stats;
+		stats.reserve(registry.mutexes.size());
+		for (Mutex* mutex : registry.mutexes)
+			stats.push_back(mutex->GetStats());
+		return stats;
+	}
+
+	void Mutex::RecordAcquire(uint64_t waitTime, bool isContended)
+	{
+		m_holdStart = Profiler::GetTimestamp();
+		m_numAcquires.fetch_add(1, std::memory_order_relaxed);
+		if (!isContended)
+			return;
+
+		m_numContended.fetch_add(1, std::memory_order_relaxed);
+		m_totalWaitTime.fetch_add(waitTime, std::memory_order_relaxed);
+		m_waitHistogram[Details::GetMutexWaitBucket(waitTime)].fetch_add(1, std::memory_order_relaxed);
+
+		// Holding the lock, so nothing else updates the max
+		if (waitTime > m_maxWaitTime.load(std::memory_order_relaxed))
+			m_maxWaitTime.store(waitTime, std::memory_order_relaxed);
+	}
+#endif // BLAZE_PROFILER
+
+	void Mutex::WriteReport(std::ostream& stream)
+	{
+		std::vector<MutexStats> stats = GetAllStats();
+		std::sort(stats.begin(), stats.end(), [](const MutexStats& lhs, const MutexStats& rhs) { return lhs.totalWaitTime > rhs.totalWaitTime; });
+
+		std::ostringstream report;
+		report << std::fixed << std::setprecision(3);
+		for (const MutexStats& mutex : stats)
+		{
+			report << "[Blaze:Info]: Mutex " << (mutex.name ? mutex.name : "Unnamed") << ": " << mutex.numAcquires << " acquires, " << mutex.numContended << " contended, waited "
+				<< mutex.totalWaitTime * 1e-6 << "ms (max " << mutex.maxWaitTime * 1e-6 << "ms), held at most " << mutex.maxHoldTime * 1e-6 << "ms by thread " << mutex.longestHolder << '\n';
+		}
+		stream << report.str();
+	}
+}
@@ -1,11 +1,15 @@
 #include <pch.h>
 #include <Blaze/Object.h>
+#include <Blaze/Mutex.h>
+#include <Blaze/Profiling/ResourceCensus.h>
 
 namespace Blaze
 {
+#if defined(_WIN32)
 	// Work around or dll-interface warnings
 	template class std::weak_ptr<Object>;
 	template class std::enable_shared_from_this<Object>;
+#endif // _WIN32
 
 	namespace Details
 	{
@@ -16,38 +20,46 @@ namespace Blaze
 		// Map of all currently registered IDs
 		static std::map<uint32_t, Object*> objectIDMap;
 		// Mutex lock for the counter and map
-		static std::mutex objectIDMutex;
+		static Mutex objectIDMutex{ "Object ID map" };
 
 		uint32_t CreateObjectID(Object* object)
 		{
-			std::lock_guard<std::mutex> guard{ objectIDMutex };
+			std::lock_guard<Mutex> guard{ objectIDMutex };
 			objectIDCounter++;
 			objectIDMap[objectIDCounter] = object;
+			CensusAddObject(objectIDCounter);
 			return objectIDCounter;
 		}
 
 		void DestroyObjectID(uint32_t objectID)
 		{
-			std::lock_guard<std::mutex> guard{ objectIDMutex };
+			std::lock_guard<Mutex> guard{ objectIDMutex };
 			objectIDMap.erase(objectID);
+			CensusRemoveObject(objectID);
 		}
 
 #else // ^^^ BLAZE_DEBUG / !BLAZE_DEBUG vvv
 
 		// Increments everytime a new object is created, used to assign unique object IDs
-		static uint32_t objectIDCounter = 0;
-		static std::mutex objectIDCounterMutex;
+		// Atomic so creating an object only takes the census' lock
+		static std::atomic<uint32_t> objectIDCounter{ 0 };
 
 		uint32_t CreateObjectID(Object* object)
 		{
-			std::lock_guard<std::mutex> guard{ objectIDCounterMutex };
-			objectIDCounter++;
-			return objectIDCounter;
+			const uint32_t objectID = objectIDCounter.fetch_add(1, std::memory_order_relaxed) + 1;
+			CensusAddObject(objectID);
+			return objectID;
 		}
 
 		void DestroyObjectID(uint32_t objectID)
 		{
+			CensusRemoveObject(objectID);
 		}
 #endif // ^^^ !BLAZE_DEBUG
+
+		void SetObjectClass(uint32_t objectID, ClassID classID)
+		{
+			CensusSetClass(objectID, classID);
+		}
 	}
 }
@@ -0,0 +1,176 @@
+#include <pch.h>
+#include <Blaze/Profiling/FlightRecorder.h>
+#include <Blaze/Profiling/Telemetry.h>
+
+#include <filesystem>
+#include <iomanip>
+
+namespace Blaze
+{
+	namespace Details
+	{
+		constexpr size_t numFlightMetrics = static_cast<size_t>(FlightMetric::NumMetrics) + 1;
+
+		constexpr std::array<const char*, numFlightMetrics> flightMetricNames =
+		{
+			"Invalid",
+			"WindowUpdateTime",
+			"NumWindowEvents",
+			"NumBufferUploads",
+			"BufferUploadBytes",
+			"SwapTime",
+			"FrameLimiterWaitTime",
+			"NumDebugMessages"
+		};
+
+		struct FlightRecorderState
+		{
+			// Guards everything but the current frame's metrics, which are added to from any thread
+			std::mutex mutex;
+			FlightRecorderConfig config;
+
+			std::array<std::atomic<uint64_t>, numFlightMetrics> currentMetrics{};
+			uint64_t currentStart = 0;
+
+			std::array<FlightFrame, flightRecorderFrames> frames{};
+			uint64_t numFrames = 0;
+			uint64_t numHitches = 0;
+			uint32_t numDumps = 0;
+			uint64_t lastDumpTime = 0;
+			bool hasDumped = false;
+		};
+
+		static FlightRecorderState& GetFlightRecorderState()
+		{
+			static FlightRecorderState state;
+			return state;
+		}
+
+		static void WriteFlightFrames(std::ostream& stream, const FlightRecorderState& state, uint64_t hitchFrame)
+		{
+			const uint64_t firstFrame = (state.numFrames > flightRecorderFrames) ? state.numFrames - flightRecorderFrames : 0;
+
+			// Frames as complete events with their metrics as arguments, and every metric as a counter track
+			stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+			stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"Frames\"}}";
+
+			stream << std::fixed << std::setprecision(3);
+			for (uint64_t i = firstFrame; i < state.numFrames; i++)
+			{
+				const FlightFrame& frame = state.frames[i % flightRecorderFrames];
+				stream << ",\n{\"name\":\"" << ((frame.frameIndex == hitchFrame) ? "Hitch" : "Frame") << "\",\"cat\":\"frame\",\"ph\":\"X\",\"pid\":1,\"tid\":0"
+					<< ",\"ts\":" << frame.start / 1000.0 << ",\"dur\":" << frame.duration / 1000.0 << ",\"args\":{\"frame\":" << frame.frameIndex;
+				for (size_t metric = 1; metric < numFlightMetrics; metric++)
+					stream << ",\"" << flightMetricNames[metric] << "\":" << frame.metrics[metric];
+				stream << "}}";
+
+				for (size_t metric = 1; metric < numFlightMetrics; metric++)
+				{
+					stream << ",\n{\"name\":\"" << flightMetricNames[metric] << "\",\"ph\":\"C\",\"pid\":1,\"ts\":" << frame.start / 1000.0
+						<< ",\"args\":{\"value\":" << frame.metrics[metric] << "}}";
+				}
+			}
+			stream << "\n]}\n";
+		}
+
+		static Result WriteFlightDump(const FlightRecorderState& state, std::string_view path, uint64_t hitchFrame)
+		{
+			std::ofstream file(std::string(path), std::ios::binary);
+			if (!file)
+				return Result::SystemError;
+
+			WriteFlightFrames(file, state, hitchFrame);
+			return file ? Result::Success : Result::SystemError;
+		}
+	}
+
+	void FlightRecorder::Configure(const FlightRecorderConfig& config)
+	{
+		Details::FlightRecorderState& state = Details::GetFlightRecorderState();
+		std::lock_guard<std::mutex> lock(state.mutex);
+		state.config = config;
+	}
+
+	void FlightRecorder::Add(FlightMetric metric, uint64_t value)
+	{
+		const size_t index = static_cast<size_t>(metric);
+		if ((index == 0) || (index >= Details::numFlightMetrics))
+			return;
+
+		Details::GetFlightRecorderState().currentMetrics[index].fetch_add(value, std::memory_order_relaxed);
+	}
+
+	void FlightRecorder::NextFrame()
+	{
+		Details::FlightRecorderState& state = Details::GetFlightRecorderState();
+		const uint64_t now = Profiler::GetTimestamp();
+
+		std::lock_guard<std::mutex> lock(state.mutex);
+
+		// The first call only starts a frame
+		if (state.currentStart == 0)
+		{
+			state.currentStart = now;
+			return;
+		}
+
+		const uint64_t frameIndex = state.numFrames;
+		FlightFrame& frame = state.frames[frameIndex % flightRecorderFrames];
+		frame.frameIndex = frameIndex;
+		frame.start = state.currentStart;
+		frame.duration = now - state.currentStart;
+		for (size_t i = 0; i < Details::numFlightMetrics; i++)
+			frame.metrics[i] = state.currentMetrics[i].exchange(0, std::memory_order_relaxed);
+		state.numFrames++;
+		state.currentStart = now;
+
+		const FlightRecorderConfig& config = state.config;
+		if ((config.frameBudget <= 0.0) || (frame.duration * 1e-9 <= config.frameBudget))
+			return;
+
+		state.numHitches++;
+		Telemetry::PostEvent(TelemetryEventType::Hitch, frame.duration);
+		if ((state.numDumps >= config.maxDumps) || (state.hasDumped && ((now - state.lastDumpTime) * 1e-9 < config.minDumpInterval)))
+			return;
+
+		// Written right away, the frame after a hitch is late already and the ring would otherwise overwrite what led up to it
+		std::filesystem::path path = std::filesystem::path(config.dumpDirectory) / ("BlazeHitch_" + std::to_string(frameIndex) + ".json");
+		if (Details::WriteFlightDump(state, path.string(), frameIndex) == Result::Success)
+		{
+			state.numDumps++;
+			Telemetry::PostEvent(TelemetryEventType::FlightDump, frameIndex);
+		}
+
+		state.hasDumped = true;
+		state.lastDumpTime = Profiler::GetTimestamp();
+
+		// The dump isn't counted against the frame it happened in
+		state.currentStart = state.lastDumpTime;
+	}
+
+	Result FlightRecorder::WriteDump(std::string_view path)
+	{
+		Details::FlightRecorderState& state = Details::GetFlightRecorderState();
+		std::lock_guard<std::mutex> lock(state.mutex);
+		return Details::WriteFlightDump(state, path, UINT64_MAX);
+	}
+
+	FlightRecorderStats FlightRecorder::GetStats()
+	{
+		Details::FlightRecorderState& state = Details::GetFlightRecorderState();
+		std::lock_guard<std::mutex> lock(state.mutex);
+
+		FlightRecorderStats stats;
+		stats.numFrames = state.numFrames;
+		stats.numHitches = state.numHitches;
+		stats.numDumps = state.numDumps;
+		return stats;
+	}
+
+	FlightFrame FlightRecorder::GetLastFrame()
+	{
+		Details::FlightRecorderState& state = Details::GetFlightRecorderState();
+		std::lock_guard<std::mutex> lock(state.mutex);
+		return state.numFrames ? state.frames[(state.numFrames - 1) % flightRecorderFrames] : FlightFrame{};
+	}
+}
@@ -0,0 +1,216 @@
+#include <pch.h>
+#include <Blaze/Profiling/FrameStatistics.h>
+#include <Blaze/Log.h>
+#include <Blaze/Profiling/HdrHistogram.h>
+#include <Blaze/Profiling/Profiler.h>
+
+#include <iomanip>
+
+namespace Blaze
+{
+	namespace Details
+	{
+		constexpr size_t numFrameTimeSeries = static_cast<size_t>(FrameTimeSeries::NumSeries) + 1;
+
+		constexpr std::array<const char*, numFrameTimeSeries> frameTimeSeriesNames =
+		{
+			"Invalid",
+			"CPU frame",
+			"GPU frame",
+			"Present interval"
+		};
+
+		// A histogram over a rolling window, samples leaving the window are taken back out of it
+		struct FrameTimeWindow
+		{
+			HdrHistogram histogram;
+			std::array<uint64_t, frameTimeWindowSize> samples{};
+			uint64_t numSamples = 0;
+
+			void Add(uint64_t time)
+			{
+				uint64_t& slot = samples[numSamples % frameTimeWindowSize];
+				if (numSamples >= frameTimeWindowSize)
+					histogram.Remove(slot);
+
+				slot = time;
+				histogram.Add(time);
+				numSamples++;
+			}
+		};
+
+		struct FrameStatisticsState
+		{
+			std::mutex mutex;
+			FrameStatisticsConfig config;
+			std::array<FrameTimeWindow, numFrameTimeSeries> windows;
+
+			uint64_t cpuFrameStart = 0;
+			uint64_t lastSwapEnd = 0;
+			uint64_t lastDump = 0;
+		};
+
+		static FrameStatisticsState& GetFrameStatisticsState()
+		{
+			static FrameStatisticsState state;
+			return state;
+		}
+
+		static FrameTimeStats GetFrameTimeStats(const FrameTimeWindow& window)
+		{
+			FrameTimeStats stats;
+			stats.numSamples = window.histogram.GetCount();
+			if (stats.numSamples == 0)
+				return stats;
+
+			stats.mean = window.histogram.GetMean() * 1e-9;
+			stats.p50 = window.histogram.GetPercentile(50.0) * 1e-9;
+			stats.p95 = window.histogram.GetPercentile(95.0) * 1e-9;
+			stats.p99 = window.histogram.GetPercentile(99.0) * 1e-9;
+
+			// The histogram only knows the max to within a bucket, the window has the exact one
+			const size_t numValid = static_cast<size_t>(std::min<uint64_t>(window.numSamples, frameTimeWindowSize));
+			stats.max = *std::max_element(window.samples.begin(), window.samples.begin() + numValid) * 1e-9;
+			stats.p50 = std::min(stats.p50, stats.max);
+			stats.p95 = std::min(stats.p95, stats.max);
+			stats.p99 = std::min(stats.p99, stats.max);
+			return stats;
+		}
+
+		static void WriteFrameTimeSummary(std::ostream& stream, const FrameStatisticsState& state)
+		{
+			// Formatted separately so the stream's own formatting isn't changed
+			std::ostringstream summary;
+			summary << std::fixed << std::setprecision(2);
+			for (size_t i = 1; i < numFrameTimeSeries; i++)
+			{
+				const FrameTimeStats stats = GetFrameTimeStats(state.windows[i]);
+				if (stats.numSamples == 0)
+					continue;
+
+				summary << "[Blaze:Info]: " << frameTimeSeriesNames[i] << " (ms): mean " << stats.mean * 1e3 << ", p50 " << stats.p50 * 1e3
+					<< ", p95 " << stats.p95 * 1e3 << ", p99 " << stats.p99 * 1e3 << ", max " << stats.max * 1e3 << '\n';
+			}
+			stream << summary.str();
+		}
+
+		// Same as WriteFrameTimeSummary, but formatted by the log thread since it's written from SwapBuffers
+		static void LogFrameTimeSummary(const FrameStatisticsState& state)
+		{
+			for (size_t i = 1; i < numFrameTimeSeries; i++)
+			{
+				const FrameTimeStats stats = GetFrameTimeStats(state.windows[i]);
+				if (stats.numSamples == 0)
+					continue;
+
+				BLAZE_LOG_INFO("{} (ms): mean {:.2}, p50 {:.2}, p95 {:.2}, p99 {:.2}, max {:.2}", frameTimeSeriesNames[i], stats.mean * 1e3, stats.p50 * 1e3, stats.p95 * 1e3, stats.p99 * 1e3, stats.max * 1e3);
+			}
+		}
+	}
+
+	void FrameStatistics::Configure(const FrameStatisticsConfig& config)
+	{
+		Details::FrameStatisticsState& state = Details::GetFrameStatisticsState();
+		std::lock_guard<std::mutex> lock(state.mutex);
+		state.config = config;
+	}
+
+	void FrameStatistics::BeginCPUFrame()
+	{
+		Details::FrameStatisticsState& state = Details::GetFrameStatisticsState();
+		std::lock_guard<std::mutex> lock(state.mutex);
+		state.cpuFrameStart = Profiler::GetTimestamp();
+	}
+
+	void FrameStatistics::RecordPresent(uint64_t swapStart, uint64_t swapEnd)
+	{
+		Details::FrameStatisticsState& state = Details::GetFrameStatisticsState();
+		std::lock_guard<std::mutex> lock(state.mutex);
+
+		const uint64_t cpuFrameStart = std::max(state.cpuFrameStart, state.lastSwapEnd);
+		if (cpuFrameStart && (swapStart >= cpuFrameStart))
+			state.windows[static_cast<size_t>(FrameTimeSeries::CPUFrame)].Add(swapStart - cpuFrameStart);
+		if (state.lastSwapEnd)
+			state.windows[static_cast<size_t>(FrameTimeSeries::PresentInterval)].Add(swapEnd - state.lastSwapEnd);
+		state.lastSwapEnd = swapEnd;
+
+		if (state.config.dumpInterval <= 0.0)
+			return;
+
+		if (!state.lastDump)
+			state.lastDump = swapEnd;
+		else if ((swapEnd - state.lastDump) * 1e-9 >= state.config.dumpInterval)
+		{
+			Details::LogFrameTimeSummary(state);
+			state.lastDump = swapEnd;
+		}
+	}
+
+	void FrameStatistics::Record(FrameTimeSeries series, uint64_t time)
+	{
+		const size_t index = static_cast<size_t>(series);
+		if ((index == 0) || (index >= Details::numFrameTimeSeries))
+			return;
+
+		Details::FrameStatisticsState& state = Details::GetFrameStatisticsState();
+		std::lock_guard<std::mutex> lock(state.mutex);
+		state.windows[index].Add(time);
+	}
+
+	FrameTimeStats FrameStatistics::GetStats(FrameTimeSeries series)
+	{
+		const size_t index = static_cast<size_t>(series);
+		if ((index == 0) || (index >= Details::numFrameTimeSeries))
+			return FrameTimeStats{};
+
+		Details::FrameStatisticsState& state = Details::GetFrameStatisticsState();
+		std::lock_guard<std::mutex> lock(state.mutex);
+		return Details::GetFrameTimeStats(state.windows[index]);
+	}
+
+	uint64_t FrameStatistics::GetLastSample(FrameTimeSeries series)
+	{
+		const size_t index = static_cast<size_t>(series);
+		if ((index == 0) || (index >= Details::numFrameTimeSeries))
+			return 0;
+
+		Details::FrameStatisticsState& state = Details::GetFrameStatisticsState();
+		std::lock_guard<std::mutex> lock(state.mutex);
+		const Details::FrameTimeWindow& window = state.windows[index];
+		return window.numSamples ? window.samples[(window.numSamples - 1) % frameTimeWindowSize] : 0;
+	}
+
+	uint64_t FrameStatistics::GetNumSamples(FrameTimeSeries series)
+	{
+		const size_t index = static_cast<size_t>(series);
+		if ((index == 0) || (index >= Details::numFrameTimeSeries))
+			return 0;
+
+		Details::FrameStatisticsState& state = Details::GetFrameStatisticsState();
+		std::lock_guard<std::mutex> lock(state.mutex);
+		return state.windows[index].numSamples;
+	}
+
+	uint64_t FrameStatistics::GetNewSamples(FrameTimeSeries series, uint64_t numSeen, std::vector<uint64_t>& samples)
+	{
+		const size_t index = static_cast<size_t>(series);
+		if ((index == 0) || (index >= Details::numFrameTimeSeries))
+			return numSeen;
+
+		Details::FrameStatisticsState& state = Details::GetFrameStatisticsState();
+		std::lock_guard<std::mutex> lock(state.mutex);
+		const Details::FrameTimeWindow& window = state.windows[index];
+
+		const uint64_t first = std::max(numSeen, (window.numSamples > frameTimeWindowSize) ? window.numSamples - frameTimeWindowSize : 0);
+		for (uint64_t i = first; i < window.numSamples; i++)
+			samples.push_back(window.samples[i % frameTimeWindowSize]);
+		return window.numSamples;
+	}
+
+	void FrameStatistics::WriteSummary(std::ostream& stream)
+	{
+		Details::FrameStatisticsState& state = Details::GetFrameStatisticsState();
+		std::lock_guard<std::mutex> lock(state.mutex);
+		Details::WriteFrameTimeSummary(stream, state);
+	}
+}
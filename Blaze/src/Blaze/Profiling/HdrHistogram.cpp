@@ -0,0 +1,102 @@
+#include <pch.h>
+#include <Blaze/Profiling/HdrHistogram.h>
+
+#include <cmath>
+
+namespace Blaze
+{
+	namespace Details
+	{
+		// Values below subBucketCount get a bucket each, above it every power of two gets halfSubBucketCount buckets
+		constexpr uint32_t subBucketBits = 7;
+		constexpr uint64_t subBucketCount = uint64_t(1) << subBucketBits;
+		constexpr uint64_t halfSubBucketCount = subBucketCount / 2;
+
+		static uint32_t MostSignificantBit(uint64_t value)
+		{
+			uint32_t bit = 0;
+			for (uint32_t shift = 32; shift; shift /= 2)
+			{
+				if (value >> shift)
+				{
+					value >>= shift;
+					bit += shift;
+				}
+			}
+			return bit;
+		}
+	}
+
+	HdrHistogram::HdrHistogram()
+		:m_counts(GetBucketIndex(maxValue) + 1, 0)
+	{
+	}
+
+	void HdrHistogram::Add(uint64_t value)
+	{
+		value = std::min(value, maxValue);
+		m_counts[GetBucketIndex(value)]++;
+		m_count++;
+		m_sum += value;
+	}
+
+	void HdrHistogram::Remove(uint64_t value)
+	{
+		value = std::min(value, maxValue);
+		uint32_t& count = m_counts[GetBucketIndex(value)];
+		if (count == 0)
+			return;
+
+		count--;
+		m_count--;
+		m_sum -= value;
+	}
+
+	void HdrHistogram::Clear()
+	{
+		std::fill(m_counts.begin(), m_counts.end(), 0);
+		m_count = 0;
+		m_sum = 0;
+	}
+
+	uint64_t HdrHistogram::GetPercentile(double percentile) const
+	{
+		if (m_count == 0)
+			return 0;
+
+		// Rank of the value at the percentile, at least the first value
+		const double clamped = std::clamp(percentile, 0.0, 100.0);
+		const uint64_t rank = std::max<uint64_t>(static_cast<uint64_t>(std::ceil(clamped / 100.0 * m_count)), 1);
+
+		uint64_t seen = 0;
+		for (size_t i = 0; i < m_counts.size(); i++)
+		{
+			seen += m_counts[i];
+			if (seen >= rank)
+				return GetBucketHighestValue(i);
+		}
+		return maxValue;
+	}
+
+	size_t HdrHistogram::GetBucketIndex(uint64_t value)
+	{
+		if (value < Details::subBucketCount)
+			return static_cast<size_t>(value);
+
+		// Shifted down so the value lands in [halfSubBucketCount, subBucketCount)
+		const uint32_t shift = Details::MostSignificantBit(value) - (Details::subBucketBits - 1);
+		const uint64_t subBucket = value >> shift;
+		return static_cast<size_t>(Details::subBucketCount + (shift - 1) * Details::halfSubBucketCount + (subBucket - Details::halfSubBucketCount));
+	}
+
+	uint64_t HdrHistogram::GetBucketHighestValue(size_t index)
+	{
+		if (index < Details::subBucketCount)
+			return index;
+
+		const uint64_t offset = index - Details::subBucketCount;
+		const uint32_t shift = static_cast<uint32_t>(offset / Details::halfSubBucketCount) + 1;
+		const uint64_t subBucket = offset % Details::halfSubBucketCount + Details::halfSubBucketCount;
+		return (subBucket << shift) + (uint64_t(1) << shift) - 1;
+	}
+}
@@ -0,0 +1,261 @@
+#include <pch.h>
+#include <Blaze/Profiling/Profiler.h>
+
+#include <chrono>
+#include <iomanip>
+
+namespace Blaze
+{
+	namespace Details
+	{
+		// Recorded scopes of one thread, only the thread writes to it
+		struct ProfilerThread
+		{
+			std::unique_ptr<ProfileEvent[]> events{ new ProfileEvent[profilerEventsPerThread] };
+			// Events ever recorded, the slot of event n is n % profilerEventsPerThread
+			std::atomic<uint64_t> numEvents{ 0 };
+			// Events before this one were cleared
+			std::atomic<uint64_t> firstEvent{ 0 };
+			uint32_t depth = 0;
+
+			uint32_t threadIndex = 0;
+			// Created with Profiler::CreateTrack instead of by a thread
+			bool isTrack = false;
+			// Guarded by ProfilerState::mutex
+			std::string name;
+		};
+
+		struct ProfilerState
+		{
+			std::mutex mutex;
+			// Threads are never removed, what a thread recorded is still exported after it exits
+			std::vector<std::unique_ptr<ProfilerThread>> threads;
+			std::atomic<bool> isEnabled{ true };
+			const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+		};
+
+		static ProfilerState& GetProfilerState()
+		{
+			static ProfilerState state;
+			return state;
+		}
+
+		// Must be called with ProfilerState::mutex locked
+		static ProfilerThread* AddProfilerThread(ProfilerState& state)
+		{
+			auto thread = std::make_unique<ProfilerThread>();
+			thread->threadIndex = static_cast<uint32_t>(state.threads.size());
+			state.threads.push_back(std::move(thread));
+			return state.threads.back().get();
+		}
+
+		static ProfilerThread& GetProfilerThread()
+		{
+			thread_local ProfilerThread* thread = nullptr;
+			if (!thread)
+			{
+				ProfilerState& state = GetProfilerState();
+				std::lock_guard<std::mutex> lock(state.mutex);
+				thread = AddProfilerThread(state);
+			}
+			return *thread;
+		}
+
+		static void AddProfileEvent(ProfilerThread& thread, const char* name, uint64_t start, uint64_t end, uint32_t depth)
+		{
+			const uint64_t index = thread.numEvents.load(std::memory_order_relaxed);
+			ProfileEvent& event = thread.events[index % profilerEventsPerThread];
+			event.name = name;
+			event.start = start;
+			event.end = end;
+			event.depth = depth;
+			thread.numEvents.store(index + 1, std::memory_order_release);
+		}
+
+		static void WriteJsonString(std::ostream& stream, std::string_view string)
+		{
+			stream << '"';
+			for (char c : string)
+			{
+				switch (c)
+				{
+				case '"': stream << "\\\""; break;
+				case '\\': stream << "\\\\"; break;
+				case '\n': stream << "\\n"; break;
+				case '\t': stream << "\\t"; break;
+				default:
+					if (static_cast<unsigned char>(c) < 0x20)
+						stream << "\\u00" << "0123456789abcdef"[c >> 4] << "0123456789abcdef"[c & 0xF];
+					else
+						stream << c;
+					break;
+				}
+			}
+			stream << '"';
+		}
+
+		// Copies the events of a thread that are still in its buffer, the thread may be recording meanwhile
+		static void CopyProfilerEvents(const ProfilerThread& thread, std::vector<ProfileEvent>& events)
+		{
+			const uint64_t numEvents = thread.numEvents.load(std::memory_order_acquire);
+			uint64_t first = std::max(thread.firstEvent.load(std::memory_order_relaxed), (numEvents > profilerEventsPerThread) ? numEvents - profilerEventsPerThread : 0);
+
+			const size_t copyStart = events.size();
+			for (uint64_t i = first; i < numEvents; i++)
+				events.push_back(thread.events[i % profilerEventsPerThread]);
+
+			// Slots the thread started overwriting during the copy are dropped, including the one it may be writing now
+			std::atomic_thread_fence(std::memory_order_acquire);
+			const uint64_t numEventsAfter = thread.numEvents.load(std::memory_order_relaxed) + 1;
+			if (numEventsAfter > first + profilerEventsPerThread)
+			{
+				const uint64_t numOverwritten = std::min(numEventsAfter - profilerEventsPerThread - first, numEvents - first);
+				events.erase(events.begin() + copyStart, events.begin() + copyStart + static_cast<size_t>(numOverwritten));
+			}
+		}
+	}
+
+	void Profiler::SetEnabled(bool isEnabled)
+	{
+		Details::GetProfilerState().isEnabled.store(isEnabled, std::memory_order_relaxed);
+	}
+
+	bool Profiler::IsEnabled()
+	{
+		return Details::GetProfilerState().isEnabled.load(std::memory_order_relaxed);
+	}
+
+	void Profiler::SetThreadName(std::string_view name)
+	{
+		Details::ProfilerThread& thread = Details::GetProfilerThread();
+
+		Details::ProfilerState& state = Details::GetProfilerState();
+		std::lock_guard<std::mutex> lock(state.mutex);
+		thread.name = name;
+	}
+
+	uint64_t Profiler::GetTimestamp()
+	{
+		const auto elapsed = std::chrono::steady_clock::now() - Details::GetProfilerState().epoch;
+		return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+	}
+
+	bool Profiler::BeginScope(uint64_t& start, uint32_t& depth)
+	{
+		if (!IsEnabled())
+			return false;
+
+		Details::ProfilerThread& thread = Details::GetProfilerThread();
+		depth = thread.depth++;
+		start = GetTimestamp();
+		return true;
+	}
+
+	void Profiler::EndScope(const char* name, uint64_t start, uint32_t depth)
+	{
+		const uint64_t end = GetTimestamp();
+
+		// A job that waited can end its scope on another thread than it began on, the depth it began with is restored
+		Details::ProfilerThread& thread = Details::GetProfilerThread();
+		thread.depth = depth;
+		Details::AddProfileEvent(thread, name, start, end, depth);
+	}
+
+	uint32_t Profiler::CreateTrack(std::string_view name)
+	{
+		Details::ProfilerState& state = Details::GetProfilerState();
+		std::lock_guard<std::mutex> lock(state.mutex);
+
+		Details::ProfilerThread* track = Details::AddProfilerThread(state);
+		track->name = name;
+		track->isTrack = true;
+		return track->threadIndex;
+	}
+
+	void Profiler::RecordScope(uint32_t track, const char* name, uint64_t start, uint64_t end, uint32_t depth)
+	{
+		if (!IsEnabled())
+			return;
+
+		Details::ProfilerThread* thread;
+		{
+			Details::ProfilerState& state = Details::GetProfilerState();
+			std::lock_guard<std::mutex> lock(state.mutex);
+			if (track >= state.threads.size())
+				return;
+			thread = state.threads[track].get();
+		}
+
+		Details::AddProfileEvent(*thread, name, start, end, depth);
+	}
+
+	void Profiler::Clear()
+	{
+		Details::ProfilerState& state = Details::GetProfilerState();
+		std::lock_guard<std::mutex> lock(state.mutex);
+		for (auto& thread : state.threads)
+			thread->firstEvent.store(thread->numEvents.load(std::memory_order_acquire), std::memory_order_relaxed);
+	}
+
+	Result Profiler::WriteChromeTrace(std::ostream& stream)
+	{
+		Details::ProfilerState& state = Details::GetProfilerState();
+
+		std::vector<ProfileEvent> events;
+		std::vector<std::pair<uint32_t, std::string>> threadNames;
+		struct ThreadEvents
+		{
+			uint32_t threadIndex;
+			bool isTrack;
+			size_t eventEnd;
+		};
+		std::vector<ThreadEvents> threadEvents;
+		{
+			std::lock_guard<std::mutex> lock(state.mutex);
+			for (auto& thread : state.threads)
+			{
+				Details::CopyProfilerEvents(*thread, events);
+				threadEvents.push_back(ThreadEvents{ thread->threadIndex, thread->isTrack, events.size() });
+				if (!thread->name.empty())
+					threadNames.emplace_back(thread->threadIndex, thread->name);
+			}
+		}
+
+		// Complete events ("X") in microseconds, nesting is shown by the times containing each other
+		stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+		bool isFirst = true;
+		for (const auto& [threadIndex, name] : threadNames)
+		{
+			stream << (isFirst ? "\n" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << threadIndex << ",\"args\":{\"name\":";
+			Details::WriteJsonString(stream, name);
+			stream << "}}";
+			isFirst = false;
+		}
+
+		stream << std::fixed << std::setprecision(3);
+		size_t eventIndex = 0;
+		for (const auto& thread : threadEvents)
+		{
+			for (; eventIndex < thread.eventEnd; eventIndex++)
+			{
+				const ProfileEvent& event = events[eventIndex];
+				stream << (isFirst ? "\n" : ",\n") << "{\"name\":";
+				Details::WriteJsonString(stream, event.name ? event.name : "");
+				stream << ",\"cat\":" << (thread.isTrack ? "\"track\"" : "\"cpu\"") << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << thread.threadIndex
+					<< ",\"ts\":" << event.start / 1000.0 << ",\"dur\":" << (event.end - event.start) / 1000.0 << '}';
+				isFirst = false;
+			}
+		}
+		stream << "\n]}\n";
+
+		return stream ? Result::Success : Result::SystemError;
+	}
+
+	Result Profiler::WriteChromeTrace(std::string_view path)
+	{
+		std::ofstream file(std::string(path), std::ios::binary);
+		if (!file)
+			return Result::SystemError;
+		return WriteChromeTrace(file);
+	}
+}
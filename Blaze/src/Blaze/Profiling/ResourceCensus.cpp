@@ -0,0 +1,357 @@
+#include <pch.h>
+#include <Blaze/Profiling/ResourceCensus.h>
+#include <Blaze/Mutex.h>
+
+#include <deque>
+#include <iomanip>
+
+namespace Blaze
+{
+	namespace Details
+	{
+		// Indexed by ImplementationID, a new implementation without a name here doesn't compile
+		constexpr std::array<const char*, static_cast<size_t>(ImplementationID::NumImplementations) + 1> implementationNames =
+		{
+			"Invalid",
+			"Generic",
+			"Win32",
+			"OpenGL",
+			"WGL",
+			"Posix",
+			"IOUring",
+			"Headless"
+		};
+		static_assert(implementationNames.back() != nullptr, "Every ImplementationID needs a name");
+
+		static const char* GetInterfaceName(InterfaceID interfaceID)
+		{
+			switch (interfaceID)
+			{
+			case InterfaceID::Object: return "Object";
+			case InterfaceID::Window: return "Window";
+			case InterfaceID::DeviceContext: return "DeviceContext";
+			case InterfaceID::Buffer: return "Buffer";
+			case InterfaceID::InstanceBatcher: return "InstanceBatcher";
+			case InterfaceID::Package: return "Package";
+			case InterfaceID::AsyncIO: return "AsyncIO";
+			case InterfaceID::FileSystem: return "FileSystem";
+			case InterfaceID::JobSystem: return "JobSystem";
+			default: return nullptr;
+			}
+		}
+
+		// Object IDs only grow, so records are kept in pages of consecutive IDs that go away once all of their objects did
+		constexpr uint32_t censusPageSize = 1024;
+
+		struct CensusRecord
+		{
+			// Objects that were never created keep the class of Object
+			ClassID classID = Object::GetStaticClassID();
+			const char* site = nullptr;
+			uint64_t cpuBytes = 0;
+			uint64_t gpuBytes = 0;
+			bool isLive = false;
+		};
+
+		struct CensusPage
+		{
+			std::array<CensusRecord, censusPageSize> records;
+			uint32_t numLive = 0;
+		};
+
+		struct ResourceCensusState
+		{
+			Mutex mutex{ "Resource census" };
+			// Page i holds the IDs from (firstPage + i) * censusPageSize, freed pages are nullptr until they reach the front
+			std::deque<std::unique_ptr<CensusPage>> pages;
+			size_t firstPage = 0;
+			// A freed page is reused for the next one, so creating and destroying objects doesn't allocate
+			std::unique_ptr<CensusPage> sparePage;
+			uint32_t newestObjectID = 0;
+
+			// Written under the mutex, read without it by GetTotals
+			std::atomic<uint64_t> numObjects{ 0 };
+			std::atomic<uint64_t> cpuBytes{ 0 };
+			std::atomic<uint64_t> gpuBytes{ 0 };
+		};
+
+		static ResourceCensusState& GetResourceCensusState()
+		{
+			static ResourceCensusState state;
+			return state;
+		}
+
+		// nullptr if the object isn't alive, the mutex has to be held
+		static CensusRecord* FindRecord(ResourceCensusState& state, uint32_t objectID)
+		{
+			const size_t pageIndex = objectID / censusPageSize;
+			if ((pageIndex < state.firstPage) || (pageIndex - state.firstPage >= state.pages.size()))
+				return nullptr;
+
+			CensusPage* page = state.pages[pageIndex - state.firstPage].get();
+			if (!page || !page->records[objectID % censusPageSize].isLive)
+				return nullptr;
+			return &page->records[objectID % censusPageSize];
+		}
+
+		static thread_local const char* threadSite = nullptr;
+
+		static std::string GetSiteName(const char* site) { return site ? site : "Untagged"; }
+
+		void CensusAddObject(uint32_t objectID)
+		{
+			ResourceCensusState& state = GetResourceCensusState();
+			std::lock_guard<Mutex> guard{ state.mutex };
+
+			// IDs are handed out before they're added, so a thread can add an older ID than the newest one
+			const size_t pageIndex = objectID / censusPageSize;
+			if (state.pages.empty())
+				state.firstPage = pageIndex;
+			for (; pageIndex < state.firstPage; state.firstPage--)
+				state.pages.emplace_front();
+			if (pageIndex - state.firstPage >= state.pages.size())
+				state.pages.resize(pageIndex - state.firstPage + 1);
+
+			std::unique_ptr<CensusPage>& page = state.pages[pageIndex - state.firstPage];
+			if (!page)
+				page = state.sparePage ? std::move(state.sparePage) : std::make_unique<CensusPage>();
+
+			CensusRecord& record = page->records[objectID % censusPageSize];
+			record = CensusRecord{};
+			record.site = threadSite;
+			record.isLive = true;
+			page->numLive++;
+			state.newestObjectID = std::max(state.newestObjectID, objectID);
+			state.numObjects.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		void CensusSetClass(uint32_t objectID, ClassID classID)
+		{
+			ResourceCensusState& state = GetResourceCensusState();
+			std::lock_guard<Mutex> guard{ state.mutex };
+			if (CensusRecord* record = FindRecord(state, objectID))
+				record->classID = classID;
+		}
+
+		void CensusRemoveObject(uint32_t objectID)
+		{
+			ResourceCensusState& state = GetResourceCensusState();
+			std::lock_guard<Mutex> guard{ state.mutex };
+			CensusRecord* record = FindRecord(state, objectID);
+			if (!record)
+				return;
+
+			state.numObjects.fetch_sub(1, std::memory_order_relaxed);
+			state.cpuBytes.fetch_sub(record->cpuBytes, std::memory_order_relaxed);
+			state.gpuBytes.fetch_sub(record->gpuBytes, std::memory_order_relaxed);
+			record->isLive = false;
+
+			// The page can go once its last ID was handed out and every object on it is gone
+			const size_t pageIndex = objectID / censusPageSize;
+			std::unique_ptr<CensusPage>& page = state.pages[pageIndex - state.firstPage];
+			if ((--page->numLive > 0) || ((pageIndex + 1) * censusPageSize - 1 > state.newestObjectID))
+				return;
+
+			if (!state.sparePage)
+				state.sparePage = std::move(page);
+			page.reset();
+			while (!state.pages.empty() && !state.pages.front())
+			{
+				state.pages.pop_front();
+				state.firstPage++;
+			}
+		}
+
+		static void WriteBytes(std::ostream& stream, int64_t bytes)
+		{
+			stream << bytes / 1024.0 << "KiB";
+		}
+	}
+
+	void ResourceCensus::SetFootprint(Object* object, uint64_t cpuBytes, uint64_t gpuBytes)
+	{
+		// The lower half of an object ID is the ID Object registered
+		const uint32_t objectID = static_cast<uint32_t>(object->GetObjectID());
+
+		Details::ResourceCensusState& state = Details::GetResourceCensusState();
+		std::lock_guard<Mutex> guard{ state.mutex };
+		Details::CensusRecord* record = Details::FindRecord(state, objectID);
+		if (!record)
+			return;
+
+		state.cpuBytes.fetch_add(cpuBytes - record->cpuBytes, std::memory_order_relaxed);
+		state.gpuBytes.fetch_add(gpuBytes - record->gpuBytes, std::memory_order_relaxed);
+		record->cpuBytes = cpuBytes;
+		record->gpuBytes = gpuBytes;
+	}
+
+	ResourceCensusTotals ResourceCensus::GetTotals()
+	{
+		Details::ResourceCensusState& state = Details::GetResourceCensusState();
+
+		ResourceCensusTotals totals;
+		totals.numObjects = state.numObjects.load(std::memory_order_relaxed);
+		totals.cpuBytes = state.cpuBytes.load(std::memory_order_relaxed);
+		totals.gpuBytes = state.gpuBytes.load(std::memory_order_relaxed);
+		return totals;
+	}
+
+	ResourceCensusSnapshot ResourceCensus::TakeSnapshot()
+	{
+		// Sites are compared by pointer while the lock is held, the strings are only made afterwards
+		std::map<std::pair<ClassID, const char*>, ResourceCensusEntry> entries;
+		{
+			Details::ResourceCensusState& state = Details::GetResourceCensusState();
+			std::lock_guard<Mutex> guard{ state.mutex };
+			for (const auto& page : state.pages)
+			{
+				if (!page)
+					continue;
+
+				for (const Details::CensusRecord& record : page->records)
+				{
+					if (!record.isLive)
+						continue;
+
+					ResourceCensusEntry& entry = entries[{ record.classID, record.site }];
+					entry.numObjects++;
+					entry.cpuBytes += record.cpuBytes;
+					entry.gpuBytes += record.gpuBytes;
+				}
+			}
+		}
+
+		// The same site string can have different addresses in different modules, those are merged here
+		std::map<std::pair<ClassID, std::string>, ResourceCensusEntry> namedEntries;
+		for (auto& [key, entry] : entries)
+		{
+			ResourceCensusEntry& namedEntry = namedEntries[{ key.first, Details::GetSiteName(key.second) }];
+			namedEntry.numObjects += entry.numObjects;
+			namedEntry.cpuBytes += entry.cpuBytes;
+			namedEntry.gpuBytes += entry.gpuBytes;
+		}
+
+		ResourceCensusSnapshot snapshot;
+		snapshot.entries.reserve(namedEntries.size());
+		for (auto& [key, entry] : namedEntries)
+		{
+			entry.classID = key.first;
+			entry.site = key.second;
+			snapshot.numObjects += entry.numObjects;
+			snapshot.cpuBytes += entry.cpuBytes;
+			snapshot.gpuBytes += entry.gpuBytes;
+			snapshot.entries.push_back(std::move(entry));
+		}
+		return snapshot;
+	}
+
+	std::vector<ResourceCensusDelta> ResourceCensus::Diff(const ResourceCensusSnapshot& before, const ResourceCensusSnapshot& after)
+	{
+		std::map<std::pair<ClassID, std::string>, ResourceCensusDelta> deltas;
+		for (const ResourceCensusEntry& entry : before.entries)
+		{
+			ResourceCensusDelta& delta = deltas[{ entry.classID, entry.site }];
+			delta.numObjects -= static_cast<int64_t>(entry.numObjects);
+			delta.cpuBytes -= static_cast<int64_t>(entry.cpuBytes);
+			delta.gpuBytes -= static_cast<int64_t>(entry.gpuBytes);
+		}
+		for (const ResourceCensusEntry& entry : after.entries)
+		{
+			ResourceCensusDelta& delta = deltas[{ entry.classID, entry.site }];
+			delta.numObjects += static_cast<int64_t>(entry.numObjects);
+			delta.cpuBytes += static_cast<int64_t>(entry.cpuBytes);
+			delta.gpuBytes += static_cast<int64_t>(entry.gpuBytes);
+		}
+
+		std::vector<ResourceCensusDelta> changed;
+		for (auto& [key, delta] : deltas)
+		{
+			if ((delta.numObjects == 0) && (delta.cpuBytes == 0) && (delta.gpuBytes == 0))
+				continue;
+
+			delta.classID = key.first;
+			delta.site = key.second;
+			changed.push_back(std::move(delta));
+		}
+
+		std::sort(changed.begin(), changed.end(), [](const ResourceCensusDelta& lhs, const ResourceCensusDelta& rhs)
+		{
+			if (lhs.gpuBytes != rhs.gpuBytes)
+				return lhs.gpuBytes > rhs.gpuBytes;
+			if (lhs.cpuBytes != rhs.cpuBytes)
+				return lhs.cpuBytes > rhs.cpuBytes;
+			return lhs.numObjects > rhs.numObjects;
+		});
+		return changed;
+	}
+
+	void ResourceCensus::WriteReport(std::ostream& stream, const ResourceCensusSnapshot& snapshot)
+	{
+		std::ostringstream report;
+		report << std::fixed << std::setprecision(3);
+		report << "[Blaze:Info]: Resource census: " << snapshot.numObjects << " objects, CPU ";
+		Details::WriteBytes(report, static_cast<int64_t>(snapshot.cpuBytes));
+		report << ", GPU ";
+		Details::WriteBytes(report, static_cast<int64_t>(snapshot.gpuBytes));
+		report << '\n';
+
+		for (const ResourceCensusEntry& entry : snapshot.entries)
+		{
+			report << "[Blaze:Info]:     " << GetClassLabel(entry.classID) << " at " << entry.site << ": " << entry.numObjects << " objects, CPU ";
+			Details::WriteBytes(report, static_cast<int64_t>(entry.cpuBytes));
+			report << ", GPU ";
+			Details::WriteBytes(report, static_cast<int64_t>(entry.gpuBytes));
+			report << '\n';
+		}
+		stream << report.str();
+	}
+
+	void ResourceCensus::WriteDiff(std::ostream& stream, const std::vector<ResourceCensusDelta>& deltas)
+	{
+		std::ostringstream report;
+		report << std::fixed << std::setprecision(3) << std::showpos;
+		if (deltas.empty())
+			report << "[Blaze:Info]: Resource census unchanged\n";
+
+		for (const ResourceCensusDelta& delta : deltas)
+		{
+			report << "[Blaze:Info]: " << GetClassLabel(delta.classID) << " at " << delta.site << ": " << delta.numObjects << " objects, CPU ";
+			Details::WriteBytes(report, delta.cpuBytes);
+			report << ", GPU ";
+			Details::WriteBytes(report, delta.gpuBytes);
+			report << '\n';
+		}
+		stream << report.str();
+	}
+
+	std::string ResourceCensus::GetClassLabel(ClassID classID)
+	{
+		const char* interfaceName = Details::GetInterfaceName(static_cast<Details::InterfaceID>(classID >> 16));
+		const uint32_t implementationID = classID & 0xffff;
+
+		std::ostringstream label;
+		if (interfaceName)
+			label << interfaceName;
+		else
+			label << "Interface 0x" << std::hex << (classID >> 16) << std::dec;
+
+		if (implementationID == 0)
+			return label.str();
+
+		if (implementationID < Details::implementationNames.size())
+			label << " (" << Details::implementationNames[implementationID] << ')';
+		else
+			label << " (" << implementationID << ')';
+		return label.str();
+	}
+
+	const char* ResourceCensus::GetThreadSite()
+	{
+		return Details::threadSite;
+	}
+
+	void ResourceCensus::SetThreadSite(const char* site)
+	{
+		Details::threadSite = site;
+	}
+}
@@ -0,0 +1,241 @@
+#include <pch.h>
+#include <Blaze/Profiling/Telemetry.h>
+#include <Blaze/Log.h>
+#include <Blaze/Profiling/Profiler.h>
+#include <Blaze/Profiling/FlightRecorder.h>
+#include <Blaze/Profiling/FrameStatistics.h>
+#include <Blaze/Profiling/ResourceCensus.h>
+#include <Blaze/Memory/AllocationTracker.h>
+
+#if defined(BLAZE_PLATFORM_LINUX)
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif // BLAZE_PLATFORM_LINUX
+
+namespace Blaze
+{
+	namespace Details
+	{
+		struct TelemetryState
+		{
+			std::mutex mutex;
+			std::string name;
+#if defined(BLAZE_PLATFORM_WIN32) || defined(BLAZE_PLATFORM_WIN64)
+			HANDLE mapping = nullptr;
+#endif // BLAZE_PLATFORM_WIN32 || BLAZE_PLATFORM_WIN64
+		};
+
+		static TelemetryState& GetTelemetryState()
+		{
+			static TelemetryState state;
+			return state;
+		}
+
+		// Kept outside the state so posting an event is a single load while telemetry is closed
+		static std::atomic<TelemetryBlock*> telemetryBlock{ nullptr };
+		// Threads posting or publishing right now, Close waits for them before unmapping the block
+		static std::atomic<uint32_t> numTelemetryWriters{ 0 };
+
+		// Holds on to the block for its lifetime, GetBlock is nullptr while telemetry is closed
+		class TelemetryWriteScope
+		{
+		public:
+			inline TelemetryWriteScope()
+			{
+				if (!telemetryBlock.load(std::memory_order_relaxed))
+					return;
+
+				// Counted before loading the block again, so a Close that swapped it out after this sees the writer
+				numTelemetryWriters.fetch_add(1, std::memory_order_seq_cst);
+				m_block = telemetryBlock.load(std::memory_order_seq_cst);
+				m_isCounted = true;
+			}
+			inline ~TelemetryWriteScope()
+			{
+				if (m_isCounted)
+					numTelemetryWriters.fetch_sub(1, std::memory_order_release);
+			}
+
+			TelemetryWriteScope(const TelemetryWriteScope&) = delete;
+			TelemetryWriteScope& operator=(const TelemetryWriteScope&) = delete;
+
+			inline TelemetryBlock* GetBlock() const { return m_block; }
+		private:
+			TelemetryBlock* m_block = nullptr;
+			bool m_isCounted = false;
+		};
+
+		static TelemetryBlock* MapTelemetryBlock(TelemetryState& state, std::string_view name)
+		{
+#if defined(BLAZE_PLATFORM_WIN32) || defined(BLAZE_PLATFORM_WIN64)
+			state.name = "Local\\" + std::string(name);
+			state.mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0, sizeof(TelemetryBlock), state.name.c_str());
+			if (!state.mapping)
+				return nullptr;
+
+			void* memory = MapViewOfFile(state.mapping, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(TelemetryBlock));
+			if (!memory)
+			{
+				CloseHandle(state.mapping);
+				state.mapping = nullptr;
+			}
+			return static_cast<TelemetryBlock*>(memory);
+#elif defined(BLAZE_PLATFORM_LINUX) // ^^^ Windows (Win32) / Linux (Posix) vvv
+			state.name = "/" + std::string(name);
+			const int fd = shm_open(state.name.c_str(), O_CREAT | O_RDWR, 0644);
+			if (fd < 0)
+				return nullptr;
+
+			void* memory = MAP_FAILED;
+			if (ftruncate(fd, sizeof(TelemetryBlock)) == 0)
+				memory = mmap(nullptr, sizeof(TelemetryBlock), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+			close(fd);
+
+			if (memory == MAP_FAILED)
+			{
+				shm_unlink(state.name.c_str());
+				return nullptr;
+			}
+			return static_cast<TelemetryBlock*>(memory);
+#endif // ^^^ Linux (Posix)
+		}
+
+		static void UnmapTelemetryBlock(TelemetryState& state, TelemetryBlock* block)
+		{
+#if defined(BLAZE_PLATFORM_WIN32) || defined(BLAZE_PLATFORM_WIN64)
+			UnmapViewOfFile(block);
+			CloseHandle(state.mapping);
+			state.mapping = nullptr;
+#elif defined(BLAZE_PLATFORM_LINUX) // ^^^ Windows (Win32) / Linux (Posix) vvv
+			munmap(block, sizeof(TelemetryBlock));
+			shm_unlink(state.name.c_str());
+#endif // ^^^ Linux (Posix)
+		}
+
+		static uint32_t GetProcessID()
+		{
+#if defined(BLAZE_PLATFORM_WIN32) || defined(BLAZE_PLATFORM_WIN64)
+			return static_cast<uint32_t>(GetCurrentProcessId());
+#elif defined(BLAZE_PLATFORM_LINUX) // ^^^ Windows (Win32) / Linux (Posix) vvv
+			return static_cast<uint32_t>(getpid());
+#endif // ^^^ Linux (Posix)
+		}
+	}
+
+	Result Telemetry::Open(std::string_view name)
+	{
+		Details::TelemetryState& state = Details::GetTelemetryState();
+		std::lock_guard<std::mutex> lock(state.mutex);
+		if (Details::telemetryBlock.load(std::memory_order_relaxed))
+			return Result::InvalidParam;
+
+		TelemetryBlock* block = Details::MapTelemetryBlock(state, name);
+		if (!block)
+		{
+			BLAZE_LOG_ERROR("Failed to open the telemetry segment {}", state.name);
+			return Result::SystemError;
+		}
+
+		// A segment left behind by a crashed process is reused, so everything is reset before it's marked valid
+		block->magic.store(0, std::memory_order_relaxed);
+		block->version = telemetryVersion;
+		block->blockSize = sizeof(TelemetryBlock);
+		block->processID = Details::GetProcessID();
+		block->sequence.store(0, std::memory_order_relaxed);
+		for (auto& counter : block->counters)
+			counter.store(0, std::memory_order_relaxed);
+		block->numEvents.store(0, std::memory_order_relaxed);
+		for (auto& slot : block->events)
+			slot.sequence.store(0, std::memory_order_relaxed);
+		block->magic.store(telemetryMagic, std::memory_order_release);
+
+		Details::telemetryBlock.store(block, std::memory_order_release);
+		return Result::Success;
+	}
+
+	void Telemetry::Close()
+	{
+		Details::TelemetryState& state = Details::GetTelemetryState();
+		std::lock_guard<std::mutex> lock(state.mutex);
+
+		// Nothing may post events or publish while the segment is closed
+		TelemetryBlock* block = Details::telemetryBlock.exchange(nullptr, std::memory_order_seq_cst);
+		if (!block)
+			return;
+
+		// Writers that loaded the block before it was swapped out are a few stores away from done
+		while (Details::numTelemetryWriters.load(std::memory_order_seq_cst) != 0)
+			std::this_thread::yield();
+		Details::UnmapTelemetryBlock(state, block);
+	}
+
+	bool Telemetry::IsOpen()
+	{
+		return Details::telemetryBlock.load(std::memory_order_relaxed) != nullptr;
+	}
+
+	void Telemetry::NextFrame()
+	{
+		Details::TelemetryWriteScope writeScope;
+		TelemetryBlock* block = writeScope.GetBlock();
+		if (!block)
+			return;
+
+		const FlightFrame frame = FlightRecorder::GetLastFrame();
+		const ResourceCensusTotals census = ResourceCensus::GetTotals();
+		const AllocationStats allocations = AllocationTracker::GetStats();
+
+		TelemetryCounters counters{};
+		auto set = [&counters](TelemetryCounter counter, uint64_t value) { counters[static_cast<size_t>(counter)] = value; };
+		set(TelemetryCounter::FrameIndex, frame.frameIndex);
+		set(TelemetryCounter::PublishTime, Profiler::GetTimestamp());
+		set(TelemetryCounter::FrameTime, frame.duration);
+		set(TelemetryCounter::CPUFrameTime, FrameStatistics::GetLastSample(FrameTimeSeries::CPUFrame));
+		set(TelemetryCounter::GPUFrameTime, FrameStatistics::GetLastSample(FrameTimeSeries::GPUFrame));
+		set(TelemetryCounter::PresentInterval, FrameStatistics::GetLastSample(FrameTimeSeries::PresentInterval));
+		set(TelemetryCounter::NumWindowEvents, frame.metrics[static_cast<size_t>(FlightMetric::NumWindowEvents)]);
+		set(TelemetryCounter::NumBufferUploads, frame.metrics[static_cast<size_t>(FlightMetric::NumBufferUploads)]);
+		set(TelemetryCounter::BufferUploadBytes, frame.metrics[static_cast<size_t>(FlightMetric::BufferUploadBytes)]);
+		set(TelemetryCounter::NumObjects, census.numObjects);
+		set(TelemetryCounter::ObjectCPUBytes, census.cpuBytes);
+		set(TelemetryCounter::ObjectGPUBytes, census.gpuBytes);
+
+		uint64_t numAllocations = 0;
+		uint64_t allocatedBytes = 0;
+		for (const AllocationCounts& counts : allocations.lastFrame)
+		{
+			numAllocations += counts.numAllocations;
+			allocatedBytes += counts.numBytes;
+		}
+		set(TelemetryCounter::NumAllocations, numAllocations);
+		set(TelemetryCounter::AllocatedBytes, allocatedBytes);
+		set(TelemetryCounter::LiveHeapBytes, static_cast<uint64_t>(std::max<int64_t>(allocations.liveBytes, 0)));
+
+		// Only the game loop's thread publishes, so the seqlock has a single writer
+		const uint64_t sequence = block->sequence.load(std::memory_order_relaxed);
+		block->sequence.store(sequence + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		for (size_t i = 0; i < counters.size(); i++)
+			block->counters[i].store(counters[i], std::memory_order_relaxed);
+		block->sequence.store(sequence + 2, std::memory_order_release);
+	}
+
+	void Telemetry::PostEvent(TelemetryEventType type, uint64_t value)
+	{
+		Details::TelemetryWriteScope writeScope;
+		TelemetryBlock* block = writeScope.GetBlock();
+		if (!block)
+			return;
+
+		const uint64_t index = block->numEvents.fetch_add(1, std::memory_order_relaxed);
+		TelemetryEventSlot& slot = block->events[index % telemetryEventRingSize];
+
+		slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		slot.timestamp.store(Profiler::GetTimestamp(), std::memory_order_relaxed);
+		slot.type.store(static_cast<uint64_t>(type), std::memory_order_relaxed);
+		slot.value.store(value, std::memory_order_relaxed);
+		slot.sequence.store(2 * index + 2, std::memory_order_release);
+	}
+}
@@ -1,14 +1,18 @@
 #ifndef PCH_H
 #define PCH_H
 
+#if defined(BLAZE_PLATFORM_WIN32) || defined(BLAZE_PLATFORM_WIN64)
 #define WIN32_LEAN_AND_MEAN
 #define NOMINMAX
 #include <Windows.h>
 #include <windowsx.h>
+#endif // BLAZE_PLATFORM_WIN32 || BLAZE_PLATFORM_WIN64
 
 // OpenGL loader (glad2) https://gen.glad.sh/
 #include <glad/gl.h>
+#if defined(BLAZE_PLATFORM_WIN32) || defined(BLAZE_PLATFORM_WIN64)
 #include <glad/wgl.h>
+#endif // BLAZE_PLATFORM_WIN32 || BLAZE_PLATFORM_WIN64
 
 #define _SILENCE_CXX17_CODECVT_HEADER_DEPRECATION_WARNING
 #include <iostream>
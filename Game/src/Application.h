@@ -168,52 +168,52 @@ void LogWindowEvent(const Blaze::WindowEvent& event, void*)
 	};
 	switch (event.eventCode)
 	{
-	case Blaze::WindowEvent::Create: std::cout << "Window created\n"; break;
-	case Blaze::WindowEvent::Destroy: std::cout << "Window destroyed\n"; break;
+	case Blaze::WindowEvent::Create: BLAZE_LOG_INFO("Window created"); break;
+	case Blaze::WindowEvent::Destroy: BLAZE_LOG_INFO("Window destroyed"); break;
 	case Blaze::WindowEvent::Resize:
 	{
 		auto eventInfo = event.GetWindowEventInfo<Blaze::WindowResizeEventInfo>();
-		std::cout << "Window resized; width = " << eventInfo.width << ", height = " << eventInfo.height << '\n';
+		BLAZE_LOG_INFO("Window resized; width = {}, height = {}", eventInfo.width, eventInfo.height);
 		break;
 	}
 	case Blaze::WindowEvent::Move:
 	{
 		auto eventInfo = event.GetWindowEventInfo<Blaze::WindowMoveEventInfo>();
-		std::cout << "Window moved; x = " << eventInfo.x << ", y = " << eventInfo.y << '\n';
+		BLAZE_LOG_INFO("Window moved; x = {}, y = {}", eventInfo.x, eventInfo.y);
 		break;
 	}
 	case Blaze::WindowEvent::KeyDown:
 	{
 		auto eventInfo = event.GetWindowEventInfo<Blaze::WindowKeyDownEventInfo>();
-		std::cout << keyStrings[static_cast<uint32_t>(eventInfo.key)] << " key pressed\n";
+		BLAZE_LOG_INFO("{} key pressed", keyStrings[static_cast<uint32_t>(eventInfo.key)]);
 		break;
 	}
 	case Blaze::WindowEvent::KeyUp:
 	{
 		auto eventInfo = event.GetWindowEventInfo<Blaze::WindowKeyUpEventInfo>();
-		std::cout << keyStrings[static_cast<uint32_t>(eventInfo.key)] << " key released\n";
+		BLAZE_LOG_INFO("{} key released", keyStrings[static_cast<uint32_t>(eventInfo.key)]);
 		break;
 	}
 	case Blaze::WindowEvent::MouseButtonDown:
 	{
 		auto eventInfo = event.GetWindowEventInfo<Blaze::WindowMouseButtonDownEventInfo>();
-		std::cout << mouseButtonStrings[static_cast<uint32_t>(eventInfo.button)] << " mouse button pressed; x = " << eventInfo.x << ", y = " << eventInfo.y << '\n';
+		BLAZE_LOG_INFO("{} mouse button pressed; x = {}, y = {}", mouseButtonStrings[static_cast<uint32_t>(eventInfo.button)], eventInfo.x, eventInfo.y);
 		break;
 	}
 	case Blaze::WindowEvent::MouseButtonUp:
 	{
 		auto eventInfo = event.GetWindowEventInfo<Blaze::WindowMouseButtonUpEventInfo>();
-		std::cout << mouseButtonStrings[static_cast<uint32_t>(eventInfo.button)] << " mouse button released; x = " << eventInfo.x << ", y = " << eventInfo.y << '\n';
+		BLAZE_LOG_INFO("{} mouse button released; x = {}, y = {}", mouseButtonStrings[static_cast<uint32_t>(eventInfo.button)], eventInfo.x, eventInfo.y);
 		break;
 	}
 	case Blaze::WindowEvent::MouseMove:
 	{
 		auto eventInfo = event.GetWindowEventInfo<Blaze::WindowMouseMoveEventInfo>();
-		std::cout << "Mouse moved; x = " << eventInfo.x << ", y = " << eventInfo.y << '\n';
+		BLAZE_LOG_TRACE("Mouse moved; x = {}, y = {}", eventInfo.x, eventInfo.y);
 		break;
 	}
 	default:
-		std::cout << "Unknown event\n";
+		BLAZE_LOG_WARNING("Unknown event");
 		break;
 	}
 }
@@ -229,34 +229,52 @@ public:
 
 	virtual void OnCreate() override
 	{
+		BLAZE_RESOURCE_SITE("Game::OnCreate");
+
 		Blaze::DeviceContextCreateInfo renderContextInfo;
 		renderContextInfo.window = GetWindow();
 		renderContextInfo.renderingApi = Blaze::RenderAPI::OpenGL;
+		renderContextInfo.enableGPUProfiler = true;
+#ifdef _DEBUG
+		// Driver warnings about our GL usage show up in the log
+		renderContextInfo.enableDebugOutput = true;
+#endif // _DEBUG
 
 		m_renderContext = Blaze::DeviceContext::Create(renderContextInfo);
 
 		if (!m_renderContext.get())
 		{
-			std::cout << "Render context creation failed.\n";
+			BLAZE_LOG_ERROR("Render context creation failed.");
+			Blaze::Log::Flush();
 			std::terminate();
 		}
+
+		m_startupCensus = Blaze::ResourceCensus::TakeSnapshot();
 	}
 
 	virtual void OnDestroy() override
 	{
+		// Anything still listed was created while running and never released
+		Blaze::Log::Flush();
+		Blaze::ResourceCensus::WriteDiff(std::cout, Blaze::ResourceCensus::Diff(m_startupCensus, Blaze::ResourceCensus::TakeSnapshot()));
+	}
 
+	virtual void OnFixedUpdate(double deltaTime) override
+	{
+		(void)deltaTime;
 	}
 
-	virtual bool OnUpdate() override
+	virtual void OnRender(double alpha) override
 	{
-		GetWindow()->Update();
-		return GetWindow()->IsRunning();
+		(void)alpha;
+		m_renderContext->SwapBuffers();
 	}
 
 private:
 	Blaze::KeyboardInput m_keyboard;
 	Blaze::MouseInput m_mouse;
 	Blaze::Ref<Blaze::DeviceContext> m_renderContext;
+	Blaze::ResourceCensusSnapshot m_startupCensus;
 };
 
 Blaze::Application* CreateApplication()
@@ -271,9 +289,16 @@ Blaze::Application* CreateApplication()
 		{ LogWindowEvent, nullptr }
 	};
 
-	return new Game{
-		Blaze::GameAppConfig{
-			windowInfo
-		}
-	};
+	Blaze::GameLoopConfig loopConfig;
+	loopConfig.tickRate = 60.0;
+	loopConfig.targetFrameRate = 120.0;
+
+	Blaze::GameAppConfig config;
+	config.windowInfo = windowInfo;
+	config.loopConfig = loopConfig;
+	config.profileTracePath = "BlazeTrace.json";
+	config.frameStatisticsConfig.dumpInterval = 10.0;
+	config.telemetrySegment = Blaze::defaultTelemetrySegment;
+
+	return new Game{ config };
 }
@@ -1,16 +1,16 @@
 #include "Application.h"
 
+#ifdef BLAZE_TRACK_ALLOCATIONS
+BLAZE_ALLOCATION_HOOKS
+#endif // BLAZE_TRACK_ALLOCATIONS
+
 int main()
 {
 	auto* app = CreateApplication();
 
-	app->OnCreate();
-
-	while (app->OnUpdate());
-
-	app->OnDestroy();
+	int result = app->Run();
 
 	delete app;
 
-	return 0;
+	return result;
 }
@@ -0,0 +1,185 @@
+// Prints the counters and events a running Blaze game publishes, see Blaze::Telemetry
+// Usage: Monitor [segment name] [interval in milliseconds]
+#include <Blaze/Profiling/TelemetryLayout.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+#if defined(BLAZE_PLATFORM_WIN32) || defined(BLAZE_PLATFORM_WIN64)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#elif defined(BLAZE_PLATFORM_LINUX) // ^^^ Windows (Win32) / Linux (Posix) vvv
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif // ^^^ Linux (Posix)
+
+// Seconds without a new publish before the segment is mapped again, the game may have restarted
+constexpr double reopenTimeout = 2.0;
+
+class TelemetryMapping
+{
+public:
+	TelemetryMapping() = default;
+	~TelemetryMapping() { Close(); }
+
+	TelemetryMapping(const TelemetryMapping&) = delete;
+	TelemetryMapping& operator=(const TelemetryMapping&) = delete;
+
+	bool Open(const std::string& name)
+	{
+		Close();
+
+#if defined(BLAZE_PLATFORM_WIN32) || defined(BLAZE_PLATFORM_WIN64)
+		m_mapping = OpenFileMappingA(FILE_MAP_READ, FALSE, ("Local\\" + name).c_str());
+		if (!m_mapping)
+			return false;
+
+		void* memory = MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, sizeof(Blaze::TelemetryBlock));
+		if (!memory)
+		{
+			Close();
+			return false;
+		}
+#elif defined(BLAZE_PLATFORM_LINUX) // ^^^ Windows (Win32) / Linux (Posix) vvv
+		const int fd = shm_open(("/" + name).c_str(), O_RDONLY, 0);
+		if (fd < 0)
+			return false;
+
+		void* memory = mmap(nullptr, sizeof(Blaze::TelemetryBlock), PROT_READ, MAP_SHARED, fd, 0);
+		close(fd);
+		if (memory == MAP_FAILED)
+			return false;
+#endif // ^^^ Linux (Posix)
+
+		m_block = static_cast<const Blaze::TelemetryBlock*>(memory);
+		if (!Blaze::IsTelemetryBlockValid(*m_block))
+		{
+			Close();
+			return false;
+		}
+		return true;
+	}
+
+	void Close()
+	{
+#if defined(BLAZE_PLATFORM_WIN32) || defined(BLAZE_PLATFORM_WIN64)
+		if (m_block)
+			UnmapViewOfFile(m_block);
+		if (m_mapping)
+			CloseHandle(m_mapping);
+		m_mapping = nullptr;
+#elif defined(BLAZE_PLATFORM_LINUX) // ^^^ Windows (Win32) / Linux (Posix) vvv
+		if (m_block)
+			munmap(const_cast<Blaze::TelemetryBlock*>(m_block), sizeof(Blaze::TelemetryBlock));
+#endif // ^^^ Linux (Posix)
+		m_block = nullptr;
+	}
+
+	inline const Blaze::TelemetryBlock* GetBlock() const { return m_block; }
+private:
+	const Blaze::TelemetryBlock* m_block = nullptr;
+#if defined(BLAZE_PLATFORM_WIN32) || defined(BLAZE_PLATFORM_WIN64)
+	HANDLE m_mapping = nullptr;
+#endif // BLAZE_PLATFORM_WIN32 || BLAZE_PLATFORM_WIN64
+};
+
+static double ToMilliseconds(uint64_t nanoseconds) { return nanoseconds * 1e-6; }
+static double ToMiB(uint64_t bytes) { return bytes / (1024.0 * 1024.0); }
+
+static void PrintCounters(const Blaze::TelemetryCounters& counters)
+{
+	auto get = [&counters](Blaze::TelemetryCounter counter) { return counters[static_cast<size_t>(counter)]; };
+	using Blaze::TelemetryCounter;
+
+	std::printf("Frame %llu: %.2fms (CPU %.2fms, GPU %.2fms, present %.2fms), %llu window events, %llu uploads (%.3fMiB), "
+		"%llu objects (CPU %.3fMiB, GPU %.3fMiB), %llu allocations (%.3fMiB), heap %.3fMiB\n",
+		static_cast<unsigned long long>(get(TelemetryCounter::FrameIndex)), ToMilliseconds(get(TelemetryCounter::FrameTime)),
+		ToMilliseconds(get(TelemetryCounter::CPUFrameTime)), ToMilliseconds(get(TelemetryCounter::GPUFrameTime)), ToMilliseconds(get(TelemetryCounter::PresentInterval)),
+		static_cast<unsigned long long>(get(TelemetryCounter::NumWindowEvents)),
+		static_cast<unsigned long long>(get(TelemetryCounter::NumBufferUploads)), ToMiB(get(TelemetryCounter::BufferUploadBytes)),
+		static_cast<unsigned long long>(get(TelemetryCounter::NumObjects)), ToMiB(get(TelemetryCounter::ObjectCPUBytes)), ToMiB(get(TelemetryCounter::ObjectGPUBytes)),
+		static_cast<unsigned long long>(get(TelemetryCounter::NumAllocations)), ToMiB(get(TelemetryCounter::AllocatedBytes)), ToMiB(get(TelemetryCounter::LiveHeapBytes)));
+}
+
+static void PrintEvent(const Blaze::TelemetryEvent& event)
+{
+	switch (event.type)
+	{
+	case Blaze::TelemetryEventType::Hitch: std::printf("Event %llu: hitch of %.2fms\n", static_cast<unsigned long long>(event.index), ToMilliseconds(event.value)); break;
+	case Blaze::TelemetryEventType::FlightDump: std::printf("Event %llu: flight recorder dump of frame %llu\n", static_cast<unsigned long long>(event.index), static_cast<unsigned long long>(event.value)); break;
+	case Blaze::TelemetryEventType::Marker: std::printf("Event %llu: marker %llu\n", static_cast<unsigned long long>(event.index), static_cast<unsigned long long>(event.value)); break;
+	default: std::printf("Event %llu: unknown\n", static_cast<unsigned long long>(event.index)); break;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const std::string name = (argc > 1) ? argv[1] : Blaze::defaultTelemetrySegment;
+	const int interval = (argc > 2) ? std::max(std::atoi(argv[2]), 10) : 500;
+
+	TelemetryMapping mapping;
+	uint64_t nextEvent = 0;
+	uint64_t lastPublish = 0;
+	auto lastChange = std::chrono::steady_clock::now();
+
+	while (true)
+	{
+		const Blaze::TelemetryBlock* block = mapping.GetBlock();
+		if (!block)
+		{
+			if (!mapping.Open(name))
+			{
+				std::this_thread::sleep_for(std::chrono::seconds(1));
+				continue;
+			}
+
+			block = mapping.GetBlock();
+			std::printf("Monitoring %s of process %u\n", name.c_str(), block->processID);
+			nextEvent = 0;
+			lastPublish = 0;
+			lastChange = std::chrono::steady_clock::now();
+		}
+
+		Blaze::TelemetryCounters counters;
+		if (Blaze::ReadTelemetryCounters(*block, counters))
+		{
+			const uint64_t publishTime = counters[static_cast<size_t>(Blaze::TelemetryCounter::PublishTime)];
+			if (publishTime != lastPublish)
+			{
+				PrintCounters(counters);
+				lastPublish = publishTime;
+				lastChange = std::chrono::steady_clock::now();
+			}
+		}
+
+		// Events that were overwritten before this poll are skipped
+		const uint64_t numEvents = block->numEvents.load(std::memory_order_acquire);
+		if (numEvents - nextEvent > Blaze::telemetryEventRingSize)
+		{
+			std::printf("Missed %llu events\n", static_cast<unsigned long long>(numEvents - nextEvent - Blaze::telemetryEventRingSize));
+			nextEvent = numEvents - Blaze::telemetryEventRingSize;
+		}
+		for (; nextEvent < numEvents; nextEvent++)
+		{
+			Blaze::TelemetryEvent event;
+			if (!Blaze::ReadTelemetryEvent(*block, nextEvent, event))
+				break;
+			PrintEvent(event);
+		}
+		std::fflush(stdout);
+
+		if (std::chrono::duration<double>(std::chrono::steady_clock::now() - lastChange).count() > reopenTimeout)
+		{
+			std::printf("No updates from %s, waiting for the game\n", name.c_str());
+			mapping.Close();
+		}
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(interval));
+	}
+}